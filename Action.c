@@ -15,6 +15,7 @@ in the source distribution for its full text.
 #include <stdlib.h>
 #include <string.h>
 
+#include "BulkAction.h"
 #include "CRT.h"
 #include "CategoriesPanel.h"
 #include "CommandScreen.h"
@@ -25,6 +26,7 @@ in the source distribution for its full text.
 #include "IncSet.h"
 #include "InfoScreen.h"
 #include "ListItem.h"
+#include "Machine.h"
 #include "Macros.h"
 #include "MainPanel.h"
 #include "OpenFilesScreen.h"
@@ -102,12 +104,16 @@ static void Action_runSetup(State* st) {
    }
 }
 
-static bool changePriority(MainPanel* panel, int delta) {
-   bool anyTagged;
-   bool ok = MainPanel_foreachRow(panel, Process_rowChangePriorityBy, (Arg) { .i = delta }, &anyTagged);
-   if (!ok)
-      beep();
-   return anyTagged;
+static Htop_Reaction changePriority(MainPanel* panel, int delta) {
+   BulkAction action;
+   BulkAction_init(&action, panel);
+   BulkAction_run(&action, Process_rowChangePriorityBy, (Arg) { .i = delta });
+
+   Htop_Reaction reaction = action.anyTagged ? HTOP_REFRESH : HTOP_OK;
+   if (BulkAction_report(&action, delta < 0 ? "Raise priority" : "Lower priority"))
+      reaction |= HTOP_REFRESH | HTOP_REDRAW_BAR;
+   BulkAction_done(&action);
+   return reaction;
 }
 
 static void addUserToVector(ht_key_t key, void* userCast, void* panelCast) {
@@ -297,7 +303,7 @@ static Htop_Reaction actionToggleHideMeters(State* st) {
 static Htop_Reaction actionExpandOrCollapseAllBranches(State* st) {
    Machine* host = st->host;
    ScreenSettings* ss = host->settings->ss;
-   if (!ss->treeView) {
+   if (!ss->treeView && !ss->groupBy) {
       return HTOP_OK;
    }
    ss->allBranchesCollapsed = !ss->allBranchesCollapsed;
@@ -326,16 +332,14 @@ static Htop_Reaction actionHigherPriority(State* st) {
    if (!Action_writeableProcess(st))
       return HTOP_OK;
 
-   bool changed = changePriority(st->mainPanel, -1);
-   return changed ? HTOP_REFRESH : HTOP_OK;
+   return changePriority(st->mainPanel, -1);
 }
 
 static Htop_Reaction actionLowerPriority(State* st) {
    if (!Action_writeableProcess(st))
       return HTOP_OK;
 
-   bool changed = changePriority(st->mainPanel, 1);
-   return changed ? HTOP_REFRESH : HTOP_OK;
+   return changePriority(st->mainPanel, 1);
 }
 
 static Htop_Reaction actionInvertSortOrder(State* st) {
@@ -346,7 +350,8 @@ static Htop_Reaction actionInvertSortOrder(State* st) {
 }
 
 static Htop_Reaction actionExpandOrCollapse(State* st) {
-   if (!st->host->settings->ss->treeView)
+   const ScreenSettings* ss = st->host->settings->ss;
+   if (!ss->treeView && !ss->groupBy)
       return HTOP_OK;
 
    bool changed = expandCollapse((Panel*)st->mainPanel);
@@ -354,7 +359,8 @@ static Htop_Reaction actionExpandOrCollapse(State* st) {
 }
 
 static Htop_Reaction actionCollapseIntoParent(State* st) {
-   if (!st->host->settings->ss->treeView) {
+   const ScreenSettings* ss = st->host->settings->ss;
+   if (!ss->treeView && !ss->groupBy) {
       return HTOP_OK;
    }
    bool changed = collapseIntoParent((Panel*)st->mainPanel);
@@ -374,6 +380,9 @@ static inline void setActiveScreen(Settings* settings, State* st, unsigned int s
       settings->ss->table = host->processTable;
    host->activeTable = settings->ss->table;
 
+   /* screens added in the setup may bring a table not scanned so far */
+   Machine_addTable(host, host->activeTable);
+
    // set correct functionBar - readonly if requested, and/or with non-process screens
    bool readonly = Settings_isReadonly() || (host->activeTable != host->processTable);
    MainPanel_setFunctionBar(st->mainPanel, readonly);
@@ -442,7 +451,7 @@ static Htop_Reaction actionSetAffinity(State* st) {
 
 #if (defined(HAVE_LIBHWLOC) || defined(HAVE_AFFINITY))
    const Row* row = (const Row*) Panel_getSelected((Panel*)st->mainPanel);
-   if (!row)
+   if (!row || row->isAggregate)
       return HTOP_OK;
 
    Affinity* affinity1 = Affinity_rowGet(row, host);
@@ -456,9 +465,11 @@ static Htop_Reaction actionSetAffinity(State* st) {
    const void* set = Action_pickFromVector(st, affinityPanel, width, true);
    if (set) {
       Affinity* affinity2 = AffinityPanel_getAffinity(affinityPanel, host);
-      bool ok = MainPanel_foreachRow(st->mainPanel, Affinity_rowSet, (Arg) { .v = affinity2 }, NULL);
-      if (!ok)
-         beep();
+      BulkAction action;
+      BulkAction_init(&action, st->mainPanel);
+      BulkAction_run(&action, Affinity_rowSet, (Arg) { .v = affinity2 });
+      BulkAction_report(&action, "Set CPU affinity");
+      BulkAction_done(&action);
       Affinity_delete(affinity2);
    }
    Object_delete(affinityPanel);
@@ -502,9 +513,11 @@ static Htop_Reaction actionSetSchedPolicy(State* st) {
 
       SchedulingArg v = { .policy = preSelectedPolicy, .priority = preSelectedPriority };
 
-      bool ok = MainPanel_foreachRow(st->mainPanel, Scheduling_rowSetPolicy, (Arg) { .v = &v }, NULL);
-      if (!ok)
-         beep();
+      BulkAction action;
+      BulkAction_init(&action, st->mainPanel);
+      BulkAction_run(&action, Scheduling_rowSetPolicy, (Arg) { .v = &v });
+      BulkAction_report(&action, "Set scheduling policy");
+      BulkAction_done(&action);
    }
 
    Panel_delete((Object*)schedPanel);
@@ -526,11 +539,15 @@ static Htop_Reaction actionKill(State* st) {
       Panel_setHeader((Panel*)st->mainPanel, "Sending...");
       Panel_draw((Panel*)st->mainPanel, false, true, true, State_hideFunctionBar(st));
       refresh();
-      bool ok = MainPanel_foreachRow(st->mainPanel, Process_rowSendSignal, (Arg) { .i = sgn->key }, NULL);
-      if (!ok) {
-         beep();
-      }
-      napms(500);
+      BulkAction action;
+      BulkAction_init(&action, st->mainPanel);
+      BulkAction_sendSignal(&action, sgn->key);
+
+      char title[32];
+      xSnprintf(title, sizeof(title), "Send signal %d", sgn->key);
+      if (!BulkAction_report(&action, title))
+         napms(500);
+      BulkAction_done(&action);
    }
    Panel_delete((Object*)signalsPanel);
 
@@ -573,7 +590,7 @@ static Htop_Reaction actionLsof(State* st) {
       return HTOP_OK;
 
    const Process* p = (Process*) Panel_getSelected((Panel*)st->mainPanel);
-   if (!p)
+   if (!p || p->super.isAggregate)
       return HTOP_OK;
 
    assert(Object_isA((const Object*) p, (const ObjectClass*) &Process_class));
@@ -591,7 +608,7 @@ static Htop_Reaction actionShowLocks(State* st) {
       return HTOP_OK;
 
    const Process* p = (Process*) Panel_getSelected((Panel*)st->mainPanel);
-   if (!p)
+   if (!p || p->super.isAggregate)
       return HTOP_OK;
 
    assert(Object_isA((const Object*) p, (const ObjectClass*) &Process_class));
@@ -609,7 +626,7 @@ static Htop_Reaction actionStrace(State* st) {
       return HTOP_OK;
 
    const Process* p = (Process*) Panel_getSelected((Panel*)st->mainPanel);
-   if (!p)
+   if (!p || p->super.isAggregate)
       return HTOP_OK;
 
    assert(Object_isA((const Object*) p, (const ObjectClass*) &Process_class));
@@ -658,6 +675,9 @@ static const struct {
    { .key = "   F3 /: ",  .roInactive = false, .info = "incremental name search" },
    { .key = "   F4 \\: ", .roInactive = false, .info = "incremental name filtering" },
    { .key = "   F5 t: ",  .roInactive = false, .info = "tree view" },
+#ifdef HTOP_LINUX
+   { .key = "      G: ",  .roInactive = false, .info = "group processes by a column" },
+#endif
    { .key = "      p: ",  .roInactive = false, .info = "toggle program path" },
    { .key = "      m: ",  .roInactive = false, .info = "toggle merged command" },
    { .key = "      Z: ",  .roInactive = false, .info = "pause/resume process updates" },
@@ -681,6 +701,7 @@ static const struct {
    { .key = "  S-Tab: ", .roInactive = false, .info = "switch to previous screen tab" },
    { .key = "  Space: ", .roInactive = false, .info = "tag process" },
    { .key = "      c: ", .roInactive = false, .info = "tag process and its children" },
+   { .key = "      A: ", .roInactive = false, .info = "tag all processes shown" },
    { .key = "      U: ", .roInactive = false, .info = "untag all processes" },
    { .key = "   F9 k: ", .roInactive = true,  .info = "kill process/tagged processes" },
    { .key = "   F7 ]: ", .roInactive = true,  .info = "higher priority (root only)" },
@@ -690,8 +711,21 @@ static const struct {
 #endif
    { .key = "      e: ", .roInactive = false, .info = "show process environment" },
    { .key = "      i: ", .roInactive = true,  .info = "set IO priority" },
+#ifdef HTOP_LINUX
+   { .key = "      l: ", .roInactive = true,  .info = "list open files" },
+#else
    { .key = "      l: ", .roInactive = true,  .info = "list open files with lsof" },
+#endif
    { .key = "      x: ", .roInactive = false, .info = "list file locks of process" },
+#ifdef HTOP_LINUX
+   { .key = "      D: ", .roInactive = false, .info = "list disks and network interfaces" },
+   { .key = "      E: ", .roInactive = false, .info = "estimate working set of process" },
+   { .key = "      J: ", .roInactive = false, .info = "sample the threads of process" },
+   { .key = "      R: ", .roInactive = false, .info = "show memory maps of process" },
+   { .key = "      V: ", .roInactive = false, .info = "list systemd units" },
+   { .key = "      W: ", .roInactive = false, .info = "sample where threads of process wait" },
+   { .key = "      X: ", .roInactive = false, .info = "list file locks of all processes" },
+#endif
    { .key = "      s: ", .roInactive = true,  .info = "trace syscalls with strace" },
    { .key = "      w: ", .roInactive = false, .info = "wrap process command in multiple lines" },
 #ifdef SCHEDULER_SUPPORT
@@ -851,6 +885,14 @@ static Htop_Reaction actionUntagAll(State* st) {
    return HTOP_REFRESH;
 }
 
+static Htop_Reaction actionTagAllShown(State* st) {
+   for (int i = 0; i < Panel_size((Panel*)st->mainPanel); i++) {
+      Row* row = (Row*) Panel_get((Panel*)st->mainPanel, i);
+      row->tag = true;
+   }
+   return HTOP_REFRESH;
+}
+
 static Htop_Reaction actionTagAllChildren(State* st) {
    Row* row = (Row*) Panel_getSelected((Panel*)st->mainPanel);
    if (!row)
@@ -865,7 +907,7 @@ static Htop_Reaction actionShowEnvScreen(State* st) {
       return HTOP_OK;
 
    Process* p = (Process*) Panel_getSelected((Panel*)st->mainPanel);
-   if (!p)
+   if (!p || p->super.isAggregate)
       return HTOP_OK;
 
    assert(Object_isA((const Object*) p, (const ObjectClass*) &Process_class));
@@ -883,7 +925,7 @@ static Htop_Reaction actionShowCommandScreen(State* st) {
       return HTOP_OK;
 
    Process* p = (Process*) Panel_getSelected((Panel*)st->mainPanel);
-   if (!p)
+   if (!p || p->super.isAggregate)
       return HTOP_OK;
 
    assert(Object_isA((const Object*) p, (const ObjectClass*) &Process_class));
@@ -909,6 +951,7 @@ void Action_setBindings(Htop_Action* keys) {
    keys['='] = actionExpandOrCollapse;
    keys['>'] = actionSetSortColumn;
    keys['?'] = actionHelp;
+   keys['A'] = actionTagAllShown;
    keys['C'] = actionSetup;
    keys['F'] = Action_follow;
    keys['H'] = actionToggleUserlandThreads;
@@ -0,0 +1,391 @@
+/*
+htop - BatchOutput.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "BatchOutput.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "Machine.h"
+#include "Macros.h"
+#include "Object.h"
+#include "Platform.h"
+#include "Process.h"
+#include "ProcessTable.h"
+#include "Profiler.h"
+#include "Recording.h"
+#include "ReplayProcessTable.h"
+#include "RichString.h"
+#include "Row.h"
+#include "RowField.h"
+#include "Settings.h"
+#include "Table.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+#ifdef HAVE_LIBNCURSESW
+#include <wchar.h>
+#endif
+
+
+typedef struct BatchOutput_ {
+   FILE* out;
+   Recorder* recorder;  /* set when recording instead of writing samples */
+   BatchFormat format;
+   const Settings* settings;
+   char* value;         /* text of the field being written */
+   size_t valueSize;
+} BatchOutput;
+
+BatchFormat BatchOutput_parseFormat(const char* name) {
+   if (!name || String_eq(name, "csv"))
+      return BATCH_FORMAT_CSV;
+   if (String_eq(name, "json"))
+      return BATCH_FORMAT_JSON;
+   if (String_eq(name, "binary"))
+      return BATCH_FORMAT_BINARY;
+   return BATCH_FORMAT_NONE;
+}
+
+static void BatchOutput_putU16(FILE* out, uint16_t v) {
+   fputc(v & 0xff, out);
+   fputc(v >> 8, out);
+}
+
+static void BatchOutput_putU32(FILE* out, uint32_t v) {
+   BatchOutput_putU16(out, v & 0xffff);
+   BatchOutput_putU16(out, v >> 16);
+}
+
+static void BatchOutput_putU64(FILE* out, uint64_t v) {
+   BatchOutput_putU32(out, v & 0xffffffff);
+   BatchOutput_putU32(out, v >> 32);
+}
+
+static void BatchOutput_putBlob(FILE* out, const char* s) {
+   size_t len = MINIMUM(strlen(s), UINT16_MAX);
+   BatchOutput_putU16(out, (uint16_t)len);
+   fwrite(s, 1, len, out);
+}
+
+static void BatchOutput_putCSV(FILE* out, const char* s) {
+   if (!strpbrk(s, ",\"\r\n")) {
+      fputs(s, out);
+      return;
+   }
+
+   fputc('"', out);
+   for (; *s; s++) {
+      if (*s == '"')
+         fputc('"', out);
+      fputc(*s, out);
+   }
+   fputc('"', out);
+}
+
+static void BatchOutput_putJSONString(FILE* out, const char* s) {
+   fputc('"', out);
+   for (; *s; s++) {
+      unsigned char c = (unsigned char) *s;
+      if (c == '"' || c == '\\') {
+         fputc('\\', out);
+         fputc(c, out);
+      } else if (c < 0x20) {
+         fprintf(out, "\\u%04x", c);
+      } else {
+         fputc(c, out);
+      }
+   }
+   fputc('"', out);
+}
+
+/* Whether s follows the grammar of JSON numbers: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)? */
+static bool BatchOutput_isJSONNumber(const char* s) {
+   if (*s == '-')
+      s++;
+
+   if (*s == '0') {
+      s++;
+   } else if (*s >= '1' && *s <= '9') {
+      while (*s >= '0' && *s <= '9')
+         s++;
+   } else {
+      return false;
+   }
+
+   if (*s == '.') {
+      s++;
+      if (!(*s >= '0' && *s <= '9'))
+         return false;
+      while (*s >= '0' && *s <= '9')
+         s++;
+   }
+
+   if (*s == 'e' || *s == 'E') {
+      s++;
+      if (*s == '+' || *s == '-')
+         s++;
+      if (!(*s >= '0' && *s <= '9'))
+         return false;
+      while (*s >= '0' && *s <= '9')
+         s++;
+   }
+
+   return *s == '\0';
+}
+
+/* Numbers are written unquoted, everything else (e.g. "1.5G", "-", "0x1f", "inf") as string */
+static void BatchOutput_putJSONValue(FILE* out, const char* s) {
+   if (BatchOutput_isJSONNumber(s)) {
+      fputs(s, out);
+      return;
+   }
+
+   BatchOutput_putJSONString(out, s);
+}
+
+static const char* BatchOutput_fieldName(const BatchOutput* this, RowField field) {
+   const char* name = Settings_fieldName(this->settings, field);
+   return name ? name : "?";
+}
+
+/* Copies the text of a formatted field into this->value without padding */
+static const char* BatchOutput_fieldText(BatchOutput* this, const RichString* str) {
+   size_t len = 0;
+   int size = RichString_size(str);
+
+   for (int i = 0; i < size; i++) {
+      if (this->valueSize - len < 8) {
+         this->valueSize = this->valueSize * 2 + 64;
+         this->value = xRealloc(this->value, this->valueSize);
+      }
+#ifdef HAVE_LIBNCURSESW
+      mbstate_t ps;
+      memset(&ps, 0, sizeof(ps));
+      size_t n = wcrtomb(this->value + len, RichString_getCharVal(*str, i), &ps);
+      if (n != (size_t)-1)
+         len += n;
+#else
+      this->value[len++] = (char) RichString_getCharVal(*str, i);
+#endif
+   }
+
+   if (!this->value)
+      return "";
+
+   while (len > 0 && this->value[len - 1] == ' ')
+      len--;
+   this->value[len] = '\0';
+
+   char* start = this->value;
+   while (*start == ' ')
+      start++;
+   return start;
+}
+
+static const char* BatchOutput_rowValue(BatchOutput* this, Row* row, RowField field, RichString* str) {
+   /* the Command column is written in full, without tree drawing characters */
+   if (field == COMM && Object_isA((const Object*) row, (const ObjectClass*) &Process_class)) {
+      Process* proc = (Process*) row;
+      Process_makeCommandStr(proc, this->settings);
+      const char* command = Process_getCommand(proc);
+      return command ? command : "";
+   }
+
+   RichString_rewind(str, RichString_size(str));
+   As_Row(row)->writeField(row, str, field);
+   return BatchOutput_fieldText(this, str);
+}
+
+static void BatchOutput_writeHeader(BatchOutput* this) {
+   const RowField* fields = this->settings->ss->fields;
+   FILE* out = this->out;
+
+   switch (this->format) {
+   case BATCH_FORMAT_CSV:
+      fputs("TIMESTAMP", out);
+      for (int i = 0; fields[i]; i++) {
+         fputc(',', out);
+         BatchOutput_putCSV(out, BatchOutput_fieldName(this, fields[i]));
+      }
+      fputc('\n', out);
+      break;
+   case BATCH_FORMAT_BINARY: {
+      uint16_t count = 0;
+      while (fields[count])
+         count++;
+      fputs(BATCH_BINARY_MAGIC, out);
+      fputc(BATCH_BINARY_VERSION, out);
+      BatchOutput_putU16(out, count);
+      for (int i = 0; fields[i]; i++)
+         BatchOutput_putBlob(out, BatchOutput_fieldName(this, fields[i]));
+      break;
+   }
+   default:
+      break;
+   }
+}
+
+static void BatchOutput_writeSample(BatchOutput* this, Table* table) {
+   const Machine* host = table->host;
+   const RowField* fields = this->settings->ss->fields;
+   FILE* out = this->out;
+
+   table->needsSort = true;
+   Table_updateDisplayList(table);
+
+   const int size = Vector_size(table->displayList);
+
+   if (this->format == BATCH_FORMAT_BINARY) {
+      uint32_t count = 0;
+      for (int i = 0; i < size; i++) {
+         const Row* row = (const Row*) Vector_get(table->displayList, i);
+         if (row->show && !Row_matchesFilter(row, table))
+            count++;
+      }
+      fputc('S', out);
+      BatchOutput_putU64(out, host->realtimeMs);
+      BatchOutput_putU32(out, count);
+   }
+
+   RichString_begin(str);
+
+   for (int i = 0; i < size; i++) {
+      Row* row = (Row*) Vector_get(table->displayList, i);
+      if (!row->show || Row_matchesFilter(row, table))
+         continue;
+
+      switch (this->format) {
+      case BATCH_FORMAT_CSV:
+         fprintf(out, "%" PRIu64, host->realtimeMs);
+         for (int j = 0; fields[j]; j++) {
+            fputc(',', out);
+            BatchOutput_putCSV(out, BatchOutput_rowValue(this, row, fields[j], &str));
+         }
+         fputc('\n', out);
+         break;
+      case BATCH_FORMAT_JSON:
+         fprintf(out, "{\"TIMESTAMP\":%" PRIu64, host->realtimeMs);
+         for (int j = 0; fields[j]; j++) {
+            fputc(',', out);
+            BatchOutput_putJSONString(out, BatchOutput_fieldName(this, fields[j]));
+            fputc(':', out);
+            BatchOutput_putJSONValue(out, BatchOutput_rowValue(this, row, fields[j], &str));
+         }
+         fputs("}\n", out);
+         break;
+      case BATCH_FORMAT_BINARY:
+         for (int j = 0; fields[j]; j++)
+            BatchOutput_putBlob(out, BatchOutput_rowValue(this, row, fields[j], &str));
+         break;
+      default:
+         break;
+      }
+   }
+
+   RichString_delete(&str);
+
+   fflush(out);
+}
+
+static void BatchOutput_sleep(int delay) {
+   struct timespec req = {
+      .tv_sec = delay / 10,
+      .tv_nsec = (long)(delay % 10) * 100000000L,
+   };
+
+   while (nanosleep(&req, &req) == -1 && errno == EINTR)
+      ;
+}
+
+int BatchOutput_run(Machine* host, BatchFormat format, const char* fileName, int iterations) {
+   BatchOutput this = {
+      .out = stdout,
+      .format = format,
+      .settings = host->settings,
+   };
+
+   if (format == BATCH_FORMAT_RECORD) {
+      this.recorder = Recorder_new(fileName);
+      if (!this.recorder) {
+         fprintf(stderr, "Error: can not open %s: %s\n", fileName, strerror(errno));
+         return 1;
+      }
+   } else if (fileName && !String_eq(fileName, "-")) {
+      this.out = fopen(fileName, format == BATCH_FORMAT_BINARY ? "wb" : "w");
+      if (!this.out) {
+         fprintf(stderr, "Error: can not open %s: %s\n", fileName, strerror(errno));
+         return 1;
+      }
+   }
+
+   Table* table = host->activeTable;
+   const ReplayProcessTable* replay = Object_isA((const Object*) host->processTable, (const ObjectClass*) &ReplayProcessTable_class) ? (const ReplayProcessTable*) host->processTable : NULL;
+
+   /* rates and percentages need a previous sample to compare against, unless recorded */
+   if (!replay) {
+      Machine_scan(host);
+      Machine_scanTables(host);
+      Profiler_commit();
+   }
+
+   if (!this.recorder)
+      BatchOutput_writeHeader(&this);
+
+   int result = 0;
+   for (int i = 0; iterations < 0 || i < iterations; i++) {
+      if (!replay || i > 0)
+         BatchOutput_sleep(this.settings->delay);
+
+      uint64_t refreshStart = Profiler_begin();
+      Platform_gettime_realtime(&host->realtime, &host->realtimeMs);
+      uint64_t start = Profiler_begin();
+      Machine_scan(host);
+      Profiler_end(PROFILE_MACHINE_SCAN, start);
+      Machine_scanTables(host);
+
+      /* the last frame was already written */
+      if (replay && replay->ended)
+         break;
+
+      if (this.recorder) {
+         bool ok = Recorder_writeFrame(this.recorder, host, (const ProcessTable*) host->processTable);
+         Profiler_end(PROFILE_REFRESH, refreshStart);
+         Profiler_commit();
+         if (!ok) {
+            fprintf(stderr, "Error: can not write to %s: %s\n", fileName, strerror(errno));
+            result = 1;
+            break;
+         }
+         continue;
+      }
+
+      BatchOutput_writeSample(&this, table);
+      Profiler_end(PROFILE_REFRESH, refreshStart);
+      Profiler_commit();
+
+      if (ferror(this.out))
+         break;
+   }
+
+   if (ferror(this.out))
+      result = 1;
+   if (this.out != stdout)
+      fclose(this.out);
+   Recorder_delete(this.recorder);
+
+   free(this.value);
+   return result;
+}
@@ -0,0 +1,32 @@
+#ifndef HEADER_BatchOutput
+#define HEADER_BatchOutput
+/*
+htop - BatchOutput.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "Machine.h"
+
+
+typedef enum BatchFormat_ {
+   BATCH_FORMAT_NONE = 0,
+   BATCH_FORMAT_CSV,
+   BATCH_FORMAT_JSON,
+   BATCH_FORMAT_BINARY,
+   BATCH_FORMAT_RECORD,  /* process table recording for --replay, see Recording.h */
+} BatchFormat;
+
+/* Magic number starting a binary batch stream, followed by the version byte */
+#define BATCH_BINARY_MAGIC "HTOPBAT"
+#define BATCH_BINARY_VERSION 1
+
+BatchFormat BatchOutput_parseFormat(const char* name);
+
+/* Scans the machine like the interactive mode and writes the rows of the
+ * active table after each update, until iterations (-1 for unlimited)
+ * samples were written. Returns the process exit code. */
+int BatchOutput_run(Machine* host, BatchFormat format, const char* fileName, int iterations);
+
+#endif
@@ -69,5 +69,6 @@ const MeterClass BatteryMeter_class = {
    .attributes = BatteryMeter_attributes,
    .name = "Battery",
    .uiName = "Battery",
-   .caption = "Battery: "
+   .caption = "Battery: ",
+   .updateInterval = 10000
 };
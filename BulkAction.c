@@ -0,0 +1,128 @@
+/*
+htop - BulkAction.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "BulkAction.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "BulkActionScreen.h"
+#include "CRT.h"
+#include "InfoScreen.h"
+#include "Panel.h"
+#include "Platform.h"
+#include "Process.h"
+#include "ProvideCurses.h"
+#include "XUtils.h"
+
+
+void BulkAction_init(BulkAction* this, MainPanel* panel) {
+   Panel* super = (Panel*) panel;
+   memset(this, 0, sizeof(BulkAction));
+
+   // aggregates only stand for the processes tagged with them
+   size_t tagged = 0;
+   for (int i = 0; i < Panel_size(super); i++) {
+      const Row* row = (const Row*) Panel_get(super, i);
+      if (row->tag) {
+         this->anyTagged = true;
+         if (!row->isAggregate)
+            tagged++;
+      }
+   }
+
+   Row* selected = NULL;
+   if (!this->anyTagged) {
+      selected = (Row*) Panel_getSelected(super);
+      if (!selected || selected->isAggregate)
+         return;
+      tagged = 1;
+   }
+   if (!tagged)
+      return;
+
+   this->targets = xCalloc(tagged, sizeof(BulkTarget));
+   if (selected) {
+      this->targets[this->count++].row = selected;
+      return;
+   }
+
+   for (int i = 0; i < Panel_size(super); i++) {
+      Row* row = (Row*) Panel_get(super, i);
+      if (row->tag && !row->isAggregate)
+         this->targets[this->count++].row = row;
+   }
+}
+
+void BulkAction_done(BulkAction* this) {
+   free(this->targets);
+   this->targets = NULL;
+   this->count = 0;
+}
+
+/* Applies fn to each target, or sends them signal sgn without one */
+static bool BulkAction_apply(BulkAction* this, MainPanel_foreachRowFn fn, Arg arg) {
+   uint64_t start;
+   Platform_gettime_monotonic(&start);
+
+   this->failed = 0;
+   for (size_t i = 0; i < this->count; i++) {
+      BulkTarget* target = &this->targets[i];
+
+      const Process* process = (const Process*) target->row;
+      int pidfd;
+      if (!Platform_pinProcess(process, &pidfd)) {
+         target->error = errno;
+         this->failed++;
+         continue;
+      }
+
+      errno = 0;
+      bool ok = fn ? fn(target->row, arg) : Platform_signalPinned(process, pidfd, arg.i);
+      target->error = ok ? 0 : (errno ? errno : EPERM);
+      if (!ok)
+         this->failed++;
+
+      if (pidfd >= 0)
+         close(pidfd);
+   }
+
+   uint64_t end;
+   Platform_gettime_monotonic(&end);
+   this->elapsedMs = end > start ? end - start : 0;
+
+   return this->failed == 0;
+}
+
+bool BulkAction_run(BulkAction* this, MainPanel_foreachRowFn fn, Arg arg) {
+   return BulkAction_apply(this, fn, arg);
+}
+
+bool BulkAction_sendSignal(BulkAction* this, int sgn) {
+   return BulkAction_apply(this, NULL, (Arg) { .i = sgn });
+}
+
+bool BulkAction_report(const BulkAction* this, const char* action) {
+   if (!this->failed)
+      return false;
+
+   if (this->count == 1) {
+      beep();
+      return false;
+   }
+
+   BulkActionScreen* screen = BulkActionScreen_new(this, action);
+   InfoScreen_run((InfoScreen*)screen);
+   BulkActionScreen_delete((Object*)screen);
+   clear();
+   CRT_enableDelay();
+   return true;
+}
@@ -0,0 +1,51 @@
+#ifndef HEADER_BulkAction
+#define HEADER_BulkAction
+/*
+htop - BulkAction.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "MainPanel.h"
+#include "Object.h"
+#include "Row.h"
+
+
+typedef struct BulkTarget_ {
+   Row* row;
+   int error;                     /* errno of the failed action, 0 if it succeeded */
+} BulkTarget;
+
+/*
+ * An action applied to the tagged processes, or to the selected one if
+ * none is tagged. Where the platform has pidfds each process is pinned
+ * before it is acted upon, and checked to still be the one listed, so
+ * that a pid reused since the last update is never hit; signals are sent
+ * through the pidfd itself. Failures are kept per target for reporting.
+ */
+typedef struct BulkAction_ {
+   BulkTarget* targets;
+   size_t count;
+   bool anyTagged;
+   size_t failed;
+   uint64_t elapsedMs;            /* time the last run took */
+} BulkAction;
+
+void BulkAction_init(BulkAction* this, MainPanel* panel);
+
+void BulkAction_done(BulkAction* this);
+
+/* Applies a row function to each target; returns whether it succeeded on all */
+bool BulkAction_run(BulkAction* this, MainPanel_foreachRowFn fn, Arg arg);
+
+bool BulkAction_sendSignal(BulkAction* this, int sgn);
+
+/* Reports failures of the last run: a beep for a single target, a screen listing them otherwise; returns whether the screen was shown */
+bool BulkAction_report(const BulkAction* this, const char* action);
+
+#endif
@@ -0,0 +1,84 @@
+/*
+htop - BulkActionScreen.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "BulkActionScreen.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Macros.h"
+#include "Panel.h"
+#include "Process.h"
+#include "ProvideCurses.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+
+BulkActionScreen* BulkActionScreen_new(const BulkAction* action, const char* title) {
+   BulkActionScreen* this = xCalloc(1, sizeof(BulkActionScreen));
+   Object_setClass(this, Class(BulkActionScreen));
+   this->action = action;
+   String_safeStrncpy(this->title, title, sizeof(this->title));
+   return (BulkActionScreen*) InfoScreen_init(&this->super, NULL, NULL, LINES - 2, " ");
+}
+
+void BulkActionScreen_delete(Object* this) {
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void BulkActionScreen_draw(InfoScreen* super) {
+   const BulkActionScreen* this = (const BulkActionScreen*) super;
+   const BulkAction* action = this->action;
+
+   InfoScreen_drawTitled(super, "%s: failed for %zu of %zu processes (took %llu ms)",
+                         this->title, action->failed, action->count, (unsigned long long int) action->elapsedMs);
+}
+
+static void BulkActionScreen_scan(InfoScreen* super) {
+   const BulkActionScreen* this = (const BulkActionScreen*) super;
+   const BulkAction* action = this->action;
+   Panel* panel = super->display;
+   int idx = MAXIMUM(Panel_getSelectedIndex(panel), 0);
+
+   Panel_prune(panel);
+   Vector_prune(super->lines);
+
+   char header[64];
+   xSnprintf(header, sizeof(header), "%*s %-32s %s", Process_pidDigits, "PID", "ERROR", "COMMAND");
+   Panel_setHeader(panel, header);
+
+   for (size_t i = 0; i < action->count; i++) {
+      const BulkTarget* target = &action->targets[i];
+      if (!target->error)
+         continue;
+
+      const char* command = Process_getCommand((const Process*) target->row);
+
+      char line[512];
+      xSnprintf(line, sizeof(line), "%*d %-32.32s %s", Process_pidDigits, target->row->id, strerror(target->error), command ? command : "");
+
+      /* the arguments of a command line are kept apart by newlines */
+      for (char* c = line; *c; c++) {
+         if (*c == '\n')
+            *c = ' ';
+      }
+      InfoScreen_addLine(super, line);
+   }
+
+   Panel_setSelected(panel, idx);
+}
+
+const InfoScreenClass BulkActionScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = BulkActionScreen_delete
+   },
+   .scan = BulkActionScreen_scan,
+   .draw = BulkActionScreen_draw
+};
@@ -0,0 +1,27 @@
+#ifndef HEADER_BulkActionScreen
+#define HEADER_BulkActionScreen
+/*
+htop - BulkActionScreen.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "BulkAction.h"
+#include "InfoScreen.h"
+#include "Object.h"
+
+
+typedef struct BulkActionScreen_ {
+   InfoScreen super;
+   const BulkAction* action;
+   char title[64];
+} BulkActionScreen;
+
+extern const InfoScreenClass BulkActionScreen_class;
+
+BulkActionScreen* BulkActionScreen_new(const BulkAction* action, const char* title);
+
+void BulkActionScreen_delete(Object* this);
+
+#endif
@@ -0,0 +1,414 @@
+/*
+htop - CPUHeatmapMeter.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "CPUHeatmapMeter.h"
+
+#include <assert.h>
+#include <limits.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "CPUMeter.h"
+#include "CRT.h"
+#include "Machine.h"
+#include "Macros.h"
+#include "Object.h"
+#include "Platform.h"
+#include "ProvideCurses.h"
+#include "XUtils.h"
+
+
+/* Rows are added for every so many groups, up to a fixed height */
+#define HEATMAP_GROUPS_PER_ROW 64
+#define HEATMAP_MAX_ROWS 8
+
+typedef enum CPUHeatmapLevel_ {
+   HEATMAP_CPU,
+   HEATMAP_CORE,
+   HEATMAP_CCD,
+   HEATMAP_SOCKET,
+   HEATMAP_NODE,
+} CPUHeatmapLevel;
+
+typedef struct CPUHeatmapData_ {
+   CPUHeatmapLevel level;
+   unsigned int cpus;           /* existing CPUs the groups were built for */
+   unsigned int nGroups;
+   unsigned int* groupOf;       /* group of each CPU */
+   unsigned int* online;        /* online CPUs of each group */
+   double* load;                /* average usage of each group, negative if all its CPUs are offline */
+} CPUHeatmapData;
+
+static const int CPUHeatmapMeter_attributes[] = {
+   CPU_NORMAL
+};
+
+#ifdef HAVE_LIBHWLOC
+
+/* Groups the CPUs by the topology objects of a type; returns false if there are none */
+static bool CPUHeatmapMeter_groupByType(CPUHeatmapData* data, hwloc_topology_t topology, hwloc_obj_type_t type) {
+   int n = hwloc_get_nbobjs_by_type(topology, type);
+   if (n <= 0)
+      return false;
+
+   for (unsigned int cpu = 0; cpu < data->cpus; cpu++)
+      data->groupOf[cpu] = UINT_MAX;
+
+   data->nGroups = 0;
+   for (int i = 0; i < n; i++) {
+      hwloc_obj_t obj = hwloc_get_obj_by_type(topology, type, (unsigned int)i);
+      if (!obj || !obj->cpuset)
+         continue;
+
+      bool used = false;
+      for (unsigned int cpu = 0; cpu < data->cpus; cpu++) {
+         if (data->groupOf[cpu] == UINT_MAX && hwloc_bitmap_isset(obj->cpuset, cpu)) {
+            data->groupOf[cpu] = data->nGroups;
+            used = true;
+         }
+      }
+      if (used)
+         data->nGroups++;
+   }
+
+   /* CPUs hwloc does not know about stand on their own */
+   for (unsigned int cpu = 0; cpu < data->cpus; cpu++) {
+      if (data->groupOf[cpu] == UINT_MAX)
+         data->groupOf[cpu] = data->nGroups++;
+   }
+
+   return true;
+}
+
+/*
+ * The topology of the Machine keeps only objects adding structure: cores
+ * without SMT siblings and caches or packages spanning the same CPUs as
+ * their parent are missing, so each level falls back to the next one.
+ */
+static bool CPUHeatmapMeter_groupByTopology(CPUHeatmapData* data, const Machine* host) {
+   if (!host->topologyOk)
+      return false;
+
+   hwloc_topology_t topology = host->topology;
+   switch (data->level) {
+      case HEATMAP_CPU:
+         return false;
+      case HEATMAP_CORE:
+         return CPUHeatmapMeter_groupByType(data, topology, HWLOC_OBJ_CORE);
+      case HEATMAP_CCD:
+         #if HWLOC_API_VERSION >= 0x00020000
+         if (CPUHeatmapMeter_groupByType(data, topology, HWLOC_OBJ_L3CACHE))
+            return true;
+         #endif
+         /* fallthrough */
+      case HEATMAP_SOCKET:
+         if (CPUHeatmapMeter_groupByType(data, topology, HWLOC_OBJ_PACKAGE))
+            return true;
+         break;
+      case HEATMAP_NODE:
+         if (CPUHeatmapMeter_groupByType(data, topology, HWLOC_OBJ_NUMANODE))
+            return true;
+         break;
+   }
+
+   /* a single package or node spanning the whole machine */
+   for (unsigned int cpu = 0; cpu < data->cpus; cpu++)
+      data->groupOf[cpu] = 0;
+   data->nGroups = data->cpus ? 1 : 0;
+   return true;
+}
+
+#endif
+
+static void CPUHeatmapMeter_buildGroups(Meter* this) {
+   CPUHeatmapData* data = this->meterData;
+
+   data->cpus = this->host->existingCPUs;
+   free(data->groupOf);
+   data->groupOf = data->cpus ? xCalloc(data->cpus, sizeof(*data->groupOf)) : NULL;
+
+   bool grouped = false;
+   #ifdef HAVE_LIBHWLOC
+   grouped = CPUHeatmapMeter_groupByTopology(data, this->host);
+   #endif
+
+   /* without topology information every CPU is a group */
+   if (!grouped) {
+      for (unsigned int cpu = 0; cpu < data->cpus; cpu++)
+         data->groupOf[cpu] = cpu;
+      data->nGroups = data->cpus;
+   }
+
+   free(data->online);
+   free(data->load);
+   data->online = data->nGroups ? xCalloc(data->nGroups, sizeof(*data->online)) : NULL;
+   data->load = data->nGroups ? xCalloc(data->nGroups, sizeof(*data->load)) : NULL;
+}
+
+static int CPUHeatmapMeter_rows(const CPUHeatmapData* data) {
+   return CLAMP((int)((data->nGroups + HEATMAP_GROUPS_PER_ROW - 1) / HEATMAP_GROUPS_PER_ROW), 1, HEATMAP_MAX_ROWS);
+}
+
+static void CPUHeatmapMeter_commonInit(Meter* this, CPUHeatmapLevel level) {
+   CPUHeatmapData* data = this->meterData;
+   if (!data) {
+      data = this->meterData = xCalloc(1, sizeof(CPUHeatmapData));
+      data->level = level;
+   }
+
+   CPUHeatmapMeter_buildGroups(this);
+}
+
+static void CPUHeatmapMeter_init(Meter* this) {
+   CPUHeatmapMeter_commonInit(this, HEATMAP_CPU);
+}
+
+static void CoreHeatmapMeter_init(Meter* this) {
+   CPUHeatmapMeter_commonInit(this, HEATMAP_CORE);
+}
+
+static void CCDHeatmapMeter_init(Meter* this) {
+   CPUHeatmapMeter_commonInit(this, HEATMAP_CCD);
+}
+
+static void SocketHeatmapMeter_init(Meter* this) {
+   CPUHeatmapMeter_commonInit(this, HEATMAP_SOCKET);
+}
+
+static void NodeHeatmapMeter_init(Meter* this) {
+   CPUHeatmapMeter_commonInit(this, HEATMAP_NODE);
+}
+
+static void CPUHeatmapMeter_done(Meter* this) {
+   CPUHeatmapData* data = this->meterData;
+   free(data->groupOf);
+   free(data->online);
+   free(data->load);
+   free(data);
+}
+
+static void CPUHeatmapMeter_updateValues(Meter* this) {
+   CPUHeatmapData* data = this->meterData;
+   if (data->cpus != this->host->existingCPUs) {
+      CPUHeatmapMeter_buildGroups(this);
+      this->h = CPUHeatmapMeter_rows(data);
+   }
+
+   for (unsigned int i = 0; i < data->nGroups; i++) {
+      data->load[i] = 0.0;
+      data->online[i] = 0;
+   }
+
+   for (unsigned int cpu = 0; cpu < data->cpus; cpu++) {
+      double percent = Platform_setCPUValues(this, cpu + 1);
+      if (!isNonnegative(percent))
+         continue;
+
+      unsigned int group = data->groupOf[cpu];
+      data->load[group] += percent;
+      data->online[group]++;
+   }
+
+   for (unsigned int i = 0; i < data->nGroups; i++)
+      data->load[i] = data->online[i] ? data->load[i] / data->online[i] : -1.0;
+
+   /* the values of the meter itself are the ones of the average CPU */
+   double percent = Platform_setCPUValues(this, 0);
+   if (isNonnegative(percent)) {
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "%.1f%%", percent);
+   } else {
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "offline");
+   }
+}
+
+static void CPUHeatmapMeter_updateMode(Meter* this, MeterModeId mode) {
+   const CPUHeatmapData* data = this->meterData;
+   this->mode = mode;
+   this->h = CPUHeatmapMeter_rows(data);
+}
+
+/* Hottest group shown by a slot, negative if they are all offline or the slot is unused */
+static double CPUHeatmapMeter_slotLoad(const CPUHeatmapData* data, size_t slot, size_t groupsPerSlot) {
+   double load = -1.0;
+   size_t first = slot * groupsPerSlot;
+   for (size_t i = first; i < first + groupsPerSlot && i < data->nGroups; i++)
+      load = MAXIMUM(load, data->load[i]);
+   return load;
+}
+
+static int CPUHeatmapMeter_loadColor(double load) {
+   if (load < 0.0)
+      return METER_SHADOW;
+   if (load < 50.0)
+      return METER_VALUE_OK;
+   if (load < 80.0)
+      return METER_VALUE_WARN;
+   return METER_VALUE_ERROR;
+}
+
+/*
+ * Every character shows two groups as bars of braille dots, colored by
+ * the hotter one; when the groups do not fit, a bar stands for several
+ * consecutive groups and shows the hottest of them. The cost of drawing
+ * thereby depends on the size of the meter, not on the number of CPUs.
+ */
+static void CPUHeatmapMeter_draw(Meter* this, int x, int y, int w) {
+   const CPUHeatmapData* data = this->meterData;
+
+   const int captionLen = 3;
+   if (w >= captionLen) {
+      attrset(CRT_colors[METER_TEXT]);
+      mvaddnstr(y, x, this->caption, captionLen);
+   }
+   w -= captionLen;
+   if (w < 1 || !data->nGroups)
+      goto end;
+   x += captionLen;
+
+   const char* const* dots;
+   int pixPerRow;
+#ifdef HAVE_LIBNCURSESW
+   if (CRT_utf8) {
+      dots = GraphMeterMode_dotsUtf8;
+      pixPerRow = PIXPERROW_UTF8;
+   } else
+#endif
+   {
+      dots = GraphMeterMode_dotsAscii;
+      pixPerRow = PIXPERROW_ASCII;
+   }
+
+   size_t slotsPerRow = (size_t)w * 2;
+   size_t slots = slotsPerRow * (size_t)this->h;
+   size_t groupsPerSlot = (data->nGroups + slots - 1) / slots;
+   size_t usedSlots = (data->nGroups + groupsPerSlot - 1) / groupsPerSlot;
+
+   for (size_t slot = 0; slot < usedSlots; slot += 2) {
+      double left = CPUHeatmapMeter_slotLoad(data, slot, groupsPerSlot);
+      double right = CPUHeatmapMeter_slotLoad(data, slot + 1, groupsPerSlot);
+
+      int v1 = left < 0.0 ? 0 : (int) lround(CLAMP(left / 100.0 * pixPerRow, 1.0, pixPerRow));
+      int v2 = right < 0.0 ? 0 : (int) lround(CLAMP(right / 100.0 * pixPerRow, 1.0, pixPerRow));
+
+      int row = (int)(slot / slotsPerRow);
+      int col = (int)(slot % slotsPerRow / 2);
+      attrset(CRT_colors[CPUHeatmapMeter_loadColor(MAXIMUM(left, right))]);
+      mvaddstr(y + row, x + col, dots[v1 * (pixPerRow + 1) + v2]);
+   }
+
+end:
+   attrset(CRT_colors[RESET_COLOR]);
+}
+
+const MeterClass CPUHeatmapMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete
+   },
+   .updateValues = CPUHeatmapMeter_updateValues,
+   .defaultMode = BAR_METERMODE,
+   .supportedModes = (1 << BAR_METERMODE),
+   .maxItems = CPU_METER_ITEMCOUNT,
+   .total = 100.0,
+   .attributes = CPUHeatmapMeter_attributes,
+   .name = "CPUHeatmap",
+   .uiName = "CPU heatmap",
+   .description = "CPU heatmap: usage of all CPUs, two per character",
+   .caption = "CPU",
+   .draw = CPUHeatmapMeter_draw,
+   .init = CPUHeatmapMeter_init,
+   .updateMode = CPUHeatmapMeter_updateMode,
+   .done = CPUHeatmapMeter_done
+};
+
+const MeterClass CoreHeatmapMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete
+   },
+   .updateValues = CPUHeatmapMeter_updateValues,
+   .defaultMode = BAR_METERMODE,
+   .supportedModes = (1 << BAR_METERMODE),
+   .maxItems = CPU_METER_ITEMCOUNT,
+   .total = 100.0,
+   .attributes = CPUHeatmapMeter_attributes,
+   .name = "CoreHeatmap",
+   .uiName = "CPU heatmap by core",
+   .description = "CPU heatmap by core: average usage of the SMT siblings of each core (needs hwloc)",
+   .caption = "Cor",
+   .draw = CPUHeatmapMeter_draw,
+   .init = CoreHeatmapMeter_init,
+   .updateMode = CPUHeatmapMeter_updateMode,
+   .done = CPUHeatmapMeter_done
+};
+
+const MeterClass CCDHeatmapMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete
+   },
+   .updateValues = CPUHeatmapMeter_updateValues,
+   .defaultMode = BAR_METERMODE,
+   .supportedModes = (1 << BAR_METERMODE),
+   .maxItems = CPU_METER_ITEMCOUNT,
+   .total = 100.0,
+   .attributes = CPUHeatmapMeter_attributes,
+   .name = "CCDHeatmap",
+   .uiName = "CPU heatmap by CCD",
+   .description = "CPU heatmap by CCD: average usage of the CPUs sharing a L3 cache (needs hwloc)",
+   .caption = "CCD",
+   .draw = CPUHeatmapMeter_draw,
+   .init = CCDHeatmapMeter_init,
+   .updateMode = CPUHeatmapMeter_updateMode,
+   .done = CPUHeatmapMeter_done
+};
+
+const MeterClass SocketHeatmapMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete
+   },
+   .updateValues = CPUHeatmapMeter_updateValues,
+   .defaultMode = BAR_METERMODE,
+   .supportedModes = (1 << BAR_METERMODE),
+   .maxItems = CPU_METER_ITEMCOUNT,
+   .total = 100.0,
+   .attributes = CPUHeatmapMeter_attributes,
+   .name = "SocketHeatmap",
+   .uiName = "CPU heatmap by socket",
+   .description = "CPU heatmap by socket: average usage of the CPUs of each package (needs hwloc)",
+   .caption = "Skt",
+   .draw = CPUHeatmapMeter_draw,
+   .init = SocketHeatmapMeter_init,
+   .updateMode = CPUHeatmapMeter_updateMode,
+   .done = CPUHeatmapMeter_done
+};
+
+const MeterClass NodeHeatmapMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete
+   },
+   .updateValues = CPUHeatmapMeter_updateValues,
+   .defaultMode = BAR_METERMODE,
+   .supportedModes = (1 << BAR_METERMODE),
+   .maxItems = CPU_METER_ITEMCOUNT,
+   .total = 100.0,
+   .attributes = CPUHeatmapMeter_attributes,
+   .name = "NodeHeatmap",
+   .uiName = "CPU heatmap by NUMA node",
+   .description = "CPU heatmap by NUMA node: average usage of the CPUs of each node (needs hwloc)",
+   .caption = "Nod",
+   .draw = CPUHeatmapMeter_draw,
+   .init = NodeHeatmapMeter_init,
+   .updateMode = CPUHeatmapMeter_updateMode,
+   .done = CPUHeatmapMeter_done
+};
@@ -0,0 +1,23 @@
+#ifndef HEADER_CPUHeatmapMeter
+#define HEADER_CPUHeatmapMeter
+/*
+htop - CPUHeatmapMeter.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "Meter.h"
+
+
+extern const MeterClass CPUHeatmapMeter_class;
+
+extern const MeterClass CoreHeatmapMeter_class;
+
+extern const MeterClass CCDHeatmapMeter_class;
+
+extern const MeterClass SocketHeatmapMeter_class;
+
+extern const MeterClass NodeHeatmapMeter_class;
+
+#endif
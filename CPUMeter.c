@@ -10,6 +10,7 @@ in the source distribution for its full text.
 #include "CPUMeter.h"
 
 #include <assert.h>
+#include <math.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdlib.h>
@@ -63,6 +64,18 @@ static void CPUMeter_getUiName(const Meter* this, char* buffer, size_t length) {
       xSnprintf(buffer, length, "%s", Meter_uiName(this));
 }
 
+/* Recordings hold the CPU% alone, shown as time in user mode */
+static double CPUMeter_setReplayedValues(Meter* this, unsigned int cpu) {
+   const MachineReplay* replay = this->host->replay;
+   double percent = cpu < replay->cpuCount ? replay->cpuPercent[cpu] : NAN;
+
+   this->curItems = isNonnegative(percent) ? CPU_METER_NORMAL + 1 : 0;
+   this->values[CPU_METER_NORMAL] = percent;
+   this->values[CPU_METER_FREQUENCY] = NAN;
+   this->values[CPU_METER_TEMPERATURE] = NAN;
+   return percent;
+}
+
 static void CPUMeter_updateValues(Meter* this) {
    memset(this->values, 0, sizeof(double) * CPU_METER_ITEMCOUNT);
 
@@ -75,7 +88,7 @@ static void CPUMeter_updateValues(Meter* this) {
       return;
    }
 
-   double percent = Platform_setCPUValues(this, cpu);
+   double percent = host->replay ? CPUMeter_setReplayedValues(this, cpu) : Platform_setCPUValues(this, cpu);
    if (!isNonnegative(percent)) {
       xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "offline");
       return;
@@ -232,7 +245,7 @@ static void AllCPUsMeter_updateValues(Meter* this) {
    int start, count;
    AllCPUsMeter_getRange(this, &start, &count);
    for (int i = 0; i < count; i++)
-      Meter_updateValues(meters[i]);
+      Meter_update(meters[i]);
 }
 
 static void CPUMeterCommonInit(Meter* this) {
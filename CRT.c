@@ -95,6 +95,8 @@ const char* const* CRT_treeStr = CRT_treeStrAscii;
 
 static const Settings* CRT_settings;
 
+static bool CRT_headless = false;
+
 #ifdef HAVE_LIBNCURSESW
 # if MB_LEN_MAX >= 3 // Minimum required to support UTF-8 BMP subset
 char CRT_degreeSign[MB_LEN_MAX * 2] = "\xc2\xb0";
@@ -1284,7 +1286,32 @@ IGNORE_WCASTQUAL_END
    initDegreeSign();
 }
 
+void CRT_initHeadless(const Settings* settings, bool allowUnicode) {
+   CRT_headless = true;
+   CRT_settings = settings;
+   CRT_colorScheme = COLORSCHEME_MONOCHROME;
+   CRT_colors = CRT_colorSchemes[CRT_colorScheme];
+
+#ifdef HAVE_LIBNCURSESW
+   CRT_utf8 = allowUnicode && String_eq(nl_langinfo(CODESET), "UTF-8");
+#else
+   (void) allowUnicode;
+#endif
+
+   CRT_treeStr =
+#ifdef HAVE_LIBNCURSESW
+      CRT_utf8 ? CRT_treeStrUtf8 :
+#endif
+      CRT_treeStrAscii;
+
+   initDegreeSign();
+}
+
 void CRT_done(void) {
+   /* nothing to restore without a terminal */
+   if (CRT_headless)
+      return;
+
    int resetColor = CRT_colors ? CRT_colors[RESET_COLOR] : CRT_colorSchemes[COLORSCHEME_DEFAULT][RESET_COLOR];
 
    attron(resetColor);
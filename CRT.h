@@ -210,6 +210,9 @@ void CRT_setMouse(bool enabled);
 
 void CRT_init(const Settings* settings, bool allowUnicode, bool retainScreenOnExit);
 
+/* Prepares colors and drawing characters for formatting rows without using the terminal */
+void CRT_initHeadless(const Settings* settings, bool allowUnicode);
+
 void CRT_done(void);
 
 void CRT_resetSignalHandlers(void);
@@ -155,12 +155,10 @@ void ColumnsPanel_update(Panel* super) {
    int size = Panel_size(super);
    *(this->changed) = true;
    this->ss->fields = xRealloc(this->ss->fields, sizeof(ProcessField) * (size + 1));
-   this->ss->flags = 0;
    for (int i = 0; i < size; i++) {
       int key = ((ListItem*) Panel_get(super, i))->key;
       this->ss->fields[i] = key;
-      if (key < LAST_PROCESSFIELD)
-         this->ss->flags |= Process_fields[key].flags;
    }
    this->ss->fields[size] = 0;
+   ScreenSettings_updateFlags(this->ss);
 }
@@ -12,9 +12,11 @@ in the source distribution for its full text.
 
 #include <assert.h>
 #include <ctype.h>
+#include <errno.h>
 #include <getopt.h>
 #include <locale.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -22,6 +24,7 @@ in the source distribution for its full text.
 #include <unistd.h>
 
 #include "Action.h"
+#include "BatchOutput.h"
 #include "CRT.h"
 #include "DynamicColumn.h"
 #include "DynamicMeter.h"
@@ -36,6 +39,9 @@ in the source distribution for its full text.
 #include "Platform.h"
 #include "Process.h"
 #include "ProcessTable.h"
+#include "Profiler.h"
+#include "Recording.h"
+#include "ReplayProcessTable.h"
 #include "ScreenManager.h"
 #include "Settings.h"
 #include "Table.h"
@@ -66,7 +72,14 @@ static void printHelpFlag(const char* name) {
           "-t --tree                       Show the tree view (can be combined with -s)\n"
           "-u --user[=USERNAME]            Show only processes for a given user (or $USER)\n"
           "-U --no-unicode                 Do not use unicode but plain ASCII\n"
-          "-V --version                    Print version info\n");
+          "-V --version                    Print version info\n"
+          "   --batch[=FORMAT]             Write samples as csv (default), json or binary instead of drawing the UI\n"
+          "   --output=FILE                Write batch samples to FILE instead of standard output\n"
+          "   --columns=COLUMN[,COLUMN...] Columns written in batch mode (try --sort-key=help for a list)\n"
+          "   --record=FILE                Append process table snapshots to FILE instead of drawing the UI\n"
+          "   --replay=FILE                Show the process table snapshots recorded in FILE ([ and ] move a minute back and forth)\n"
+          "   --replay-from=TIME           Start replaying at TIME (seconds since the epoch or YYYY-MM-DDTHH:MM:SS)\n"
+          "   --stats-file=FILE            Write the time spent per refresh phase to FILE on exit\n");
    Platform_longOptionsUsage(name);
    printf("\n"
           "Press F1 inside %s for online help.\n"
@@ -91,8 +104,39 @@ typedef struct CommandLineSettings_ {
    bool highlightChanges;
    int highlightDelaySecs;
    bool readonly;
+   BatchFormat batchFormat;
+   char* batchOutput;
+   char* batchColumns;
+   char* recordFile;
+   char* replayFile;
+   uint64_t replayFromMs;
+   char* statsFile;
 } CommandLineSettings;
 
+/* Accepts seconds since the epoch or a local time like 2025-01-31T12:00:00 */
+static bool parseReplayTime(const char* arg, uint64_t* timestampMs) {
+   char* end;
+   unsigned long long seconds = strtoull(arg, &end, 10);
+   if (end != arg && *end == '\0') {
+      *timestampMs = (uint64_t)seconds * 1000;
+      return true;
+   }
+
+   struct tm date = { .tm_isdst = -1 };
+   char sep;
+   if (sscanf(arg, "%4d-%2d-%2d%c%2d:%2d:%2d", &date.tm_year, &date.tm_mon, &date.tm_mday, &sep, &date.tm_hour, &date.tm_min, &date.tm_sec) != 7 || (sep != 'T' && sep != ' '))
+      return false;
+
+   date.tm_year -= 1900;
+   date.tm_mon -= 1;
+   time_t t = mktime(&date);
+   if (t == (time_t)-1)
+      return false;
+
+   *timestampMs = (uint64_t)t * 1000;
+   return true;
+}
+
 static CommandLineStatus parseArguments(int argc, char** argv, CommandLineSettings* flags) {
 
    *flags = (CommandLineSettings) {
@@ -111,6 +155,13 @@ static CommandLineStatus parseArguments(int argc, char** argv, CommandLineSettin
       .highlightChanges = false,
       .highlightDelaySecs = -1,
       .readonly = false,
+      .batchFormat = BATCH_FORMAT_NONE,
+      .batchOutput = NULL,
+      .batchColumns = NULL,
+      .recordFile = NULL,
+      .replayFile = NULL,
+      .replayFromMs = 0,
+      .statsFile = NULL,
    };
 
    const struct option long_opts[] =
@@ -130,6 +181,13 @@ static CommandLineStatus parseArguments(int argc, char** argv, CommandLineSettin
       {"filter",     required_argument,   0, 'F'},
       {"highlight-changes", optional_argument, 0, 'H'},
       {"readonly",   no_argument,         0, 128},
+      {"batch",      optional_argument,   0, 140},
+      {"output",     required_argument,   0, 141},
+      {"columns",    required_argument,   0, 142},
+      {"record",     required_argument,   0, 143},
+      {"replay",     required_argument,   0, 144},
+      {"replay-from", required_argument,  0, 145},
+      {"stats-file", required_argument,   0, 146},
       PLATFORM_LONG_OPTIONS
       {0, 0, 0, 0}
    };
@@ -276,6 +334,40 @@ static CommandLineStatus parseArguments(int argc, char** argv, CommandLineSettin
          case 128:
             flags->readonly = true;
             break;
+         case 140:
+            flags->batchFormat = BatchOutput_parseFormat(optarg);
+            if (flags->batchFormat == BATCH_FORMAT_NONE) {
+               fprintf(stderr, "Error: invalid batch format \"%s\".\n", optarg);
+               return STATUS_ERROR_EXIT;
+            }
+            break;
+         case 141:
+            assert(optarg);
+            free_and_xStrdup(&flags->batchOutput, optarg);
+            break;
+         case 142:
+            assert(optarg);
+            free_and_xStrdup(&flags->batchColumns, optarg);
+            break;
+         case 143:
+            assert(optarg);
+            free_and_xStrdup(&flags->recordFile, optarg);
+            break;
+         case 144:
+            assert(optarg);
+            free_and_xStrdup(&flags->replayFile, optarg);
+            break;
+         case 145:
+            assert(optarg);
+            if (!parseReplayTime(optarg, &flags->replayFromMs)) {
+               fprintf(stderr, "Error: invalid replay time \"%s\".\n", optarg);
+               return STATUS_ERROR_EXIT;
+            }
+            break;
+         case 146:
+            assert(optarg);
+            free_and_xStrdup(&flags->statsFile, optarg);
+            break;
 
          default: {
             CommandLineStatus status;
@@ -286,6 +378,21 @@ static CommandLineStatus parseArguments(int argc, char** argv, CommandLineSettin
       }
    }
 
+   if ((flags->batchOutput || flags->batchColumns) && flags->batchFormat == BATCH_FORMAT_NONE) {
+      fprintf(stderr, "Error: --output and --columns require --batch.\n");
+      return STATUS_ERROR_EXIT;
+   }
+
+   if (flags->recordFile && (flags->batchFormat != BATCH_FORMAT_NONE || flags->replayFile)) {
+      fprintf(stderr, "Error: --record can not be combined with --batch or --replay.\n");
+      return STATUS_ERROR_EXIT;
+   }
+
+   if (flags->replayFromMs && !flags->replayFile) {
+      fprintf(stderr, "Error: --replay-from requires --replay.\n");
+      return STATUS_ERROR_EXIT;
+   }
+
    if (optind < argc) {
       fprintf(stderr, "Error: unsupported non-option ARGV-elements:");
       while (optind < argc)
@@ -323,19 +430,38 @@ int CommandLine_run(int argc, char** argv) {
    if ((status = parseArguments(argc, argv, &flags)) != STATUS_OK)
       return status != STATUS_OK_EXIT ? 1 : 0;
 
-   if (flags.readonly)
+   /* replayed processes are not those of this machine, so none may be acted upon */
+   if (flags.readonly || flags.replayFile)
       Settings_enableReadonly();
 
    if (!Platform_init())
       return 1;
 
+   RecordingReader* reader = NULL;
+   if (flags.replayFile) {
+      reader = RecordingReader_new(flags.replayFile);
+      if (!reader) {
+         fprintf(stderr, "Error: can not read recording %s: %s\n", flags.replayFile, strerror(errno));
+         free(flags.replayFile);
+         Platform_done();
+         return 1;
+      }
+      if (flags.replayFromMs && !RecordingReader_seek(reader, flags.replayFromMs)) {
+         fprintf(stderr, "Error: can not seek in recording %s\n", flags.replayFile);
+         RecordingReader_delete(reader);
+         free(flags.replayFile);
+         Platform_done();
+         return 1;
+      }
+   }
+
    UsersTable* ut = UsersTable_new();
    Hashtable* dm = DynamicMeters_new();
    Hashtable* dc = DynamicColumns_new();
    Hashtable* ds = DynamicScreens_new();
 
    Machine* host = Machine_new(ut, flags.userId);
-   ProcessTable* pt = ProcessTable_new(host, flags.pidMatchList);
+   ProcessTable* pt = reader ? ReplayProcessTable_new(host, flags.pidMatchList, reader) : ProcessTable_new(host, flags.pidMatchList);
    Settings* settings = Settings_new(host, dm, dc, ds);
    Machine_populateTablesFromSettings(host, settings, &pt->super);
 
@@ -365,43 +491,86 @@ int CommandLine_run(int argc, char** argv) {
       ScreenSettings_setSortKey(settings->ss, flags.sortKey);
    }
 
+   if (reader) {
+      /* screens set up for replaying must not replace the configuration */
+      settings->writeConfig = false;
+      ReplayProcessTable_restrictFields(settings);
+   }
+
    host->iterationsRemaining = flags.iterationsRemaining;
-   CRT_init(settings, flags.allowUnicode, flags.iterationsRemaining != -1);
 
-   MainPanel* panel = MainPanel_new();
-   Machine_setTablesPanel(host, (Panel*) panel);
+   if (flags.statsFile)
+      Profiler_enable();
 
-   MainPanel_updateLabels(panel, settings->ss->treeView, flags.commFilter);
+   int result = 0;
+   ScreenManager* scr = NULL;
 
-   State state = {
-      .host = host,
-      .mainPanel = panel,
-      .header = header,
-      .failedUpdate = NULL,
-      .pauseUpdate = false,
-      .hideSelection = false,
-      .hideMeters = false,
-   };
+   /* like a replay, batch output and recording must not save screens they changed, as with --columns */
+   if (flags.recordFile || flags.batchFormat != BATCH_FORMAT_NONE)
+      settings->writeConfig = false;
 
-   MainPanel_setState(panel, &state);
-   if (flags.commFilter)
-      setCommFilter(&state, &(flags.commFilter));
+   if (flags.recordFile) {
+      CRT_initHeadless(settings, flags.allowUnicode);
 
-   ScreenManager* scr = ScreenManager_new(header, host, &state, true);
-   ScreenManager_add(scr, (Panel*) panel, -1);
+      result = BatchOutput_run(host, BATCH_FORMAT_RECORD, flags.recordFile, flags.iterationsRemaining);
+   } else if (flags.batchFormat != BATCH_FORMAT_NONE) {
+      CRT_initHeadless(settings, flags.allowUnicode);
 
-   Machine_scan(host);
-   Machine_scanTables(host);
+      if (flags.batchColumns && !ScreenSettings_parseFields(settings->ss, settings->dynamicColumns, flags.batchColumns)) {
+         fprintf(stderr, "Error: invalid columns \"%s\".\n", flags.batchColumns);
+         result = 1;
+      } else {
+         host->activeTable->incFilter = flags.commFilter;
+         result = BatchOutput_run(host, flags.batchFormat, flags.batchOutput, flags.iterationsRemaining);
+         host->activeTable->incFilter = NULL;
+      }
+   } else {
+      CRT_init(settings, flags.allowUnicode, flags.iterationsRemaining != -1);
+
+      MainPanel* panel = MainPanel_new();
+      Machine_setTablesPanel(host, (Panel*) panel);
+      if (reader)
+         ReplayProcessTable_setBindings(panel->keys);
+
+      MainPanel_updateLabels(panel, settings->ss->treeView, flags.commFilter);
+
+      State state = {
+         .host = host,
+         .mainPanel = panel,
+         .header = header,
+         .failedUpdate = NULL,
+         .pauseUpdate = false,
+         .hideSelection = false,
+         .hideMeters = false,
+      };
+
+      MainPanel_setState(panel, &state);
+      if (flags.commFilter)
+         setCommFilter(&state, &(flags.commFilter));
+
+      scr = ScreenManager_new(header, host, &state, true);
+      ScreenManager_add(scr, (Panel*) panel, -1);
 
-   if (settings->ss->allBranchesCollapsed)
-      Table_collapseAllBranches(&pt->super);
+      Machine_scan(host);
+      Machine_scanTables(host);
 
-   ScreenManager_run(scr, NULL, NULL, NULL);
+      if (settings->ss->allBranchesCollapsed)
+         Table_collapseAllBranches(&pt->super);
+
+      ScreenManager_run(scr, NULL, NULL, NULL);
+   }
 
    Platform_done();
 
    CRT_done();
 
+   if (flags.statsFile) {
+      int r = Profiler_writeStatsFile(flags.statsFile);
+      if (r < 0)
+         fprintf(stderr, "Can not write statistics to %s: %s\n", flags.statsFile, strerror(-r));
+      Profiler_disable();
+   }
+
    if (settings->changed) {
 #ifndef NDEBUG
       if (!String_eq(settings->initialFilename, settings->filename))
@@ -415,7 +584,8 @@ int CommandLine_run(int argc, char** argv) {
    Header_delete(header);
    Machine_delete(host);
 
-   ScreenManager_delete(scr);
+   if (scr)
+      ScreenManager_delete(scr);
    MetersPanel_cleanup();
 
    UsersTable_delete(ut);
@@ -423,6 +593,13 @@ int CommandLine_run(int argc, char** argv) {
    if (flags.pidMatchList)
       Hashtable_delete(flags.pidMatchList);
 
+   free(flags.commFilter);
+   free(flags.batchOutput);
+   free(flags.batchColumns);
+   free(flags.recordFile);
+   free(flags.replayFile);
+   free(flags.statsFile);
+
    CRT_resetSignalHandlers();
 
    /* Delete these last, since they can get accessed in the crash handler */
@@ -431,5 +608,5 @@ int CommandLine_run(int argc, char** argv) {
    DynamicMeters_delete(dm);
    DynamicScreens_delete(ds);
 
-   return 0;
+   return result;
 }
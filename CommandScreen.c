@@ -10,58 +10,46 @@ in the source distribution for its full text.
 
 #include "CommandScreen.h"
 
-#include <assert.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "Macros.h"
 #include "Panel.h"
+#include "Platform.h"
 #include "ProvideCurses.h"
+#include "XUtils.h"
 
 
-static void CommandScreen_scan(InfoScreen* this) {
-   Panel* panel = this->display;
+static void CommandScreen_scan(InfoScreen* super) {
+   CommandScreen* this = (CommandScreen*) super;
+   Panel* panel = super->display;
    int idx = MAXIMUM(Panel_getSelectedIndex(panel), 0);
-   Panel_prune(panel);
-
-   const char* p = Process_getCommand(this->process);
-
-   size_t line_maxlen = COLS < 40 ? 40 : COLS;
-   size_t line_offset = 0;
-   size_t last_space = 0;
-   char* line = xCalloc(line_maxlen + 1, sizeof(char));
-
-   for (; *p != '\0'; p++) {
-      if (line_offset >= line_maxlen) {
-         assert(line_offset <= line_maxlen);
-         assert(last_space <= line_maxlen);
 
-         size_t line_len = last_space <= 0 ? line_offset : last_space;
-         char tmp = line[line_len];
-         line[line_len] = '\0';
-         InfoScreen_addLine(this, line);
-         line[line_len] = tmp;
-
-         assert(line_len <= line_offset);
-         line_offset -= line_len;
-         memmove(line, line + line_len, line_offset);
-
-         last_space = 0;
-      }
-
-      line[line_offset++] = *p;
-      if (*p == ' ') {
-         last_space = line_offset;
-      }
+   Panel_prune(panel);
+   TextIndex_done(&this->text);
+
+   /* the arguments in full where they can be read, the process table may hold them truncated */
+   size_t size = 0;
+   char* command = Platform_getProcessCmdline(Process_getPid(super->process), &size);
+   while (command && size > 0 && command[size - 1] == '\0')
+      size--;
+   if (!command || size == 0) {
+      free(command);
+      const char* cached = Process_getCommand(super->process);
+      size = cached ? strlen(cached) : 0;
+      command = xStrndup(cached ? cached : "", size);
    }
 
-   if (line_offset > 0) {
-      line[line_offset] = '\0';
-      InfoScreen_addLine(this, line);
+   for (size_t i = 0; i < size; i++) {
+      if (command[i] == '\0' || command[i] == '\n')
+         command[i] = ' ';
    }
 
-   free(line);
+   TextIndex_init(&this->text, size, 1, (size_t) MAXIMUM(COLS, 40));
+   TextIndex_add(&this->text, command, size);
+   free(command);
 
+   TextIndex_show(&this->text, super);
    Panel_setSelected(panel, idx);
 }
 
@@ -79,10 +67,13 @@ const InfoScreenClass CommandScreen_class = {
 };
 
 CommandScreen* CommandScreen_new(Process* process) {
-   CommandScreen* this = AllocThis(CommandScreen);
+   CommandScreen* this = xCalloc(1, sizeof(CommandScreen));
+   Object_setClass(this, Class(CommandScreen));
    return (CommandScreen*) InfoScreen_init(&this->super, process, NULL, LINES - 2, " ");
 }
 
-void CommandScreen_delete(Object* this) {
-   free(InfoScreen_done((InfoScreen*)this));
+void CommandScreen_delete(Object* cast) {
+   CommandScreen* this = (CommandScreen*) InfoScreen_done((InfoScreen*)cast);
+   TextIndex_done(&this->text);
+   free(this);
 }
@@ -11,10 +11,12 @@ in the source distribution for its full text.
 #include "InfoScreen.h"
 #include "Object.h"
 #include "Process.h"
+#include "TextIndex.h"
 
 
 typedef struct CommandScreen_ {
    InfoScreen super;
+   TextIndex text;
 } CommandScreen;
 
 extern const InfoScreenClass CommandScreen_class;
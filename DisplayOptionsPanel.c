@@ -199,7 +199,12 @@ DisplayOptionsPanel* DisplayOptionsPanel_new(Settings* settings, ScreenManager*
    #ifdef HAVE_GETMOUSE
    Panel_add(super, (Object*) CheckItem_newByRef("Enable the mouse", &(settings->enableMouse)));
    #endif
+   Panel_add(super, (Object*) NumberItem_newByRef("Time shown by meter graphs (in minutes, 0 - one sample per update)", &(settings->graphHistoryMins), 0, 0, 24 * 60));
    Panel_add(super, (Object*) NumberItem_newByRef("Update interval (in seconds)", &(settings->delay), -1, 1, 255));
+   #ifdef HTOP_LINUX
+   Panel_add(super, (Object*) NumberItem_newByRef("Pages sampled for the working set (in percent)", &(settings->workingSetPercent), 0, 1, 100));
+   Panel_add(super, (Object*) NumberItem_newByRef("- Pages count as touched within (in updates)", &(settings->workingSetWindow), 0, 1, 60));
+   #endif
    Panel_add(super, (Object*) CheckItem_newByRef("Highlight new and old processes", &(settings->highlightChanges)));
    Panel_add(super, (Object*) NumberItem_newByRef("- Highlight time (in seconds)", &(settings->highlightDelaySecs), 0, 1, 24 * 60 * 60));
    Panel_add(super, (Object*) NumberItem_newByRef("Hide main function bar (0 - off, 1 - on ESC until next input, 2 - permanently)", &(settings->hideFunctionBar), 0, 0, 2));
@@ -23,37 +23,61 @@ in the source distribution for its full text.
 
 
 EnvScreen* EnvScreen_new(Process* process) {
-   EnvScreen* this = xMalloc(sizeof(EnvScreen));
+   EnvScreen* this = xCalloc(1, sizeof(EnvScreen));
    Object_setClass(this, Class(EnvScreen));
    return (EnvScreen*) InfoScreen_init(&this->super, process, NULL, LINES - 2, " ");
 }
 
-void EnvScreen_delete(Object* this) {
-   free(InfoScreen_done((InfoScreen*)this));
+void EnvScreen_delete(Object* cast) {
+   EnvScreen* this = (EnvScreen*) InfoScreen_done((InfoScreen*)cast);
+   TextIndex_done(&this->text);
+   free(this);
 }
 
 static void EnvScreen_draw(InfoScreen* this) {
    InfoScreen_drawTitled(this, "Environment of process %d - %s", Process_getPid(this->process), Process_getCommand(this->process));
 }
 
-static void EnvScreen_scan(InfoScreen* this) {
-   Panel* panel = this->display;
+static int EnvScreen_compareVariables(const void* v1, const void* v2) {
+   return strcmp(*(const char* const*)v1, *(const char* const*)v2);
+}
+
+static void EnvScreen_scan(InfoScreen* super) {
+   EnvScreen* this = (EnvScreen*) super;
+   Panel* panel = super->display;
    int idx = MAXIMUM(Panel_getSelectedIndex(panel), 0);
 
    Panel_prune(panel);
+   TextIndex_done(&this->text);
 
-   char* env = Platform_getProcessEnv(Process_getPid(this->process));
-   if (env) {
-      for (const char* p = env; *p; p = strrchr(p, 0) + 1)
-         InfoScreen_addLine(this, p);
-      free(env);
+   char* env = Platform_getProcessEnv(Process_getPid(super->process));
+   if (!env) {
+      InfoScreen_addLine(super, "Could not read process environment.");
+      Panel_setSelected(panel, idx);
+      return;
    }
-   else {
-      InfoScreen_addLine(this, "Could not read process environment.");
+
+   size_t count = 0;
+   size_t bytes = 0;
+   for (const char* p = env; *p; p = strrchr(p, 0) + 1) {
+      count++;
+      bytes += strlen(p);
    }
 
-   Vector_insertionSort(this->lines);
-   Vector_insertionSort(panel->items);
+   /* sorted before being wrapped, so that each variable stays in one piece */
+   const char** variables = xMallocArray(MAXIMUM(count, 1), sizeof(const char*));
+   size_t i = 0;
+   for (const char* p = env; *p; p = strrchr(p, 0) + 1)
+      variables[i++] = p;
+   qsort(variables, count, sizeof(const char*), EnvScreen_compareVariables);
+
+   TextIndex_init(&this->text, bytes, count, (size_t) MAXIMUM(COLS, 40));
+   for (i = 0; i < count; i++)
+      TextIndex_add(&this->text, variables[i], strlen(variables[i]));
+   free(variables);
+   free(env);
+
+   TextIndex_show(&this->text, super);
    Panel_setSelected(panel, idx);
 }
 
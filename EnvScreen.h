@@ -12,10 +12,12 @@ in the source distribution for its full text.
 #include "InfoScreen.h"
 #include "Object.h"
 #include "Process.h"
+#include "TextIndex.h"
 
 
 typedef struct EnvScreen_ {
    InfoScreen super;
+   TextIndex text;
 } EnvScreen;
 
 extern const InfoScreenClass EnvScreen_class;
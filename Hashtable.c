@@ -330,3 +330,48 @@ void Hashtable_foreach(Hashtable* this, Hashtable_PairFunction f, void* userData
    }
    assert(Hashtable_isConsistent(this));
 }
+
+ht_key_t Hashtable_hashBytes(ht_key_t hash, const void* data, size_t len) {
+   const unsigned char* bytes = data;
+   for (size_t i = 0; i < len; i++) {
+      hash ^= bytes[i];
+      hash *= 16777619U;
+   }
+   return hash;
+}
+
+void* Hashtable_find(Hashtable* this, ht_key_t hash, Hashtable_MatchFunction matches, const void* userData, ht_key_t* key) {
+   for (ht_key_t probe = hash;; probe++) {
+      void* value = Hashtable_get(this, probe);
+      if (!value || matches(value, userData)) {
+         *key = probe;
+         return value;
+      }
+   }
+}
+
+void* Hashtable_removeFound(Hashtable* this, ht_key_t key, Hashtable_HashFunction hashOf) {
+   void* res = Hashtable_remove(this, key);
+
+   /* moved values must not be freed on their way */
+   bool owner = this->owner;
+   this->owner = false;
+
+   ht_key_t hole = key;
+   for (ht_key_t probe = key + 1;; probe++) {
+      void* value = Hashtable_get(this, probe);
+      if (!value)
+         break;
+
+      /* a value goes back to the hole if its probe passed it, that is if the hole lies between its hash and its key */
+      ht_key_t home = hashOf(value);
+      if ((ht_key_t)(probe - home) >= (ht_key_t)(probe - hole)) {
+         Hashtable_remove(this, probe);
+         Hashtable_put(this, hole, value);
+         hole = probe;
+      }
+   }
+
+   this->owner = owner;
+   return res;
+}
@@ -9,12 +9,20 @@ in the source distribution for its full text.
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <string.h>
 
 
 typedef unsigned int ht_key_t;
 
 typedef void(*Hashtable_PairFunction)(ht_key_t key, void* value, void* userdata);
 
+typedef bool(*Hashtable_MatchFunction)(const void* value, const void* userData);
+
+typedef ht_key_t(*Hashtable_HashFunction)(const void* value);
+
+/* Start of a hash of values that have no numeric key, such as names */
+#define HASHTABLE_HASH_INIT 2166136261U
+
 typedef struct Hashtable_ Hashtable;
 
 #ifndef NDEBUG
@@ -39,4 +47,27 @@ void* Hashtable_get(Hashtable* this, ht_key_t key);
 
 void Hashtable_foreach(Hashtable* this, Hashtable_PairFunction f, void* userData);
 
+/* Adds len bytes to a hash begun with HASHTABLE_HASH_INIT (FNV-1a) */
+ht_key_t Hashtable_hashBytes(ht_key_t hash, const void* data, size_t len);
+
+static inline ht_key_t Hashtable_hashString(ht_key_t hash, const char* s) {
+   return Hashtable_hashBytes(hash, s, strlen(s));
+}
+
+/*
+ * Looks up a value stored under a hash of what identifies it, colliding
+ * values taking the next free key. Returns the value matching userData,
+ * or NULL if there is none; key is set to the key it is or is to be
+ * stored under.
+ */
+void* Hashtable_find(Hashtable* this, ht_key_t hash, Hashtable_MatchFunction matches, const void* userData, ht_key_t* key);
+
+/*
+ * Removes the value stored under key through Hashtable_find(), moving back
+ * the values that probed past it, so that none of them is lost to a lookup
+ * stopping at the freed key. hashOf() gives the hash a value was found by.
+ * Returns the value, as Hashtable_remove() does.
+ */
+void* Hashtable_removeFound(Hashtable* this, ht_key_t key, Hashtable_HashFunction hashOf);
+
 #endif
@@ -243,7 +243,7 @@ void Header_updateData(Header* this) {
       int items = Vector_size(meters);
       for (int i = 0; i < items; i++) {
          Meter* meter = (Meter*) Vector_get(meters, i);
-         Meter_updateValues(meter);
+         Meter_update(meter);
       }
    }
 }
@@ -36,4 +36,5 @@ const MeterClass HostnameMeter_class = {
    .name = "Hostname",
    .uiName = "Hostname",
    .caption = "Hostname: ",
+   .updateInterval = 10000
 };
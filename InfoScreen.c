@@ -68,14 +68,18 @@ void InfoScreen_drawTitled(InfoScreen* this, const char* fmt, ...) {
    IncSet_drawBar(this->inc, CRT_colors[FUNCTION_BAR]);
 }
 
-void InfoScreen_addLine(InfoScreen* this, const char* line) {
-   Vector_add(this->lines, (Object*) ListItem_new(line, 0));
+void InfoScreen_addItem(InfoScreen* this, ListItem* item) {
+   Vector_add(this->lines, (Object*) item);
    const char* incFilter = IncSet_filter(this->inc);
-   if (!incFilter || String_contains_i(line, incFilter, true)) {
-      Panel_add(this->display, Vector_get(this->lines, Vector_size(this->lines) - 1));
+   if (!incFilter || String_contains_i(item->value, incFilter, true)) {
+      Panel_add(this->display, (Object*) item);
    }
 }
 
+void InfoScreen_addLine(InfoScreen* this, const char* line) {
+   InfoScreen_addItem(this, ListItem_new(line, 0));
+}
+
 void InfoScreen_appendLine(InfoScreen* this, const char* line) {
    if (!Vector_size(this->lines)) {
       InfoScreen_addLine(this, line);
@@ -12,6 +12,7 @@ in the source distribution for its full text.
 
 #include "FunctionBar.h"
 #include "IncSet.h"
+#include "ListItem.h"
 #include "Macros.h"
 #include "Object.h"
 #include "Panel.h"
@@ -53,6 +54,9 @@ InfoScreen* InfoScreen_done(InfoScreen* this);
 ATTR_FORMAT(printf, 2, 3)
 void InfoScreen_drawTitled(InfoScreen* this, const char* fmt, ...);
 
+/* Adds a line of a class extending ListItem, which the screen owns from then on */
+void InfoScreen_addItem(InfoScreen* this, ListItem* item);
+
 void InfoScreen_addLine(InfoScreen* this, const char* line);
 
 void InfoScreen_appendLine(InfoScreen* this, const char* line);
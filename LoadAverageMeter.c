@@ -39,8 +39,21 @@ static const int High_attributes[] = {
    METER_VALUE_ERROR
 };
 
+/* The load averages of this machine, or those recorded while replaying */
+static void LoadAverageMeter_getLoadAverage(const Meter* this, double* one, double* five, double* fifteen) {
+   const MachineReplay* replay = this->host->replay;
+   if (!replay) {
+      Platform_getLoadAverage(one, five, fifteen);
+      return;
+   }
+
+   *one = replay->loadAverage[0];
+   *five = replay->loadAverage[1];
+   *fifteen = replay->loadAverage[2];
+}
+
 static void LoadAverageMeter_updateValues(Meter* this) {
-   Platform_getLoadAverage(&this->values[0], &this->values[1], &this->values[2]);
+   LoadAverageMeter_getLoadAverage(this, &this->values[0], &this->values[1], &this->values[2]);
 
    // only show bar for 1min value
    this->curItems = 1;
@@ -75,7 +88,7 @@ static void LoadAverageMeter_display(const Object* cast, RichString* out) {
 
 static void LoadMeter_updateValues(Meter* this) {
    double five, fifteen;
-   Platform_getLoadAverage(&this->values[0], &five, &fifteen);
+   LoadAverageMeter_getLoadAverage(this, &this->values[0], &five, &fifteen);
 
    // change bar color and total based on value
    if (this->total < this->host->activeCPUs) {
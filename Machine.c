@@ -10,11 +10,13 @@ in the source distribution for its full text.
 
 #include "Machine.h"
 
+#include <stdint.h>
 #include <stdlib.h>
 #include <unistd.h>
 
 #include "Object.h"
 #include "Platform.h"
+#include "Profiler.h"
 #include "Row.h"
 #include "XUtils.h"
 
@@ -60,7 +62,7 @@ void Machine_done(Machine* this) {
    free(this->tables);
 }
 
-static void Machine_addTable(Machine* this, Table* table) {
+void Machine_addTable(Machine* this, Table* table) {
    /* check that this table has not been seen previously */
    for (size_t i = 0; i < this->tableCount; i++)
       if (this->tables[i] == table)
@@ -118,13 +120,19 @@ void Machine_scanTables(Machine* this) {
       Table* table = this->tables[i];
 
       // pre-processing of each row
+      uint64_t start = Profiler_begin();
       Table_scanPrepare(table);
+      Profiler_end(PROFILE_TABLE_PREPARE, start);
 
       // scan values for this table
+      start = Profiler_begin();
       Table_scanIterate(table);
+      Profiler_end(PROFILE_TABLE_ITERATE, start);
 
       // post-process after scanning
+      start = Profiler_begin();
       Table_scanCleanup(table);
+      Profiler_end(PROFILE_TABLE_CLEANUP, start);
    }
 
    Row_setUidColumnWidth(this->maxUserId);
@@ -35,6 +35,14 @@ in the source distribution for its full text.
 typedef unsigned long long int memory_t;
 #define MEMORY_MAX ULLONG_MAX
 
+/* Values of the meters reading the system directly, as recorded, see ReplayProcessTable */
+typedef struct MachineReplay_ {
+   double loadAverage[3];
+   int uptime;                /* in seconds, -1 if unknown */
+   unsigned int cpuCount;     /* CPU percentages held, the average of all first */
+   const double* cpuPercent;  /* NAN for CPUs offline */
+} MachineReplay;
+
 typedef struct Machine_ {
    struct Settings_* settings;
 
@@ -75,6 +83,8 @@ typedef struct Machine_ {
    Table **tables;
    Table *activeTable;
    Table *processTable;
+
+   const MachineReplay* replay;  /* shown by the meters instead of this machine's values while replaying, NULL otherwise */
 } Machine;
 
 
@@ -90,6 +100,9 @@ bool Machine_isCPUonline(const Machine* this, unsigned int id);
 
 void Machine_populateTablesFromSettings(Machine* this, Settings* settings, Table* processTable);
 
+/* Adds a table to those scanned, unless it is one of them already */
+void Machine_addTable(Machine* this, Table* table);
+
 void Machine_setTablesPanel(Machine* this, Panel* panel);
 
 void Machine_scan(Machine* this);
@@ -167,13 +167,15 @@ bool MainPanel_foreachRow(MainPanel* this, MainPanel_foreachRowFn fn, Arg arg, b
    for (int i = 0; i < Panel_size(super); i++) {
       Row* row = (Row*) Panel_get(super, i);
       if (row->tag) {
-         ok &= fn(row, arg);
+         // aggregates only stand for the processes tagged with them
+         if (!row->isAggregate)
+            ok &= fn(row, arg);
          anyTagged = true;
       }
    }
    if (!anyTagged) {
       Row* row = (Row*) Panel_getSelected(super);
-      if (row) {
+      if (row && !row->isAggregate) {
          ok &= fn(row, arg);
       }
    }
@@ -29,8 +29,8 @@ typedef struct MemorySwapMeterData_ {
 static void MemorySwapMeter_updateValues(Meter* this) {
    MemorySwapMeterData* data = this->meterData;
 
-   Meter_updateValues(data->memoryMeter);
-   Meter_updateValues(data->swapMeter);
+   Meter_update(data->memoryMeter);
+   Meter_update(data->swapMeter);
 }
 
 static void MemorySwapMeter_draw(Meter* this, int x, int y, int w) {
@@ -19,6 +19,7 @@ in the source distribution for its full text.
 #include "CRT.h"
 #include "Macros.h"
 #include "Object.h"
+#include "Profiler.h"
 #include "ProvideCurses.h"
 #include "RichString.h"
 #include "Row.h"
@@ -199,8 +200,7 @@ end:
 
 #ifdef HAVE_LIBNCURSESW
 
-#define PIXPERROW_UTF8 4
-static const char* const GraphMeterMode_dotsUtf8[] = {
+const char* const GraphMeterMode_dotsUtf8[] = {
    /*00*/" ", /*01*/"⢀", /*02*/"⢠", /*03*/"⢰", /*04*/ "⢸",
    /*10*/"⡀", /*11*/"⣀", /*12*/"⣠", /*13*/"⣰", /*14*/ "⣸",
    /*20*/"⡄", /*21*/"⣄", /*22*/"⣤", /*23*/"⣴", /*24*/ "⣼",
@@ -210,13 +210,206 @@ static const char* const GraphMeterMode_dotsUtf8[] = {
 
 #endif
 
-#define PIXPERROW_ASCII 2
-static const char* const GraphMeterMode_dotsAscii[] = {
+const char* const GraphMeterMode_dotsAscii[] = {
    /*00*/" ", /*01*/".", /*02*/":",
    /*10*/".", /*11*/".", /*12*/":",
    /*20*/":", /*21*/":", /*22*/":"
 };
 
+typedef struct GraphTierSpec_ {
+   uint64_t bucketMs;
+   size_t nBuckets;
+} GraphTierSpec;
+
+/* 10 minutes in 1s, 1 hour in 10s and 24 hours in 1min buckets, at most */
+static const GraphTierSpec Meter_graphTiers[METER_GRAPH_TIERS] = {
+   { .bucketMs = 1000,  .nBuckets = 600 },
+   { .bucketMs = 10000, .nBuckets = 360 },
+   { .bucketMs = 60000, .nBuckets = 1440 },
+};
+
+/* The tier a graph spanning spanMs is drawn from: the finest holding that much time */
+static size_t GraphData_tier(uint64_t spanMs) {
+   size_t t = 0;
+   while (t < METER_GRAPH_TIERS - 1 && Meter_graphTiers[t].bucketMs * Meter_graphTiers[t].nBuckets < spanMs)
+      t++;
+   return t;
+}
+
+static void GraphData_grow(GraphData* data, size_t nValues) {
+   assert(nValues > data->nValues);
+
+   /* move the samples to the start of the new buffer, oldest first */
+   double* values = xCalloc(nValues, sizeof(*values));
+   for (size_t i = 0; i < data->count; i++)
+      values[i] = data->values[(data->head + data->nValues - data->count + i) % data->nValues];
+
+   free(data->values);
+   data->values = values;
+   data->nValues = nValues;
+   data->head = data->count % nValues;
+}
+
+static void GraphBucket_add(GraphBucket* bucket, double value) {
+   float v = (float)MINIMUM(value, FLT_MAX);
+   if (bucket->count == 0) {
+      *bucket = (GraphBucket) { .max = v, .avg = v, .count = 1 };
+      return;
+   }
+
+   bucket->max = MAXIMUM(bucket->max, v);
+   bucket->count++;
+   bucket->avg += (v - bucket->avg) / (float)bucket->count;
+}
+
+static void GraphTier_clear(GraphTier* this) {
+   free(this->buckets);
+   *this = (GraphTier) { .buckets = NULL };
+}
+
+/* Changes the capacity, keeping the newest buckets */
+static void GraphTier_resize(GraphTier* this, size_t nBuckets) {
+   GraphBucket* buckets = xCalloc(nBuckets, sizeof(*buckets));
+   size_t count = MINIMUM(this->count, nBuckets);
+   for (size_t i = 0; i < count; i++)
+      buckets[count - 1 - i] = this->buckets[(this->head + this->nBuckets - i) % this->nBuckets];
+
+   free(this->buckets);
+   this->buckets = buckets;
+   this->nBuckets = nBuckets;
+   this->head = count ? count - 1 : 0;
+   this->count = count;
+}
+
+static void GraphTier_add(GraphTier* this, const GraphTierSpec* spec, uint64_t timeMs, double value) {
+   uint64_t index = timeMs / spec->bucketMs;
+
+   if (!this->count) {
+      this->newest = index;
+      this->head = 0;
+      this->count = 1;
+   } else if (index > this->newest) {
+      /* start a new bucket, leaving the ones of the skipped time empty */
+      uint64_t skip = index - this->newest;
+      if (skip >= this->nBuckets) {
+         memset(this->buckets, 0, this->nBuckets * sizeof(*this->buckets));
+         this->head = 0;
+         this->count = 1;
+      } else {
+         for (uint64_t i = 0; i < skip; i++) {
+            this->head = (this->head + 1) % this->nBuckets;
+            this->buckets[this->head].count = 0;
+         }
+         this->count = MINIMUM(this->count + (size_t)skip, this->nBuckets);
+      }
+      this->newest = index;
+   }
+   /* a clock going backwards keeps adding to the newest bucket */
+
+   GraphBucket_add(&this->buckets[this->head], value);
+}
+
+static void Meter_recordGraphData(Meter* this) {
+   GraphData* data = &this->drawData;
+   const Machine* host = this->host;
+   if (timercmp(&host->realtime, &(data->time), <))
+      return;
+
+   int globalDelay = host->settings->delay;
+   struct timeval delay = { .tv_sec = globalDelay / 10, .tv_usec = (globalDelay % 10) * 100000L };
+   timeradd(&host->realtime, &delay, &(data->time));
+
+   double value = 0.0;
+   if (this->curItems > 0) {
+      value = Meter_computeSum(this);
+      if (Meter_isPercentChart(this) && this->total > 0.0) {
+         value /= this->total;
+      }
+   }
+
+   if (!data->values)
+      GraphData_grow(data, METER_GRAPHDATA_INITIAL_VALUES);
+
+   data->values[data->head] = value;
+   data->head = (data->head + 1) % data->nValues;
+   if (data->count < data->nValues)
+      data->count++;
+
+   /* a graph over a time span draws from one tier, and only back that far;
+      it is kept whatever the mode, so switching to a graph shows the past */
+   uint64_t spanMs = (uint64_t)host->settings->graphHistoryMins * 60 * 1000;
+   if (data->spanMs != spanMs) {
+      for (size_t i = 0; i < METER_GRAPH_TIERS; i++) {
+         if (data->tiers[i].buckets)
+            GraphTier_clear(&data->tiers[i]);
+      }
+      data->spanMs = spanMs;
+   }
+   if (!spanMs)
+      return;
+
+   size_t used = GraphData_tier(spanMs);
+   GraphTier* tier = &data->tiers[used];
+   const GraphTierSpec* spec = &Meter_graphTiers[used];
+   size_t nBuckets = (size_t) MINIMUM((spanMs + spec->bucketMs - 1) / spec->bucketMs + 1, (uint64_t)spec->nBuckets);
+   if (tier->nBuckets != nBuckets)
+      GraphTier_resize(tier, nBuckets);
+   GraphTier_add(tier, spec, host->realtimeMs, value);
+}
+
+/*
+ * Value of point i of n points ending with the newest sample. Without a
+ * time span every point is one sample, otherwise the points spread over
+ * spanMs using the finest tier holding that much time: percent charts
+ * show the average of the buckets of a point, other charts their peak.
+ */
+static double GraphData_point(const GraphData* data, bool isPercentChart, uint64_t spanMs, size_t i, size_t n) {
+   assert(i < n);
+
+   if (!spanMs) {
+      size_t age = n - i;
+      if (age > data->count)
+         return 0.0;
+      return data->values[(data->head + data->nValues - age) % data->nValues];
+   }
+
+   size_t t = GraphData_tier(spanMs);
+   const GraphTier* tier = &data->tiers[t];
+   const GraphTierSpec* spec = &Meter_graphTiers[t];
+   if (!tier->count)
+      return 0.0;
+
+   uint64_t end = (tier->newest + 1) * spec->bucketMs;
+   uint64_t fromAge = spanMs * (n - i) / n;
+   if (fromAge > end)
+      return 0.0;
+
+   uint64_t first = (end - fromAge) / spec->bucketMs;
+   uint64_t last = MAXIMUM((end - spanMs * (n - i - 1) / n) / spec->bucketMs, first + 1);
+
+   double sum = 0.0;
+   double peak = 0.0;
+   uint64_t samples = 0;
+   for (uint64_t b = first; b < last && b <= tier->newest; b++) {
+      uint64_t age = tier->newest - b;
+      if (age >= tier->count)
+         continue;
+
+      const GraphBucket* bucket = &tier->buckets[(tier->head + tier->nBuckets - (size_t)age) % tier->nBuckets];
+      if (!bucket->count)
+         continue;
+
+      sum += (double)bucket->avg * bucket->count;
+      peak = MAXIMUM(peak, (double)bucket->max);
+      samples += bucket->count;
+   }
+
+   if (!samples)
+      return 0.0;
+
+   return isPercentChart ? sum / (double)samples : peak;
+}
+
 static void GraphMeterMode_draw(Meter* this, int x, int y, int w) {
    assert(x >= 0);
    assert(w <= INT_MAX - x);
@@ -237,45 +430,20 @@ static void GraphMeterMode_draw(Meter* this, int x, int y, int w) {
    bool isPercentChart = Meter_isPercentChart(this);
 
    GraphData* data = &this->drawData;
-
-   // Expand the graph data buffer if necessary
-   assert(data->nValues / 2 <= INT_MAX);
-   if (w > (int)(data->nValues / 2) && MAX_METER_GRAPHDATA_VALUES > data->nValues) {
-      size_t oldNValues = data->nValues;
-      data->nValues = MAXIMUM(oldNValues + oldNValues / 2, (size_t)w * 2);
-      data->nValues = MINIMUM(data->nValues, MAX_METER_GRAPHDATA_VALUES);
-      data->values = xReallocArray(data->values, data->nValues, sizeof(*data->values));
-      memmove(data->values + (data->nValues - oldNValues), data->values, oldNValues * sizeof(*data->values));
-      memset(data->values, 0, (data->nValues - oldNValues) * sizeof(*data->values));
-   }
-
-   const size_t nValues = data->nValues;
-   if (nValues < 1)
-      goto end;
-
-   // Record new value if necessary
-   const Machine* host = this->host;
-   if (!timercmp(&host->realtime, &(data->time), <)) {
-      int globalDelay = host->settings->delay;
-      struct timeval delay = { .tv_sec = globalDelay / 10, .tv_usec = (globalDelay % 10) * 100000L };
-      timeradd(&host->realtime, &delay, &(data->time));
-
-      memmove(&data->values[0], &data->values[1], (nValues - 1) * sizeof(*data->values));
-
-      data->values[nValues - 1] = 0.0;
-      if (this->curItems > 0) {
-         data->values[nValues - 1] = Meter_computeSum(this);
-         if (isPercentChart && this->total > 0.0) {
-            data->values[nValues - 1] /= this->total;
-         }
-      }
-   }
+   const Settings* settings = this->host->settings;
+   uint64_t spanMs = (uint64_t)settings->graphHistoryMins * 60 * 1000;
 
    if (w < 1) {
       goto end;
    }
    x += captionLen;
 
+   // Expand the sample history if the graph got wider
+   if ((size_t)w * 2 > data->nValues && data->nValues < MAX_METER_GRAPHDATA_VALUES) {
+      size_t nValues = MAXIMUM(data->nValues + data->nValues / 2, (size_t)w * 2);
+      GraphData_grow(data, MINIMUM(nValues, MAX_METER_GRAPHDATA_VALUES));
+   }
+
    // Graph drawing style (character set, etc.)
    const char* const* GraphMeterMode_dots;
    int GraphMeterMode_pixPerRow;
@@ -290,28 +458,28 @@ static void GraphMeterMode_draw(Meter* this, int x, int y, int w) {
       GraphMeterMode_pixPerRow = PIXPERROW_ASCII;
    }
 
-   // Starting positions of graph data and terminal column
-   if ((size_t)w > nValues / 2) {
-      x += w - nValues / 2;
-      w = (int)(nValues / 2);
+   // Starting position of the terminal column
+   if ((size_t)w > MAX_METER_GRAPHDATA_VALUES / 2) {
+      x += w - MAX_METER_GRAPHDATA_VALUES / 2;
+      w = MAX_METER_GRAPHDATA_VALUES / 2;
    }
-   size_t i = nValues - (size_t)w * 2;
+   const size_t nPoints = (size_t)w * 2;
 
    // Determine the graph scale
    double total = 1.0;
    if (!isPercentChart) {
-      for (size_t j = i; j < nValues; j++) {
-         total = MAXIMUM(data->values[j], total);
+      for (size_t j = 0; j < nPoints; j++) {
+         total = MAXIMUM(GraphData_point(data, isPercentChart, spanMs, j, nPoints), total);
       }
       assert(total <= DBL_MAX);
    }
    assert(total >= 1.0);
 
    // Draw the actual graph
-   for (int col = 0; i < nValues - 1; i += 2, col++) {
+   for (size_t i = 0, col = 0; i < nPoints; i += 2, col++) {
       int pix = GraphMeterMode_pixPerRow * h;
-      int v1 = (int) lround(CLAMP(data->values[i] / total * pix, 1.0, pix));
-      int v2 = (int) lround(CLAMP(data->values[i + 1] / total * pix, 1.0, pix));
+      int v1 = (int) lround(CLAMP(GraphData_point(data, isPercentChart, spanMs, i, nPoints) / total * pix, 1.0, pix));
+      int v2 = (int) lround(CLAMP(GraphData_point(data, isPercentChart, spanMs, i + 1, nPoints) / total * pix, 1.0, pix));
 
       int colorIdx = GRAPH_1;
       for (int line = 0; line < h; line++) {
@@ -319,7 +487,7 @@ static void GraphMeterMode_draw(Meter* this, int x, int y, int w) {
          int line2 = CLAMP(v2 - (GraphMeterMode_pixPerRow * (h - 1 - line)), 0, GraphMeterMode_pixPerRow);
 
          attrset(CRT_colors[colorIdx]);
-         mvaddstr(y + line, x + col, GraphMeterMode_dots[line1 * (GraphMeterMode_pixPerRow + 1) + line2]);
+         mvaddstr(y + line, x + (int)col, GraphMeterMode_dots[line1 * (GraphMeterMode_pixPerRow + 1) + line2]);
          colorIdx = GRAPH_2;
       }
    }
@@ -513,11 +681,41 @@ void Meter_delete(Object* cast) {
       Meter_done(this);
    }
    free(this->drawData.values);
+   for (size_t i = 0; i < METER_GRAPH_TIERS; i++)
+      free(this->drawData.tiers[i].buckets);
    free(this->caption);
    free(this->values);
    free(this);
 }
 
+/*
+ * The values are updated once per interval of the class, and kept in
+ * between. The cost of every update is measured, and a meter taking more
+ * than 1/METER_COST_RATIO of its interval gets a longer one, so a slow
+ * source (e.g. forking a helper) cannot dominate the refresh.
+ */
+void Meter_update(Meter* this) {
+   uint64_t now = this->host->monotonicMs;
+   if (!this->updates || now >= this->nextUpdateMs) {
+      uint64_t start = Profiler_clock();
+      Meter_updateValues(this);
+      uint64_t cost = Profiler_clock() - start;
+
+      this->costNs = this->updates ? (3 * this->costNs + cost) / 4 : cost;
+      this->updates++;
+
+      uint64_t throttled = MINIMUM(this->costNs * METER_COST_RATIO / 1000000, METER_MAX_INTERVAL_MS);
+      this->intervalMs = (uint32_t) MAXIMUM(Meter_updateInterval(this), throttled);
+      this->nextUpdateMs = now + this->intervalMs;
+   }
+
+   /* meters made of sub meters record those as they update them */
+   if (Meter_updateModeFn(this) || !(Meter_supportedModes(this) & (1 << GRAPH_METERMODE)))
+      return;
+
+   Meter_recordGraphData(this);
+}
+
 void Meter_setCaption(Meter* this, const char* caption) {
    free_and_xStrdup(&this->caption, caption);
 }
@@ -542,10 +740,6 @@ void Meter_setMode(Meter* this, MeterModeId modeIndex) {
       this->draw = Meter_drawFn(this);
       Meter_updateMode(this, modeIndex);
    } else {
-      free(this->drawData.values);
-      this->drawData.values = NULL;
-      this->drawData.nValues = 0;
-
       const MeterMode* mode = &Meter_modes[modeIndex];
       this->draw = mode->draw;
       this->h = mode->h;
@@ -579,8 +773,15 @@ ListItem* Meter_toListItem(const Meter* this, bool moving) {
       Meter_getUiName(this, name, sizeof(name));
    else
       xSnprintf(name, sizeof(name), "%s", Meter_uiName(this));
-   char buffer[50];
-   xSnprintf(buffer, sizeof(buffer), "%s%s", name, mode);
+   /* the cost of an update, and how often it happens when not on every refresh */
+   char cost[32] = "";
+   if (this->updates) {
+      int len = xSnprintf(cost, sizeof(cost), " %.1fms", this->costNs / 1000000.0);
+      if (this->intervalMs >= 1000)
+         xSnprintf(cost + len, sizeof(cost) - (size_t)len, "/%us", (unsigned int)(this->intervalMs / 1000));
+   }
+   char buffer[80];
+   xSnprintf(buffer, sizeof(buffer), "%s%s%s", name, mode, cost);
    ListItem* li = ListItem_new(buffer, 0);
    li->moving = moving;
    return li;
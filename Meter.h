@@ -21,6 +21,12 @@ in the source distribution for its full text.
 
 #define METER_TXTBUFFER_LEN 256
 #define MAX_METER_GRAPHDATA_VALUES 32768
+#define METER_GRAPHDATA_INITIAL_VALUES 256
+#define METER_GRAPH_TIERS 3
+
+/* A meter may spend at most 1/METER_COST_RATIO of the time updating; slower ones get updated less often */
+#define METER_COST_RATIO 100
+#define METER_MAX_INTERVAL_MS 60000
 
 #define METER_BUFFER_CHECK(buffer, size, written)          \
    do {                                                    \
@@ -75,6 +81,7 @@ typedef struct MeterClass_ {
    const char* const description;          /* optional meter description in header setup menu */
    const uint8_t maxItems;
    const bool isMultiColumn;               /* whether the meter draws multiple sub-columns (defaults to false) */
+   const uint32_t updateInterval;          /* milliseconds the values stay relevant; 0 (default) updates on every refresh */
 
    /* Specifies how the meter is rendered in bar or graph mode:
       true: a percent bar or graph with 'total' representing 100% or maximum.
@@ -102,11 +109,31 @@ typedef struct MeterClass_ {
 #define Meter_uiName(this_)            As_Meter(this_)->uiName
 #define Meter_isMultiColumn(this_)     As_Meter(this_)->isMultiColumn
 #define Meter_isPercentChart(this_)    As_Meter(this_)->isPercentChart
+#define Meter_updateInterval(this_)    As_Meter(this_)->updateInterval
+
+typedef struct GraphBucket_ {
+   float max;
+   float avg;
+   uint32_t count;            /**< samples taken in the bucket, 0 if none */
+} GraphBucket;
+
+/* Rollup of the samples over fixed time buckets, see Meter_graphTiers */
+typedef struct GraphTier_ {
+   uint64_t newest;           /**< time index (realtimeMs / bucket length) of the newest bucket */
+   size_t head;               /**< slot of the newest bucket */
+   size_t count;              /**< buckets holding history */
+   size_t nBuckets;           /**< capacity, enough for the time span shown */
+   GraphBucket* buckets;      /**< NULL unless a graph is drawn from the tier */
+} GraphTier;
 
 typedef struct GraphData_ {
-   struct timeval time;
-   size_t nValues;
-   double* values;
+   struct timeval time;       /**< when the next sample is due */
+   size_t nValues;            /**< capacity of the values ring */
+   size_t head;               /**< slot the next sample is stored in */
+   size_t count;              /**< samples held, at most nValues */
+   double* values;            /**< one sample per update */
+   uint64_t spanMs;           /**< time span the tiers were filled for */
+   GraphTier tiers[METER_GRAPH_TIERS];   /**< only that of the span is filled */
 } GraphData;
 
 struct Meter_ {
@@ -126,6 +153,12 @@ struct Meter_ {
    double* values;
    double total;
    void* meterData;
+
+   /* update scheduling, see Meter_update */
+   uint64_t updates;          /* number of times the values were updated */
+   uint64_t nextUpdateMs;     /* monotonic time the values are due again */
+   uint32_t intervalMs;       /* current interval: the one of the class, or longer for a slow meter */
+   uint64_t costNs;           /* moving average of the time an update takes */
 };
 
 typedef enum {
@@ -137,6 +170,16 @@ typedef enum {
 
 extern const MeterClass Meter_class;
 
+/* Braille (or ASCII) characters showing two bars of 0 to PIXPERROW_* dots,
+   indexed by left * (PIXPERROW_* + 1) + right */
+#ifdef HAVE_LIBNCURSESW
+#define PIXPERROW_UTF8 4
+extern const char* const GraphMeterMode_dotsUtf8[];
+#endif
+
+#define PIXPERROW_ASCII 2
+extern const char* const GraphMeterMode_dotsAscii[];
+
 Meter* Meter_new(const Machine* host, unsigned int param, const MeterClass* type);
 
 /* Converts 'value' in kibibytes into a human readable string.
@@ -145,6 +188,11 @@ int Meter_humanUnit(char* buffer, double value, size_t size);
 
 void Meter_delete(Object* cast);
 
+/* Updates the values of the meter unless the last ones are still due, and,
+   for a meter that can be drawn as a graph, records them into its graph
+   history whatever its current mode */
+void Meter_update(Meter* this);
+
 void Meter_setCaption(Meter* this, const char* caption);
 
 void Meter_setMode(Meter* this, MeterModeId modeIndex);
@@ -180,9 +180,7 @@ static inline char* stpcpyWithNewlineConversion(char* dstStr, const char* srcStr
  * Process_writeCommand() for coloring. The merged Command string is also
  * returned by Process_getCommand() for searching, sorting and filtering.
  */
-void Process_makeCommandStr(Process* this, const Settings* settings) {
-   ProcessMergedCommand* mc = &this->mergedCommand;
-
+static void Process_buildCommandData(const Process* this, const Settings* settings, ProcessMergedCommandData* mc) {
    bool showMergedCommand = settings->showMergedCommand;
    bool showProgramPath = settings->showProgramPath;
    bool searchCommInCmdline = settings->findCommInCmdline;
@@ -190,24 +188,6 @@ void Process_makeCommandStr(Process* this, const Settings* settings) {
    bool showThreadNames = settings->showThreadNames;
    bool shadowDistPathPrefix = settings->shadowDistPathPrefix;
 
-   uint64_t settingsStamp = settings->lastUpdate;
-
-   /* Nothing to do to (Re)Generate the Command string, if the process is:
-    * - a kernel thread, or
-    * - a zombie from before being under htop's watch, or
-    * - a user thread and showThreadNames is not set */
-   if (Process_isKernelThread(this))
-      return;
-   if (this->state == ZOMBIE && !this->mergedCommand.str)
-      return;
-
-   /* this->mergedCommand.str needs updating only if its state or contents changed.
-    * Its content is based on the fields cmdline, comm, and exe. */
-   if (mc->lastUpdate >= settingsStamp)
-      return;
-
-   mc->lastUpdate = settingsStamp;
-
    /* The field separator "│" has been chosen such that it will not match any
     * valid string used for searching or filtering */
    const char* SEPARATOR = CRT_treeStr[TREE_STR_VERT];
@@ -219,13 +199,8 @@ void Process_makeCommandStr(Process* this, const Settings* settings) {
    maxLen += this->procComm ? strlen(this->procComm) : 0;
    maxLen += this->procExe ? strlen(this->procExe) : 0;
 
-   free(mc->str);
    mc->str = xCalloc(1, maxLen);
 
-   /* Reset all locations that need extra handling when actually displaying */
-   mc->highlightCount = 0;
-   memset(mc->highlights, 0, sizeof(mc->highlights));
-
    size_t mbMismatch = 0;
    #define WRITE_HIGHLIGHT(_offset, _length, _attr, _flags)                                   \
       do {                                                                                    \
@@ -468,11 +443,139 @@ void Process_makeCommandStr(Process* this, const Settings* settings) {
    #undef WRITE_HIGHLIGHT
 }
 
+#define COMMAND_TASK_USERLAND_THREAD  0x01
+#define COMMAND_TASK_THREAD           0x02
+#define COMMAND_TASK_EXE_DELETED      0x04
+#define COMMAND_TASK_LIB_DELETED      0x08
+#define COMMAND_TASK_NO_CMDLINE       0x10
+
+static uint32_t Process_commandTaskFlags(const Process* this) {
+   uint32_t flags = 0;
+   if (Process_isUserlandThread(this))
+      flags |= COMMAND_TASK_USERLAND_THREAD;
+   if (Process_isThread(this))
+      flags |= COMMAND_TASK_THREAD;
+   if (this->procExeDeleted)
+      flags |= COMMAND_TASK_EXE_DELETED;
+   if (this->usesDeletedLib)
+      flags |= COMMAND_TASK_LIB_DELETED;
+   if (!this->cmdline)
+      flags |= COMMAND_TASK_NO_CMDLINE;
+   return flags;
+}
+
+/* NULL hashes like the empty string; each string is ended by a byte none contains */
+static ht_key_t hashCommandString(ht_key_t hash, const char* s) {
+   if (s)
+      hash = Hashtable_hashString(hash, s);
+   return Hashtable_hashBytes(hash, "\xff", 1);
+}
+
+static ht_key_t Process_commandHash(const Process* this, uint32_t settingsKey, uint32_t taskFlags) {
+   ht_key_t hash = HASHTABLE_HASH_INIT;
+   hash = hashCommandString(hash, this->cmdline);
+   hash = hashCommandString(hash, this->procComm);
+   hash = hashCommandString(hash, this->procExe);
+   hash ^= (ht_key_t)(this->cmdlineBasenameStart * 31 + this->cmdlineBasenameEnd * 17 + this->procExeBasenameOffset);
+   hash ^= settingsKey * 2654435761U;
+   hash ^= taskFlags << 24;
+   return hash;
+}
+
+static bool Process_commandDataMatches(const ProcessMergedCommandData* data, const Process* this, uint32_t settingsKey, uint32_t taskFlags) {
+   return data->settingsKey == settingsKey &&
+          data->taskFlags == taskFlags &&
+          data->cmdlineBasenameStart == this->cmdlineBasenameStart &&
+          data->cmdlineBasenameEnd == this->cmdlineBasenameEnd &&
+          data->procExeBasenameOffset == this->procExeBasenameOffset &&
+          String_eq_nullable(data->cmdline, this->cmdline) &&
+          String_eq_nullable(data->procComm, this->procComm) &&
+          String_eq_nullable(data->procExe, this->procExe);
+}
+
+static void Process_releaseCommandData(ProcessMergedCommandData* data) {
+   if (!data)
+      return;
+
+   assert(data->refCount > 0);
+   if (--data->refCount > 0)
+      return;
+
+   if (data->cache && Hashtable_get(data->cache, data->hash) == data)
+      Hashtable_remove(data->cache, data->hash);
+
+   free(data->cmdline);
+   free(data->procComm);
+   free(data->procExe);
+   free(data->str);
+   free(data);
+}
+
+void Process_makeCommandStr(Process* this, const Settings* settings) {
+   ProcessMergedCommand* mc = &this->mergedCommand;
+
+   /* Nothing to do to (Re)Generate the Command string, if the process is:
+    * - a kernel thread, or
+    * - a zombie from before being under htop's watch */
+   if (Process_isKernelThread(this))
+      return;
+   if (this->state == ZOMBIE && !mc->data)
+      return;
+
+   ProcessTable* pt = (ProcessTable*) this->super.host->processTable;
+   uint64_t generation = ProcessTable_commandGeneration(pt, settings);
+
+   /* this->mergedCommand needs updating only if the relevant display settings
+    * or its contents changed. Its content is based on the fields cmdline, comm, and exe. */
+   if (mc->lastUpdate >= generation)
+      return;
+
+   mc->lastUpdate = generation;
+
+   uint32_t settingsKey = pt->commandSettings;
+   uint32_t taskFlags = Process_commandTaskFlags(this);
+   ht_key_t hash = Process_commandHash(this, settingsKey, taskFlags);
+
+   ProcessMergedCommandData* old = mc->data;
+   ProcessMergedCommandData* data = Hashtable_get(pt->commandCache, hash);
+   if (data && Process_commandDataMatches(data, this, settingsKey, taskFlags)) {
+      if (data != old) {
+         data->refCount++;
+         mc->data = data;
+         Process_releaseCommandData(old);
+      }
+      return;
+   }
+
+   ProcessMergedCommandData* fresh = xCalloc(1, sizeof(ProcessMergedCommandData));
+   fresh->refCount = 1;
+   fresh->hash = hash;
+   fresh->settingsKey = settingsKey;
+   fresh->taskFlags = taskFlags;
+   fresh->cmdline = this->cmdline ? xStrdup(this->cmdline) : NULL;
+   fresh->procComm = this->procComm ? xStrdup(this->procComm) : NULL;
+   fresh->procExe = this->procExe ? xStrdup(this->procExe) : NULL;
+   fresh->cmdlineBasenameStart = this->cmdlineBasenameStart;
+   fresh->cmdlineBasenameEnd = this->cmdlineBasenameEnd;
+   fresh->procExeBasenameOffset = this->procExeBasenameOffset;
+
+   Process_buildCommandData(this, settings, fresh);
+
+   /* On a hash collision the data stays private to this process */
+   if (!data) {
+      fresh->cache = pt->commandCache;
+      Hashtable_put(pt->commandCache, hash, fresh);
+   }
+
+   mc->data = fresh;
+   Process_releaseCommandData(old);
+}
+
 void Process_writeCommand(const Process* this, int attr, int baseAttr, RichString* str) {
    (void)baseAttr;
 
-   const ProcessMergedCommand* mc = &this->mergedCommand;
-   const char* mergedCommand = mc->str;
+   const ProcessMergedCommandData* mc = this->mergedCommand.data;
+   const char* mergedCommand = mc ? mc->str : NULL;
 
    size_t strStart = RichString_size(str);
 
@@ -588,7 +691,7 @@ void Process_writeField(const Process* this, RichString* str, RowField field) {
          baseattr = CRT_colors[PROCESS_THREAD_BASENAME];
       }
       const ScreenSettings* ss = settings->ss;
-      if (!ss->treeView || super->indent == 0) {
+      if ((!ss->treeView && !ss->groupBy) || super->indent == 0) {
          Process_writeCommand(this, attr, baseattr, str);
          return;
       }
@@ -798,7 +901,7 @@ void Process_done(Process* this) {
    free(this->procComm);
    free(this->procExe);
    free(this->procCwd);
-   free(this->mergedCommand.str);
+   Process_releaseCommandData(this->mergedCommand.data);
    free(this->tty_name);
 }
 
@@ -808,11 +911,11 @@ void Process_done(Process* this) {
 const char* Process_getCommand(const Process* this) {
    const Settings* settings = this->super.host->settings;
 
-   if ((Process_isUserlandThread(this) && settings->showThreadNames) || !this->mergedCommand.str) {
+   if ((Process_isUserlandThread(this) && settings->showThreadNames) || !this->mergedCommand.data) {
       return this->cmdline;
    }
 
-   return this->mergedCommand.str;
+   return this->mergedCommand.data->str;
 }
 
 static const char* Process_getSortKey(const Process* this) {
@@ -820,8 +923,10 @@ static const char* Process_getSortKey(const Process* this) {
 }
 
 const char* Process_rowGetSortKey(Row* super) {
-   const Process* this = (const Process*) super;
+   Process* this = (Process*) super;
    assert(Object_isA((const Object*) this, (const ObjectClass*) &Process_class));
+   /* searching may reach rows that have not been displayed yet */
+   Process_makeCommandStr(this, super->host->settings);
    return Process_getSortKey(this);
 }
 
@@ -13,6 +13,7 @@ in the source distribution for its full text.
 #include <stdint.h>
 #include <sys/types.h>
 
+#include "Hashtable.h"
 #include "Object.h"
 #include "RichString.h"
 #include "Row.h"
@@ -67,15 +68,34 @@ typedef struct ProcessCmdlineHighlight_ {
    int flags;     /* Special flags used for selective highlighting, zero for always */
 } ProcessCmdlineHighlight;
 
-/* ProcessMergedCommand is populated by Process_makeCommandStr: It
+/* ProcessMergedCommandData is populated by Process_makeCommandStr: It
  * contains the merged Command string, and the information needed by
- * Process_writeCommand to color the string. str will be NULL for kernel
- * threads and zombies */
-typedef struct ProcessMergedCommand_ {
-   uint64_t lastUpdate;                        /* Marker based on settings->lastUpdate to track when the rendering needs refreshing */
+ * Process_writeCommand to color the string. Instances are reference
+ * counted and shared (via ProcessTable.commandCache) by all processes
+ * with identical cmdline, comm, exe and display settings, e.g. threads
+ * of the same process or identical worker processes. */
+typedef struct ProcessMergedCommandData_ {
+   unsigned int refCount;                      /* number of processes using this data */
+   ht_key_t hash;                              /* hash of the inputs below */
+   Hashtable* cache;                           /* cache this data is registered in, NULL if private */
+   uint32_t settingsKey;                       /* display settings used, see ProcessTable_commandSettingsKey */
+   uint32_t taskFlags;                         /* thread and deleted exe/lib state used */
+   char* cmdline;                              /* inputs the merged Command string was built from */
+   char* procComm;
+   char* procExe;
+   size_t cmdlineBasenameStart;
+   size_t cmdlineBasenameEnd;
+   size_t procExeBasenameOffset;
    char* str;                                  /* merged Command string */
    size_t highlightCount;                      /* how many portions of cmdline to highlight */
    ProcessCmdlineHighlight highlights[8];      /* which portions of cmdline to highlight */
+} ProcessMergedCommandData;
+
+/* Per process reference to the shared merged Command. data will be NULL
+ * for kernel threads, zombies and processes not displayed yet */
+typedef struct ProcessMergedCommand_ {
+   uint64_t lastUpdate;                        /* Command generation (see ProcessTable_commandGeneration) data was looked up for, zero when cmdline, comm or exe changed */
+   ProcessMergedCommandData* data;             /* shared merged Command */
 } ProcessMergedCommand;
 
 typedef struct Process_ {
@@ -330,7 +350,8 @@ void Process_updateCmdline(Process* this, const char* cmdline, size_t basenameSt
 void Process_updateExe(Process* this, const char* exe);
 
 /* This function constructs the string that is displayed by
- * Process_writeCommand and also returned by Process_getCommand */
+ * Process_writeCommand and also returned by Process_getCommand.
+ * It is called lazily, for rows about to be displayed, sorted or filtered. */
 void Process_makeCommandStr(Process* this, const struct Settings_ *settings);
 
 void Process_writeCommand(const Process* this, int attr, int baseAttr, RichString* str);
@@ -13,7 +13,9 @@ in the source distribution for its full text.
 #include <stdlib.h>
 
 #include "Hashtable.h"
+#include "Panel.h"
 #include "Row.h"
+#include "RowField.h"
 #include "Settings.h"
 #include "Vector.h"
 
@@ -22,10 +24,43 @@ void ProcessTable_init(ProcessTable* this, const ObjectClass* klass, Machine* ho
    Table_init(&this->super, klass, host);
 
    this->pidMatchList = pidMatchList;
+
+   this->commandCache = Hashtable_new(200, false);
+   this->commandGeneration = 1;
 }
 
 void ProcessTable_done(ProcessTable* this) {
+   /* Releases the merged Command strings of all rows, so the cache is emptied last */
    Table_done(&this->super);
+   Hashtable_delete(this->commandCache);
+}
+
+/* All settings the merged Command string and its highlighting depend on */
+static uint32_t ProcessTable_commandSettingsKey(const Settings* settings) {
+   uint32_t key = 0;
+   key |= settings->showMergedCommand ? 0x01 : 0;
+   key |= settings->showProgramPath ? 0x02 : 0;
+   key |= settings->findCommInCmdline ? 0x04 : 0;
+   key |= settings->stripExeFromCmdline ? 0x08 : 0;
+   key |= settings->showThreadNames ? 0x10 : 0;
+   key |= settings->shadowDistPathPrefix ? 0x20 : 0;
+   key |= (uint32_t)settings->colorScheme << 8;
+   return key;
+}
+
+uint64_t ProcessTable_commandGeneration(ProcessTable* this, const Settings* settings) {
+   uint32_t key = ProcessTable_commandSettingsKey(settings);
+   if (key != this->commandSettings) {
+      this->commandSettings = key;
+      this->commandGeneration++;
+   }
+   return this->commandGeneration;
+}
+
+/* Whether every row needs its merged Command, not only those displayed */
+static bool ProcessTable_needsAllCommands(const Table* super) {
+   const ScreenSettings* ss = super->host->settings->ss;
+   return super->incFilter || ScreenSettings_getActiveSortKey(ss) == COMM;
 }
 
 Process* ProcessTable_getProcess(ProcessTable* this, pid_t pid, bool* preExisting, Process_New constructor) {
@@ -43,7 +78,7 @@ Process* ProcessTable_getProcess(ProcessTable* this, pid_t pid, bool* preExistin
    return proc;
 }
 
-static void ProcessTable_prepareEntries(Table* super) {
+void ProcessTable_prepareEntries(Table* super) {
    ProcessTable* this = (ProcessTable*) super;
    this->totalTasks = 0;
    this->userlandThreads = 0;
@@ -59,7 +94,7 @@ static void ProcessTable_iterateEntries(Table* super) {
    ProcessTable_goThroughEntries(this);
 }
 
-static void ProcessTable_cleanupEntries(Table* super) {
+void ProcessTable_cleanupEntries(Table* super) {
    Machine* host = super->host;
    const Settings* settings = host->settings;
 
@@ -68,11 +103,14 @@ static void ProcessTable_cleanupEntries(Table* super) {
    int dirtyIndex = Vector_size(super->rows);
 
    // Finish process table update, culling any exit'd processes
+   bool allCommands = ProcessTable_needsAllCommands(super);
    for (int i = Vector_size(super->rows) - 1; i >= 0; i--) {
       Process* p = (Process*) Vector_get(super->rows, i);
 
-      // tidy up Process state after refreshing the ProcessTable table
-      Process_makeCommandStr(p, settings);
+      // tidy up Process state after refreshing the ProcessTable table;
+      // otherwise the Command is built once the row gets displayed
+      if (allCommands)
+         Process_makeCommandStr(p, settings);
 
       // keep track of the highest UID and PID for column scaling
       if (p->st_uid > host->maxUserId)
@@ -91,6 +129,19 @@ static void ProcessTable_cleanupEntries(Table* super) {
    Table_compact(super, dirtyIndex);
 }
 
+void ProcessTable_prepareVisible(Table* super, int first, int last) {
+   const Settings* settings = super->host->settings;
+
+   if (ProcessTable_needsAllCommands(super)) {
+      for (int i = 0; i < Vector_size(super->rows); i++)
+         Process_makeCommandStr((Process*) Vector_get(super->rows, i), settings);
+      return;
+   }
+
+   for (int i = first; i < last; i++)
+      Process_makeCommandStr((Process*) Panel_get(super->panel, i), settings);
+}
+
 const TableClass ProcessTable_class = {
    .super = {
       .extends = Class(Table),
@@ -99,4 +150,5 @@ const TableClass ProcessTable_class = {
    .prepare = ProcessTable_prepareEntries,
    .iterate = ProcessTable_iterateEntries,
    .cleanup = ProcessTable_cleanupEntries,
+   .prepareVisible = ProcessTable_prepareVisible,
 };
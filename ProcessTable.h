@@ -8,12 +8,14 @@ in the source distribution for its full text.
 */
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <sys/types.h>
 
 #include "Hashtable.h"
 #include "Machine.h"
 #include "Object.h"
 #include "Process.h"
+#include "Settings.h"
 #include "Table.h"
 
 
@@ -22,6 +24,10 @@ typedef struct ProcessTable_ {
 
    Hashtable* pidMatchList;
 
+   Hashtable* commandCache;      /* shared merged Command strings (ProcessMergedCommandData), keyed by content hash */
+   uint32_t commandSettings;     /* display settings key the merged Command strings are built for */
+   uint64_t commandGeneration;   /* bumped whenever commandSettings changes */
+
    unsigned int totalTasks;
    unsigned int runningTasks;
    unsigned int userlandThreads;
@@ -37,12 +43,21 @@ void ProcessTable_init(ProcessTable* this, const ObjectClass* klass, Machine* ho
 
 void ProcessTable_done(ProcessTable* this);
 
+/* Table methods, shared with tables not scanning the local machine */
+void ProcessTable_prepareEntries(Table* super);
+
+void ProcessTable_cleanupEntries(Table* super);
+
+void ProcessTable_prepareVisible(Table* super, int first, int last);
+
 extern const TableClass ProcessTable_class;
 
 static inline void ProcessTable_add(ProcessTable* this, Process* process) {
    Table_add(&this->super, &process->super);
 }
 
+uint64_t ProcessTable_commandGeneration(ProcessTable* this, const Settings* settings);
+
 Process* ProcessTable_getProcess(ProcessTable* this, pid_t pid, bool* preExisting, Process_New constructor);
 
 static inline Process* ProcessTable_findProcess(ProcessTable* this, pid_t pid) {
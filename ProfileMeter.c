@@ -0,0 +1,100 @@
+/*
+htop - ProfileMeter.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "ProfileMeter.h"
+
+#include <stddef.h>
+
+#include "CRT.h"
+#include "Macros.h"
+#include "Object.h"
+#include "Profiler.h"
+#include "RichString.h"
+#include "XUtils.h"
+
+
+/* Phases shown, each with its p50 and p99 over the last refreshes */
+static const struct {
+   ProfilerPhase phase;
+   const char* label;
+} ProfileMeter_phases[] = {
+   { PROFILE_REFRESH,        "total " },
+   { PROFILE_MACHINE_SCAN,   " machine " },
+   { PROFILE_TABLE_ITERATE,  " scan " },
+   { PROFILE_TABLE_CLEANUP,  " cleanup " },
+   { PROFILE_REBUILD_PANEL,  " sort " },
+   { PROFILE_DRAW_PANELS,    " draw " },
+};
+
+static const int ProfileMeter_attributes[] = {
+   METER_VALUE
+};
+
+static void ProfileMeter_init(Meter* this) {
+   (void) this;
+   Profiler_enable();
+}
+
+static void ProfileMeter_done(Meter* this) {
+   (void) this;
+   Profiler_disable();
+}
+
+static void ProfileMeter_updateValues(Meter* this) {
+   ProfilerSummary summary;
+   Profiler_summary(PROFILE_REFRESH, &summary);
+   this->values[0] = summary.p50 / 1000000.0;
+   xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "%.1fms", this->values[0]);
+}
+
+static void ProfileMeter_appendTime(RichString* out, uint64_t ns) {
+   char buffer[16];
+   int len = xSnprintf(buffer, sizeof(buffer), "%.1f", ns / 1000000.0);
+   RichString_appendnAscii(out, CRT_colors[METER_VALUE], buffer, len);
+}
+
+static void ProfileMeter_display(const Object* cast, RichString* out) {
+   (void) cast;
+
+   for (size_t i = 0; i < ARRAYSIZE(ProfileMeter_phases); i++) {
+      ProfilerSummary summary;
+      Profiler_summary(ProfileMeter_phases[i].phase, &summary);
+
+      RichString_appendAscii(out, CRT_colors[METER_TEXT], ProfileMeter_phases[i].label);
+      if (!summary.samples) {
+         RichString_appendAscii(out, CRT_colors[METER_SHADOW], "-");
+         continue;
+      }
+
+      ProfileMeter_appendTime(out, summary.p50);
+      RichString_appendAscii(out, CRT_colors[METER_TEXT], "/");
+      ProfileMeter_appendTime(out, summary.p99);
+   }
+   RichString_appendAscii(out, CRT_colors[METER_SHADOW], " ms p50/p99");
+}
+
+const MeterClass ProfileMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete,
+      .display = ProfileMeter_display,
+   },
+   .init = ProfileMeter_init,
+   .done = ProfileMeter_done,
+   .updateValues = ProfileMeter_updateValues,
+   .defaultMode = TEXT_METERMODE,
+   .supportedModes = (1 << TEXT_METERMODE),
+   .maxItems = 1,
+   .total = 100.0,
+   .attributes = ProfileMeter_attributes,
+   .name = "Profile",
+   .uiName = "htop refresh timing",
+   .caption = "htop: ",
+   .description = "Time htop spends per refresh and per phase (p50/p99 in milliseconds)"
+};
@@ -0,0 +1,167 @@
+/*
+htop - Profiler.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "Profiler.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+
+#include "Macros.h"
+
+
+typedef struct ProfilerPhaseData_ {
+   uint64_t current;                      /* accumulated during the running refresh */
+   bool measured;                         /* whether current holds a measurement */
+   uint64_t samples[PROFILER_SAMPLES];    /* ring buffer of the last refreshes */
+   unsigned int sampleCount;
+   unsigned int next;
+   uint64_t total;
+   uint64_t count;
+   uint64_t max;
+} ProfilerPhaseData;
+
+unsigned int Profiler_users = 0;
+
+static ProfilerPhaseData Profiler_data[PROFILE_PHASES];
+
+unsigned long long int Profiler_counters[PROFILE_COUNTERS];
+
+static const char* const Profiler_phaseNames[PROFILE_PHASES] = {
+   [PROFILE_REFRESH] = "refresh",
+   [PROFILE_MACHINE_SCAN] = "Machine_scan",
+   [PROFILE_TABLE_PREPARE] = "Table_scanPrepare",
+   [PROFILE_TABLE_ITERATE] = "Table_scanIterate",
+   [PROFILE_TABLE_CLEANUP] = "Table_scanCleanup",
+   [PROFILE_HEADER_UPDATE] = "Header_updateData",
+   [PROFILE_REBUILD_PANEL] = "Table_rebuildPanel",
+   [PROFILE_HEADER_DRAW] = "Header_draw",
+   [PROFILE_DRAW_PANELS] = "ScreenManager_drawPanels",
+   [PROFILE_READ_STAT] = "read stat",
+   [PROFILE_READ_STATM] = "read statm",
+   [PROFILE_READ_STATUS] = "read status",
+   [PROFILE_READ_IO] = "read io",
+   [PROFILE_READ_SMAPS] = "read smaps",
+   [PROFILE_READ_CGROUP] = "read cgroup",
+   [PROFILE_READ_CMDLINE] = "read cmdline",
+};
+
+static const char* const Profiler_counterNames[PROFILE_COUNTERS] = {
+   [PROFILE_USER_NAME_HITS] = "user_name_hits",
+   [PROFILE_USER_NAME_MISSES] = "user_name_misses",
+   [PROFILE_USER_NAME_UNRESOLVED] = "user_name_unresolved",
+};
+
+uint64_t Profiler_clock(void) {
+   uint64_t ns;
+
+#if defined(HAVE_CLOCK_GETTIME)
+   struct timespec ts;
+   if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0)
+      return 1;
+   ns = (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+#else
+   struct timeval tv;
+   if (gettimeofday(&tv, NULL) != 0)
+      return 1;
+   ns = (uint64_t)tv.tv_sec * 1000000000 + (uint64_t)tv.tv_usec * 1000;
+#endif
+
+   /* zero means "not measuring" to Profiler_end */
+   return ns ? ns : 1;
+}
+
+void Profiler_add(ProfilerPhase phase, uint64_t ns) {
+   ProfilerPhaseData* data = &Profiler_data[phase];
+   data->current += ns;
+   data->measured = true;
+}
+
+void Profiler_commit(void) {
+   for (size_t i = 0; i < PROFILE_PHASES; i++) {
+      ProfilerPhaseData* data = &Profiler_data[i];
+      if (!data->measured)
+         continue;
+
+      data->samples[data->next] = data->current;
+      data->next = (data->next + 1) % PROFILER_SAMPLES;
+      if (data->sampleCount < PROFILER_SAMPLES)
+         data->sampleCount++;
+
+      data->total += data->current;
+      data->count++;
+      data->max = MAXIMUM(data->max, data->current);
+
+      data->current = 0;
+      data->measured = false;
+   }
+}
+
+const char* Profiler_phaseName(ProfilerPhase phase) {
+   return Profiler_phaseNames[phase];
+}
+
+const char* Profiler_counterName(ProfilerCounter counter) {
+   return Profiler_counterNames[counter];
+}
+
+static int Profiler_compareSamples(const void* a, const void* b) {
+   uint64_t sa = *(const uint64_t*)a;
+   uint64_t sb = *(const uint64_t*)b;
+   return SPACESHIP_NUMBER(sa, sb);
+}
+
+void Profiler_summary(ProfilerPhase phase, ProfilerSummary* summary) {
+   const ProfilerPhaseData* data = &Profiler_data[phase];
+
+   *summary = (ProfilerSummary) {
+      .samples = data->sampleCount,
+      .max = data->max,
+      .mean = data->count ? data->total / data->count : 0,
+      .count = data->count,
+   };
+
+   if (!data->sampleCount)
+      return;
+
+   uint64_t sorted[PROFILER_SAMPLES];
+   memcpy(sorted, data->samples, data->sampleCount * sizeof(*sorted));
+   qsort(sorted, data->sampleCount, sizeof(*sorted), Profiler_compareSamples);
+
+   summary->p50 = sorted[(data->sampleCount - 1) / 2];
+   summary->p99 = sorted[(data->sampleCount - 1) * 99 / 100];
+}
+
+int Profiler_writeStatsFile(const char* fileName) {
+   FILE* fp = fopen(fileName, "w");
+   if (!fp)
+      return -errno;
+
+   fprintf(fp, "# phase,refreshes,p50_us,p99_us,max_us,mean_us\n");
+   for (size_t i = 0; i < PROFILE_PHASES; i++) {
+      ProfilerSummary s;
+      Profiler_summary((ProfilerPhase)i, &s);
+      fprintf(fp, "%s,%" PRIu64 ",%.1f,%.1f,%.1f,%.1f\n",
+              Profiler_phaseName((ProfilerPhase)i), s.count,
+              s.p50 / 1000.0, s.p99 / 1000.0, s.max / 1000.0, s.mean / 1000.0);
+   }
+
+   fprintf(fp, "# counter,value\n");
+   for (size_t i = 0; i < PROFILE_COUNTERS; i++)
+      fprintf(fp, "%s,%llu\n", Profiler_counterName((ProfilerCounter)i), Profiler_counters[i]);
+
+   int r = ferror(fp) ? -EIO : 0;
+   if (fclose(fp) != 0 && r == 0)
+      r = -errno;
+   return r;
+}
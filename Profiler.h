@@ -0,0 +1,100 @@
+#ifndef HEADER_Profiler
+#define HEADER_Profiler
+/*
+htop - Profiler.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/* Number of refreshes the percentiles are computed over */
+#define PROFILER_SAMPLES 128
+
+typedef enum ProfilerPhase_ {
+   PROFILE_REFRESH,          /* whole update, from scanning to drawing */
+   PROFILE_MACHINE_SCAN,
+   PROFILE_TABLE_PREPARE,
+   PROFILE_TABLE_ITERATE,
+   PROFILE_TABLE_CLEANUP,
+   PROFILE_HEADER_UPDATE,
+   PROFILE_REBUILD_PANEL,
+   PROFILE_HEADER_DRAW,
+   PROFILE_DRAW_PANELS,
+   /* totals of reading the per-process files, part of PROFILE_TABLE_ITERATE */
+   PROFILE_READ_STAT,
+   PROFILE_READ_STATM,
+   PROFILE_READ_STATUS,
+   PROFILE_READ_IO,
+   PROFILE_READ_SMAPS,
+   PROFILE_READ_CGROUP,
+   PROFILE_READ_CMDLINE,
+   PROFILE_PHASES
+} ProfilerPhase;
+
+typedef enum ProfilerCounter_ {
+   PROFILE_USER_NAME_HITS,        /* user names found in the table */
+   PROFILE_USER_NAME_MISSES,      /* user names asked of the name service */
+   PROFILE_USER_NAME_UNRESOLVED,  /* uids answered with no name, while looked up or after failing */
+   PROFILE_COUNTERS
+} ProfilerCounter;
+
+typedef struct ProfilerSummary_ {
+   unsigned int samples;     /* refreshes the phase was measured in, at most PROFILER_SAMPLES */
+   uint64_t p50;             /* in nanoseconds, over the last samples */
+   uint64_t p99;
+   uint64_t max;             /* in nanoseconds, over the whole run */
+   uint64_t mean;
+   uint64_t count;           /* refreshes measured over the whole run */
+} ProfilerSummary;
+
+/* Number of users (meters, --stats-file) needing timings; profiling costs nothing while zero */
+extern unsigned int Profiler_users;
+
+static inline void Profiler_enable(void) {
+   Profiler_users++;
+}
+
+static inline void Profiler_disable(void) {
+   if (Profiler_users)
+      Profiler_users--;
+}
+
+/* Totals over the whole run, only counted while profiling */
+extern unsigned long long int Profiler_counters[PROFILE_COUNTERS];
+
+uint64_t Profiler_clock(void);
+
+void Profiler_add(ProfilerPhase phase, uint64_t ns);
+
+/* Returns the start time of a measurement, or 0 if profiling is disabled */
+static inline uint64_t Profiler_begin(void) {
+   return Profiler_users ? Profiler_clock() : 0;
+}
+
+static inline void Profiler_end(ProfilerPhase phase, uint64_t start) {
+   if (start)
+      Profiler_add(phase, Profiler_clock() - start);
+}
+
+static inline void Profiler_count(ProfilerCounter counter) {
+   if (Profiler_users)
+      Profiler_counters[counter]++;
+}
+
+/* Ends a refresh: the time accumulated per phase since the last call becomes one sample */
+void Profiler_commit(void);
+
+const char* Profiler_phaseName(ProfilerPhase phase);
+
+const char* Profiler_counterName(ProfilerCounter counter);
+
+void Profiler_summary(ProfilerPhase phase, ProfilerSummary* summary);
+
+/* Writes the summary of all phases, then the counters; returns 0 or the negated errno */
+int Profiler_writeStatsFile(const char* fileName);
+
+#endif
@@ -0,0 +1,673 @@
+/*
+htop - Recording.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "Recording.h"
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include "CPUMeter.h"
+#include "Machine.h"
+#include "Macros.h"
+#include "Meter.h"
+#include "Platform.h"
+#include "Process.h"
+#include "ProcessTable.h"
+#include "Row.h"
+#include "Table.h"
+#include "XUtils.h"
+
+
+#define RECORDING_FRAME_KEY   'K'
+#define RECORDING_FRAME_DELTA 'D'
+#define RECORDING_FRAME_HEADER_SIZE 5
+
+/* Upper bound for a frame payload; protects the reader against corrupt lengths */
+#define RECORDING_MAX_PAYLOAD (256u * 1024 * 1024)
+
+typedef struct RecordingBuffer_ {
+   uint8_t* data;
+   size_t size;
+   size_t capacity;
+} RecordingBuffer;
+
+struct Recorder_ {
+   FILE* out;
+   FILE* index;
+   Meter* cpuMeter;     /* reads the CPU% of each CPU */
+   unsigned int framesSinceKey;
+   RecordingFrame prev;
+   RecordingFrame cur;
+   RecordingBuffer buffer;
+   const Process** procs;
+   size_t procsCapacity;
+   ssize_t* prevIndex;
+   uint8_t* unchanged;  /* per row, bit set for each string equal to the previous frame's */
+};
+
+struct RecordingReader_ {
+   FILE* in;
+   char* indexFileName;
+   bool havePrev;
+   RecordingFrame prev;
+   RecordingFrame cur;
+   RecordingBuffer buffer;
+   ssize_t* prevIndex;
+   size_t prevIndexCapacity;
+};
+
+static inline uint64_t Recording_zigzag(int64_t v) {
+   return v < 0 ? ~((uint64_t)v << 1) : (uint64_t)v << 1;
+}
+
+static inline int64_t Recording_unzigzag(uint64_t v) {
+   return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+static void RecordingBuffer_reserve(RecordingBuffer* this, size_t extra) {
+   if (this->capacity - this->size >= extra)
+      return;
+
+   this->capacity = MAXIMUM(this->capacity * 2, this->size + extra + 4096);
+   this->data = xRealloc(this->data, this->capacity);
+}
+
+static void RecordingBuffer_putVarint(RecordingBuffer* this, uint64_t v) {
+   RecordingBuffer_reserve(this, 10);
+   while (v >= 0x80) {
+      this->data[this->size++] = (uint8_t)(v | 0x80);
+      v >>= 7;
+   }
+   this->data[this->size++] = (uint8_t)v;
+}
+
+static void RecordingBuffer_putDelta(RecordingBuffer* this, int64_t value, int64_t previous) {
+   RecordingBuffer_putVarint(this, Recording_zigzag((int64_t)((uint64_t)value - (uint64_t)previous)));
+}
+
+static void RecordingBuffer_putBytes(RecordingBuffer* this, const void* data, size_t len) {
+   RecordingBuffer_reserve(this, len);
+   memcpy(this->data + this->size, data, len);
+   this->size += len;
+}
+
+typedef struct RecordingCursor_ {
+   const uint8_t* pos;
+   const uint8_t* end;
+   bool error;
+} RecordingCursor;
+
+static uint64_t RecordingCursor_varint(RecordingCursor* this) {
+   uint64_t v = 0;
+   for (unsigned int shift = 0; shift < 64; shift += 7) {
+      if (this->pos >= this->end)
+         break;
+
+      uint8_t b = *this->pos++;
+      v |= (uint64_t)(b & 0x7f) << shift;
+      if (!(b & 0x80))
+         return v;
+   }
+
+   this->error = true;
+   return 0;
+}
+
+static int64_t RecordingCursor_delta(RecordingCursor* this, int64_t previous) {
+   return (int64_t)((uint64_t)previous + (uint64_t)Recording_unzigzag(RecordingCursor_varint(this)));
+}
+
+static void RecordingFrame_reserve(RecordingFrame* this, size_t rows) {
+   if (rows <= this->rowCapacity)
+      return;
+
+   size_t old = this->rowCapacity;
+   this->rowCapacity = MAXIMUM(rows, old * 2);
+   this->rows = xReallocArray(this->rows, this->rowCapacity, sizeof(RecordingRow));
+   memset(this->rows + old, 0, (this->rowCapacity - old) * sizeof(RecordingRow));
+}
+
+static void RecordingFrame_clearStrings(RecordingFrame* this) {
+   for (size_t i = 0; i < this->rowCount; i++) {
+      for (int s = 0; s < RECORD_ROW_STRINGS; s++) {
+         free(this->rows[i].strings[s]);
+         this->rows[i].strings[s] = NULL;
+      }
+   }
+}
+
+static void RecordingFrame_reserveCPUs(RecordingFrame* this, size_t cpus) {
+   if (cpus <= this->cpuCapacity)
+      return;
+
+   this->cpuCapacity = cpus;
+   this->cpus = xReallocArray(this->cpus, this->cpuCapacity, sizeof(*this->cpus));
+}
+
+static void RecordingFrame_done(RecordingFrame* this) {
+   RecordingFrame_clearStrings(this);
+   free(this->cpus);
+   free(this->rows);
+   memset(this, 0, sizeof(*this));
+}
+
+/* Releases the previous frame's remaining strings and makes the current frame the previous one */
+static void RecordingFrame_swap(RecordingFrame* prev, RecordingFrame* cur) {
+   RecordingFrame_clearStrings(prev);
+
+   RecordingFrame tmp = *prev;
+   *prev = *cur;
+   *cur = tmp;
+   cur->rowCount = 0;
+}
+
+/* For each row of cur, stores the position of the row with the same PID in prev (or -1) */
+static void Recording_matchRows(const RecordingFrame* prev, const RecordingFrame* cur, ssize_t* prevIndex) {
+   size_t j = 0;
+   for (size_t i = 0; i < cur->rowCount; i++) {
+      pid_t pid = cur->rows[i].pid;
+      while (j < prev->rowCount && prev->rows[j].pid < pid)
+         j++;
+      prevIndex[i] = (j < prev->rowCount && prev->rows[j].pid == pid) ? (ssize_t)j : -1;
+   }
+}
+
+static int Recording_compareProcs(const void* a, const void* b) {
+   pid_t pa = Process_getPid(*(const Process* const*)a);
+   pid_t pb = Process_getPid(*(const Process* const*)b);
+   return SPACESHIP_NUMBER(pa, pb);
+}
+
+static void Recording_putU32(uint8_t* p, uint32_t v) {
+   p[0] = v & 0xff;
+   p[1] = (v >> 8) & 0xff;
+   p[2] = (v >> 16) & 0xff;
+   p[3] = v >> 24;
+}
+
+static uint32_t Recording_getU32(const uint8_t* p) {
+   return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static char* Recording_indexFileName(const char* fileName) {
+   return String_cat(fileName, RECORDING_INDEX_SUFFIX);
+}
+
+/* Checks the magic and version a recording starts with */
+static bool Recording_readHeader(FILE* in) {
+   char magic[sizeof(RECORDING_MAGIC)];
+   return fread(magic, 1, sizeof(magic), in) == sizeof(magic) &&
+          memcmp(magic, RECORDING_MAGIC, sizeof(magic) - 1) == 0 &&
+          magic[sizeof(magic) - 1] == RECORDING_VERSION;
+}
+
+Recorder* Recorder_new(const char* fileName) {
+   FILE* out = fopen(fileName, "a+b");
+   if (!out)
+      return NULL;
+
+   /* frames are only appended to a recording of this version */
+   if (fseeko(out, 0, SEEK_END) != 0) {
+      int err = errno;
+      fclose(out);
+      errno = err;
+      return NULL;
+   }
+   if (ftello(out) != 0 && (fseeko(out, 0, SEEK_SET) != 0 || !Recording_readHeader(out))) {
+      fclose(out);
+      errno = EINVAL;
+      return NULL;
+   }
+   if (ftello(out) == 0 && (fputs(RECORDING_MAGIC, out) == EOF || fputc(RECORDING_VERSION, out) == EOF)) {
+      int err = errno;
+      fclose(out);
+      errno = err;
+      return NULL;
+   }
+
+   char* indexFileName = Recording_indexFileName(fileName);
+   FILE* index = fopen(indexFileName, "ab");
+   free(indexFileName);
+   if (!index) {
+      int err = errno;
+      fclose(out);
+      errno = err;
+      return NULL;
+   }
+
+   Recorder* this = xCalloc(1, sizeof(Recorder));
+   this->out = out;
+   this->index = index;
+   return this;
+}
+
+void Recorder_delete(Recorder* this) {
+   if (!this)
+      return;
+
+   fclose(this->out);
+   fclose(this->index);
+   if (this->cpuMeter)
+      Meter_delete((Object*) this->cpuMeter);
+   RecordingFrame_done(&this->prev);
+   RecordingFrame_done(&this->cur);
+   free(this->buffer.data);
+   free(this->procs);
+   free(this->prevIndex);
+   free(this->unchanged);
+   free(this);
+}
+
+/* Returns the bit mask of strings unchanged from the previous frame */
+static uint8_t Recorder_fillRow(RecordingRow* row, const Process* p, RecordingRow* prev) {
+   int64_t* v = row->values;
+
+   row->pid = Process_getPid(p);
+   v[RECORD_PPID] = Process_getParent(p);
+   v[RECORD_TGID] = Process_getThreadGroup(p);
+   v[RECORD_PGRP] = p->pgrp;
+   v[RECORD_SESSION] = p->session;
+   v[RECORD_TTY_NR] = (int64_t)p->tty_nr;
+   v[RECORD_TPGID] = p->tpgid;
+   v[RECORD_UID] = p->st_uid;
+   v[RECORD_PROCESSOR] = p->processor;
+   v[RECORD_PRIORITY] = p->priority;
+   v[RECORD_NICE] = p->nice;
+   v[RECORD_NLWP] = p->nlwp;
+   v[RECORD_STARTTIME] = p->starttime_ctime;
+   v[RECORD_TIME] = (int64_t)p->time;
+   v[RECORD_M_VIRT] = p->m_virt;
+   v[RECORD_M_RESIDENT] = p->m_resident;
+   v[RECORD_MINFLT] = (int64_t)p->minflt;
+   v[RECORD_MAJFLT] = (int64_t)p->majflt;
+   v[RECORD_STATE] = p->state;
+   v[RECORD_PERCENT_CPU] = isNonnegative(p->percent_cpu) ? (int64_t)(p->percent_cpu * 100.0F + 0.5F) : -1;
+   v[RECORD_PERCENT_MEM] = isNonnegative(p->percent_mem) ? (int64_t)(p->percent_mem * 100.0F + 0.5F) : -1;
+   v[RECORD_TASK_FLAGS] = (p->isKernelThread ? RECORD_TASK_KERNEL_THREAD : 0) | (p->isUserlandThread ? RECORD_TASK_USERLAND_THREAD : 0);
+   v[RECORD_BASENAME_START] = (int64_t)p->cmdlineBasenameStart;
+   v[RECORD_BASENAME_END] = (int64_t)p->cmdlineBasenameEnd;
+
+   const char* strings[RECORD_ROW_STRINGS] = {
+      [RECORD_COMM] = p->procComm,
+      [RECORD_CMDLINE] = p->cmdline,
+      [RECORD_EXE] = p->procExe,
+      [RECORD_TTY_NAME] = p->tty_name,
+      [RECORD_USER] = p->user,
+   };
+
+   uint8_t unchanged = 0;
+   for (int s = 0; s < RECORD_ROW_STRINGS; s++) {
+      /* unchanged strings move over from the previous frame instead of being copied */
+      if (prev && String_eq_nullable(prev->strings[s], strings[s])) {
+         row->strings[s] = prev->strings[s];
+         prev->strings[s] = NULL;
+         unchanged |= 1U << s;
+      } else {
+         row->strings[s] = strings[s] ? xStrdup(strings[s]) : NULL;
+      }
+   }
+   return unchanged;
+}
+
+static void Recorder_encode(Recorder* this, bool key) {
+   const RecordingFrame* prev = &this->prev;
+   const RecordingFrame* cur = &this->cur;
+   RecordingBuffer* buf = &this->buffer;
+
+   RecordingBuffer_putDelta(buf, (int64_t)cur->timestampMs, key ? 0 : (int64_t)prev->timestampMs);
+   for (int m = 0; m < RECORD_MACHINE_VALUES; m++)
+      RecordingBuffer_putDelta(buf, cur->machine[m], key ? 0 : prev->machine[m]);
+
+   RecordingBuffer_putVarint(buf, cur->cpuCount);
+   for (size_t i = 0; i < cur->cpuCount; i++)
+      RecordingBuffer_putDelta(buf, cur->cpus[i], !key && i < prev->cpuCount ? prev->cpus[i] : 0);
+
+   RecordingBuffer_putVarint(buf, cur->rowCount);
+   pid_t lastPid = 0;
+   for (size_t i = 0; i < cur->rowCount; i++) {
+      RecordingBuffer_putDelta(buf, cur->rows[i].pid, lastPid);
+      lastPid = cur->rows[i].pid;
+   }
+
+   for (int f = 0; f < RECORD_ROW_VALUES; f++) {
+      for (size_t i = 0; i < cur->rowCount; i++) {
+         ssize_t j = key ? -1 : this->prevIndex[i];
+         RecordingBuffer_putDelta(buf, cur->rows[i].values[f], j >= 0 ? prev->rows[j].values[f] : 0);
+      }
+   }
+
+   for (int s = 0; s < RECORD_ROW_STRINGS; s++) {
+      for (size_t i = 0; i < cur->rowCount; i++) {
+         const char* str = cur->rows[i].strings[s];
+
+         if (!key && (this->unchanged[i] & (1U << s))) {
+            RecordingBuffer_putVarint(buf, 0);
+            continue;
+         }
+
+         if (!str) {
+            RecordingBuffer_putVarint(buf, 1);
+            continue;
+         }
+
+         size_t len = strlen(str);
+         RecordingBuffer_putVarint(buf, (uint64_t)len + 2);
+         RecordingBuffer_putBytes(buf, str, len);
+      }
+   }
+}
+
+/* A non-negative value in hundredths, -1 for values unknown */
+static int64_t Recording_hundredths(double value) {
+   return isNonnegative(value) ? (int64_t)(value * 100.0 + 0.5) : -1;
+}
+
+bool Recorder_writeFrame(Recorder* this, const Machine* host, const ProcessTable* pt) {
+   const Table* table = &pt->super;
+
+   /* collect the processes alive in this update, sorted by PID */
+   size_t count = 0;
+   const int size = Vector_size(table->rows);
+   if ((size_t)size > this->procsCapacity) {
+      this->procsCapacity = (size_t)size;
+      this->procs = xReallocArray(this->procs, this->procsCapacity, sizeof(*this->procs));
+      this->prevIndex = xReallocArray(this->prevIndex, this->procsCapacity, sizeof(*this->prevIndex));
+      this->unchanged = xReallocArray(this->unchanged, this->procsCapacity, sizeof(*this->unchanged));
+   }
+   for (int i = 0; i < size; i++) {
+      const Process* p = (const Process*) Vector_get(table->rows, i);
+      if (p->super.updated && !p->super.isAggregate)
+         this->procs[count++] = p;
+   }
+   qsort(this->procs, count, sizeof(*this->procs), Recording_compareProcs);
+
+   RecordingFrame* cur = &this->cur;
+   cur->timestampMs = host->realtimeMs;
+   cur->machine[RECORD_TOTAL_MEM] = (int64_t)host->totalMem;
+   cur->machine[RECORD_USED_MEM] = (int64_t)host->usedMem;
+   cur->machine[RECORD_BUFFERS_MEM] = (int64_t)host->buffersMem;
+   cur->machine[RECORD_CACHED_MEM] = (int64_t)host->cachedMem;
+   cur->machine[RECORD_SHARED_MEM] = (int64_t)host->sharedMem;
+   cur->machine[RECORD_AVAILABLE_MEM] = (int64_t)host->availableMem;
+   cur->machine[RECORD_TOTAL_SWAP] = (int64_t)host->totalSwap;
+   cur->machine[RECORD_USED_SWAP] = (int64_t)host->usedSwap;
+   cur->machine[RECORD_CACHED_SWAP] = (int64_t)host->cachedSwap;
+   cur->machine[RECORD_TOTAL_TASKS] = pt->totalTasks;
+   cur->machine[RECORD_RUNNING_TASKS] = pt->runningTasks;
+   cur->machine[RECORD_USERLAND_THREADS] = pt->userlandThreads;
+   cur->machine[RECORD_KERNEL_THREADS] = pt->kernelThreads;
+
+   double load1, load5, load15;
+   Platform_getLoadAverage(&load1, &load5, &load15);
+   cur->machine[RECORD_LOAD_AVERAGE_1] = Recording_hundredths(load1);
+   cur->machine[RECORD_LOAD_AVERAGE_5] = Recording_hundredths(load5);
+   cur->machine[RECORD_LOAD_AVERAGE_15] = Recording_hundredths(load15);
+   int uptime = Platform_getUptime();
+   cur->machine[RECORD_UPTIME] = uptime > 0 ? uptime : -1;
+
+   if (!this->cpuMeter)
+      this->cpuMeter = Meter_new(host, 0, &CPUMeter_class);
+   cur->cpuCount = (size_t)host->existingCPUs + 1;
+   RecordingFrame_reserveCPUs(cur, cur->cpuCount);
+   for (size_t i = 0; i < cur->cpuCount; i++)
+      cur->cpus[i] = Recording_hundredths(Platform_setCPUValues(this->cpuMeter, (unsigned int)i));
+
+   RecordingFrame_reserve(cur, count);
+   cur->rowCount = count;
+   for (size_t i = 0; i < count; i++)
+      cur->rows[i].pid = Process_getPid(this->procs[i]);
+   Recording_matchRows(&this->prev, cur, this->prevIndex);
+
+   for (size_t i = 0; i < count; i++) {
+      RecordingRow* prevRow = this->prevIndex[i] >= 0 ? &this->prev.rows[this->prevIndex[i]] : NULL;
+      this->unchanged[i] = Recorder_fillRow(&cur->rows[i], this->procs[i], prevRow);
+   }
+
+   bool key = this->framesSinceKey == 0;
+
+   this->buffer.size = 0;
+   RecordingBuffer_putBytes(&this->buffer, "\0\0\0\0\0", RECORDING_FRAME_HEADER_SIZE);
+   Recorder_encode(this, key);
+   this->buffer.data[0] = key ? RECORDING_FRAME_KEY : RECORDING_FRAME_DELTA;
+   Recording_putU32(this->buffer.data + 1, (uint32_t)(this->buffer.size - RECORDING_FRAME_HEADER_SIZE));
+
+   off_t offset = ftello(this->out);
+   bool ok = offset >= 0 &&
+             fwrite(this->buffer.data, 1, this->buffer.size, this->out) == this->buffer.size &&
+             fflush(this->out) == 0;
+
+   if (ok && key) {
+      uint8_t entry[16];
+      Recording_putU32(entry, (uint32_t)(cur->timestampMs & 0xffffffff));
+      Recording_putU32(entry + 4, (uint32_t)(cur->timestampMs >> 32));
+      Recording_putU32(entry + 8, (uint32_t)((uint64_t)offset & 0xffffffff));
+      Recording_putU32(entry + 12, (uint32_t)((uint64_t)offset >> 32));
+      ok = fwrite(entry, 1, sizeof(entry), this->index) == sizeof(entry) && fflush(this->index) == 0;
+   }
+
+   this->framesSinceKey = (this->framesSinceKey + 1) % RECORDING_KEYFRAME_INTERVAL;
+
+   RecordingFrame_swap(&this->prev, &this->cur);
+   return ok;
+}
+
+RecordingReader* RecordingReader_new(const char* fileName) {
+   FILE* in = fopen(fileName, "rb");
+   if (!in)
+      return NULL;
+
+   if (!Recording_readHeader(in)) {
+      fclose(in);
+      errno = EINVAL;
+      return NULL;
+   }
+
+   RecordingReader* this = xCalloc(1, sizeof(RecordingReader));
+   this->in = in;
+   this->indexFileName = Recording_indexFileName(fileName);
+   return this;
+}
+
+void RecordingReader_delete(RecordingReader* this) {
+   if (!this)
+      return;
+
+   fclose(this->in);
+   free(this->indexFileName);
+   RecordingFrame_done(&this->prev);
+   RecordingFrame_done(&this->cur);
+   free(this->buffer.data);
+   free(this->prevIndex);
+   free(this);
+}
+
+/* Reads the next frame's payload into the buffer; on a partially written frame rewinds to its start */
+static bool RecordingReader_readPayload(RecordingReader* this, int* type) {
+   off_t start = ftello(this->in);
+   uint8_t header[RECORDING_FRAME_HEADER_SIZE];
+
+   clearerr(this->in);
+   if (fread(header, 1, sizeof(header), this->in) != sizeof(header))
+      goto incomplete;
+
+   uint32_t len = Recording_getU32(header + 1);
+   if ((header[0] != RECORDING_FRAME_KEY && header[0] != RECORDING_FRAME_DELTA) || len > RECORDING_MAX_PAYLOAD)
+      return false;
+
+   this->buffer.size = 0;
+   RecordingBuffer_reserve(&this->buffer, len);
+   if (fread(this->buffer.data, 1, len, this->in) != len)
+      goto incomplete;
+
+   this->buffer.size = len;
+   *type = header[0];
+   return true;
+
+incomplete:
+   if (start >= 0)
+      fseeko(this->in, start, SEEK_SET);
+   return false;
+}
+
+static bool RecordingReader_decode(RecordingReader* this, bool key) {
+   const RecordingFrame* prev = &this->prev;
+   RecordingFrame* cur = &this->cur;
+   RecordingCursor c = { .pos = this->buffer.data, .end = this->buffer.data + this->buffer.size, .error = false };
+
+   cur->timestampMs = (uint64_t)RecordingCursor_delta(&c, key ? 0 : (int64_t)prev->timestampMs);
+   for (int m = 0; m < RECORD_MACHINE_VALUES; m++)
+      cur->machine[m] = RecordingCursor_delta(&c, key ? 0 : prev->machine[m]);
+
+   uint64_t cpus = RecordingCursor_varint(&c);
+   if (c.error || cpus > (uint64_t)(c.end - c.pos))
+      return false;
+
+   RecordingFrame_reserveCPUs(cur, (size_t)cpus);
+   cur->cpuCount = (size_t)cpus;
+   for (size_t i = 0; i < cur->cpuCount; i++)
+      cur->cpus[i] = RecordingCursor_delta(&c, !key && i < prev->cpuCount ? prev->cpus[i] : 0);
+
+   uint64_t count = RecordingCursor_varint(&c);
+   /* every row takes at least one byte per column */
+   if (c.error || count > (uint64_t)(c.end - c.pos))
+      return false;
+
+   RecordingFrame_reserve(cur, (size_t)count);
+   if (count > this->prevIndexCapacity) {
+      this->prevIndexCapacity = (size_t)count;
+      this->prevIndex = xReallocArray(this->prevIndex, this->prevIndexCapacity, sizeof(*this->prevIndex));
+   }
+   cur->rowCount = (size_t)count;
+
+   pid_t lastPid = 0;
+   for (size_t i = 0; i < cur->rowCount; i++) {
+      cur->rows[i].pid = (pid_t)RecordingCursor_delta(&c, lastPid);
+      lastPid = cur->rows[i].pid;
+   }
+
+   if (key) {
+      for (size_t i = 0; i < cur->rowCount; i++)
+         this->prevIndex[i] = -1;
+   } else {
+      Recording_matchRows(prev, cur, this->prevIndex);
+   }
+
+   for (int f = 0; f < RECORD_ROW_VALUES; f++) {
+      for (size_t i = 0; i < cur->rowCount; i++) {
+         ssize_t j = this->prevIndex[i];
+         cur->rows[i].values[f] = RecordingCursor_delta(&c, j >= 0 ? prev->rows[j].values[f] : 0);
+      }
+   }
+
+   for (int s = 0; s < RECORD_ROW_STRINGS; s++) {
+      for (size_t i = 0; i < cur->rowCount; i++) {
+         ssize_t j = this->prevIndex[i];
+         uint64_t len = RecordingCursor_varint(&c);
+         char** str = &cur->rows[i].strings[s];
+
+         if (len == 0 && j >= 0) {
+            *str = this->prev.rows[j].strings[s];
+            this->prev.rows[j].strings[s] = NULL;
+         } else if (len <= 1) {
+            *str = NULL;
+         } else {
+            len -= 2;
+            if (len > (uint64_t)(c.end - c.pos)) {
+               c.error = true;
+               *str = NULL;
+               continue;
+            }
+            *str = xStrndup((const char*)c.pos, (size_t)len);
+            c.pos += len;
+         }
+      }
+   }
+
+   return !c.error;
+}
+
+const RecordingFrame* RecordingReader_next(RecordingReader* this) {
+   int type;
+   while (RecordingReader_readPayload(this, &type)) {
+      bool key = type == RECORDING_FRAME_KEY;
+
+      /* delta frames can not be decoded before the next keyframe */
+      if (!key && !this->havePrev)
+         continue;
+
+      if (!RecordingReader_decode(this, key)) {
+         RecordingFrame_clearStrings(&this->cur);
+         this->cur.rowCount = 0;
+         this->havePrev = false;
+         continue;
+      }
+
+      RecordingFrame_swap(&this->prev, &this->cur);
+      this->havePrev = true;
+      return &this->prev;
+   }
+
+   return NULL;
+}
+
+/* Returns the timestamp of the next frame without consuming it */
+static bool RecordingReader_peekTimestamp(RecordingReader* this, uint64_t* timestampMs) {
+   off_t start = ftello(this->in);
+   int type;
+   if (start < 0 || !RecordingReader_readPayload(this, &type))
+      return false;
+
+   fseeko(this->in, start, SEEK_SET);
+
+   bool key = type == RECORDING_FRAME_KEY;
+   if (!key && !this->havePrev)
+      return false;
+
+   RecordingCursor c = { .pos = this->buffer.data, .end = this->buffer.data + this->buffer.size, .error = false };
+   *timestampMs = (uint64_t)RecordingCursor_delta(&c, key ? 0 : (int64_t)this->prev.timestampMs);
+   return !c.error;
+}
+
+bool RecordingReader_seek(RecordingReader* this, uint64_t timestampMs) {
+   off_t offset = (off_t)sizeof(RECORDING_MAGIC);
+
+   /* start decoding at the last keyframe recorded before the requested time */
+   FILE* index = fopen(this->indexFileName, "rb");
+   if (index) {
+      uint8_t entry[16];
+      while (fread(entry, 1, sizeof(entry), index) == sizeof(entry)) {
+         uint64_t ts = Recording_getU32(entry) | ((uint64_t)Recording_getU32(entry + 4) << 32);
+         uint64_t off = Recording_getU32(entry + 8) | ((uint64_t)Recording_getU32(entry + 12) << 32);
+         if (ts > timestampMs)
+            break;
+         offset = (off_t)off;
+      }
+      fclose(index);
+   }
+
+   if (fseeko(this->in, offset, SEEK_SET) != 0)
+      return false;
+
+   RecordingFrame_clearStrings(&this->prev);
+   this->prev.rowCount = 0;
+   this->havePrev = false;
+
+   uint64_t ts;
+   while (RecordingReader_peekTimestamp(this, &ts) && ts < timestampMs) {
+      if (!RecordingReader_next(this))
+         return false;
+   }
+
+   return true;
+}
@@ -0,0 +1,142 @@
+#ifndef HEADER_Recording
+#define HEADER_Recording
+/*
+htop - Recording.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "Machine.h"
+#include "ProcessTable.h"
+
+
+/*
+ * A recording starts with the magic RECORDING_MAGIC and the version byte,
+ * followed by frames appended one per update. Each frame consists of its
+ * type byte ('K' for keyframes, 'D' for delta frames), the little-endian
+ * 32 bit length of its payload and the payload, made up of LEB128 varints:
+ *
+ * - timestamp in milliseconds
+ * - machine values (RecordingMachineValue)
+ * - CPU count, followed by the CPU% of each in hundredths, the average
+ *   of all first, -1 for CPUs offline
+ * - row count, followed by the row columns: PIDs (delta to the previous
+ *   row), each RecordingRowValue for all rows, then each RecordingRowString
+ *   for all rows (0 if unchanged, else length + 1 followed by the bytes)
+ *
+ * Numbers are zigzag encoded differences to the previous frame (to the same
+ * PID for row values, to the same CPU for CPU%), or to zero in keyframes. Every keyframe's timestamp
+ * and file offset is appended to the index file named like the recording
+ * with the suffix RECORDING_INDEX_SUFFIX, so replay can seek by time.
+ */
+#define RECORDING_MAGIC "HTOPREC"
+#define RECORDING_VERSION 2
+#define RECORDING_INDEX_SUFFIX ".idx"
+#define RECORDING_KEYFRAME_INTERVAL 64
+
+typedef enum RecordingMachineValue_ {
+   RECORD_TOTAL_MEM,
+   RECORD_USED_MEM,
+   RECORD_BUFFERS_MEM,
+   RECORD_CACHED_MEM,
+   RECORD_SHARED_MEM,
+   RECORD_AVAILABLE_MEM,
+   RECORD_TOTAL_SWAP,
+   RECORD_USED_SWAP,
+   RECORD_CACHED_SWAP,
+   RECORD_TOTAL_TASKS,
+   RECORD_RUNNING_TASKS,
+   RECORD_USERLAND_THREADS,
+   RECORD_KERNEL_THREADS,
+   RECORD_LOAD_AVERAGE_1,  /* in hundredths */
+   RECORD_LOAD_AVERAGE_5,
+   RECORD_LOAD_AVERAGE_15,
+   RECORD_UPTIME,          /* in seconds, -1 if unknown */
+   RECORD_MACHINE_VALUES
+} RecordingMachineValue;
+
+typedef enum RecordingRowValue_ {
+   RECORD_PPID,
+   RECORD_TGID,
+   RECORD_PGRP,
+   RECORD_SESSION,
+   RECORD_TTY_NR,
+   RECORD_TPGID,
+   RECORD_UID,
+   RECORD_PROCESSOR,
+   RECORD_PRIORITY,
+   RECORD_NICE,
+   RECORD_NLWP,
+   RECORD_STARTTIME,
+   RECORD_TIME,
+   RECORD_M_VIRT,
+   RECORD_M_RESIDENT,
+   RECORD_MINFLT,
+   RECORD_MAJFLT,
+   RECORD_STATE,
+   RECORD_PERCENT_CPU,     /* in hundredths of a percent */
+   RECORD_PERCENT_MEM,     /* in hundredths of a percent */
+   RECORD_TASK_FLAGS,      /* RECORD_TASK_* */
+   RECORD_BASENAME_START,
+   RECORD_BASENAME_END,
+   RECORD_ROW_VALUES
+} RecordingRowValue;
+
+typedef enum RecordingRowString_ {
+   RECORD_COMM,
+   RECORD_CMDLINE,
+   RECORD_EXE,
+   RECORD_TTY_NAME,
+   RECORD_USER,
+   RECORD_ROW_STRINGS
+} RecordingRowString;
+
+#define RECORD_TASK_KERNEL_THREAD    0x01
+#define RECORD_TASK_USERLAND_THREAD  0x02
+
+typedef struct RecordingRow_ {
+   pid_t pid;
+   int64_t values[RECORD_ROW_VALUES];
+   char* strings[RECORD_ROW_STRINGS];
+} RecordingRow;
+
+typedef struct RecordingFrame_ {
+   uint64_t timestampMs;
+   int64_t machine[RECORD_MACHINE_VALUES];
+   size_t cpuCount;
+   size_t cpuCapacity;
+   int64_t* cpus;       /* CPU% in hundredths, the average first */
+   size_t rowCount;
+   size_t rowCapacity;
+   RecordingRow* rows;  /* sorted by PID */
+} RecordingFrame;
+
+typedef struct Recorder_ Recorder;
+
+/* Opens fileName for appending frames; returns NULL and sets errno on failure, EINVAL for a file of another format */
+Recorder* Recorder_new(const char* fileName);
+
+void Recorder_delete(Recorder* this);
+
+bool Recorder_writeFrame(Recorder* this, const Machine* host, const ProcessTable* pt);
+
+typedef struct RecordingReader_ RecordingReader;
+
+/* Opens a recording; returns NULL and sets errno on failure */
+RecordingReader* RecordingReader_new(const char* fileName);
+
+void RecordingReader_delete(RecordingReader* this);
+
+/* Positions the reader so the next frame returned is the first one recorded at or after timestampMs */
+bool RecordingReader_seek(RecordingReader* this, uint64_t timestampMs);
+
+/* Returns the next frame, or NULL at the (current) end of the recording */
+const RecordingFrame* RecordingReader_next(RecordingReader* this);
+
+#endif
@@ -0,0 +1,319 @@
+/*
+htop - ReplayProcessTable.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "ReplayProcessTable.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Action.h"
+#include "Header.h"
+#include "Machine.h"
+#include "Macros.h"
+#include "Object.h"
+#include "Process.h"
+#include "Recording.h"
+#include "RichString.h"
+#include "Row.h"
+#include "RowField.h"
+#include "Table.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+
+typedef struct ReplayProcess_ {
+   Process super;
+   char* user;   /* owned copy of the recorded user name */
+} ReplayProcess;
+
+/* Columns computed from the fields a recording contains */
+static const RowField ReplayProcessTable_fields[] = {
+   PID, COMM, STATE, PPID, PGRP, SESSION, TTY, TPGID, MINFLT, MAJFLT,
+   PRIORITY, NICE, STARTTIME, ELAPSED, PROCESSOR, M_VIRT, M_RESIDENT,
+   ST_UID, PERCENT_CPU, PERCENT_NORM_CPU, PERCENT_MEM, USER, TIME, NLWP,
+   TGID, PROC_COMM, PROC_EXE,
+};
+
+static void ReplayProcess_delete(Object* cast) {
+   ReplayProcess* this = (ReplayProcess*) cast;
+   Process_done(&this->super);
+   free(this->user);
+   free(this);
+}
+
+static void ReplayProcess_rowWriteField(const Row* super, RichString* str, RowField field) {
+   Process_writeField((const Process*) super, str, field);
+}
+
+static const ProcessClass ReplayProcess_class = {
+   .super = {
+      .super = {
+         .extends = Class(Process),
+         .display = Row_display,
+         .delete = ReplayProcess_delete,
+         .compare = Process_compare
+      },
+      .isHighlighted = Process_rowIsHighlighted,
+      .isVisible = Process_rowIsVisible,
+      .matchesFilter = Process_rowMatchesFilter,
+      .compareByParent = Process_compareByParent,
+      .sortKeyString = Process_rowGetSortKey,
+      .writeField = ReplayProcess_rowWriteField
+   },
+};
+
+static Process* ReplayProcess_new(const Machine* host) {
+   ReplayProcess* this = xCalloc(1, sizeof(ReplayProcess));
+   Object_setClass(this, Class(ReplayProcess));
+   Process_init(&this->super, host);
+   return &this->super;
+}
+
+ProcessTable* ReplayProcessTable_new(Machine* host, Hashtable* pidMatchList, RecordingReader* reader) {
+   ReplayProcessTable* this = xCalloc(1, sizeof(ReplayProcessTable));
+   Object_setClass(this, Class(ReplayProcessTable));
+
+   ProcessTable* super = &this->super;
+   ProcessTable_init(super, Class(ReplayProcess), host, pidMatchList);
+
+   this->reader = reader;
+   return super;
+}
+
+void ReplayProcessTable_delete(Object* cast) {
+   ReplayProcessTable* this = (ReplayProcessTable*) cast;
+   Machine* host = this->super.super.host;
+   if (host->replay == &this->meters)
+      host->replay = NULL;
+   ProcessTable_done(&this->super);
+   RecordingReader_delete(this->reader);
+   free(this->cpuPercent);
+   free(this);
+}
+
+static bool ReplayProcessTable_isReplayField(RowField field) {
+   for (size_t i = 0; i < ARRAYSIZE(ReplayProcessTable_fields); i++) {
+      if (ReplayProcessTable_fields[i] == field)
+         return true;
+   }
+   return false;
+}
+
+void ReplayProcessTable_restrictFields(Settings* settings) {
+   for (unsigned int i = 0; i < settings->nScreens; i++) {
+      ScreenSettings* ss = settings->screens[i];
+      if (ss->dynamic)
+         continue;
+
+      size_t n = 0;
+      for (size_t j = 0; ss->fields[j]; j++) {
+         if (ReplayProcessTable_isReplayField(ss->fields[j]))
+            ss->fields[n++] = ss->fields[j];
+      }
+      if (n == 0)
+         ss->fields[n++] = PID;
+      ss->fields[n] = 0;
+
+      /* nothing is scanned, so no column needs extra data */
+      ss->flags = 0;
+
+      if (!ReplayProcessTable_isReplayField(ss->sortKey))
+         ss->sortKey = PID;
+      if (!ReplayProcessTable_isReplayField(ss->treeSortKey))
+         ss->treeSortKey = PID;
+   }
+}
+
+static void ReplayProcessTable_applyMachine(ReplayProcessTable* this) {
+   ProcessTable* pt = &this->super;
+   Machine* host = pt->super.host;
+   const int64_t* m = this->machine;
+
+   host->totalMem = (memory_t)m[RECORD_TOTAL_MEM];
+   host->usedMem = (memory_t)m[RECORD_USED_MEM];
+   host->buffersMem = (memory_t)m[RECORD_BUFFERS_MEM];
+   host->cachedMem = (memory_t)m[RECORD_CACHED_MEM];
+   host->sharedMem = (memory_t)m[RECORD_SHARED_MEM];
+   host->availableMem = (memory_t)m[RECORD_AVAILABLE_MEM];
+   host->totalSwap = (memory_t)m[RECORD_TOTAL_SWAP];
+   host->usedSwap = (memory_t)m[RECORD_USED_SWAP];
+   host->cachedSwap = (memory_t)m[RECORD_CACHED_SWAP];
+
+   pt->totalTasks = (unsigned int)m[RECORD_TOTAL_TASKS];
+   pt->runningTasks = (unsigned int)m[RECORD_RUNNING_TASKS];
+   pt->userlandThreads = (unsigned int)m[RECORD_USERLAND_THREADS];
+   pt->kernelThreads = (unsigned int)m[RECORD_KERNEL_THREADS];
+
+   MachineReplay* meters = &this->meters;
+   meters->loadAverage[0] = m[RECORD_LOAD_AVERAGE_1] >= 0 ? (double)m[RECORD_LOAD_AVERAGE_1] / 100.0 : NAN;
+   meters->loadAverage[1] = m[RECORD_LOAD_AVERAGE_5] >= 0 ? (double)m[RECORD_LOAD_AVERAGE_5] / 100.0 : NAN;
+   meters->loadAverage[2] = m[RECORD_LOAD_AVERAGE_15] >= 0 ? (double)m[RECORD_LOAD_AVERAGE_15] / 100.0 : NAN;
+   meters->uptime = m[RECORD_UPTIME] >= 0 && m[RECORD_UPTIME] <= INT_MAX ? (int)m[RECORD_UPTIME] : -1;
+   meters->cpuCount = (unsigned int)this->cpuCount;
+   meters->cpuPercent = this->cpuPercent;
+   host->replay = meters;
+
+   host->realtimeMs = this->timestampMs;
+   host->realtime.tv_sec = (time_t)(this->timestampMs / 1000);
+   host->realtime.tv_usec = (suseconds_t)(this->timestampMs % 1000) * 1000;
+}
+
+static void ReplayProcessTable_applyRow(ReplayProcessTable* this, const RecordingRow* row) {
+   ProcessTable* pt = &this->super;
+   const Settings* settings = pt->super.host->settings;
+   const int64_t* v = row->values;
+
+   bool preExisting;
+   Process* proc = ProcessTable_getProcess(pt, row->pid, &preExisting, ReplayProcess_new);
+   ReplayProcess* rp = (ReplayProcess*) proc;
+
+   Process_setParent(proc, (pid_t)v[RECORD_PPID]);
+   Process_setThreadGroup(proc, (pid_t)v[RECORD_TGID]);
+   proc->pgrp = (int)v[RECORD_PGRP];
+   proc->session = (int)v[RECORD_SESSION];
+   proc->tty_nr = (unsigned long int)v[RECORD_TTY_NR];
+   proc->tpgid = (int)v[RECORD_TPGID];
+   proc->st_uid = (uid_t)v[RECORD_UID];
+   proc->processor = (int)v[RECORD_PROCESSOR];
+   proc->priority = (long int)v[RECORD_PRIORITY];
+   proc->nice = (long int)v[RECORD_NICE];
+   proc->nlwp = (long int)v[RECORD_NLWP];
+   proc->starttime_ctime = (time_t)v[RECORD_STARTTIME];
+   proc->time = (unsigned long long int)v[RECORD_TIME];
+   proc->m_virt = (long)v[RECORD_M_VIRT];
+   proc->m_resident = (long)v[RECORD_M_RESIDENT];
+   proc->minflt = (unsigned long int)v[RECORD_MINFLT];
+   proc->majflt = (unsigned long int)v[RECORD_MAJFLT];
+   proc->state = (v[RECORD_STATE] >= UNKNOWN && v[RECORD_STATE] <= SLEEPING) ? (ProcessState)v[RECORD_STATE] : UNKNOWN;
+   proc->percent_cpu = v[RECORD_PERCENT_CPU] >= 0 ? (float)v[RECORD_PERCENT_CPU] / 100.0F : NAN;
+   proc->percent_mem = v[RECORD_PERCENT_MEM] >= 0 ? (float)v[RECORD_PERCENT_MEM] / 100.0F : NAN;
+   proc->isKernelThread = v[RECORD_TASK_FLAGS] & RECORD_TASK_KERNEL_THREAD;
+   proc->isUserlandThread = v[RECORD_TASK_FLAGS] & RECORD_TASK_USERLAND_THREAD;
+
+   /* only pass basenames that fit the recorded command line */
+   const char* cmdline = row->strings[RECORD_CMDLINE];
+   size_t len = cmdline ? strlen(cmdline) : 0;
+   if (cmdline && len == 0)
+      cmdline = NULL;
+   size_t basenameStart = (size_t)v[RECORD_BASENAME_START];
+   size_t basenameEnd = (size_t)v[RECORD_BASENAME_END];
+   if (!cmdline || v[RECORD_BASENAME_START] < 0 || v[RECORD_BASENAME_END] < 0 || basenameStart >= len || basenameEnd > len || basenameEnd <= basenameStart) {
+      basenameStart = 0;
+      basenameEnd = cmdline ? len : 0;
+   }
+
+   Process_updateComm(proc, row->strings[RECORD_COMM]);
+   Process_updateCmdline(proc, cmdline, basenameStart, basenameEnd);
+   Process_updateExe(proc, row->strings[RECORD_EXE]);
+
+   if (!String_eq_nullable(proc->tty_name, row->strings[RECORD_TTY_NAME])) {
+      free(proc->tty_name);
+      proc->tty_name = row->strings[RECORD_TTY_NAME] ? xStrdup(row->strings[RECORD_TTY_NAME]) : NULL;
+   }
+
+   if (!String_eq_nullable(rp->user, row->strings[RECORD_USER])) {
+      free(rp->user);
+      rp->user = row->strings[RECORD_USER] ? xStrdup(row->strings[RECORD_USER]) : NULL;
+   }
+   proc->user = rp->user;
+
+   Process_fillStarttimeBuffer(proc);
+   Process_updateCPUFieldWidths(proc->percent_cpu);
+
+   proc->super.show = !((settings->hideKernelThreads && Process_isKernelThread(proc)) ||
+                        (settings->hideUserlandThreads && Process_isUserlandThread(proc)));
+   proc->super.updated = true;
+
+   if (!preExisting)
+      ProcessTable_add(pt, proc);
+}
+
+static void ReplayProcessTable_iterateEntries(Table* super) {
+   ReplayProcessTable* this = (ReplayProcessTable*) super;
+
+   const RecordingFrame* frame = RecordingReader_next(this->reader);
+   this->ended = !frame;
+   if (!frame) {
+      /* end of the recording (so far): keep showing the last frame */
+      for (int i = 0; i < Vector_size(super->rows); i++) {
+         Row* row = (Row*) Vector_get(super->rows, i);
+         row->updated = true;
+         row->show = row->wasShown;
+      }
+
+      if (this->haveFrame)
+         ReplayProcessTable_applyMachine(this);
+      return;
+   }
+
+   this->haveFrame = true;
+   this->timestampMs = frame->timestampMs;
+   memcpy(this->machine, frame->machine, sizeof(this->machine));
+
+   if (frame->cpuCount > this->cpuCapacity) {
+      this->cpuCapacity = frame->cpuCount;
+      this->cpuPercent = xReallocArray(this->cpuPercent, this->cpuCapacity, sizeof(*this->cpuPercent));
+   }
+   this->cpuCount = frame->cpuCount;
+   for (size_t i = 0; i < frame->cpuCount; i++)
+      this->cpuPercent[i] = frame->cpus[i] >= 0 ? (double)frame->cpus[i] / 100.0 : NAN;
+
+   ReplayProcessTable_applyMachine(this);
+
+   for (size_t i = 0; i < frame->rowCount; i++)
+      ReplayProcessTable_applyRow(this, &frame->rows[i]);
+}
+
+/* Time the replay moves back or forth by at a key press */
+#define REPLAY_SKIP_MS (60 * 1000)
+
+static Htop_Reaction ReplayProcessTable_skip(State* st, int64_t ms) {
+   ReplayProcessTable* this = (ReplayProcessTable*) st->host->processTable;
+   if (!this->haveFrame)
+      return HTOP_OK;
+
+   uint64_t timestampMs = ms < 0 && this->timestampMs < (uint64_t)-ms ? 0 : (uint64_t)((int64_t)this->timestampMs + ms);
+   if (!RecordingReader_seek(this->reader, timestampMs))
+      return HTOP_OK;
+
+   /* shows the frame sought at once, even with updates paused */
+   st->host->activeTable->needsSort = true;
+   Machine_scanTables(st->host);
+   Header_updateData(st->header);
+
+   return HTOP_REFRESH | HTOP_REDRAW_BAR | HTOP_KEEP_FOLLOWING;
+}
+
+static Htop_Reaction ReplayProcessTable_actionRewind(State* st) {
+   return ReplayProcessTable_skip(st, -REPLAY_SKIP_MS);
+}
+
+static Htop_Reaction ReplayProcessTable_actionForward(State* st) {
+   return ReplayProcessTable_skip(st, REPLAY_SKIP_MS);
+}
+
+void ReplayProcessTable_setBindings(Htop_Action* keys) {
+   keys['['] = ReplayProcessTable_actionRewind;
+   keys[']'] = ReplayProcessTable_actionForward;
+}
+
+const TableClass ReplayProcessTable_class = {
+   .super = {
+      .extends = Class(ProcessTable),
+      .delete = ReplayProcessTable_delete,
+   },
+   .prepare = ProcessTable_prepareEntries,
+   .iterate = ReplayProcessTable_iterateEntries,
+   .cleanup = ProcessTable_cleanupEntries,
+   .prepareVisible = ProcessTable_prepareVisible,
+};
@@ -0,0 +1,48 @@
+#ifndef HEADER_ReplayProcessTable
+#define HEADER_ReplayProcessTable
+/*
+htop - ReplayProcessTable.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "Action.h"
+#include "Hashtable.h"
+#include "Machine.h"
+#include "ProcessTable.h"
+#include "Recording.h"
+#include "Settings.h"
+
+
+typedef struct ReplayProcessTable_ {
+   ProcessTable super;
+
+   RecordingReader* reader;
+   bool haveFrame;                                 /* whether a frame was replayed yet */
+   bool ended;                                     /* whether the last update found no frame left */
+   uint64_t timestampMs;                           /* time the last frame replayed was recorded */
+   int64_t machine[RECORD_MACHINE_VALUES];         /* values of the last frame replayed */
+   MachineReplay meters;                           /* the host's replay, from the last frame replayed */
+   double* cpuPercent;                             /* of the last frame replayed, see MachineReplay */
+   size_t cpuCount;
+   size_t cpuCapacity;
+} ReplayProcessTable;
+
+extern const TableClass ReplayProcessTable_class;
+
+/* Replays the frames of reader (taking ownership) instead of scanning processes, one per update */
+ProcessTable* ReplayProcessTable_new(Machine* host, Hashtable* pidMatchList, RecordingReader* reader);
+
+void ReplayProcessTable_delete(Object* cast);
+
+/* Limits the columns and sort keys of the process screens to those recordings contain */
+void ReplayProcessTable_restrictFields(Settings* settings);
+
+/* Binds the keys moving the replay back and forth in time, '[' and ']', in place of those changing priorities */
+void ReplayProcessTable_setBindings(Htop_Action* keys);
+
+#endif
@@ -63,6 +63,19 @@ typedef struct Row_ {
    /* Whether the row was updated during the last scan */
    bool updated;
 
+   /* Stands for a group of rows (see aggregate) rather than for an entity */
+   bool isAggregate;
+
+   /* Hangs from its aggregate, its parent not being in the group in tree-mode */
+   bool underAggregate;
+
+   /* Identifier of the aggregate row this row is summed into, zero if none */
+   int aggregate;
+
+   /* Next row shown under the same aggregate, the first one for an aggregate;
+    * only valid while the display list is built */
+   struct Row_* nextInAggregate;
+
    /*
     * Internal state for tree-mode.
     */
@@ -170,6 +183,8 @@ static inline int Row_idEqualCompare(const void* v1, const void* v2) {
 
 /* Routines used primarily with the tree view */
 static inline int Row_getGroupOrParent(const Row* this) {
+   if (this->underAggregate)
+      return this->aggregate;
    return this->group == this->id ? this->parent : this->group;
 }
 
@@ -22,6 +22,7 @@ in the source distribution for its full text.
 #include "Object.h"
 #include "Platform.h"
 #include "Process.h"
+#include "Profiler.h"
 #include "ProvideCurses.h"
 #include "Settings.h"
 #include "Table.h"
@@ -119,7 +120,8 @@ void ScreenManager_resize(ScreenManager* this) {
    Panel_move(panel, lastX, y1_header);
 }
 
-static void checkRecalculation(ScreenManager* this, double* oldTime, int* sortTimeout, bool* redraw, bool* rescan, bool* timedOut, bool* force_redraw) {
+/* Returns whether the values were sampled again */
+static bool checkRecalculation(ScreenManager* this, double* oldTime, int* sortTimeout, bool* redraw, bool* rescan, bool* timedOut, bool* force_redraw) {
    Machine* host = this->host;
 
    Platform_gettime_realtime(&host->realtime, &host->realtimeMs);
@@ -132,6 +134,7 @@ static void checkRecalculation(ScreenManager* this, double* oldTime, int* sortTi
       *rescan = true; // clock was adjusted?
    }
 
+   bool scanned = *rescan;
    if (*rescan) {
       *oldTime = newTime;
 
@@ -144,13 +147,24 @@ static void checkRecalculation(ScreenManager* this, double* oldTime, int* sortTi
       int oldPidDigits = Process_pidDigits;
 
       // sample current values for system metrics and processes if not paused
+      uint64_t start = Profiler_begin();
       Machine_scan(host);
+      Profiler_end(PROFILE_MACHINE_SCAN, start);
       if (!this->state->pauseUpdate)
          Machine_scanTables(host);
       this->state->failedUpdate = Platform_getFailedState();
 
       // always update header, especially to avoid gaps in graph meters
+      start = Profiler_begin();
       Header_updateData(this->header);
+      Profiler_end(PROFILE_HEADER_UPDATE, start);
+
+      // meters may have changed their height, e.g. heatmaps after CPU hotplug
+      int oldHeight = this->header->height;
+      if (Header_calculateHeight(this->header) != oldHeight) {
+         ScreenManager_resize(this);
+         *force_redraw = true;
+      }
 
       // force redraw if the number of UID/PID digits changed
       if (Process_uidDigits != oldUidDigits || Process_pidDigits != oldPidDigits)
@@ -160,12 +174,18 @@ static void checkRecalculation(ScreenManager* this, double* oldTime, int* sortTi
    }
 
    if (*redraw) {
+      uint64_t start = Profiler_begin();
       Table_rebuildPanel(host->activeTable);
-      if (!this->state->hideMeters)
+      Profiler_end(PROFILE_REBUILD_PANEL, start);
+      if (!this->state->hideMeters) {
+         start = Profiler_begin();
          Header_draw(this->header);
+         Profiler_end(PROFILE_HEADER_DRAW, start);
+      }
    }
 
    *rescan = false;
+   return scanned;
 }
 
 static inline bool drawTab(const int* y, int* x, int l, const char* name, bool cur) {
@@ -258,12 +278,20 @@ void ScreenManager_run(ScreenManager* this, Panel** lastFocus, int* lastKey, con
    this->name = name;
 
    while (!quit) {
+      uint64_t refreshStart = Profiler_begin();
+      bool scanned = false;
       if (this->header) {
-         checkRecalculation(this, &oldTime, &sortTimeout, &redraw, &rescan, &timedOut, &force_redraw);
+         scanned = checkRecalculation(this, &oldTime, &sortTimeout, &redraw, &rescan, &timedOut, &force_redraw);
       }
 
       if (redraw || force_redraw) {
+         uint64_t start = Profiler_begin();
          ScreenManager_drawPanels(this, focus, force_redraw);
+         Profiler_end(PROFILE_DRAW_PANELS, start);
+         /* updates only redrawing would pull the mean below that of the scan within it */
+         if (scanned)
+            Profiler_end(PROFILE_REFRESH, refreshStart);
+         Profiler_commit();
          force_redraw = false;
          if (this->host->iterationsRemaining != -1) {
             if (!--this->host->iterationsRemaining) {
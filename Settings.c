@@ -251,6 +251,37 @@ static void ScreenSettings_readFields(ScreenSettings* ss, Hashtable* columns, co
    String_freeArray(ids);
 }
 
+bool ScreenSettings_parseFields(ScreenSettings* this, Hashtable* columns, const char* names) {
+   char* line = xStrdup(names);
+   for (char* c = line; *c; c++)
+      if (*c == ',')
+         *c = ' ';
+
+   bool valid = true;
+   size_t count = 0;
+   char** ids = String_split(line, ' ', NULL);
+   for (size_t i = 0; ids[i]; i++) {
+      if (!ids[i][0])
+         continue;
+      if (toFieldIndex(columns, ids[i]) <= 0)
+         valid = false;
+      count++;
+   }
+   String_freeArray(ids);
+
+   if (valid && count > 0) {
+      ScreenSettings_readFields(this, columns, line);
+      ScreenSettings_updateFlags(this);
+   }
+
+   free(line);
+   return valid && count > 0;
+}
+
+const char* Settings_fieldName(const Settings* this, RowField field) {
+   return toFieldName(this->dynamicColumns, field, NULL);
+}
+
 static ScreenSettings* Settings_initScreenSettings(ScreenSettings* ss, Settings* this, const char* columns) {
    ScreenSettings_readFields(ss, this->dynamicColumns, columns);
    this->screens[this->nScreens] = ss;
@@ -279,6 +310,7 @@ ScreenSettings* Settings_newScreen(Settings* this, const ScreenDefaults* default
       .treeView = false,
       .treeViewAlwaysByPID = false,
       .allBranchesCollapsed = false,
+      .groupBy = 0,
    };
    return Settings_initScreenSettings(ss, this, defaults->columns);
 }
@@ -443,6 +475,14 @@ static bool Settings_read(Settings* this, const char* fileName, const Machine* h
          this->highlightChanges = atoi(option[1]);
       } else if (String_eq(option[0], "highlight_changes_delay_secs")) {
          this->highlightDelaySecs = CLAMP(atoi(option[1]), 1, 24 * 60 * 60);
+      } else if (String_eq(option[0], "graph_history_mins")) {
+         this->graphHistoryMins = CLAMP(atoi(option[1]), 0, 24 * 60);
+      #ifdef HTOP_LINUX
+      } else if (String_eq(option[0], "working_set_percent")) {
+         this->workingSetPercent = CLAMP(atoi(option[1]), 1, 100);
+      } else if (String_eq(option[0], "working_set_window")) {
+         this->workingSetWindow = CLAMP(atoi(option[1]), 1, 60);
+      #endif
       } else if (String_eq(option[0], "find_comm_in_cmdline")) {
          this->findCommInCmdline = atoi(option[1]);
       } else if (String_eq(option[0], "strip_exe_from_cmdline")) {
@@ -547,6 +587,11 @@ static bool Settings_read(Settings* this, const char* fileName, const Machine* h
       } else if (String_eq(option[0], ".all_branches_collapsed")) {
          if (screen)
             screen->allBranchesCollapsed = atoi(option[1]);
+      } else if (String_eq(option[0], ".group_by")) {
+         if (screen) {
+            int key = toFieldIndex(this->dynamicColumns, option[1]);
+            ScreenSettings_setGroupBy(screen, key > 0 ? key : 0);
+         }
       } else if (String_eq(option[0], ".dynamic")) {
          if (screen) {
             free_and_xStrdup(&screen->dynamic, option[1]);
@@ -692,6 +737,11 @@ int Settings_write(const Settings* this, bool onCrash) {
    printSettingInteger("highlight_threads", this->highlightThreads);
    printSettingInteger("highlight_changes", this->highlightChanges);
    printSettingInteger("highlight_changes_delay_secs", this->highlightDelaySecs);
+   printSettingInteger("graph_history_mins", this->graphHistoryMins);
+   #ifdef HTOP_LINUX
+   printSettingInteger("working_set_percent", this->workingSetPercent);
+   printSettingInteger("working_set_window", this->workingSetWindow);
+   #endif
    printSettingInteger("find_comm_in_cmdline", this->findCommInCmdline);
    printSettingInteger("strip_exe_from_cmdline", this->stripExeFromCmdline);
    printSettingInteger("show_merged_command", this->showMergedCommand);
@@ -753,6 +803,8 @@ int Settings_write(const Settings* this, bool onCrash) {
          printSettingString(".sort_key", sortKey);
          printSettingString(".tree_sort_key", treeSortKey);
          printSettingInteger(".tree_view_always_by_pid", ss->treeViewAlwaysByPID);
+         if (ss->groupBy)
+            printSettingString(".group_by", toFieldName(this->dynamicColumns, ss->groupBy, NULL));
       }
       printSettingInteger(".tree_view", ss->treeView);
       printSettingInteger(".sort_direction", ss->direction);
@@ -811,6 +863,11 @@ Settings* Settings_new(const Machine* host, Hashtable* dynamicMeters, Hashtable*
    this->degreeFahrenheit = false;
    #endif
    this->showCachedMemory = true;
+   this->graphHistoryMins = 0;
+   #ifdef HTOP_LINUX
+   this->workingSetPercent = 5;
+   this->workingSetWindow = 3;
+   #endif
    this->updateProcessNames = false;
    this->showProgramPath = true;
    this->highlightThreads = true;
@@ -916,6 +973,21 @@ void ScreenSettings_setSortKey(ScreenSettings* this, ProcessField sortKey) {
    }
 }
 
+void ScreenSettings_setGroupBy(ScreenSettings* this, RowField groupBy) {
+   this->groupBy = groupBy;
+   ScreenSettings_updateFlags(this);
+}
+
+void ScreenSettings_updateFlags(ScreenSettings* this) {
+   this->flags = 0;
+   for (int i = 0; this->fields[i]; i++) {
+      if (this->fields[i] < LAST_PROCESSFIELD)
+         this->flags |= Process_fields[this->fields[i]].flags;
+   }
+   if (this->groupBy < LAST_PROCESSFIELD)
+      this->flags |= Process_fields[this->groupBy].flags;
+}
+
 static bool readonly = false;
 
 void Settings_enableReadonly(void) {
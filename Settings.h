@@ -52,6 +52,7 @@ typedef struct ScreenSettings_ {
    bool treeView;
    bool treeViewAlwaysByPID;
    bool allBranchesCollapsed;
+   RowField groupBy;      /* rows are shown under aggregates of this field, zero for none */
 } ScreenSettings;
 
 typedef struct Settings_ {
@@ -102,6 +103,11 @@ typedef struct Settings_ {
    bool headerMargin;
    bool screenTabs;
    bool showCachedMemory;
+   int graphHistoryMins;  // time span of meter graphs, 0 - one sample per update
+   #ifdef HTOP_LINUX
+   int workingSetPercent; // share of the pages of a process sampled for its working set
+   int workingSetWindow;  // refreshes within which sampled pages count as touched
+   #endif
    #ifdef HAVE_GETMOUSE
    bool enableMouse;
    #endif
@@ -142,6 +148,17 @@ void ScreenSettings_invertSortOrder(ScreenSettings* this);
 
 void ScreenSettings_setSortKey(ScreenSettings* this, RowField sortKey);
 
+/* Groups rows by a field, whose data is then read even if it is not a column */
+void ScreenSettings_setGroupBy(ScreenSettings* this, RowField groupBy);
+
+/* Recomputes the data the scan reads from the columns and the grouping field */
+void ScreenSettings_updateFlags(ScreenSettings* this);
+
+/* Replaces the columns of a screen by a list of column names separated by commas or spaces */
+bool ScreenSettings_parseFields(ScreenSettings* this, Hashtable* columns, const char* names);
+
+const char* Settings_fieldName(const Settings* this, RowField field);
+
 void Settings_enableReadonly(void);
 
 bool Settings_isReadonly(void);
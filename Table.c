@@ -21,6 +21,7 @@ in the source distribution for its full text.
 #include "Panel.h"
 #include "RowField.h"
 #include "Vector.h"
+#include "XUtils.h"
 
 
 Table* Table_init(Table* this, const ObjectClass* klass, Machine* host) {
@@ -149,9 +150,19 @@ static void Table_buildTree(Table* this) {
    int vsize = Vector_size(this->rows);
    for (int i = 0; i < vsize; i++) {
       Row* row = (Row*) Vector_get(this->rows, i);
+      row->underAggregate = false;
       int parent = Row_getGroupOrParent(row);
       row->isRoot = false;
 
+      // Rows of an aggregate hang from it, unless their parent is in it too
+      if (row->aggregate && Table_findRow(this, row->aggregate)) {
+         const Row* parentRow = (parent && parent != row->id) ? Table_findRow(this, parent) : NULL;
+         if (!parentRow || parentRow->aggregate != row->aggregate) {
+            row->underAggregate = true;
+            continue;
+         }
+      }
+
       if (row->id == parent) {
          row->isRoot = true;
          continue;
@@ -191,19 +202,73 @@ static void Table_buildTree(Table* this) {
    assert(Vector_size(this->displayList) == vsize); (void)vsize;
 }
 
+// Lists the sorted rows under their aggregates, each group following the
+// position of its aggregate; linking the rows of each group keeps it linear
+static void Table_buildGroups(Table* this) {
+   Vector_prune(this->displayList);
+
+   int size = Vector_size(this->rows);
+   for (int i = 0; i < size; i++) {
+      Row* row = (Row*) Vector_get(this->rows, i);
+      row->nextInAggregate = NULL;
+      row->underAggregate = false;
+      row->indent = 0;
+      row->tree_depth = 0;
+   }
+
+   // Backwards, so that each group ends up linked in sort order
+   for (int i = size - 1; i >= 0; i--) {
+      Row* row = (Row*) Vector_get(this->rows, i);
+      if (row->isAggregate || !row->aggregate)
+         continue;
+
+      Row* aggregate = Table_findRow(this, row->aggregate);
+      if (!aggregate)
+         continue;
+
+      row->nextInAggregate = aggregate->nextInAggregate;
+      row->underAggregate = true;
+      row->indent = row->nextInAggregate ? 1 : -1;
+      row->tree_depth = 1;
+      aggregate->nextInAggregate = row;
+   }
+
+   for (int i = 0; i < size; i++) {
+      Row* row = (Row*) Vector_get(this->rows, i);
+      if (row->underAggregate)
+         continue;
+
+      Vector_add(this->displayList, row);
+      if (!row->isAggregate || !row->showChildren)
+         continue;
+
+      for (Row* member = row->nextInAggregate; member; member = member->nextInAggregate)
+         Vector_add(this->displayList, member);
+   }
+}
+
 void Table_updateDisplayList(Table* this) {
    const Settings* settings = this->host->settings;
 
    if (settings->ss->treeView) {
       if (this->needsSort)
          Table_buildTree(this);
+   } else if (settings->ss->groupBy) {
+      if (this->needsSort)
+         Vector_insertionSort(this->rows);
+      Table_buildGroups(this);
    } else {
       if (this->needsSort)
          Vector_insertionSort(this->rows);
       Vector_prune(this->displayList);
       int size = Vector_size(this->rows);
-      for (int i = 0; i < size; i++)
-         Vector_add(this->displayList, Vector_get(this->rows, i));
+      for (int i = 0; i < size; i++) {
+         Row* row = (Row*) Vector_get(this->rows, i);
+         row->underAggregate = false;
+         // leftover aggregates of a grouping just turned off
+         if (!row->isAggregate)
+            Vector_add(this->displayList, row);
+      }
    }
    this->needsSort = false;
 }
@@ -224,7 +289,7 @@ void Table_collapseAllBranches(Table* this) {
    for (int i = 0; i < size; i++) {
       Row* row = (Row*) Vector_get(this->rows, i);
       // FreeBSD has pid 0 = kernel and pid 1 = init, so init has tree_depth = 1
-      if (row->tree_depth > 0 && row->id > 1)
+      if ((row->tree_depth > 0 && row->id > 1) || row->isAggregate)
          row->showChildren = false;
    }
 }
@@ -284,6 +349,14 @@ void Table_rebuildPanel(Table* this) {
 
       this->panel->scrollV = currScrollV;
    }
+
+   /* Drawing shows the lines at the current scroll position or, after
+    * scrolling to keep the selection visible, those around the selection */
+   const int selected = Panel_getSelectedIndex(this->panel);
+   const int height = this->panel->h;
+   const int first = MAXIMUM(0, MINIMUM(selected - height, this->panel->scrollV));
+   const int last = MINIMUM(Panel_size(this->panel), MAXIMUM(selected + height, this->panel->scrollV + height));
+   Table_prepareVisible(this, first, last);
 }
 
 void Table_printHeader(const Settings* settings, RichString* header) {
@@ -293,6 +366,7 @@ void Table_printHeader(const Settings* settings, RichString* header) {
    const RowField* fields = ss->fields;
 
    RowField key = ScreenSettings_getActiveSortKey(ss);
+   const char* groupBy = ss->groupBy ? Settings_fieldName(settings, ss->groupBy) : NULL;
 
    for (int i = 0; fields[i]; i++) {
       int color;
@@ -315,6 +389,11 @@ void Table_printHeader(const Settings* settings, RichString* header) {
       if (COMM == fields[i] && settings->showMergedCommand) {
          RichString_appendAscii(header, color, "(merged)");
       }
+      if (COMM == fields[i] && groupBy) {
+         char buffer[64];
+         xSnprintf(buffer, sizeof(buffer), "(by %s)", groupBy);
+         RichString_appendAscii(header, color, buffer);
+      }
    }
 }
 
@@ -340,7 +419,7 @@ Row* Table_cleanupRow(Table* table, Row* row, int idx) {
       }
    } else if (!row->updated) {
       // process no longer exists
-      if (settings->highlightChanges && row->wasShown) {
+      if (settings->highlightChanges && row->wasShown && !row->isAggregate) {
          // mark tombed
          row->tombStampMs = host->monotonicMs + 1000 * settings->highlightDelaySecs;
       } else {
@@ -42,12 +42,14 @@ typedef Table* (*Table_New)(const struct Machine_*);
 typedef void (*Table_ScanPrepare)(Table* this);
 typedef void (*Table_ScanIterate)(Table* this);
 typedef void (*Table_ScanCleanup)(Table* this);
+typedef void (*Table_PrepareVisible)(Table* this, int first, int last);
 
 typedef struct TableClass_ {
    const ObjectClass super;
    const Table_ScanPrepare prepare;
    const Table_ScanIterate iterate;
    const Table_ScanCleanup cleanup;
+   const Table_PrepareVisible prepareVisible;  /* optional; readies panel lines [first, last) before drawing */
 } TableClass;
 
 #define As_Table(this_)  ((const TableClass*)((this_)->super.klass))
@@ -55,6 +57,7 @@ typedef struct TableClass_ {
 #define Table_scanPrepare(t_)  (As_Table(t_)->prepare ? (As_Table(t_)->prepare(t_)) : Table_prepareEntries(t_))
 #define Table_scanIterate(t_)  (As_Table(t_)->iterate(t_))  /* mandatory; must have a custom iterate method */
 #define Table_scanCleanup(t_)  (As_Table(t_)->cleanup ? (As_Table(t_)->cleanup(t_)) : Table_cleanupEntries(t_))
+#define Table_prepareVisible(t_, f_, l_)  (As_Table(t_)->prepareVisible ? (As_Table(t_)->prepareVisible(t_, f_, l_)) : (void)0)
 
 Table* Table_init(Table* this, const ObjectClass* klass, struct Machine_* host);
 
@@ -0,0 +1,88 @@
+/*
+htop - TextIndex.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "TextIndex.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+
+
+static void TextLine_delete(ATTR_UNUSED Object* cast) {
+   /* held by its TextIndex */
+}
+
+const ObjectClass TextLine_class = {
+   .extends = Class(ListItem),
+   .display = ListItem_display,
+   .delete = TextLine_delete,
+   .compare = ListItem_compare
+};
+
+void TextIndex_init(TextIndex* this, size_t bytes, size_t lines, size_t width) {
+   memset(this, 0, sizeof(TextIndex));
+   this->width = MAXIMUM(width, 2);
+
+   /* wrapping cuts no earlier than half the width, so that bounds the lines a text can take */
+   this->lineCapacity = lines + 2 * bytes / this->width + 1;
+   this->capacity = bytes + this->lineCapacity;
+   this->text = xMalloc(this->capacity);
+   this->lines = xMallocArray(this->lineCapacity, sizeof(ListItem));
+}
+
+void TextIndex_done(TextIndex* this) {
+   free(this->text);
+   free(this->lines);
+   memset(this, 0, sizeof(TextIndex));
+}
+
+static void TextIndex_emit(TextIndex* this, const char* segment, size_t len) {
+   assert(this->count < this->lineCapacity);
+   assert(this->used + len < this->capacity);
+
+   char* value = this->text + this->used;
+   memcpy(value, segment, len);
+   value[len] = '\0';
+   this->used += len + 1;
+
+   ListItem* line = &this->lines[this->count++];
+   Object_setClass(line, Class(TextLine));
+   line->value = value;
+   line->key = 0;
+   line->moving = false;
+}
+
+void TextIndex_add(TextIndex* this, const char* line, size_t len) {
+   const size_t width = this->width;
+   size_t start = 0;
+
+   while (len - start > width) {
+      size_t cut = start + width;
+      for (size_t i = cut; i > start + width / 2; i--) {
+         char c = line[i - 1];
+         if (c == ' ' || c == ':' || c == ',') {
+            cut = i;
+            break;
+         }
+      }
+
+      TextIndex_emit(this, line + start, cut - start);
+      start = cut;
+   }
+
+   TextIndex_emit(this, line + start, len - start);
+}
+
+void TextIndex_show(TextIndex* this, InfoScreen* screen) {
+   for (size_t i = 0; i < this->count; i++)
+      InfoScreen_addItem(screen, &this->lines[i]);
+}
@@ -0,0 +1,51 @@
+#ifndef HEADER_TextIndex
+#define HEADER_TextIndex
+/*
+htop - TextIndex.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stddef.h>
+
+#include "InfoScreen.h"
+#include "ListItem.h"
+#include "Object.h"
+
+
+/* A line of a TextIndex: a ListItem whose value points into the text of the index, which owns it */
+extern const ObjectClass TextLine_class;
+
+/*
+ * Lines of a possibly huge text, as an environment or a command line of
+ * several megabytes, wrapped to a width and copied once into a single
+ * buffer. Lines are ListItems held in one array and pointing into that
+ * buffer, so showing them allocates nothing per line and drawing one
+ * never renders more than the width. Every line is a ListItem, not only
+ * the visible ones, as the panel holds one object per row and its search
+ * and filter read each of them: the memory taken stays proportional to
+ * the text, one copy of it and a ListItem per line.
+ */
+typedef struct TextIndex_ {
+   char* text;                    /* the lines, each terminated by a NUL */
+   size_t used;
+   size_t capacity;
+   ListItem* lines;
+   size_t count;
+   size_t lineCapacity;
+   size_t width;                  /* longest line, longer ones being wrapped */
+} TextIndex;
+
+/* Makes room for lines summing up to bytes, without their terminators */
+void TextIndex_init(TextIndex* this, size_t bytes, size_t lines, size_t width);
+
+void TextIndex_done(TextIndex* this);
+
+/* Adds a line, wrapped after blanks, colons or commas where it is longer than the width */
+void TextIndex_add(TextIndex* this, const char* line, size_t len);
+
+/* Shows the lines on a screen, which must be cleared before the index is done */
+void TextIndex_show(TextIndex* this, InfoScreen* screen);
+
+#endif
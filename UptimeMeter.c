@@ -10,6 +10,7 @@ in the source distribution for its full text.
 #include "UptimeMeter.h"
 
 #include "CRT.h"
+#include "Machine.h"
 #include "Object.h"
 #include "Platform.h"
 #include "XUtils.h"
@@ -20,7 +21,7 @@ static const int UptimeMeter_attributes[] = {
 };
 
 static void UptimeMeter_updateValues(Meter* this) {
-   int totalseconds = Platform_getUptime();
+   int totalseconds = this->host->replay ? this->host->replay->uptime : Platform_getUptime();
    if (totalseconds <= 0) {
       xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "(unknown)");
       return;
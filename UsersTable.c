@@ -9,36 +9,348 @@ in the source distribution for its full text.
 
 #include "UsersTable.h"
 
+#include <errno.h>
+#include <limits.h>
 #include <pwd.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#include <signal.h>
+#endif
+
+#include "Macros.h"
+#include "Platform.h"
+#include "Profiler.h"
 #include "XUtils.h"
 
 
+/* How long a uid whose lookup failed is shown as a number before it is looked up again */
+#define USERSTABLE_RETRY_MS 60000
+
+/* Largest /etc/passwd read ahead; the users of a larger one are looked up one by one */
+#define USERSTABLE_PASSWD_MAX (16 * 1024 * 1024)
+
+typedef struct UsersTableUnknown_ {
+   uint64_t retryMs;              /* when the uid may be looked up again */
+   bool pending;                  /* whether the background thread is looking it up */
+} UsersTableUnknown;
+
+#ifdef HAVE_PTHREAD
+
+typedef struct UsersTableAnswer_ {
+   unsigned int uid;
+   char* name;                    /* NULL if the uid has none */
+} UsersTableAnswer;
+
+typedef struct UsersTableResolver_ {
+   bool running;                  /* false if the thread could not be started */
+   pthread_t thread;
+   pthread_mutex_t lock;          /* guards all below but pending */
+   pthread_cond_t wake;
+   unsigned int* questions;       /* uids to look up */
+   size_t questionCount;
+   size_t questionCapacity;
+   UsersTableAnswer* answers;     /* looked up, not yet collected */
+   size_t answerCount;
+   size_t answerCapacity;
+   bool quit;                     /* the thread is left to free the resolver */
+   size_t pending;                /* asked, not yet collected; only used by the asking thread */
+} UsersTableResolver;
+
+static char* UsersTableResolver_lookUp(unsigned int uid) {
+   long size = sysconf(_SC_GETPW_R_SIZE_MAX);
+   size_t bufferSize = size > 0 ? (size_t)size : 1024;
+   char* buffer = NULL;
+   char* name = NULL;
+
+   for (;;) {
+      buffer = xRealloc(buffer, bufferSize);
+
+      struct passwd entry;
+      struct passwd* result = NULL;
+      int error = getpwuid_r((uid_t)uid, &entry, buffer, bufferSize, &result);
+      if (error == ERANGE && bufferSize < 1024 * 1024) {
+         bufferSize *= 2;
+         continue;
+      }
+
+      if (!error && result)
+         name = xStrdup(result->pw_name);
+      break;
+   }
+
+   free(buffer);
+   return name;
+}
+
+static void UsersTableResolver_free(UsersTableResolver* this) {
+   for (size_t i = 0; i < this->answerCount; i++)
+      free(this->answers[i].name);
+   free(this->answers);
+   free(this->questions);
+   pthread_cond_destroy(&this->wake);
+   pthread_mutex_destroy(&this->lock);
+   free(this);
+}
+
+static void* UsersTableResolver_run(void* cast) {
+   UsersTableResolver* this = cast;
+
+   pthread_mutex_lock(&this->lock);
+   for (;;) {
+      while (!this->questionCount && !this->quit)
+         pthread_cond_wait(&this->wake, &this->lock);
+      if (this->quit)
+         break;
+
+      unsigned int uid = this->questions[--this->questionCount];
+
+      /* the name service may take long to answer, the table stays usable meanwhile */
+      pthread_mutex_unlock(&this->lock);
+      char* name = UsersTableResolver_lookUp(uid);
+      pthread_mutex_lock(&this->lock);
+
+      if (this->answerCount == this->answerCapacity) {
+         this->answerCapacity = this->answerCapacity ? this->answerCapacity * 2 : 16;
+         this->answers = xReallocArray(this->answers, this->answerCapacity, sizeof(UsersTableAnswer));
+      }
+      this->answers[this->answerCount].uid = uid;
+      this->answers[this->answerCount].name = name;
+      this->answerCount++;
+   }
+   pthread_mutex_unlock(&this->lock);
+
+   UsersTableResolver_free(this);
+   return NULL;
+}
+
+static UsersTableResolver* UsersTableResolver_new(void) {
+   UsersTableResolver* this = xCalloc(1, sizeof(UsersTableResolver));
+   pthread_mutex_init(&this->lock, NULL);
+   pthread_cond_init(&this->wake, NULL);
+
+   /* signals are left for the display thread to handle */
+   sigset_t all;
+   sigset_t previous;
+   sigfillset(&all);
+   pthread_sigmask(SIG_SETMASK, &all, &previous);
+   this->running = pthread_create(&this->thread, NULL, UsersTableResolver_run, this) == 0;
+   pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+   return this;
+}
+
+static void UsersTableResolver_delete(UsersTableResolver* this) {
+   if (!this)
+      return;
+
+   if (!this->running) {
+      UsersTableResolver_free(this);
+      return;
+   }
+
+   /* a lookup may hang on an unreachable directory, so exiting does not
+      wait for it: the thread frees the resolver whenever it gets to quit */
+   pthread_detach(this->thread);
+   pthread_mutex_lock(&this->lock);
+   this->quit = true;
+   pthread_cond_signal(&this->wake);
+   pthread_mutex_unlock(&this->lock);
+}
+
+/* Hands a uid to the background thread; returns false if there is none */
+static bool UsersTable_ask(UsersTable* this, unsigned int uid) {
+   if (!this->resolver)
+      this->resolver = UsersTableResolver_new();
+
+   UsersTableResolver* resolver = this->resolver;
+   if (!resolver->running)
+      return false;
+
+   pthread_mutex_lock(&resolver->lock);
+   if (resolver->questionCount == resolver->questionCapacity) {
+      resolver->questionCapacity = resolver->questionCapacity ? resolver->questionCapacity * 2 : 16;
+      resolver->questions = xReallocArray(resolver->questions, resolver->questionCapacity, sizeof(unsigned int));
+   }
+   resolver->questions[resolver->questionCount++] = uid;
+   pthread_cond_signal(&resolver->wake);
+   pthread_mutex_unlock(&resolver->lock);
+
+   resolver->pending++;
+   return true;
+}
+
+/* Takes in the names the background thread found since the last call */
+static void UsersTable_collect(UsersTable* this) {
+   UsersTableResolver* resolver = this->resolver;
+   if (!resolver || !resolver->pending)
+      return;
+
+   uint64_t now;
+   Platform_gettime_monotonic(&now);
+
+   pthread_mutex_lock(&resolver->lock);
+   for (size_t i = 0; i < resolver->answerCount; i++) {
+      const UsersTableAnswer* answer = &resolver->answers[i];
+      if (answer->name) {
+         Hashtable_remove(this->unknown, answer->uid);
+         Hashtable_put(this->users, answer->uid, answer->name);
+         continue;
+      }
+
+      UsersTableUnknown* unknown = Hashtable_get(this->unknown, answer->uid);
+      if (unknown) {
+         unknown->pending = false;
+         unknown->retryMs = now + USERSTABLE_RETRY_MS;
+      }
+   }
+   resolver->pending -= resolver->answerCount;
+   resolver->answerCount = 0;
+   pthread_mutex_unlock(&resolver->lock);
+}
+
+#else /* HAVE_PTHREAD */
+
+static void UsersTableResolver_delete(struct UsersTableResolver_* this) {
+   (void)this;
+}
+
+static bool UsersTable_ask(UsersTable* this, unsigned int uid) {
+   (void)this;
+   (void)uid;
+   return false;
+}
+
+static void UsersTable_collect(UsersTable* this) {
+   (void)this;
+}
+
+#endif /* HAVE_PTHREAD */
+
+/* Reads the names of /etc/passwd at once, sparing its users a lookup each */
+static void UsersTable_readPasswd(UsersTable* this) {
+   struct stat sb;
+   if (stat("/etc/passwd", &sb) != 0 || sb.st_size <= 0 || sb.st_size > USERSTABLE_PASSWD_MAX)
+      return;
+
+   size_t size = (size_t)sb.st_size + 1;
+   char* buffer = xMalloc(size);
+   if (xReadfile("/etc/passwd", buffer, size) <= 0) {
+      free(buffer);
+      return;
+   }
+
+   for (char* line = buffer; line && *line;) {
+      char* next = strchr(line, '\n');
+      if (next)
+         *next++ = '\0';
+
+      /* "name:password:uid:..."; the '+' and '-' entries of NIS are left to the name service */
+      char* colon = strchr(line, ':');
+      const char* password = colon ? strchr(colon + 1, ':') : NULL;
+      if (password && colon != line && line[0] != '+' && line[0] != '-' && line[0] != '#') {
+         char* end;
+         errno = 0;
+         unsigned long uid = strtoul(password + 1, &end, 10);
+         if (!errno && end != password + 1 && *end == ':' && uid <= UINT_MAX && !Hashtable_get(this->known, (ht_key_t)uid)) {
+            *colon = '\0';
+            Hashtable_put(this->known, (ht_key_t)uid, xStrdup(line));
+         }
+      }
+
+      line = next;
+   }
+
+   free(buffer);
+}
+
 UsersTable* UsersTable_new(void) {
    UsersTable* this;
-   this = xMalloc(sizeof(UsersTable));
+   this = xCalloc(1, sizeof(UsersTable));
    this->users = Hashtable_new(10, true);
+   this->known = Hashtable_new(64, false);
+   this->unknown = Hashtable_new(10, true);
+   UsersTable_readPasswd(this);
    return this;
 }
 
+static void UsersTable_freeName(ATTR_UNUSED ht_key_t key, void* name, ATTR_UNUSED void* userData) {
+   free(name);
+}
+
 void UsersTable_delete(UsersTable* this) {
+   UsersTableResolver_delete(this->resolver);
+   Hashtable_foreach(this->known, UsersTable_freeName, NULL);
+   Hashtable_delete(this->known);
+   Hashtable_delete(this->unknown);
    Hashtable_delete(this->users);
    free(this);
 }
 
+/* Looks up a uid that is in neither table, or tells why it cannot be yet */
+static char* UsersTable_lookUp(UsersTable* this, unsigned int uid) {
+   UsersTable_collect(this);
+   char* name = Hashtable_get(this->users, uid);
+   if (name) {
+      Profiler_count(PROFILE_USER_NAME_HITS);
+      return name;
+   }
+
+   uint64_t now;
+   Platform_gettime_monotonic(&now);
+
+   UsersTableUnknown* unknown = Hashtable_get(this->unknown, uid);
+   if (unknown && (unknown->pending || now < unknown->retryMs)) {
+      Profiler_count(PROFILE_USER_NAME_UNRESOLVED);
+      return NULL;
+   }
+   if (!unknown) {
+      unknown = xCalloc(1, sizeof(UsersTableUnknown));
+      Hashtable_put(this->unknown, uid, unknown);
+   }
+
+   Profiler_count(PROFILE_USER_NAME_MISSES);
+   if (UsersTable_ask(this, uid)) {
+      unknown->pending = true;
+      Profiler_count(PROFILE_USER_NAME_UNRESOLVED);
+      return NULL;
+   }
+
+   /* without a background thread, the name service is asked right away */
+   const struct passwd* userData = getpwuid(uid);
+   if (userData) {
+      Hashtable_remove(this->unknown, uid);
+      name = xStrdup(userData->pw_name);
+      Hashtable_put(this->users, uid, name);
+      return name;
+   }
+
+   unknown->retryMs = now + USERSTABLE_RETRY_MS;
+   Profiler_count(PROFILE_USER_NAME_UNRESOLVED);
+   return NULL;
+}
+
 char* UsersTable_getRef(UsersTable* this, unsigned int uid) {
    char* name = Hashtable_get(this->users, uid);
-   if (name == NULL) {
-      const struct passwd* userData = getpwuid(uid);
-      if (userData != NULL) {
-         name = xStrdup(userData->pw_name);
+   if (!name) {
+      name = Hashtable_remove(this->known, uid);
+      if (name)
          Hashtable_put(this->users, uid, name);
-      }
    }
-   return name;
+
+   if (name) {
+      Profiler_count(PROFILE_USER_NAME_HITS);
+      return name;
+   }
+
+   return UsersTable_lookUp(this, uid);
 }
 
 inline void UsersTable_foreach(UsersTable* this, Hashtable_PairFunction f, void* userData) {
@@ -7,17 +7,32 @@ Released under the GNU GPLv2+, see the COPYING file
 in the source distribution for its full text.
 */
 
+#include <stddef.h>
+
 #include "Hashtable.h"
 
 
+struct UsersTableResolver_;
+
+/*
+ * User names by uid. Names are read ahead from /etc/passwd; those it does
+ * not hold are asked of the name service by a background thread where
+ * threads are available, so that a slow directory never stalls the
+ * display. Until a name arrives, and for a while after a lookup failed,
+ * the numeric uid is shown instead.
+ */
 typedef struct UsersTable_ {
-   Hashtable* users;
+   Hashtable* users;              /* names of the uids asked for, by uid */
+   Hashtable* known;              /* names read from /etc/passwd, not yet asked for */
+   Hashtable* unknown;            /* uids being looked up, or whose lookup failed */
+   struct UsersTableResolver_* resolver;   /* NULL until a name is looked up in the background */
 } UsersTable;
 
 UsersTable* UsersTable_new(void);
 
 void UsersTable_delete(UsersTable* this);
 
+/* The name of a user, or NULL while it is looked up or if it has none */
 char* UsersTable_getRef(UsersTable* this, unsigned int uid);
 
 void UsersTable_foreach(UsersTable* this, Hashtable_PairFunction f, void* userData);
@@ -186,7 +186,8 @@ static void Vector_resizeIfNecessary(Vector* this, int newSize) {
    if (newSize > this->arraySize) {
       assert(Vector_isConsistent(this));
       int oldSize = this->arraySize;
-      this->arraySize = newSize + this->growthRate;
+      /* growing by half at least keeps adding many items linear */
+      this->arraySize = newSize + MAXIMUM(this->growthRate, oldSize / 2);
       this->array = (Object**)xReallocArrayZero(this->array, oldSize, this->arraySize, sizeof(Object*));
    }
    assert(Vector_isConsistent(this));
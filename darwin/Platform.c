@@ -34,6 +34,7 @@ in the source distribution for its full text.
 #include <IOKit/storage/IOBlockStorageDriver.h>
 
 #include "ClockMeter.h"
+#include "CPUHeatmapMeter.h"
 #include "CPUMeter.h"
 #include "CRT.h"
 #include "DateMeter.h"
@@ -46,6 +47,7 @@ in the source distribution for its full text.
 #include "MemoryMeter.h"
 #include "MemorySwapMeter.h"
 #include "ProcessLocksScreen.h"
+#include "ProfileMeter.h"
 #include "SwapMeter.h"
 #include "SysArchMeter.h"
 #include "TasksMeter.h"
@@ -141,6 +143,11 @@ const MeterClass* const Platform_meterTypes[] = {
    &RightCPUs4Meter_class,
    &LeftCPUs8Meter_class,
    &RightCPUs8Meter_class,
+   &CPUHeatmapMeter_class,
+   &CoreHeatmapMeter_class,
+   &CCDHeatmapMeter_class,
+   &SocketHeatmapMeter_class,
+   &NodeHeatmapMeter_class,
    &ZfsArcMeter_class,
    &ZfsCompressedArcMeter_class,
    &DiskIOMeter_class,
@@ -148,6 +155,7 @@ const MeterClass* const Platform_meterTypes[] = {
    &FileDescriptorMeter_class,
    &GPUMeter_class,
    &BlankMeter_class,
+   &ProfileMeter_class,
    NULL
 };
 
@@ -494,6 +502,12 @@ char* Platform_getProcessEnv(pid_t pid) {
    return env;
 }
 
+char* Platform_getProcessCmdline(pid_t pid, size_t* size) {
+   (void) pid;
+   (void) size;
+   return NULL;
+}
+
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
    (void)pid;
    return NULL;
@@ -8,6 +8,7 @@ Released under the GNU GPLv2+, see the COPYING file
 in the source distribution for its full text.
 */
 
+#include <signal.h>
 #include <stdbool.h>
 #include <sys/types.h>
 
@@ -70,6 +71,8 @@ void Platform_setZfsCompressedArcValues(Meter* this);
 
 char* Platform_getProcessEnv(pid_t pid);
 
+char* Platform_getProcessCmdline(pid_t pid, size_t* size);
+
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid);
 
 void Platform_getFileDescriptors(double* used, double* max);
@@ -144,4 +147,13 @@ static inline void Platform_addDynamicScreenAvailableColumns(ATTR_UNUSED Panel*
 
 static inline void Platform_dynamicScreensDone(ATTR_UNUSED Hashtable* screens) { }
 
+static inline bool Platform_pinProcess(ATTR_UNUSED const Process* proc, int* pidfd) {
+   *pidfd = -1;
+   return true;
+}
+
+static inline bool Platform_signalPinned(const Process* proc, ATTR_UNUSED int pidfd, int sgn) {
+   return kill(Process_getPid(proc), sgn) == 0;
+}
+
 #endif
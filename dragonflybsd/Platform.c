@@ -23,6 +23,7 @@ in the source distribution for its full text.
 #include <vm/vm_param.h>
 
 #include "ClockMeter.h"
+#include "CPUHeatmapMeter.h"
 #include "CPUMeter.h"
 #include "DateMeter.h"
 #include "DateTimeMeter.h"
@@ -33,6 +34,7 @@ in the source distribution for its full text.
 #include "MemoryMeter.h"
 #include "MemorySwapMeter.h"
 #include "ProcessTable.h"
+#include "ProfileMeter.h"
 #include "SwapMeter.h"
 #include "SysArchMeter.h"
 #include "TasksMeter.h"
@@ -120,10 +122,16 @@ const MeterClass* const Platform_meterTypes[] = {
    &RightCPUs4Meter_class,
    &LeftCPUs8Meter_class,
    &RightCPUs8Meter_class,
+   &CPUHeatmapMeter_class,
+   &CoreHeatmapMeter_class,
+   &CCDHeatmapMeter_class,
+   &SocketHeatmapMeter_class,
+   &NodeHeatmapMeter_class,
    &DiskIOMeter_class,
    &NetworkIOMeter_class,
    &FileDescriptorMeter_class,
    &BlankMeter_class,
+   &ProfileMeter_class,
    NULL
 };
 
@@ -244,6 +252,12 @@ char* Platform_getProcessEnv(pid_t pid) {
    return NULL;
 }
 
+char* Platform_getProcessCmdline(pid_t pid, size_t* size) {
+   (void) pid;
+   (void) size;
+   return NULL;
+}
+
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
    (void)pid;
    return NULL;
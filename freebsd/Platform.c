@@ -26,6 +26,7 @@ in the source distribution for its full text.
 #include <sys/types.h>
 #include <vm/vm_param.h>
 
+#include "CPUHeatmapMeter.h"
 #include "CPUMeter.h"
 #include "ClockMeter.h"
 #include "DateMeter.h"
@@ -40,6 +41,7 @@ in the source distribution for its full text.
 #include "MemorySwapMeter.h"
 #include "Meter.h"
 #include "NetworkIOMeter.h"
+#include "ProfileMeter.h"
 #include "Settings.h"
 #include "SwapMeter.h"
 #include "SysArchMeter.h"
@@ -127,12 +129,18 @@ const MeterClass* const Platform_meterTypes[] = {
    &RightCPUs4Meter_class,
    &LeftCPUs8Meter_class,
    &RightCPUs8Meter_class,
+   &CPUHeatmapMeter_class,
+   &CoreHeatmapMeter_class,
+   &CCDHeatmapMeter_class,
+   &SocketHeatmapMeter_class,
+   &NodeHeatmapMeter_class,
    &BlankMeter_class,
    &ZfsArcMeter_class,
    &ZfsCompressedArcMeter_class,
    &DiskIOMeter_class,
    &FileDescriptorMeter_class,
    &NetworkIOMeter_class,
+   &ProfileMeter_class,
    NULL
 };
 
@@ -288,6 +296,12 @@ char* Platform_getProcessEnv(pid_t pid) {
    return env;
 }
 
+char* Platform_getProcessCmdline(pid_t pid, size_t* size) {
+   (void) pid;
+   (void) size;
+   return NULL;
+}
+
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
    (void)pid;
    return NULL;
@@ -0,0 +1,215 @@
+/*
+htop - CGroupEntry.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/CGroupEntry.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CRT.h"
+#include "Macros.h"
+#include "RichString.h"
+#include "Settings.h"
+#include "XUtils.h"
+
+
+const CGroupFieldData CGroupEntry_fields[LAST_CGROUP_FIELD] = {
+   [CGROUP_FIELD_CPU] = { .name = "cpu", .heading = "CPU%", .caption = "CPU%", .description = "Percentage of the CPU time used by the cgroup in the last sampling", .width = 5, },
+   [CGROUP_FIELD_MEMORY] = { .name = "memory", .heading = "MEM", .caption = "MEM", .description = "Memory charged to the cgroup (memory.current)", .width = 5, },
+   [CGROUP_FIELD_IO_READ] = { .name = "io_read", .heading = "DISK READ", .caption = "DISK READ", .description = "Rate of the bytes read from block devices by the cgroup", .width = 11, },
+   [CGROUP_FIELD_IO_WRITE] = { .name = "io_write", .heading = "DISK WRITE", .caption = "DISK WRITE", .description = "Rate of the bytes written to block devices by the cgroup", .width = 11, },
+   [CGROUP_FIELD_TASKS] = { .name = "tasks", .heading = "TASKS", .caption = "TASKS", .description = "Number of tasks in the cgroup (pids.current)", .width = 6, },
+   [CGROUP_FIELD_CPU_PRESSURE] = { .name = "cpu_pressure", .heading = "CPU_PSI", .caption = "CPU_PSI", .description = "Percentage of the last 10 seconds some tasks of the cgroup waited for a CPU", .width = 7, },
+   [CGROUP_FIELD_MEMORY_PRESSURE] = { .name = "memory_pressure", .heading = "MEM_PSI", .caption = "MEM_PSI", .description = "Percentage of the last 10 seconds some tasks of the cgroup waited for memory", .width = 7, },
+   [CGROUP_FIELD_IO_PRESSURE] = { .name = "io_pressure", .heading = "IO_PSI", .caption = "IO_PSI", .description = "Percentage of the last 10 seconds some tasks of the cgroup waited for I/O", .width = 7, },
+   [CGROUP_FIELD_NAME] = { .name = "name", .heading = "CGROUP", .caption = "CGROUP", .description = "Path of the cgroup, or its name in tree view", .width = -6, },
+};
+
+CGroupEntry* CGroupEntry_new(const Machine* host, int id, const char* path) {
+   CGroupEntry* this = xCalloc(1, sizeof(CGroupEntry));
+   Object_setClass(this, Class(CGroupEntry));
+
+   Row* super = &this->super;
+   Row_init(super, host);
+   super->id = id;
+   super->group = id;
+
+   this->path = xStrdup(path);
+   const char* slash = strrchr(this->path, '/');
+   this->name = slash ? slash + 1 : this->path;
+
+   this->memory = ULLONG_MAX;
+   this->tasks = -1;
+   this->cpuPressure = NAN;
+   this->memoryPressure = NAN;
+   this->ioPressure = NAN;
+   return this;
+}
+
+void CGroupEntry_setChildren(CGroupEntry* this, char** children, size_t nChildren) {
+   for (size_t i = 0; i < this->nChildren; i++)
+      free(this->children[i]);
+   free(this->children);
+
+   this->children = children;
+   this->nChildren = nChildren;
+}
+
+void CGroupEntry_done(CGroupEntry* this) {
+   CGroupEntry_setChildren(this, NULL, 0);
+   free(this->path);
+   Row_done(&this->super);
+}
+
+static void CGroupEntry_delete(Object* cast) {
+   CGroupEntry* this = (CGroupEntry*) cast;
+   CGroupEntry_done(this);
+   free(this);
+}
+
+static void CGroupEntry_writeName(const CGroupEntry* this, RichString* str) {
+   const Row* super = &this->super;
+   const ScreenSettings* ss = super->host->settings->ss;
+
+   if (!ss->treeView) {
+      if (!this->path[0]) {
+         RichString_appendAscii(str, CRT_colors[PROCESS_BASENAME], "/");
+         return;
+      }
+      RichString_appendnWide(str, CRT_colors[PROCESS], this->path, (size_t)(this->name - this->path));
+      RichString_appendWide(str, CRT_colors[PROCESS_BASENAME], this->name);
+      return;
+   }
+
+   if (super->indent != 0) {
+      char buffer[256];
+      char* buf = buffer;
+      size_t n = sizeof(buffer);
+
+      for (uint32_t indent = (super->indent < 0 ? -super->indent : super->indent); indent > 1 && n > 4; indent >>= 1) {
+         int ret = xSnprintf(buf, n, "%s  ", (indent & 1U) ? CRT_treeStr[TREE_STR_VERT] : " ");
+         buf += ret;
+         n -= (size_t)ret;
+      }
+
+      const char* draw = CRT_treeStr[super->indent < 0 ? TREE_STR_BEND : TREE_STR_RTEE];
+      xSnprintf(buf, n, "%s%s ", draw, super->showChildren ? CRT_treeStr[TREE_STR_SHUT] : CRT_treeStr[TREE_STR_OPEN]);
+      RichString_appendWide(str, CRT_colors[PROCESS_TREE], buffer);
+   }
+   RichString_appendWide(str, CRT_colors[PROCESS_BASENAME], this->path[0] ? this->name : "/");
+}
+
+static void CGroupEntry_printPressure(RichString* str, float pressure) {
+   char buffer[16];
+   if (isnan(pressure)) {
+      RichString_appendAscii(str, CRT_colors[PROCESS_SHADOW], "    N/A ");
+      return;
+   }
+
+   int len = xSnprintf(buffer, sizeof(buffer), "%7.2f ", pressure);
+   RichString_appendnAscii(str, CRT_colors[pressure < 0.005F ? PROCESS_SHADOW : PROCESS], buffer, len);
+}
+
+static void CGroupEntry_writeField(const Row* super, RichString* str, RowField field) {
+   const CGroupEntry* this = (const CGroupEntry*) super;
+   const Settings* settings = super->host->settings;
+   bool coloring = settings->highlightMegabytes;
+   char buffer[16];
+   int attr = CRT_colors[PROCESS];
+
+   switch (field - ROW_DYNAMIC_FIELDS) {
+   case CGROUP_FIELD_CPU:
+      Row_printPercentage(this->percentCpu, buffer, sizeof(buffer), 5, &attr);
+      RichString_appendAscii(str, attr, buffer);
+      return;
+   case CGROUP_FIELD_MEMORY: Row_printBytes(str, this->memory, coloring); return;
+   case CGROUP_FIELD_IO_READ: Row_printRate(str, this->sampled ? this->readRate : NAN, coloring); return;
+   case CGROUP_FIELD_IO_WRITE: Row_printRate(str, this->sampled ? this->writeRate : NAN, coloring); return;
+   case CGROUP_FIELD_TASKS:
+      if (this->tasks < 0) {
+         RichString_appendAscii(str, CRT_colors[PROCESS_SHADOW], "   N/A ");
+      } else {
+         int len = xSnprintf(buffer, sizeof(buffer), "%6lld ", this->tasks);
+         RichString_appendnAscii(str, attr, buffer, len);
+      }
+      return;
+   case CGROUP_FIELD_CPU_PRESSURE: CGroupEntry_printPressure(str, this->cpuPressure); return;
+   case CGROUP_FIELD_MEMORY_PRESSURE: CGroupEntry_printPressure(str, this->memoryPressure); return;
+   case CGROUP_FIELD_IO_PRESSURE: CGroupEntry_printPressure(str, this->ioPressure); return;
+   case CGROUP_FIELD_NAME: CGroupEntry_writeName(this, str); return;
+   default:
+      RichString_appendAscii(str, CRT_colors[PROCESS_SHADOW], "- ");
+      return;
+   }
+}
+
+static bool CGroupEntry_matchesFilter(const Row* super, const Table* table) {
+   const CGroupEntry* this = (const CGroupEntry*) super;
+   return table->incFilter && !String_contains_i(this->path, table->incFilter, true);
+}
+
+static const char* CGroupEntry_sortKeyString(Row* super) {
+   const CGroupEntry* this = (const CGroupEntry*) super;
+   return this->name;
+}
+
+static int CGroupEntry_compareByKey(const CGroupEntry* c1, const CGroupEntry* c2, RowField key) {
+   switch (key - ROW_DYNAMIC_FIELDS) {
+   case CGROUP_FIELD_CPU: return SPACESHIP_NUMBER(c1->percentCpu, c2->percentCpu);
+   case CGROUP_FIELD_MEMORY: return SPACESHIP_NUMBER(c1->memory + 1, c2->memory + 1);  /* not accounted wraps to zero */
+   case CGROUP_FIELD_IO_READ: return SPACESHIP_NUMBER(c1->readRate, c2->readRate);
+   case CGROUP_FIELD_IO_WRITE: return SPACESHIP_NUMBER(c1->writeRate, c2->writeRate);
+   case CGROUP_FIELD_TASKS: return SPACESHIP_NUMBER(c1->tasks, c2->tasks);
+   case CGROUP_FIELD_CPU_PRESSURE: return compareRealNumbers(c1->cpuPressure, c2->cpuPressure);
+   case CGROUP_FIELD_MEMORY_PRESSURE: return compareRealNumbers(c1->memoryPressure, c2->memoryPressure);
+   case CGROUP_FIELD_IO_PRESSURE: return compareRealNumbers(c1->ioPressure, c2->ioPressure);
+   default: return strcmp(c1->path, c2->path);
+   }
+}
+
+static int CGroupEntry_compare(const void* v1, const void* v2) {
+   const CGroupEntry* c1 = (const CGroupEntry*) v1;
+   const CGroupEntry* c2 = (const CGroupEntry*) v2;
+   const ScreenSettings* ss = c1->super.host->settings->ss;
+
+   int result = CGroupEntry_compareByKey(c1, c2, ScreenSettings_getActiveSortKey(ss));
+
+   // Implement tie-breaker (needed to make tree mode more stable)
+   if (!result)
+      return strcmp(c1->path, c2->path);
+
+   return (ScreenSettings_getActiveDirection(ss) == 1) ? result : -result;
+}
+
+static int CGroupEntry_compareByParent(const Row* r1, const Row* r2) {
+   int result = SPACESHIP_NUMBER(
+      r1->isRoot ? 0 : Row_getGroupOrParent(r1),
+      r2->isRoot ? 0 : Row_getGroupOrParent(r2)
+   );
+
+   if (result != 0)
+      return result;
+
+   return CGroupEntry_compare(r1, r2);
+}
+
+const RowClass CGroupEntry_class = {
+   .super = {
+      .extends = Class(Row),
+      .display = Row_display,
+      .delete = CGroupEntry_delete,
+      .compare = CGroupEntry_compare,
+   },
+   .writeField = CGroupEntry_writeField,
+   .matchesFilter = CGroupEntry_matchesFilter,
+   .sortKeyString = CGroupEntry_sortKeyString,
+   .compareByParent = CGroupEntry_compareByParent,
+};
@@ -0,0 +1,86 @@
+#ifndef HEADER_CGroupEntry
+#define HEADER_CGroupEntry
+/*
+htop - CGroupEntry.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "Machine.h"
+#include "Object.h"
+#include "Row.h"
+#include "RowField.h"
+
+
+typedef enum CGroupField_ {
+   CGROUP_FIELD_CPU,
+   CGROUP_FIELD_MEMORY,
+   CGROUP_FIELD_IO_READ,
+   CGROUP_FIELD_IO_WRITE,
+   CGROUP_FIELD_TASKS,
+   CGROUP_FIELD_CPU_PRESSURE,
+   CGROUP_FIELD_MEMORY_PRESSURE,
+   CGROUP_FIELD_IO_PRESSURE,
+   CGROUP_FIELD_NAME,
+   LAST_CGROUP_FIELD
+} CGroupField;
+
+/* The cgroup columns are the first dynamic fields */
+#define CGROUP_FIELD_KEY(field_) ((RowField)(ROW_DYNAMIC_FIELDS + (field_)))
+
+typedef struct CGroupFieldData_ {
+   const char* name;          /* in the configuration file, after "cgroups:" */
+   const char* heading;
+   const char* caption;
+   const char* description;
+   int width;                 /* negative for left aligned columns */
+} CGroupFieldData;
+
+extern const CGroupFieldData CGroupEntry_fields[LAST_CGROUP_FIELD];
+
+/*
+ * A cgroup of the v2 hierarchy. The kernel accounts the usage of a
+ * cgroup including all its descendants, so every row already holds
+ * the aggregate of its subtree.
+ */
+typedef struct CGroupEntry_ {
+   Row super;
+
+   char* path;                /* relative to the root of the hierarchy, empty for the root itself */
+   const char* name;          /* last component of the path */
+
+   bool listed;               /* whether children holds the subdirectories as of mtime */
+   struct timespec mtime;
+   char** children;
+   size_t nChildren;
+
+   bool sampled;              /* whether the counters hold a previous sample */
+   unsigned long long usageUsec;
+   unsigned long long readBytes;
+   unsigned long long writeBytes;
+
+   float percentCpu;
+   double readRate;           /* bytes per second */
+   double writeRate;
+   unsigned long long memory; /* bytes, ULLONG_MAX if not accounted */
+   long long tasks;           /* -1 without the pids controller */
+   float cpuPressure;         /* percent of the last 10s some tasks stalled, NAN if unavailable */
+   float memoryPressure;
+   float ioPressure;
+} CGroupEntry;
+
+extern const RowClass CGroupEntry_class;
+
+CGroupEntry* CGroupEntry_new(const Machine* host, int id, const char* path);
+
+void CGroupEntry_done(CGroupEntry* this);
+
+void CGroupEntry_setChildren(CGroupEntry* this, char** children, size_t nChildren);
+
+#endif
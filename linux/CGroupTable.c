@@ -0,0 +1,276 @@
+/*
+htop - CGroupTable.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/CGroupTable.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "Macros.h"
+#include "Object.h"
+#include "Row.h"
+#include "XUtils.h"
+#include "linux/CGroupEntry.h"
+
+
+/* Opens the root of the v2 hierarchy, mounted on its own or, in hybrid setups, beside the v1 controllers */
+static int CGroupTable_openHierarchy(void) {
+   static const char* const roots[] = { CGROUPDIR, CGROUPDIR "/unified" };
+
+   for (size_t i = 0; i < ARRAYSIZE(roots); i++) {
+      int fd = open(roots[i], O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+      if (fd < 0)
+         continue;
+      if (faccessat(fd, "cgroup.controllers", F_OK, 0) == 0)
+         return fd;
+      close(fd);
+   }
+   return -1;
+}
+
+CGroupTable* CGroupTable_new(Machine* host) {
+   CGroupTable* this = xCalloc(1, sizeof(CGroupTable));
+   Object_setClass(this, Class(CGroupTable));
+
+   Table* super = &this->super;
+   Table_init(super, Class(CGroupEntry), host);
+
+   this->rootFd = CGroupTable_openHierarchy();
+   return this;
+}
+
+static void CGroupTable_delete(Object* cast) {
+   CGroupTable* this = (CGroupTable*) cast;
+   Table_done(&this->super);
+   if (this->rootFd >= 0)
+      close(this->rootFd);
+   free(this);
+}
+
+/* Nothing but the cgroups screen uses the table, so it is only scanned while displayed */
+static bool CGroupTable_isActive(const CGroupTable* this) {
+   return CGroupTable_available(this) && this->super.host->activeTable == &this->super;
+}
+
+static ssize_t CGroupTable_readFile(const CGroupTable* this, const CGroupEntry* entry, const char* file, char* buffer, size_t size) {
+   char path[PATH_MAX];
+   int len = snprintf(path, sizeof(path), "%s%s%s", entry->path, entry->path[0] ? "/" : "", file);
+   if (len < 0 || (size_t)len >= sizeof(path))
+      return -1;
+
+   return xReadfileat(this->rootFd, path, buffer, size);
+}
+
+static bool CGroupTable_readValue(const CGroupTable* this, const CGroupEntry* entry, const char* file, unsigned long long* value) {
+   char buffer[32];
+   if (CGroupTable_readFile(this, entry, file, buffer, sizeof(buffer)) <= 0)
+      return false;
+
+   char* end;
+   *value = strtoull(buffer, &end, 10);
+   return end != buffer;
+}
+
+/* The share of time some tasks stalled, averaged over the last 10 seconds */
+static float CGroupTable_readPressure(const CGroupTable* this, const CGroupEntry* entry, const char* file) {
+   char buffer[256];
+   float avg10;
+   if (CGroupTable_readFile(this, entry, file, buffer, sizeof(buffer)) <= 0 ||
+       sscanf(buffer, "some avg10=%f", &avg10) != 1)
+      return NAN;
+
+   return avg10;
+}
+
+static void CGroupTable_readIO(const CGroupTable* this, const CGroupEntry* entry, unsigned long long* readBytes, unsigned long long* writeBytes) {
+   char buffer[8192];
+   *readBytes = *writeBytes = 0;
+   if (CGroupTable_readFile(this, entry, "io.stat", buffer, sizeof(buffer)) <= 0)
+      return;
+
+   /* one line per device: "MAJ:MIN rbytes=N wbytes=N rios=N wios=N dbytes=N dios=N" */
+   char* saveLine = NULL;
+   for (char* line = strtok_r(buffer, "\n", &saveLine); line; line = strtok_r(NULL, "\n", &saveLine)) {
+      char* saveField = NULL;
+      for (char* field = strtok_r(line, " ", &saveField); field; field = strtok_r(NULL, " ", &saveField)) {
+         if (String_startsWith(field, "rbytes="))
+            *readBytes += strtoull(field + strlen("rbytes="), NULL, 10);
+         else if (String_startsWith(field, "wbytes="))
+            *writeBytes += strtoull(field + strlen("wbytes="), NULL, 10);
+      }
+   }
+}
+
+static void CGroupTable_readStats(const CGroupTable* this, CGroupEntry* entry, uint64_t intervalMs) {
+   char buffer[1024];
+   unsigned long long usageUsec = 0;
+   if (CGroupTable_readFile(this, entry, "cpu.stat", buffer, sizeof(buffer)) > 0)
+      sscanf(buffer, "usage_usec %llu", &usageUsec);
+
+   unsigned long long readBytes;
+   unsigned long long writeBytes;
+   CGroupTable_readIO(this, entry, &readBytes, &writeBytes);
+
+   if (entry->sampled && intervalMs > 0) {
+      /* counters restart when a cgroup is replaced by one of the same name */
+      entry->percentCpu = usageUsec >= entry->usageUsec ? (float)(usageUsec - entry->usageUsec) / (float)intervalMs / 10.0F : 0.0F;
+      entry->readRate = readBytes >= entry->readBytes ? (double)(readBytes - entry->readBytes) * 1000.0 / (double)intervalMs : 0.0;
+      entry->writeRate = writeBytes >= entry->writeBytes ? (double)(writeBytes - entry->writeBytes) * 1000.0 / (double)intervalMs : 0.0;
+   } else {
+      /* the previous sample, if any, is from before the table was hidden */
+      entry->percentCpu = 0.0F;
+      entry->readRate = 0.0;
+      entry->writeRate = 0.0;
+   }
+   entry->usageUsec = usageUsec;
+   entry->readBytes = readBytes;
+   entry->writeBytes = writeBytes;
+   entry->sampled = true;
+
+   if (!CGroupTable_readValue(this, entry, "memory.current", &entry->memory))
+      entry->memory = ULLONG_MAX;
+
+   unsigned long long tasks;
+   entry->tasks = CGroupTable_readValue(this, entry, "pids.current", &tasks) ? (long long)tasks : -1;
+
+   entry->cpuPressure = CGroupTable_readPressure(this, entry, "cpu.pressure");
+   entry->memoryPressure = CGroupTable_readPressure(this, entry, "memory.pressure");
+   entry->ioPressure = CGroupTable_readPressure(this, entry, "io.pressure");
+}
+
+static void CGroupTable_listChildren(const CGroupTable* this, CGroupEntry* entry) {
+   int fd = openat(this->rootFd, entry->path[0] ? entry->path : ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   if (fd < 0)
+      return;
+
+   DIR* dir = fdopendir(fd);
+   if (!dir) {
+      close(fd);
+      return;
+   }
+
+   char** children = NULL;
+   size_t count = 0;
+   size_t capacity = 0;
+
+   const struct dirent* dirent;
+   while ((dirent = readdir(dir)) != NULL) {
+      if (String_eq(dirent->d_name, ".") || String_eq(dirent->d_name, ".."))
+         continue;
+
+      if (dirent->d_type == DT_UNKNOWN) {
+         struct stat sb;
+         if (fstatat(fd, dirent->d_name, &sb, AT_SYMLINK_NOFOLLOW) < 0 || !S_ISDIR(sb.st_mode))
+            continue;
+      } else if (dirent->d_type != DT_DIR) {
+         continue;
+      }
+
+      if (count == capacity) {
+         capacity = capacity ? capacity * 2 : 8;
+         children = xReallocArray(children, capacity, sizeof(char*));
+      }
+      children[count++] = xStrdup(dirent->d_name);
+   }
+   closedir(dir);
+
+   CGroupEntry_setChildren(entry, children, count);
+   entry->listed = true;
+}
+
+/* Scans the cgroup at path, then its children; path is a buffer of PATH_MAX the children are appended to */
+static void CGroupTable_scanCGroup(CGroupTable* this, char* path, int parent, uint64_t intervalMs) {
+   Table* super = &this->super;
+
+   struct stat sb;
+   if (fstatat(this->rootFd, path[0] ? path : ".", &sb, AT_SYMLINK_NOFOLLOW) < 0 || !S_ISDIR(sb.st_mode))
+      return;
+
+   /* the inode numbers of cgroupfs are unique identifiers of the cgroups */
+   int id = (int)(sb.st_ino & INT_MAX);
+   CGroupEntry* entry = (CGroupEntry*) Table_findRow(super, id);
+   if (entry && entry->super.updated)
+      return;
+
+   if (entry && !String_eq(entry->path, path)) {
+      /* renamed, or its inode number reused */
+      free_and_xStrdup(&entry->path, path);
+      const char* slash = strrchr(entry->path, '/');
+      entry->name = slash ? slash + 1 : entry->path;
+      entry->listed = false;
+      entry->sampled = false;
+   } else if (!entry) {
+      entry = CGroupEntry_new(super->host, id, path);
+      Table_add(super, &entry->super);
+   }
+
+   entry->super.parent = parent;
+   entry->super.updated = true;
+   entry->super.show = true;
+
+   if (!entry->listed ||
+       entry->mtime.tv_sec != sb.st_mtim.tv_sec ||
+       entry->mtime.tv_nsec != sb.st_mtim.tv_nsec) {
+      entry->mtime = sb.st_mtim;
+      CGroupTable_listChildren(this, entry);
+   }
+
+   CGroupTable_readStats(this, entry, intervalMs);
+
+   size_t len = strlen(path);
+   for (size_t i = 0; i < entry->nChildren; i++) {
+      int n = snprintf(path + len, PATH_MAX - len, "%s%s", len ? "/" : "", entry->children[i]);
+      if (n > 0 && (size_t)n < PATH_MAX - len)
+         CGroupTable_scanCGroup(this, path, id, intervalMs);
+      path[len] = '\0';
+   }
+}
+
+static void CGroupTable_prepareEntries(Table* super) {
+   if (CGroupTable_isActive((CGroupTable*) super))
+      Table_prepareEntries(super);
+}
+
+static void CGroupTable_iterateEntries(Table* super) {
+   CGroupTable* this = (CGroupTable*) super;
+   if (!CGroupTable_isActive(this)) {
+      /* rates restart once the table is displayed again */
+      this->lastScanMs = 0;
+      return;
+   }
+
+   uint64_t now = super->host->monotonicMs;
+   uint64_t intervalMs = this->lastScanMs ? now - this->lastScanMs : 0;
+   this->lastScanMs = now;
+
+   char path[PATH_MAX] = "";
+   CGroupTable_scanCGroup(this, path, 0, intervalMs);
+}
+
+static void CGroupTable_cleanupEntries(Table* super) {
+   if (CGroupTable_isActive((CGroupTable*) super))
+      Table_cleanupEntries(super);
+}
+
+const TableClass CGroupTable_class = {
+   .super = {
+      .extends = Class(Table),
+      .delete = CGroupTable_delete,
+   },
+   .prepare = CGroupTable_prepareEntries,
+   .iterate = CGroupTable_iterateEntries,
+   .cleanup = CGroupTable_cleanupEntries,
+};
@@ -0,0 +1,43 @@
+#ifndef HEADER_CGroupTable
+#define HEADER_CGroupTable
+/*
+htop - CGroupTable.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "Machine.h"
+#include "Table.h"
+
+
+#ifndef CGROUPDIR
+#define CGROUPDIR "/sys/fs/cgroup"
+#endif
+
+/*
+ * The cgroups of the v2 hierarchy, with their CPU, memory, I/O and
+ * pressure statistics. Scans are incremental: the subdirectories of
+ * a cgroup are only listed again once the modification time of its
+ * directory changed, which the kernel updates whenever a child cgroup
+ * is created or removed.
+ */
+typedef struct CGroupTable_ {
+   Table super;
+
+   int rootFd;                /* of the root of the v2 hierarchy, -1 without one */
+   uint64_t lastScanMs;       /* of the previous scan, 0 before the first one while displayed */
+} CGroupTable;
+
+extern const TableClass CGroupTable_class;
+
+CGroupTable* CGroupTable_new(Machine* host);
+
+static inline bool CGroupTable_available(const CGroupTable* this) {
+   return this->rootFd >= 0;
+}
+
+#endif
@@ -0,0 +1,675 @@
+/*
+htop - DBus.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/DBus.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include "Macros.h"
+#include "Platform.h"
+#include "XUtils.h"
+
+
+/* Limit of the specification, so a corrupt length cannot make us allocate without bounds */
+#define DBUS_MAX_MESSAGE (128 * 1024 * 1024)
+
+/* Nesting of containers and variants accepted in a value */
+#define DBUS_MAX_DEPTH 32
+
+enum {
+   DBUS_FIELD_PATH = 1,
+   DBUS_FIELD_INTERFACE = 2,
+   DBUS_FIELD_MEMBER = 3,
+   DBUS_FIELD_REPLY_SERIAL = 5,
+   DBUS_FIELD_DESTINATION = 6,
+   DBUS_FIELD_SIGNATURE = 8,
+};
+
+static char DBus_nativeEndianness(void) {
+   const uint16_t one = 1;
+   return *(const char*)&one ? 'l' : 'B';
+}
+
+typedef struct DBusWriter_ {
+   char* data;
+   size_t len;
+   size_t size;
+} DBusWriter;
+
+static void DBusWriter_append(DBusWriter* this, const void* bytes, size_t len) {
+   if (this->len + len > this->size) {
+      this->size = MAXIMUM(this->size * 2, this->len + len + 64);
+      this->data = xRealloc(this->data, this->size);
+   }
+   memcpy(this->data + this->len, bytes, len);
+   this->len += len;
+}
+
+static void DBusWriter_align(DBusWriter* this, size_t alignment) {
+   static const char zeros[8] = { 0 };
+   size_t padding = (alignment - this->len % alignment) % alignment;
+   DBusWriter_append(this, zeros, padding);
+}
+
+static void DBusWriter_byte(DBusWriter* this, uint8_t value) {
+   DBusWriter_append(this, &value, 1);
+}
+
+static void DBusWriter_uint32(DBusWriter* this, uint32_t value) {
+   DBusWriter_align(this, 4);
+   DBusWriter_append(this, &value, sizeof(value));
+}
+
+static void DBusWriter_string(DBusWriter* this, const char* value) {
+   size_t len = strlen(value);
+   DBusWriter_uint32(this, (uint32_t)len);
+   DBusWriter_append(this, value, len + 1);
+}
+
+static void DBusWriter_signature(DBusWriter* this, const char* value) {
+   size_t len = strlen(value);
+   DBusWriter_byte(this, (uint8_t)len);
+   DBusWriter_append(this, value, len + 1);
+}
+
+/* A header field: a struct of the field code and a variant of a string, object path or signature */
+static void DBusWriter_field(DBusWriter* this, uint8_t code, char type, const char* value) {
+   DBusWriter_align(this, 8);
+   DBusWriter_byte(this, code);
+   const char signature[2] = { type, '\0' };
+   DBusWriter_signature(this, signature);
+   if (type == 'g') {
+      DBusWriter_signature(this, value);
+   } else {
+      DBusWriter_string(this, value);
+   }
+}
+
+static bool DBus_sendAll(int fd, const char* data, size_t len) {
+   while (len) {
+      ssize_t r = send(fd, data, len, MSG_NOSIGNAL);
+      if (r < 0) {
+         if (errno == EINTR)
+            continue;
+         return false;
+      }
+      data += r;
+      len -= (size_t)r;
+   }
+   return true;
+}
+
+static bool DBus_sendCall(DBus* this, const char* destination, const char* path, const char* interface, const char* member, const char* argument) {
+   DBusWriter w = { 0 };
+
+   DBusWriter_byte(&w, (uint8_t)DBus_nativeEndianness());
+   DBusWriter_byte(&w, DBUS_METHOD_CALL);
+   DBusWriter_byte(&w, 0);                   /* flags */
+   DBusWriter_byte(&w, 1);                   /* protocol version */
+   DBusWriter_uint32(&w, 0);                 /* body length, set below */
+   DBusWriter_uint32(&w, ++this->serial);
+   DBusWriter_uint32(&w, 0);                 /* length of the header fields, set below */
+
+   DBusWriter_field(&w, DBUS_FIELD_PATH, 'o', path);
+   DBusWriter_field(&w, DBUS_FIELD_INTERFACE, 's', interface);
+   DBusWriter_field(&w, DBUS_FIELD_MEMBER, 's', member);
+   DBusWriter_field(&w, DBUS_FIELD_DESTINATION, 's', destination);
+   if (argument)
+      DBusWriter_field(&w, DBUS_FIELD_SIGNATURE, 'g', "s");
+   uint32_t fieldsLen = (uint32_t)(w.len - 16);
+
+   DBusWriter_align(&w, 8);
+   size_t bodyStart = w.len;
+   if (argument)
+      DBusWriter_string(&w, argument);
+   uint32_t bodyLen = (uint32_t)(w.len - bodyStart);
+
+   memcpy(w.data + 4, &bodyLen, sizeof(bodyLen));
+   memcpy(w.data + 12, &fieldsLen, sizeof(fieldsLen));
+
+   bool ok = DBus_sendAll(this->fd, w.data, w.len);
+   free(w.data);
+   return ok;
+}
+
+static uint32_t DBus_swap32(uint32_t value) {
+   return (value >> 24) | ((value >> 8) & 0xff00) | ((value << 8) & 0xff0000) | (value << 24);
+}
+
+static uint32_t DBus_peek32(const char* data, bool swapped) {
+   uint32_t value;
+   memcpy(&value, data, sizeof(value));
+   return swapped ? DBus_swap32(value) : value;
+}
+
+/* Parses the header fields of a complete message */
+static bool DBusMessage_parseHeader(DBusMessage* this) {
+   DBusReader r = { .message = this, .pos = 12, .end = this->len };
+   size_t end;
+   if (!DBusReader_enterArray(&r, '(', &end))
+      return false;
+
+   this->signature = "";
+   while (r.pos < end && !r.failed) {
+      DBusReader_enterStruct(&r);
+      if (r.pos >= end)
+         return false;
+      uint8_t code = (uint8_t)this->data[r.pos++];
+      const char* type = DBusReader_signature(&r);
+      if (!type)
+         return false;
+
+      if (code == DBUS_FIELD_REPLY_SERIAL && String_eq(type, "u")) {
+         this->replySerial = DBusReader_uint32(&r);
+      } else if (code == DBUS_FIELD_SIGNATURE && String_eq(type, "g")) {
+         this->signature = DBusReader_signature(&r);
+      } else if (!DBusReader_skip(&r, &type) || *type) {
+         return false;
+      }
+   }
+
+   this->bodyOffset = (end + 7) & ~(size_t)7;
+   return !r.failed && this->signature && this->bodyOffset <= this->len;
+}
+
+/* Takes the first complete message out of the received bytes: 1 if there is one, 0 if more are needed, -1 on garbage */
+static int DBus_takeMessage(DBus* this, DBusMessage** message) {
+   if (this->inLen < 16)
+      return 0;
+
+   char endianness = this->in[0];
+   if ((endianness != 'l' && endianness != 'B') || this->in[3] != 1)
+      return -1;
+
+   bool swapped = endianness != DBus_nativeEndianness();
+   uint64_t bodyLen = DBus_peek32(this->in + 4, swapped);
+   uint64_t fieldsLen = DBus_peek32(this->in + 12, swapped);
+   uint64_t total = ((16 + fieldsLen + 7) & ~(uint64_t)7) + bodyLen;
+   if (total > DBUS_MAX_MESSAGE)
+      return -1;
+   if (this->inLen < total)
+      return 0;
+
+   DBusMessage* msg = xCalloc(1, sizeof(DBusMessage));
+   msg->type = (uint8_t)this->in[1];
+   msg->swapped = swapped;
+   msg->len = (size_t)total;
+   msg->data = xMalloc(msg->len);
+   memcpy(msg->data, this->in, msg->len);
+
+   this->inLen -= msg->len;
+   memmove(this->in, this->in + msg->len, this->inLen);
+
+   if (!DBusMessage_parseHeader(msg)) {
+      DBusMessage_delete(msg);
+      return -1;
+   }
+
+   *message = msg;
+   return 1;
+}
+
+/* Receives what is available, waiting up to timeout milliseconds (0: not at all) for something to arrive */
+static bool DBus_receive(DBus* this, int timeout) {
+   if (timeout > 0) {
+      struct pollfd pfd = { .fd = this->fd, .events = POLLIN };
+      int r = poll(&pfd, 1, timeout);
+      if (r < 0)
+         return errno == EINTR;
+      if (r == 0)
+         return true;
+   }
+
+   for (;;) {
+      if (this->inSize - this->inLen < 4096) {
+         this->inSize = MAXIMUM(this->inSize * 2, this->inLen + 4096);
+         this->in = xRealloc(this->in, this->inSize);
+      }
+
+      ssize_t r = recv(this->fd, this->in + this->inLen, this->inSize - this->inLen, MSG_DONTWAIT);
+      if (r < 0) {
+         if (errno == EINTR)
+            continue;
+         return errno == EAGAIN || errno == EWOULDBLOCK;
+      }
+      if (r == 0)
+         return false;
+
+      this->inLen += (size_t)r;
+   }
+}
+
+DBusMessage* DBus_call(DBus* this, const char* destination, const char* path, const char* interface, const char* member, const char* argument) {
+   if (!DBus_sendCall(this, destination, path, interface, member, argument))
+      return NULL;
+
+   uint32_t serial = this->serial;
+   uint64_t start;
+   Platform_gettime_monotonic(&start);
+
+   for (;;) {
+      DBusMessage* msg;
+      int r;
+      while ((r = DBus_takeMessage(this, &msg)) > 0) {
+         if ((msg->type == DBUS_METHOD_RETURN || msg->type == DBUS_ERROR) && msg->replySerial == serial) {
+            if (msg->type == DBUS_METHOD_RETURN)
+               return msg;
+
+            DBusMessage_delete(msg);
+            return NULL;
+         }
+
+         if (msg->type == DBUS_SIGNAL)
+            this->signalled = true;
+         DBusMessage_delete(msg);
+      }
+      if (r < 0)
+         return NULL;
+
+      uint64_t now;
+      Platform_gettime_monotonic(&now);
+      if (now - start >= DBUS_TIMEOUT_MS)
+         return NULL;
+
+      if (!DBus_receive(this, (int)(DBUS_TIMEOUT_MS - (now - start))))
+         return NULL;
+   }
+}
+
+bool DBus_poll(DBus* this) {
+   if (!DBus_receive(this, 0))
+      return false;
+
+   DBusMessage* msg;
+   int r;
+   while ((r = DBus_takeMessage(this, &msg)) > 0) {
+      if (msg->type == DBUS_SIGNAL)
+         this->signalled = true;
+      DBusMessage_delete(msg);
+   }
+   return r == 0;
+}
+
+void DBusMessage_delete(DBusMessage* this) {
+   if (!this)
+      return;
+
+   free(this->data);
+   free(this);
+}
+
+/* SASL EXTERNAL: the server checks the credentials of the socket against the hex-encoded uid */
+static bool DBus_authenticate(int fd) {
+   char uid[16];
+   xSnprintf(uid, sizeof(uid), "%u", (unsigned int)getuid());
+
+   char command[64] = "AUTH EXTERNAL ";
+   size_t len = strlen(command);
+   for (const char* c = uid; *c; c++)
+      len += (size_t)xSnprintf(command + len, sizeof(command) - len, "%02x", (unsigned char)*c);
+   String_safeStrncpy(command + len, "\r\n", sizeof(command) - len);
+
+   if (!DBus_sendAll(fd, "", 1) || !DBus_sendAll(fd, command, strlen(command)))
+      return false;
+
+   /* the server sends nothing else before BEGIN, so its reply is all there is to read */
+   char reply[256];
+   size_t got = 0;
+   while (got < sizeof(reply) - 1 && !memchr(reply, '\n', got)) {
+      struct pollfd pfd = { .fd = fd, .events = POLLIN };
+      if (poll(&pfd, 1, DBUS_TIMEOUT_MS) <= 0)
+         return false;
+
+      ssize_t r = recv(fd, reply + got, sizeof(reply) - 1 - got, 0);
+      if (r <= 0)
+         return false;
+      got += (size_t)r;
+   }
+   reply[got] = '\0';
+
+   if (!String_startsWith(reply, "OK "))
+      return false;
+
+   static const char begin[] = "BEGIN\r\n";
+   return DBus_sendAll(fd, begin, strlen(begin));
+}
+
+/* Decodes the %XX escapes of an address value */
+static void DBus_unescape(char* value) {
+   char* out = value;
+   for (const char* in = value; *in; in++) {
+      unsigned int byte;
+      if (in[0] == '%' && in[1] && in[2] && sscanf(in + 1, "%2x", &byte) == 1) {
+         *out++ = (char)byte;
+         in += 2;
+      } else {
+         *out++ = *in;
+      }
+   }
+   *out = '\0';
+}
+
+static int DBus_connect(const char* path, bool abstract) {
+   struct sockaddr_un addr = { .sun_family = AF_UNIX };
+   size_t len = strlen(path);
+   size_t offset = abstract ? 1 : 0;
+   if (len + offset >= sizeof(addr.sun_path))
+      return -1;
+   memcpy(addr.sun_path + offset, path, len);
+
+   int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+   if (fd < 0)
+      return -1;
+
+   socklen_t addrLen = (socklen_t)(offsetof(struct sockaddr_un, sun_path) + offset + len + (abstract ? 0 : 1));
+   if (connect(fd, (struct sockaddr*)&addr, addrLen) < 0) {
+      close(fd);
+      return -1;
+   }
+   return fd;
+}
+
+/* Tries the "unix:" entries of a ';' separated address list in order */
+static int DBus_connectAddress(const char* address) {
+   char* copy = xStrdup(address);
+   int fd = -1;
+
+   char* saveEntry = NULL;
+   for (char* entry = strtok_r(copy, ";", &saveEntry); entry && fd < 0; entry = strtok_r(NULL, ";", &saveEntry)) {
+      if (!String_startsWith(entry, "unix:"))
+         continue;
+
+      char* saveKey = NULL;
+      for (char* pair = strtok_r(entry + strlen("unix:"), ",", &saveKey); pair; pair = strtok_r(NULL, ",", &saveKey)) {
+         char* value = strchr(pair, '=');
+         if (!value)
+            continue;
+         *value++ = '\0';
+         DBus_unescape(value);
+
+         if (String_eq(pair, "path")) {
+            fd = DBus_connect(value, false);
+            break;
+         }
+         if (String_eq(pair, "abstract")) {
+            fd = DBus_connect(value, true);
+            break;
+         }
+      }
+   }
+
+   free(copy);
+   return fd;
+}
+
+DBus* DBus_open(const char* address) {
+   int fd = DBus_connectAddress(address);
+   if (fd < 0)
+      return NULL;
+
+   if (!DBus_authenticate(fd)) {
+      close(fd);
+      return NULL;
+   }
+
+   DBus* this = xCalloc(1, sizeof(DBus));
+   this->fd = fd;
+
+   /* a bus only talks to clients that said hello */
+   DBusMessage* reply = DBus_call(this, "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus", "Hello", NULL);
+   if (!reply) {
+      DBus_close(this);
+      return NULL;
+   }
+   DBusMessage_delete(reply);
+
+   return this;
+}
+
+DBus* DBus_openBus(bool user) {
+   const char* address = getenv(user ? "DBUS_SESSION_BUS_ADDRESS" : "DBUS_SYSTEM_BUS_ADDRESS");
+   if (address && *address)
+      return DBus_open(address);
+
+   if (!user)
+      return DBus_open("unix:path=/run/dbus/system_bus_socket;unix:path=/var/run/dbus/system_bus_socket");
+
+   const char* runtimeDir = getenv("XDG_RUNTIME_DIR");
+   if (!runtimeDir || !*runtimeDir)
+      return NULL;
+
+   char* userAddress = String_cat("unix:path=", runtimeDir);
+   char* busAddress = String_cat(userAddress, "/bus");
+   DBus* this = DBus_open(busAddress);
+   free(busAddress);
+   free(userAddress);
+   return this;
+}
+
+void DBus_close(DBus* this) {
+   if (!this)
+      return;
+
+   close(this->fd);
+   free(this->in);
+   free(this);
+}
+
+static bool DBusReader_fail(DBusReader* this) {
+   this->failed = true;
+   this->pos = this->end;
+   return false;
+}
+
+static bool DBusReader_align(DBusReader* this, size_t alignment) {
+   size_t pos = (this->pos + alignment - 1) & ~(alignment - 1);
+   if (pos > this->end)
+      return DBusReader_fail(this);
+
+   this->pos = pos;
+   return true;
+}
+
+static bool DBusReader_advance(DBusReader* this, size_t alignment, size_t len) {
+   if (!DBusReader_align(this, alignment) || this->end - this->pos < len)
+      return DBusReader_fail(this);
+
+   this->pos += len;
+   return true;
+}
+
+void DBusReader_init(DBusReader* this, const DBusMessage* message) {
+   *this = (DBusReader) {
+      .message = message,
+      .pos = message->bodyOffset,
+      .end = message->len,
+   };
+}
+
+uint32_t DBusReader_uint32(DBusReader* this) {
+   if (!DBusReader_advance(this, 4, 4))
+      return 0;
+
+   return DBus_peek32(this->message->data + this->pos - 4, this->message->swapped);
+}
+
+/* Takes len bytes and the NUL terminating them */
+static const char* DBusReader_takeString(DBusReader* this, size_t len) {
+   if (this->failed || this->end - this->pos < len + 1 || this->message->data[this->pos + len] != '\0') {
+      DBusReader_fail(this);
+      return NULL;
+   }
+
+   const char* value = this->message->data + this->pos;
+   this->pos += len + 1;
+   return value;
+}
+
+const char* DBusReader_string(DBusReader* this) {
+   uint32_t len = DBusReader_uint32(this);
+   return DBusReader_takeString(this, len);
+}
+
+const char* DBusReader_signature(DBusReader* this) {
+   if (this->pos >= this->end) {
+      DBusReader_fail(this);
+      return NULL;
+   }
+
+   size_t len = (unsigned char)this->message->data[this->pos++];
+   return DBusReader_takeString(this, len);
+}
+
+static size_t DBus_alignment(char type) {
+   switch (type) {
+      case 'y':
+      case 'g':
+      case 'v':
+         return 1;
+      case 'n':
+      case 'q':
+         return 2;
+      case 'b':
+      case 'i':
+      case 'u':
+      case 'h':
+      case 's':
+      case 'o':
+      case 'a':
+         return 4;
+      case 'x':
+      case 't':
+      case 'd':
+      case '(':
+      case '{':
+         return 8;
+      default:
+         return 0;
+   }
+}
+
+bool DBusReader_enterArray(DBusReader* this, char elementType, size_t* end) {
+   size_t alignment = DBus_alignment(elementType);
+   uint32_t len = DBusReader_uint32(this);
+   if (this->failed || !alignment || !DBusReader_align(this, alignment) || this->end - this->pos < len)
+      return DBusReader_fail(this);
+
+   *end = this->pos + len;
+   return true;
+}
+
+void DBusReader_enterStruct(DBusReader* this) {
+   DBusReader_align(this, 8);
+}
+
+/* Returns the end of the first complete type of a signature, or NULL if it is not valid */
+static const char* DBus_typeEnd(const char* sig, unsigned int depth) {
+   if (depth > DBUS_MAX_DEPTH)
+      return NULL;
+
+   switch (*sig) {
+      case 'a':
+         return DBus_typeEnd(sig + 1, depth + 1);
+      case '(':
+      case '{': {
+         char close = *sig == '(' ? ')' : '}';
+         sig++;
+         while (*sig != close) {
+            sig = *sig ? DBus_typeEnd(sig, depth + 1) : NULL;
+            if (!sig)
+               return NULL;
+         }
+         return sig + 1;
+      }
+      default:
+         return DBus_alignment(*sig) ? sig + 1 : NULL;
+   }
+}
+
+static bool DBusReader_skipValue(DBusReader* this, const char** signature, unsigned int depth) {
+   const char* sig = *signature;
+   if (depth > DBUS_MAX_DEPTH)
+      return DBusReader_fail(this);
+
+   switch (*sig) {
+      case 'y':
+      case 'n':
+      case 'q':
+      case 'b':
+      case 'i':
+      case 'u':
+      case 'h':
+      case 'x':
+      case 't':
+      case 'd': {
+         size_t size = DBus_alignment(*sig);
+         if (!DBusReader_advance(this, size, size))
+            return false;
+         sig++;
+         break;
+      }
+      case 's':
+      case 'o':
+         if (!DBusReader_string(this))
+            return false;
+         sig++;
+         break;
+      case 'g':
+         if (!DBusReader_signature(this))
+            return false;
+         sig++;
+         break;
+      case 'v': {
+         const char* inner = DBusReader_signature(this);
+         if (!inner || !DBusReader_skipValue(this, &inner, depth + 1) || *inner)
+            return DBusReader_fail(this);
+         sig++;
+         break;
+      }
+      case 'a': {
+         /* the elements are skipped as a whole */
+         const char* next = DBus_typeEnd(sig, depth);
+         size_t end;
+         if (!next || !DBusReader_enterArray(this, sig[1], &end))
+            return DBusReader_fail(this);
+         this->pos = end;
+         sig = next;
+         break;
+      }
+      case '(':
+      case '{': {
+         char close = *sig == '(' ? ')' : '}';
+         if (!DBusReader_align(this, 8))
+            return false;
+         sig++;
+         while (*sig != close) {
+            if (!*sig || !DBusReader_skipValue(this, &sig, depth + 1))
+               return DBusReader_fail(this);
+         }
+         sig++;
+         break;
+      }
+      default:
+         return DBusReader_fail(this);
+   }
+
+   *signature = sig;
+   return true;
+}
+
+bool DBusReader_skip(DBusReader* this, const char** signature) {
+   return DBusReader_skipValue(this, signature, 0);
+}
@@ -0,0 +1,94 @@
+#ifndef HEADER_DBus
+#define HEADER_DBus
+/*
+htop - DBus.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/*
+ * A minimal D-Bus client: one connection to a bus over a UNIX socket,
+ * synchronous method calls with at most one string argument, and the
+ * reading of their replies. Signals arriving in between are only noted,
+ * so a caller can tell whether something changed since it last looked.
+ */
+
+/* Milliseconds to wait for the reply of a method call */
+#define DBUS_TIMEOUT_MS 1000
+
+typedef struct DBus_ {
+   int fd;
+   uint32_t serial;           /* of the last message sent */
+   bool signalled;            /* whether a signal arrived since the flag was last cleared */
+   char* in;                  /* received bytes not yet parsed */
+   size_t inLen;
+   size_t inSize;
+} DBus;
+
+typedef enum DBusMessageType_ {
+   DBUS_METHOD_CALL = 1,
+   DBUS_METHOD_RETURN = 2,
+   DBUS_ERROR = 3,
+   DBUS_SIGNAL = 4,
+} DBusMessageType;
+
+typedef struct DBusMessage_ {
+   uint8_t type;
+   bool swapped;              /* whether the message is of the other endianness */
+   uint32_t replySerial;
+   const char* signature;     /* of the body, points into data */
+   size_t bodyOffset;
+   char* data;                /* the whole message */
+   size_t len;
+} DBusMessage;
+
+/* Cursor over the values of a message; alignment is relative to the start of the message */
+typedef struct DBusReader_ {
+   const DBusMessage* message;
+   size_t pos;
+   size_t end;
+   bool failed;               /* set by any read past the end or of a malformed value */
+} DBusReader;
+
+/* Connects to a bus address like "unix:path=/run/dbus/system_bus_socket"; returns NULL on failure */
+DBus* DBus_open(const char* address);
+
+/* Connects to the system bus, or to the bus of the user, honouring the DBUS_*_BUS_ADDRESS variables */
+DBus* DBus_openBus(bool user);
+
+void DBus_close(DBus* this);
+
+/* Calls a method with no argument or one string argument; returns NULL on errors and timeouts */
+DBusMessage* DBus_call(DBus* this, const char* destination, const char* path, const char* interface, const char* member, const char* argument);
+
+/* Reads whatever arrived without blocking; returns false if the connection broke */
+bool DBus_poll(DBus* this);
+
+void DBusMessage_delete(DBusMessage* this);
+
+void DBusReader_init(DBusReader* this, const DBusMessage* message);
+
+uint32_t DBusReader_uint32(DBusReader* this);
+
+/* Reads a string or object path; the result points into the message */
+const char* DBusReader_string(DBusReader* this);
+
+/* Reads the signature of a variant; the result points into the message */
+const char* DBusReader_signature(DBusReader* this);
+
+/* Enters an array whose elements have the alignment of elementType; sets *end to the position past it */
+bool DBusReader_enterArray(DBusReader* this, char elementType, size_t* end);
+
+/* Aligns to the start of a struct or dict entry */
+void DBusReader_enterStruct(DBusReader* this);
+
+/* Skips one value of the first complete type of *signature, advancing *signature past that type */
+bool DBusReader_skip(DBusReader* this, const char** signature);
+
+#endif
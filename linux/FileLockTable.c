@@ -0,0 +1,200 @@
+/*
+htop - FileLockTable.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/FileLockTable.h"
+
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/sysmacros.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+#include "linux/LinuxMachine.h"
+
+
+/* Deepest chain of requests waiting on one another that is followed */
+#define FILELOCK_MAX_LEVELS 16
+
+void FileLockTable_init(FileLockTable* this) {
+   memset(this, 0, sizeof(FileLockTable));
+   ProcFile_init(&this->file, PROCDIR "/locks");
+   this->byFile = Hashtable_new(64, false);
+   this->byPid = Hashtable_new(64, false);
+}
+
+void FileLockTable_done(FileLockTable* this) {
+   ProcFile_done(&this->file);
+   Hashtable_delete(this->byFile);
+   Hashtable_delete(this->byPid);
+   free(this->locks);
+}
+
+/* Copies the next blank separated word, advancing *str */
+static bool FileLockTable_parseWord(const char** str, char* word, size_t size) {
+   const char* p = ProcFile_skipBlanks(*str);
+   size_t len = 0;
+   for (; *p && *p != ' ' && *p != '\t'; p++) {
+      if (len + 1 < size)
+         word[len++] = *p;
+   }
+   word[len] = '\0';
+   *str = p;
+   return len > 0;
+}
+
+static bool FileLockTable_parseHexNumber(const char** str, unsigned int* value) {
+   char* end;
+   unsigned long v = strtoul(*str, &end, 16);
+   if (end == *str)
+      return false;
+
+   *value = (unsigned int)v;
+   *str = end;
+   return true;
+}
+
+/*
+ * Parses "ID: [->] KIND MODE ACCESS PID MAJ:MIN:INODE START END", where the
+ * requests blocked by a lock follow it with "->" after as many blanks as
+ * they are deep in the chain of waiters, less one; returns that depth.
+ */
+static int FileLockTable_parseLine(const char* line, FileLock* lock) {
+   const char* p = line;
+   unsigned long long int id;
+   if (!ProcFile_parseULL(&p, &id) || *p != ':')
+      return -1;
+   p++;
+   lock->id = (unsigned int)id;
+
+   int level = 0;
+   const char* arrow = ProcFile_skipBlanks(p);
+   if (String_startsWith(arrow, "->")) {
+      level = (int)(arrow - p);
+      p = arrow + 2;
+   }
+
+   if (!FileLockTable_parseWord(&p, lock->kind, sizeof(lock->kind)) ||
+       !FileLockTable_parseWord(&p, lock->mode, sizeof(lock->mode)) ||
+       !FileLockTable_parseWord(&p, lock->access, sizeof(lock->access)))
+      return -1;
+
+   p = ProcFile_skipBlanks(p);
+   bool negative = *p == '-';
+   if (negative)
+      p++;
+   unsigned long long int pid;
+   if (!ProcFile_parseULL(&p, &pid))
+      return -1;
+   lock->pid = negative ? -(pid_t)pid : (pid_t)pid;
+
+   unsigned int major;
+   unsigned int minor;
+   p = ProcFile_skipBlanks(p);
+   if (!FileLockTable_parseHexNumber(&p, &major) || *p++ != ':' ||
+       !FileLockTable_parseHexNumber(&p, &minor) || *p++ != ':' ||
+       !ProcFile_parseULL(&p, &lock->inode))
+      return -1;
+   lock->dev = makedev(major, minor);
+
+   if (!ProcFile_parseULL(&p, &lock->start))
+      return -1;
+   p = ProcFile_skipBlanks(p);
+   if (String_startsWith(p, "EOF"))
+      lock->end = ULLONG_MAX;
+   else if (!ProcFile_parseULL(&p, &lock->end))
+      return -1;
+
+   return level;
+}
+
+static bool FileLock_isOn(const void* cast, const void* fileCast) {
+   const FileLock* lock = cast;
+   const FileLock* file = fileCast;
+   return lock->dev == file->dev && lock->inode == file->inode;
+}
+
+/* Key under which the locks of a file are, or would be */
+static ht_key_t FileLockTable_findFile(const FileLockTable* this, dev_t dev, unsigned long long int inode, FileLock** head) {
+   const uint64_t words[] = { (uint64_t)dev, inode };
+   const FileLock file = { .dev = dev, .inode = inode };
+   ht_key_t key;
+   *head = Hashtable_find(this->byFile, Hashtable_hashBytes(HASHTABLE_HASH_INIT, words, sizeof(words)), FileLock_isOn, &file, &key);
+   return key;
+}
+
+void FileLockTable_update(FileLockTable* this) {
+   Hashtable_clear(this->byFile);
+   Hashtable_clear(this->byPid);
+   this->count = 0;
+   this->files = 0;
+   this->waiting = 0;
+
+   this->valid = ProcFile_read(&this->file);
+   if (!this->valid)
+      return;
+
+   /* the lock or request last seen at each depth, the one a deeper request waits for */
+   int chain[FILELOCK_MAX_LEVELS];
+   for (size_t i = 0; i < ARRAYSIZE(chain); i++)
+      chain[i] = -1;
+
+   char* cursor = NULL;
+   char* line;
+   while ((line = ProcFile_nextLine(&this->file, &cursor)) != NULL) {
+      if (this->count == this->capacity) {
+         this->capacity = this->capacity ? this->capacity * 2 : 64;
+         this->locks = xReallocArray(this->locks, this->capacity, sizeof(FileLock));
+      }
+
+      FileLock* lock = &this->locks[this->count];
+      memset(lock, 0, sizeof(FileLock));
+      int level = FileLockTable_parseLine(line, lock);
+      if (level < 0)
+         continue;
+
+      level = MINIMUM(level, FILELOCK_MAX_LEVELS - 1);
+      lock->blocker = level > 0 ? chain[level - 1] : -1;
+      chain[level] = (int)this->count;
+
+      if (lock->blocker >= 0) {
+         this->waiting++;
+         for (int i = lock->blocker; i >= 0; i = this->locks[i].blocker)
+            this->locks[i].waiters++;
+      }
+      this->count++;
+   }
+
+   /* indexed backwards, so the chains list locks in the order of the file */
+   for (size_t i = this->count; i-- > 0;) {
+      FileLock* lock = &this->locks[i];
+
+      FileLock* head;
+      ht_key_t key = FileLockTable_findFile(this, lock->dev, lock->inode, &head);
+      lock->nextOnFile = head ? (int)(head - this->locks) : -1;
+      if (!head)
+         this->files++;
+      Hashtable_put(this->byFile, key, lock);
+
+      FileLock* first = Hashtable_get(this->byPid, (ht_key_t)lock->pid);
+      lock->nextOfPid = first ? (int)(first - this->locks) : -1;
+      Hashtable_put(this->byPid, (ht_key_t)lock->pid, lock);
+   }
+}
+
+const FileLock* FileLockTable_firstOnFile(const FileLockTable* this, dev_t dev, unsigned long long int inode) {
+   FileLock* head;
+   FileLockTable_findFile(this, dev, inode, &head);
+   return head;
+}
+
+const FileLock* FileLockTable_firstOfPid(const FileLockTable* this, pid_t pid) {
+   return Hashtable_get(this->byPid, (ht_key_t)pid);
+}
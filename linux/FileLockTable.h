@@ -0,0 +1,69 @@
+#ifndef HEADER_FileLockTable
+#define HEADER_FileLockTable
+/*
+htop - FileLockTable.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "Hashtable.h"
+#include "linux/ProcFile.h"
+
+
+/* A line of /proc/locks: a lock held, or a request waiting for one */
+typedef struct FileLock_ {
+   unsigned int id;               /* shared by a lock and the requests it blocks */
+   char kind[8];                  /* POSIX, FLOCK, OFDLCK, LEASE, DELEG */
+   char mode[12];                 /* ADVISORY, MANDATORY, or the state of a lease */
+   char access[8];                /* READ, WRITE, ... */
+   pid_t pid;                     /* -1 for locks owned by open files rather than processes */
+   dev_t dev;
+   unsigned long long int inode;
+   unsigned long long int start;
+   unsigned long long int end;    /* ULLONG_MAX up to the end of the file */
+   int blocker;                   /* index of the lock this request waits for, -1 if it holds it */
+   unsigned int waiters;          /* requests waiting for this lock, directly or not */
+   int nextOnFile;                /* index of the next lock on the same file, -1 after the last */
+   int nextOfPid;                 /* index of the next lock of the same process, -1 after the last */
+} FileLock;
+
+/*
+ * All file locks of the system, from one read of /proc/locks, indexed by
+ * file and by process: the cost depends on the number of locks only, not
+ * on how many files processes hold open.
+ */
+typedef struct FileLockTable_ {
+   ProcFile file;
+   FileLock* locks;               /* in the order of /proc/locks, waiters following their lock */
+   size_t count;
+   size_t capacity;
+   Hashtable* byFile;             /* first FileLock on a file, by hash of device and inode */
+   Hashtable* byPid;              /* first FileLock of a process */
+   size_t files;                  /* files locked */
+   size_t waiting;                /* requests waiting */
+   bool valid;                    /* whether the last update could read /proc/locks */
+} FileLockTable;
+
+void FileLockTable_init(FileLockTable* this);
+
+void FileLockTable_done(FileLockTable* this);
+
+void FileLockTable_update(FileLockTable* this);
+
+/* The first lock on a file, the others following through nextOnFile */
+const FileLock* FileLockTable_firstOnFile(const FileLockTable* this, dev_t dev, unsigned long long int inode);
+
+/* The first lock of a process, the others following through nextOfPid */
+const FileLock* FileLockTable_firstOfPid(const FileLockTable* this, pid_t pid);
+
+static inline const FileLock* FileLockTable_next(const FileLockTable* this, int index) {
+   return index >= 0 ? &this->locks[index] : NULL;
+}
+
+#endif
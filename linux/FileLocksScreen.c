@@ -0,0 +1,186 @@
+/*
+htop - FileLocksScreen.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/FileLocksScreen.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <sys/sysmacros.h>
+
+#include "Macros.h"
+#include "Panel.h"
+#include "Process.h"
+#include "ProvideCurses.h"
+#include "Row.h"
+#include "Table.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+
+FileLocksScreen* FileLocksScreen_new(Machine* host) {
+   FileLocksScreen* this = xCalloc(1, sizeof(FileLocksScreen));
+   Object_setClass(this, Class(FileLocksScreen));
+   this->host = host;
+   FileLockTable_init(&this->locks);
+   return (FileLocksScreen*) InfoScreen_init(&this->super, NULL, NULL, LINES - 2, " ");
+}
+
+void FileLocksScreen_delete(Object* cast) {
+   FileLocksScreen* this = (FileLocksScreen*) cast;
+   FileLockTable_done(&this->locks);
+   free(this->files);
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void FileLocksScreen_draw(InfoScreen* super) {
+   const FileLocksScreen* this = (const FileLocksScreen*) super;
+   const FileLockTable* locks = &this->locks;
+
+   InfoScreen_drawTitled(super, "File locks of all processes: %zu locks on %zu files, %zu requests waiting",
+                         locks->count - locks->waiting, locks->files, locks->waiting);
+}
+
+/* Requests waiting on a file, whichever lock they wait for */
+static unsigned int FileLocksScreen_waitingOn(const FileLockTable* locks, const FileLock* first) {
+   unsigned int waiting = 0;
+   for (const FileLock* lock = first; lock; lock = FileLockTable_next(locks, lock->nextOnFile)) {
+      if (lock->blocker >= 0)
+         waiting++;
+   }
+   return waiting;
+}
+
+static const FileLockTable* FileLocksScreen_sorting;
+
+static int FileLocksScreen_compareFiles(const void* v1, const void* v2) {
+   const FileLock* f1 = *(const FileLock* const*)v1;
+   const FileLock* f2 = *(const FileLock* const*)v2;
+
+   int result = SPACESHIP_NUMBER(FileLocksScreen_waitingOn(FileLocksScreen_sorting, f2), FileLocksScreen_waitingOn(FileLocksScreen_sorting, f1));
+   if (result)
+      return result;
+
+   result = SPACESHIP_NUMBER(f1->dev, f2->dev);
+   return result ? result : SPACESHIP_NUMBER(f1->inode, f2->inode);
+}
+
+static void FileLocksScreen_addLock(FileLocksScreen* this, const FileLock* lock, bool first) {
+   const FileLockTable* locks = &this->locks;
+
+   char file[48] = "";
+   if (first)
+      xSnprintf(file, sizeof(file), "%u:%u:%llu", major(lock->dev), minor(lock->dev), lock->inode);
+
+   char range[48];
+   if (lock->end == ULLONG_MAX)
+      xSnprintf(range, sizeof(range), "%llu-EOF", lock->start);
+   else
+      xSnprintf(range, sizeof(range), "%llu-%llu", lock->start, lock->end);
+
+   char state[32];
+   if (lock->blocker >= 0) {
+      const FileLock* blocker = &locks->locks[lock->blocker];
+      if (blocker->pid > 0)
+         xSnprintf(state, sizeof(state), "waits for %d", (int)blocker->pid);
+      else
+         xSnprintf(state, sizeof(state), "waits");
+   } else if (lock->waiters) {
+      xSnprintf(state, sizeof(state), "blocks %u", lock->waiters);
+   } else {
+      xSnprintf(state, sizeof(state), "holds");
+   }
+
+   char pid[16] = "";
+   const char* command = "";
+   if (lock->pid > 0) {
+      xSnprintf(pid, sizeof(pid), "%d", (int)lock->pid);
+      const Row* row = Table_findRow(this->host->processTable, lock->pid);
+      if (row) {
+         command = Process_getCommand((const Process*) row);
+         if (!command)
+            command = "";
+      }
+   } else {
+      command = "(open file description)";
+   }
+
+   char entry[512];
+   xSnprintf(entry, sizeof(entry), "%-24.24s %-6.6s %-9.9s %-5.5s %-22.22s %-17.17s %*s  %s",
+             file, lock->kind, lock->mode, lock->access, range, state, Process_pidDigits, pid, command);
+
+   /* the arguments of a command line are kept apart by newlines */
+   for (char* c = entry; *c; c++) {
+      if (*c == '\n')
+         *c = ' ';
+   }
+   InfoScreen_addLine(&this->super, entry);
+}
+
+static void FileLocksScreen_scan(InfoScreen* super) {
+   FileLocksScreen* this = (FileLocksScreen*) super;
+   FileLockTable* locks = &this->locks;
+   Panel* panel = super->display;
+   int idx = Panel_getSelectedIndex(panel);
+   Panel_prune(panel);
+   Vector_prune(super->lines);
+
+   char header[160];
+   xSnprintf(header, sizeof(header), "%-24s %-6s %-9s %-5s %-22s %-17s %*s  %s",
+             "DEVICE:INODE", "KIND", "MODE", "R/W", "RANGE", "STATE", Process_pidDigits, "PID", "COMMAND");
+   Panel_setHeader(panel, header);
+
+   FileLockTable_update(locks);
+   if (!locks->valid) {
+      InfoScreen_addLine(super, "Could not read " PROCDIR "/locks.");
+      return;
+   }
+
+   if (this->filesCapacity < locks->files) {
+      this->filesCapacity = locks->files;
+      this->files = xReallocArray(this->files, this->filesCapacity, sizeof(const FileLock*));
+   }
+
+   /* the first lock of a file heads its chain */
+   size_t files = 0;
+   for (size_t i = 0; i < locks->count; i++) {
+      const FileLock* lock = &locks->locks[i];
+      if (FileLockTable_firstOnFile(locks, lock->dev, lock->inode) == lock)
+         this->files[files++] = lock;
+   }
+
+   FileLocksScreen_sorting = locks;
+   qsort(this->files, files, sizeof(const FileLock*), FileLocksScreen_compareFiles);
+   FileLocksScreen_sorting = NULL;
+
+   for (size_t i = 0; i < files; i++) {
+      bool first = true;
+      for (const FileLock* lock = this->files[i]; lock; lock = FileLockTable_next(locks, lock->nextOnFile)) {
+         FileLocksScreen_addLock(this, lock, first);
+         first = false;
+      }
+   }
+
+   Panel_setSelected(panel, idx);
+}
+
+/* Reads the locks again whenever no key was pressed within the update delay */
+static void FileLocksScreen_update(InfoScreen* super) {
+   FileLocksScreen_scan(super);
+   InfoScreen_draw(super);
+}
+
+const InfoScreenClass FileLocksScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = FileLocksScreen_delete
+   },
+   .scan = FileLocksScreen_scan,
+   .draw = FileLocksScreen_draw,
+   .onErr = FileLocksScreen_update
+};
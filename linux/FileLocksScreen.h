@@ -0,0 +1,32 @@
+#ifndef HEADER_FileLocksScreen
+#define HEADER_FileLocksScreen
+/*
+htop - FileLocksScreen.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stddef.h>
+
+#include "InfoScreen.h"
+#include "Machine.h"
+#include "Object.h"
+#include "linux/FileLockTable.h"
+
+
+typedef struct FileLocksScreen_ {
+   InfoScreen super;
+   Machine* host;                 /* whose process table names the owners */
+   FileLockTable locks;
+   const FileLock** files;        /* first lock of each file, most waited for first */
+   size_t filesCapacity;
+} FileLocksScreen;
+
+extern const InfoScreenClass FileLocksScreen_class;
+
+FileLocksScreen* FileLocksScreen_new(Machine* host);
+
+void FileLocksScreen_delete(Object* this);
+
+#endif
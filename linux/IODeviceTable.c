@@ -0,0 +1,298 @@
+/*
+htop - IODeviceTable.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/IODeviceTable.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "Macros.h"
+#include "Platform.h"
+#include "XUtils.h"
+
+
+void IODeviceTable_init(IODeviceTable* this) {
+   *this = (IODeviceTable) {
+      .disks = Hashtable_new(16, false),
+      .interfaces = Hashtable_new(16, false),
+   };
+   ProcFile_init(&this->diskstats, PROCDIR "/diskstats");
+   ProcFile_init(&this->netdev, PROCDIR "/net/dev");
+}
+
+void IODeviceTable_done(IODeviceTable* this) {
+   if (!this->disks)
+      return;
+
+   for (size_t i = 0; i < this->count; i++)
+      free(this->devices[i]);
+   free(this->devices);
+   Hashtable_delete(this->disks);
+   Hashtable_delete(this->interfaces);
+   ProcFile_done(&this->diskstats);
+   ProcFile_done(&this->netdev);
+   *this = (IODeviceTable) { .diskstats = { .fd = -1 }, .netdev = { .fd = -1 } };
+}
+
+static bool IODevice_isNamed(const IODevice* this, const char* name, size_t len) {
+   return strncmp(this->name, name, len) == 0 && this->name[len] == '\0';
+}
+
+static IODevice* IODeviceTable_add(IODeviceTable* this, IODeviceKind kind, ht_key_t key, const char* name, size_t len) {
+   if (this->count == this->capacity) {
+      this->capacity = this->capacity ? this->capacity * 2 : 16;
+      this->devices = xReallocArray(this->devices, this->capacity, sizeof(IODevice*));
+   }
+
+   IODevice* dev = xCalloc(1, sizeof(IODevice));
+   dev->kind = kind;
+   dev->key = key;
+   memcpy(dev->name, name, len);
+   dev->name[len] = '\0';
+   this->devices[this->count++] = dev;
+   return dev;
+}
+
+static IODevice* IODeviceTable_getDisk(IODeviceTable* this, unsigned int major, unsigned int minor, const char* name, size_t len) {
+   ht_key_t key = (major << 20) | (minor & 0xfffff);
+   IODevice* dev = Hashtable_get(this->disks, key);
+   if (!dev) {
+      dev = IODeviceTable_add(this, IODEVICE_DISK, key, name, len);
+      Hashtable_put(this->disks, key, dev);
+   } else if (!IODevice_isNamed(dev, name, len)) {
+      /* the device number got reused by another disk */
+      *dev = (IODevice) { .kind = IODEVICE_DISK, .key = key };
+      memcpy(dev->name, name, len);
+      dev->name[len] = '\0';
+   }
+   return dev;
+}
+
+/*
+ * Interfaces are keyed by a hash of their name. Colliding names are rare
+ * enough to be looked up among all devices; one that finds its slot free
+ * again (the other interface went away) takes it over.
+ */
+static IODevice* IODeviceTable_getInterface(IODeviceTable* this, const char* name, size_t len) {
+   ht_key_t key = Hashtable_hashBytes(HASHTABLE_HASH_INIT, name, len);
+   IODevice* slot = Hashtable_get(this->interfaces, key);
+   if (slot && IODevice_isNamed(slot, name, len))
+      return slot;
+
+   IODevice* dev = NULL;
+   for (size_t i = 0; i < this->count; i++) {
+      IODevice* candidate = this->devices[i];
+      if (candidate->kind == IODEVICE_INTERFACE && IODevice_isNamed(candidate, name, len)) {
+         dev = candidate;
+         break;
+      }
+   }
+
+   if (!dev)
+      dev = IODeviceTable_add(this, IODEVICE_INTERFACE, key, name, len);
+   if (!slot)
+      Hashtable_put(this->interfaces, key, dev);
+   return dev;
+}
+
+static double IODevice_rate(uint64_t now, uint64_t before, double seconds) {
+   return now > before ? (double)(now - before) / seconds : 0.0;
+}
+
+/* Stores the counters of this pass and the rates since the last one, if the device was listed there */
+static void IODevice_record(IODevice* this, unsigned int generation, double seconds, const uint64_t counters[6]) {
+   uint64_t readBytes = counters[0], writeBytes = counters[1];
+   uint64_t readOps = counters[2], writeOps = counters[3];
+   uint64_t busyMs = counters[4], waitMs = counters[5];
+
+   this->hasRates = seconds > 0.0 && this->generation == generation - 1;
+   if (this->hasRates) {
+      this->readRate = IODevice_rate(readBytes, this->readBytes, seconds);
+      this->writeRate = IODevice_rate(writeBytes, this->writeBytes, seconds);
+      this->opsRate = IODevice_rate(readOps + writeOps, this->readOps + this->writeOps, seconds);
+      this->utilisation = MINIMUM(IODevice_rate(busyMs, this->busyMs, seconds) / 10.0, 100.0);
+
+      uint64_t ops = readOps + writeOps - this->readOps - this->writeOps;
+      this->waitTime = ops && waitMs > this->waitMs ? (double)(waitMs - this->waitMs) / (double)ops : 0.0;
+
+      this->history[this->historyHead] = (float)IODevice_throughput(this);
+      this->historyHead = (this->historyHead + 1) % IODEVICE_HISTORY;
+      this->historyCount = MINIMUM(this->historyCount + 1, IODEVICE_HISTORY);
+   } else {
+      this->readRate = this->writeRate = this->opsRate = 0.0;
+      this->utilisation = this->waitTime = 0.0;
+   }
+
+   this->readBytes = readBytes;
+   this->writeBytes = writeBytes;
+   this->readOps = readOps;
+   this->writeOps = writeOps;
+   this->busyMs = busyMs;
+   this->waitMs = waitMs;
+   this->generation = generation;
+}
+
+static bool IODeviceTable_scanDisks(IODeviceTable* this, double seconds) {
+   if (!ProcFile_read(&this->diskstats))
+      return false;
+
+   const char* lastTopDisk = NULL;
+   size_t lastTopDiskLen = 0;
+
+   /* "major minor name" followed by the statistics, see Documentation/admin-guide/iostats.rst */
+   char* cursor = NULL;
+   for (char* line; (line = ProcFile_nextLine(&this->diskstats, &cursor)) != NULL; ) {
+      const char* p = line;
+      unsigned long long int major, minor;
+      if (!ProcFile_parseULL(&p, &major) || !ProcFile_parseULL(&p, &minor))
+         continue;
+
+      const char* name = ProcFile_skipBlanks(p);
+      p = ProcFile_skipField(p);
+      size_t nameLen = (size_t)(p - name);
+      if (nameLen == 0 || nameLen >= sizeof(((IODevice*)NULL)->name))
+         continue;
+
+      unsigned long long int stats[11];
+      size_t n = 0;
+      while (n < ARRAYSIZE(stats) && ProcFile_parseULL(&p, &stats[n]))
+         n++;
+      if (n < ARRAYSIZE(stats))
+         continue;
+
+      IODevice* dev = IODeviceTable_getDisk(this, (unsigned int)major, (unsigned int)minor, name, nameLen);
+
+      /* only count root disks, e.g. do not count IO from sda and sda1 twice;
+         this assumes disks are listed directly before any of their partitions */
+      bool partition = lastTopDisk && nameLen >= lastTopDiskLen && strncmp(name, lastTopDisk, lastTopDiskLen) == 0;
+      dev->counted = !partition && !String_startsWith(dev->name, "dm-") && !String_startsWith(dev->name, "zram");
+      if (!partition && dev->counted) {
+         lastTopDisk = dev->name;
+         lastTopDiskLen = nameLen;
+      }
+
+      /* sectors of 512 bytes read and written, requests completed, milliseconds doing IO and reading plus writing */
+      const uint64_t counters[6] = { 512 * stats[2], 512 * stats[6], stats[0], stats[4], stats[9], stats[3] + stats[7] };
+      IODevice_record(dev, this->generation, seconds, counters);
+   }
+
+   return true;
+}
+
+static bool IODeviceTable_scanInterfaces(IODeviceTable* this, double seconds) {
+   if (!ProcFile_read(&this->netdev))
+      return false;
+
+   /* "name: 8 receive counters 8 transmit counters", after two header lines without colon */
+   char* cursor = NULL;
+   for (char* line; (line = ProcFile_nextLine(&this->netdev, &cursor)) != NULL; ) {
+      const char* colon = strchr(line, ':');
+      if (!colon)
+         continue;
+
+      const char* name = ProcFile_skipBlanks(line);
+      size_t nameLen = (size_t)(colon - name);
+      if (nameLen == 0 || nameLen >= sizeof(((IODevice*)NULL)->name))
+         continue;
+
+      const char* p = colon + 1;
+      unsigned long long int stats[10];
+      size_t n = 0;
+      while (n < ARRAYSIZE(stats) && ProcFile_parseULL(&p, &stats[n]))
+         n++;
+      if (n < ARRAYSIZE(stats))
+         continue;
+
+      IODevice* dev = IODeviceTable_getInterface(this, name, nameLen);
+      dev->counted = !String_eq(dev->name, "lo");
+
+      /* bytes and packets received and transmitted */
+      const uint64_t counters[6] = { stats[0], stats[8], stats[1], stats[9], 0, 0 };
+      IODevice_record(dev, this->generation, seconds, counters);
+   }
+
+   return true;
+}
+
+/* Drops the devices missing from the files of this pass, as long as the files could be read */
+static void IODeviceTable_prune(IODeviceTable* this) {
+   size_t kept = 0;
+   for (size_t i = 0; i < this->count; i++) {
+      IODevice* dev = this->devices[i];
+      bool scanned = dev->kind == IODEVICE_DISK ? this->haveDisks : this->haveInterfaces;
+      if (!scanned || dev->generation == this->generation) {
+         this->devices[kept++] = dev;
+         continue;
+      }
+
+      Hashtable* table = dev->kind == IODEVICE_DISK ? this->disks : this->interfaces;
+      if (Hashtable_get(table, dev->key) == dev)
+         Hashtable_remove(table, dev->key);
+      free(dev);
+   }
+   this->count = kept;
+}
+
+static int IODevice_compareByThroughput(const void* v1, const void* v2) {
+   const IODevice* dev1 = *(const IODevice* const*)v1;
+   const IODevice* dev2 = *(const IODevice* const*)v2;
+
+   int result = compareRealNumbers(IODevice_throughput(dev2), IODevice_throughput(dev1));
+   if (result)
+      return result;
+   if (dev1->kind != dev2->kind)
+      return dev1->kind == IODEVICE_DISK ? -1 : 1;
+   return strcmp(dev1->name, dev2->name);
+}
+
+void IODeviceTable_update(IODeviceTable* this) {
+   uint64_t now;
+   Platform_gettime_monotonic(&now);
+   if (this->lastPassMs && now - this->lastPassMs < IODEVICE_INTERVAL_MS)
+      return;
+
+   double seconds = this->lastPassMs ? (double)(now - this->lastPassMs) / 1000.0 : 0.0;
+   this->lastPassMs = now;
+   this->generation++;
+
+   this->haveDisks = IODeviceTable_scanDisks(this, seconds);
+   this->haveInterfaces = IODeviceTable_scanInterfaces(this, seconds);
+
+   IODeviceTable_prune(this);
+   if (this->count > 1)
+      qsort(this->devices, this->count, sizeof(IODevice*), IODevice_compareByThroughput);
+}
+
+void IODeviceTable_sumDisks(const IODeviceTable* this, DiskIOData* data) {
+   *data = (DiskIOData) { 0 };
+   for (size_t i = 0; i < this->count; i++) {
+      const IODevice* dev = this->devices[i];
+      if (dev->kind != IODEVICE_DISK || !dev->counted)
+         continue;
+
+      data->totalBytesRead += dev->readBytes;
+      data->totalBytesWritten += dev->writeBytes;
+      data->totalMsTimeSpend += dev->busyMs;
+      data->numDisks++;
+   }
+}
+
+void IODeviceTable_sumInterfaces(const IODeviceTable* this, NetworkIOData* data) {
+   *data = (NetworkIOData) { 0 };
+   for (size_t i = 0; i < this->count; i++) {
+      const IODevice* dev = this->devices[i];
+      if (dev->kind != IODEVICE_INTERFACE || !dev->counted)
+         continue;
+
+      data->bytesReceived += dev->readBytes;
+      data->bytesTransmitted += dev->writeBytes;
+      data->packetsReceived += dev->readOps;
+      data->packetsTransmitted += dev->writeOps;
+   }
+}
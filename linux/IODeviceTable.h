@@ -0,0 +1,94 @@
+#ifndef HEADER_IODeviceTable
+#define HEADER_IODeviceTable
+/*
+htop - IODeviceTable.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "DiskIOMeter.h"
+#include "Hashtable.h"
+#include "NetworkIOMeter.h"
+#include "linux/ProcFile.h"
+
+
+/* Number of throughput samples kept for every device */
+#define IODEVICE_HISTORY 60
+
+/* Minimum span between two passes over the statistics files: the meters of
+   one update share a pass, and it is short of the 500ms the IO meters wait */
+#define IODEVICE_INTERVAL_MS 250
+
+typedef enum IODeviceKind_ {
+   IODEVICE_DISK,
+   IODEVICE_INTERFACE,
+} IODeviceKind;
+
+typedef struct IODevice_ {
+   char name[32];
+   IODeviceKind kind;
+   ht_key_t key;
+   bool counted;               /* part of the system-wide sums: no partitions, dm-, zram or lo */
+   unsigned int generation;    /* last pass the device was listed in */
+
+   /* cumulative counters; received/transmitted and packets for interfaces */
+   uint64_t readBytes;
+   uint64_t writeBytes;
+   uint64_t readOps;
+   uint64_t writeOps;
+   uint64_t busyMs;            /* disks only: time spent doing IO */
+   uint64_t waitMs;            /* disks only: time spent by all requests, queued or in service */
+
+   /* rates over the last interval, valid once hasRates is set */
+   bool hasRates;
+   double readRate;            /* bytes per second */
+   double writeRate;
+   double opsRate;             /* IO operations or packets per second */
+   double utilisation;         /* percent of the interval the disk was busy */
+   double waitTime;            /* average milliseconds per request, queueing included */
+
+   float history[IODEVICE_HISTORY];   /* throughput ring, bytes per second */
+   size_t historyHead;                /* next slot to write */
+   size_t historyCount;
+} IODevice;
+
+typedef struct IODeviceTable_ {
+   Hashtable* disks;           /* by device number */
+   Hashtable* interfaces;      /* by hash of the name */
+   IODevice** devices;         /* all devices, highest throughput first */
+   size_t count;
+   size_t capacity;
+   ProcFile diskstats;
+   ProcFile netdev;
+   bool haveDisks;             /* whether the last pass could read each file */
+   bool haveInterfaces;
+   unsigned int generation;
+   uint64_t lastPassMs;        /* monotonic time of the last pass, 0 before the first one */
+} IODeviceTable;
+
+void IODeviceTable_init(IODeviceTable* this);
+
+void IODeviceTable_done(IODeviceTable* this);
+
+/* Reads /proc/diskstats and /proc/net/dev once, unless the last pass is more recent than IODEVICE_INTERVAL_MS */
+void IODeviceTable_update(IODeviceTable* this);
+
+void IODeviceTable_sumDisks(const IODeviceTable* this, DiskIOData* data);
+
+void IODeviceTable_sumInterfaces(const IODeviceTable* this, NetworkIOData* data);
+
+static inline double IODevice_throughput(const IODevice* this) {
+   return this->readRate + this->writeRate;
+}
+
+/* Throughput sample i of the history, 0 being the oldest kept one */
+static inline float IODevice_historyAt(const IODevice* this, size_t i) {
+   return this->history[(this->historyHead + IODEVICE_HISTORY - this->historyCount + i) % IODEVICE_HISTORY];
+}
+
+#endif
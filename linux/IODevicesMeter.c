@@ -0,0 +1,255 @@
+/*
+htop - IODevicesMeter.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/IODevicesMeter.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CRT.h"
+#include "Macros.h"
+#include "Meter.h"
+#include "Object.h"
+#include "Platform.h"
+#include "ProvideCurses.h"
+#include "XUtils.h"
+#include "linux/IODeviceTable.h"
+
+
+/* Devices shown, one per row */
+#define IODEVICES_METER_ROWS 4
+
+/* Throughput samples in the trailing sparkline, two per character */
+#define IODEVICES_METER_SPARK 16
+
+typedef struct IODevicesRow_ {
+   char name[32];
+   double readRate;
+   double writeRate;
+   double opsRate;
+   double utilisation;
+   double waitTime;
+   float spark[IODEVICES_METER_SPARK];
+   size_t sparkCount;
+} IODevicesRow;
+
+typedef struct IODevicesData_ {
+   IODeviceKind kind;
+   MeterRateStatus status;
+   size_t nRows;
+   IODevicesRow rows[IODEVICES_METER_ROWS];
+} IODevicesData;
+
+static const int IODevicesMeter_attributes[] = {
+   METER_VALUE,
+};
+
+static void IODevicesMeter_commonInit(Meter* this, IODeviceKind kind) {
+   if (!this->meterData) {
+      IODevicesData* data = this->meterData = xCalloc(1, sizeof(IODevicesData));
+      data->kind = kind;
+      data->status = RATESTATUS_INIT;
+   }
+}
+
+static void DiskIODevicesMeter_init(Meter* this) {
+   IODevicesMeter_commonInit(this, IODEVICE_DISK);
+}
+
+static void NetworkIODevicesMeter_init(Meter* this) {
+   IODevicesMeter_commonInit(this, IODEVICE_INTERFACE);
+}
+
+static void IODevicesMeter_done(Meter* this) {
+   free(this->meterData);
+}
+
+static void IODevicesMeter_updateMode(Meter* this, MeterModeId mode) {
+   this->mode = mode;
+   this->h = IODEVICES_METER_ROWS;
+}
+
+/* Takes the busiest devices of the kind from the table, which is sorted by throughput */
+static void IODevicesMeter_updateValues(Meter* this) {
+   IODevicesData* data = this->meterData;
+   const IODeviceTable* table = Platform_getIODevices();
+
+   bool available = data->kind == IODEVICE_DISK ? table->haveDisks : table->haveInterfaces;
+   double total = 0.0;
+   data->nRows = 0;
+   data->status = available ? RATESTATUS_INIT : RATESTATUS_NODATA;
+
+   for (size_t i = 0; available && i < table->count; i++) {
+      const IODevice* dev = table->devices[i];
+      if (dev->kind != data->kind || !dev->counted)
+         continue;
+
+      if (dev->hasRates)
+         data->status = RATESTATUS_DATA;
+      total += IODevice_throughput(dev);
+
+      if (data->nRows == IODEVICES_METER_ROWS)
+         continue;
+
+      IODevicesRow* row = &data->rows[data->nRows++];
+      String_safeStrncpy(row->name, dev->name, sizeof(row->name));
+      row->readRate = dev->readRate;
+      row->writeRate = dev->writeRate;
+      row->opsRate = dev->opsRate;
+      row->utilisation = dev->utilisation;
+      row->waitTime = dev->waitTime;
+
+      row->sparkCount = MINIMUM(dev->historyCount, IODEVICES_METER_SPARK);
+      for (size_t j = 0; j < row->sparkCount; j++)
+         row->spark[j] = IODevice_historyAt(dev, dev->historyCount - row->sparkCount + j);
+   }
+
+   this->values[0] = total;
+
+   if (data->status != RATESTATUS_DATA || !data->nRows) {
+      xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), data->status == RATESTATUS_NODATA ? "no data" : "init");
+      return;
+   }
+
+   const IODevicesRow* top = &data->rows[0];
+   char rate[6];
+   Meter_humanUnit(rate, (top->readRate + top->writeRate) / ONE_K, sizeof(rate));
+   xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "%s %siB/s", top->name, rate);
+}
+
+/* Draws the samples as bars of dots, two per character, relative to the highest of them */
+static void IODevicesMeter_drawSpark(const IODevicesRow* row, int x, int y, int w) {
+   const char* const* dots;
+   int pixPerRow;
+#ifdef HAVE_LIBNCURSESW
+   if (CRT_utf8) {
+      dots = GraphMeterMode_dotsUtf8;
+      pixPerRow = PIXPERROW_UTF8;
+   } else
+#endif
+   {
+      dots = GraphMeterMode_dotsAscii;
+      pixPerRow = PIXPERROW_ASCII;
+   }
+
+   size_t count = MINIMUM(row->sparkCount, (size_t)w * 2);
+   const float* samples = row->spark + row->sparkCount - count;
+
+   float peak = 0.0F;
+   for (size_t i = 0; i < count; i++)
+      peak = MAXIMUM(peak, samples[i]);
+
+   attrset(CRT_colors[GRAPH_1]);
+   for (size_t i = 0; i < count; i += 2) {
+      int v[2] = { 0, 0 };
+      for (size_t j = 0; j < 2 && i + j < count; j++) {
+         if (peak > 0.0F && samples[i + j] > 0.0F)
+            v[j] = (int) lroundf(CLAMP(samples[i + j] / peak * (float)pixPerRow, 1.0F, (float)pixPerRow));
+      }
+      mvaddstr(y, x + (int)(i / 2), dots[v[0] * (pixPerRow + 1) + v[1]]);
+   }
+}
+
+static void IODevicesMeter_drawRow(const IODevicesData* data, const IODevicesRow* row, int x, int y, int w) {
+   char read[6];
+   char write[6];
+   Meter_humanUnit(read, row->readRate / ONE_K, sizeof(read));
+   Meter_humanUnit(write, row->writeRate / ONE_K, sizeof(write));
+
+   char buffer[128];
+   int len;
+   if (data->kind == IODEVICE_DISK) {
+      len = xSnprintf(buffer, sizeof(buffer), "%-9.9s r:%6s w:%6s %6.0f IOPS %6.1fms %5.1f%% ",
+                      row->name, read, write, row->opsRate, row->waitTime, row->utilisation);
+   } else {
+      len = xSnprintf(buffer, sizeof(buffer), "%-9.9s rx:%6s tx:%6s %7.0f pkt/s ",
+                      row->name, read, write, row->opsRate);
+   }
+
+   attrset(CRT_colors[METER_VALUE]);
+   mvaddnstr(y, x, buffer, MINIMUM(len, w));
+   if (len < w)
+      IODevicesMeter_drawSpark(row, x + len, y, MINIMUM(w - len, IODEVICES_METER_SPARK / 2));
+}
+
+static void IODevicesMeter_draw(Meter* this, int x, int y, int w) {
+   const IODevicesData* data = this->meterData;
+
+   int captionLen = (int)strlen(this->caption);
+   attrset(CRT_colors[METER_TEXT]);
+   mvaddnstr(y, x, this->caption, MINIMUM(captionLen, w));
+   w -= captionLen;
+   if (w < 1)
+      goto end;
+   x += captionLen;
+
+   switch (data->status) {
+      case RATESTATUS_NODATA:
+         attrset(CRT_colors[METER_VALUE_ERROR]);
+         mvaddnstr(y, x, "no data", w);
+         goto end;
+      case RATESTATUS_INIT:
+      case RATESTATUS_STALE:
+         attrset(CRT_colors[METER_VALUE]);
+         mvaddnstr(y, x, "initializing...", w);
+         goto end;
+      case RATESTATUS_DATA:
+         break;
+   }
+
+   for (size_t i = 0; i < data->nRows; i++)
+      IODevicesMeter_drawRow(data, &data->rows[i], x, y + (int)i, w);
+
+end:
+   attrset(CRT_colors[RESET_COLOR]);
+}
+
+const MeterClass DiskIODevicesMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete
+   },
+   .updateValues = IODevicesMeter_updateValues,
+   .defaultMode = TEXT_METERMODE,
+   .supportedModes = (1 << TEXT_METERMODE),
+   .maxItems = 1,
+   .total = 1.0,
+   .attributes = IODevicesMeter_attributes,
+   .name = "DiskIODevices",
+   .uiName = "Disk IO devices",
+   .description = "Disk IO devices: throughput, IOPS, wait time and utilisation of the busiest disks",
+   .caption = "Disk: ",
+   .draw = IODevicesMeter_draw,
+   .init = DiskIODevicesMeter_init,
+   .updateMode = IODevicesMeter_updateMode,
+   .done = IODevicesMeter_done
+};
+
+const MeterClass NetworkIODevicesMeter_class = {
+   .super = {
+      .extends = Class(Meter),
+      .delete = Meter_delete
+   },
+   .updateValues = IODevicesMeter_updateValues,
+   .defaultMode = TEXT_METERMODE,
+   .supportedModes = (1 << TEXT_METERMODE),
+   .maxItems = 1,
+   .total = 1.0,
+   .attributes = IODevicesMeter_attributes,
+   .name = "NetworkIODevices",
+   .uiName = "Network IO interfaces",
+   .description = "Network IO interfaces: throughput and packet rates of the busiest interfaces",
+   .caption = "Net:  ",
+   .draw = IODevicesMeter_draw,
+   .init = NetworkIODevicesMeter_init,
+   .updateMode = IODevicesMeter_updateMode,
+   .done = IODevicesMeter_done
+};
@@ -0,0 +1,128 @@
+/*
+htop - IODevicesScreen.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/IODevicesScreen.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CRT.h"
+#include "Macros.h"
+#include "Meter.h"
+#include "Panel.h"
+#include "Platform.h"
+#include "ProvideCurses.h"
+#include "Vector.h"
+#include "XUtils.h"
+#include "linux/IODeviceTable.h"
+
+
+IODevicesScreen* IODevicesScreen_new(void) {
+   IODevicesScreen* this = xCalloc(1, sizeof(IODevicesScreen));
+   Object_setClass(this, Class(IODevicesScreen));
+   return (IODevicesScreen*) InfoScreen_init(&this->super, NULL, NULL, LINES - 2, "DEVICE           KIND    READ/RX   WRITE/TX    OPS/s   WAIT ms  UTIL%  HISTORY");
+}
+
+void IODevicesScreen_delete(Object* this) {
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void IODevicesScreen_draw(InfoScreen* this) {
+   InfoScreen_drawTitled(this, "Disks and network interfaces, busiest first");
+}
+
+/* Appends the throughput history as bars of dots, two samples per character, relative to its peak */
+static void IODevicesScreen_appendHistory(const IODevice* dev, char* buffer, size_t size) {
+   const char* const* dots;
+   int pixPerRow;
+#ifdef HAVE_LIBNCURSESW
+   if (CRT_utf8) {
+      dots = GraphMeterMode_dotsUtf8;
+      pixPerRow = PIXPERROW_UTF8;
+   } else
+#endif
+   {
+      dots = GraphMeterMode_dotsAscii;
+      pixPerRow = PIXPERROW_ASCII;
+   }
+
+   float peak = 0.0F;
+   for (size_t i = 0; i < dev->historyCount; i++)
+      peak = MAXIMUM(peak, IODevice_historyAt(dev, i));
+
+   size_t len = strlen(buffer);
+   for (size_t i = 0; i < dev->historyCount; i += 2) {
+      int v[2] = { 0, 0 };
+      for (size_t j = 0; j < 2 && i + j < dev->historyCount; j++) {
+         float sample = IODevice_historyAt(dev, i + j);
+         if (peak > 0.0F && sample > 0.0F)
+            v[j] = (int) lroundf(CLAMP(sample / peak * (float)pixPerRow, 1.0F, (float)pixPerRow));
+      }
+
+      const char* dot = dots[v[0] * (pixPerRow + 1) + v[1]];
+      size_t dotLen = strlen(dot);
+      if (len + dotLen >= size)
+         break;
+      memcpy(buffer + len, dot, dotLen + 1);
+      len += dotLen;
+   }
+}
+
+static void IODevicesScreen_scan(InfoScreen* this) {
+   Panel* panel = this->display;
+   int idx = Panel_getSelectedIndex(panel);
+   Panel_prune(panel);
+   Vector_prune(this->lines);
+
+   const IODeviceTable* table = Platform_getIODevices();
+   if (!table->haveDisks && !table->haveInterfaces) {
+      InfoScreen_addLine(this, "Could not read " PROCDIR "/diskstats nor " PROCDIR "/net/dev.");
+      return;
+   }
+
+   for (size_t i = 0; i < table->count; i++) {
+      const IODevice* dev = table->devices[i];
+
+      char read[6];
+      char write[6];
+      Meter_humanUnit(read, dev->readRate / ONE_K, sizeof(read));
+      Meter_humanUnit(write, dev->writeRate / ONE_K, sizeof(write));
+
+      char entry[512];
+      if (dev->kind == IODEVICE_DISK) {
+         xSnprintf(entry, sizeof(entry), "%-16.16s disk %7siB %7siB %8.0f %9.2f %6.1f  ",
+                   dev->name, read, write, dev->opsRate, dev->waitTime, dev->utilisation);
+      } else {
+         xSnprintf(entry, sizeof(entry), "%-16.16s net  %7siB %7siB %8.0f %9s %6s  ",
+                   dev->name, read, write, dev->opsRate, "-", "-");
+      }
+      IODevicesScreen_appendHistory(dev, entry, sizeof(entry));
+
+      InfoScreen_addLine(this, entry);
+   }
+
+   Panel_setSelected(panel, idx);
+}
+
+/* Refreshes the list whenever no key was pressed within the update delay */
+static void IODevicesScreen_update(InfoScreen* this) {
+   IODevicesScreen_scan(this);
+   InfoScreen_draw(this);
+}
+
+const InfoScreenClass IODevicesScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = IODevicesScreen_delete
+   },
+   .scan = IODevicesScreen_scan,
+   .draw = IODevicesScreen_draw,
+   .onErr = IODevicesScreen_update
+};
@@ -0,0 +1,24 @@
+#ifndef HEADER_IODevicesScreen
+#define HEADER_IODevicesScreen
+/*
+htop - IODevicesScreen.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "InfoScreen.h"
+#include "Object.h"
+
+
+typedef struct IODevicesScreen_ {
+   InfoScreen super;
+} IODevicesScreen;
+
+extern const InfoScreenClass IODevicesScreen_class;
+
+IODevicesScreen* IODevicesScreen_new(void);
+
+void IODevicesScreen_delete(Object* this);
+
+#endif
@@ -42,6 +42,11 @@ in the source distribution for its full text.
 #define O_PATH         010000000 // declare for ancient glibc versions
 #endif
 
+/* Sampling of the CPU frequencies, see LinuxMachine_sweepCPUFrequencies */
+#define CPUFREQ_INTERVAL_US 1000000
+#define CPUFREQ_BUDGET_US 500
+#define CPUFREQ_MAX_SCANS 4
+
 /* Similar to get_nprocs_conf(3) / _SC_NPROCESSORS_CONF
  * https://sourceware.org/git/?p=glibc.git;a=blob;f=sysdeps/unix/sysv/linux/getsysstats.c;hb=HEAD
  */
@@ -127,74 +132,88 @@ static void LinuxMachine_updateCPUcount(LinuxMachine* this) {
    super->existingCPUs = currExisting;
 }
 
+typedef enum {
+   MEMINFO_MEM_TOTAL,
+   MEMINFO_MEM_FREE,
+   MEMINFO_MEM_AVAILABLE,
+   MEMINFO_BUFFERS,
+   MEMINFO_CACHED,
+   MEMINFO_SHMEM,
+   MEMINFO_SRECLAIMABLE,
+   MEMINFO_SWAP_TOTAL,
+   MEMINFO_SWAP_CACHED,
+   MEMINFO_SWAP_FREE,
+   MEMINFO_ZSWAP,
+   MEMINFO_ZSWAPPED,
+   MEMINFO_KEYS
+} MeminfoKey;
+
+static const char* const LinuxMachine_meminfoKeyNames[MEMINFO_KEYS] = {
+   [MEMINFO_MEM_TOTAL] = "MemTotal",
+   [MEMINFO_MEM_FREE] = "MemFree",
+   [MEMINFO_MEM_AVAILABLE] = "MemAvailable",
+   [MEMINFO_BUFFERS] = "Buffers",
+   [MEMINFO_CACHED] = "Cached",
+   [MEMINFO_SHMEM] = "Shmem",
+   [MEMINFO_SRECLAIMABLE] = "SReclaimable",
+   [MEMINFO_SWAP_TOTAL] = "SwapTotal",
+   [MEMINFO_SWAP_CACHED] = "SwapCached",
+   [MEMINFO_SWAP_FREE] = "SwapFree",
+   [MEMINFO_ZSWAP] = "Zswap",
+   [MEMINFO_ZSWAPPED] = "Zswapped",
+};
+
+static ProcKeys LinuxMachine_meminfoKeys;
+
+typedef enum {
+   STAT_BTIME,
+   STAT_PROCS_RUNNING,
+   STAT_KEYS
+} StatKey;
+
+static const char* const LinuxMachine_statKeyNames[STAT_KEYS] = {
+   [STAT_BTIME] = "btime",
+   [STAT_PROCS_RUNNING] = "procs_running",
+};
+
+static ProcKeys LinuxMachine_statKeys;
+
 static void LinuxMachine_scanMemoryInfo(LinuxMachine* this) {
    Machine* host = &this->super;
-   memory_t availableMem = 0;
-   memory_t freeMem = 0;
-   memory_t totalMem = 0;
-   memory_t buffersMem = 0;
-   memory_t cachedMem = 0;
-   memory_t sharedMem = 0;
-   memory_t swapTotalMem = 0;
-   memory_t swapCacheMem = 0;
-   memory_t swapFreeMem = 0;
-   memory_t sreclaimableMem = 0;
-   memory_t zswapCompMem = 0;
-   memory_t zswapOrigMem = 0;
-
-   FILE* file = fopen(PROCMEMINFOFILE, "r");
-   if (!file)
+   memory_t values[MEMINFO_KEYS] = { 0 };
+
+   if (!ProcFile_read(&this->meminfoFile))
       CRT_fatalError("Cannot open " PROCMEMINFOFILE);
 
-   char buffer[128];
-   while (fgets(buffer, sizeof(buffer), file)) {
-
-      #define tryRead(label, variable)                                       \
-         if (String_startsWith(buffer, label)) {                             \
-            memory_t parsed_;                                                \
-            if (sscanf(buffer + strlen(label), "%llu kB", &parsed_) == 1) {  \
-               (variable) = parsed_;                                         \
-            }                                                                \
-            break;                                                           \
-         } else (void) 0 /* Require a ";" after the macro use. */
+   /* "Key:   value kB" */
+   char* cursor = NULL;
+   for (char* line; (line = ProcFile_nextLine(&this->meminfoFile, &cursor)) != NULL; ) {
+      const char* colon = strchr(line, ':');
+      if (!colon)
+         continue;
 
-      switch (buffer[0]) {
-         case 'M':
-            tryRead("MemAvailable:", availableMem);
-            tryRead("MemFree:", freeMem);
-            tryRead("MemTotal:", totalMem);
-            break;
-         case 'B':
-            tryRead("Buffers:", buffersMem);
-            break;
-         case 'C':
-            tryRead("Cached:", cachedMem);
-            break;
-         case 'S':
-            switch (buffer[1]) {
-               case 'h':
-                  tryRead("Shmem:", sharedMem);
-                  break;
-               case 'w':
-                  tryRead("SwapTotal:", swapTotalMem);
-                  tryRead("SwapCached:", swapCacheMem);
-                  tryRead("SwapFree:", swapFreeMem);
-                  break;
-               case 'R':
-                  tryRead("SReclaimable:", sreclaimableMem);
-                  break;
-            }
-            break;
-         case 'Z':
-            tryRead("Zswap:", zswapCompMem);
-            tryRead("Zswapped:", zswapOrigMem);
-            break;
-      }
+      int key = ProcKeys_find(&LinuxMachine_meminfoKeys, line, (size_t)(colon - line));
+      if (key < 0)
+         continue;
 
-      #undef tryRead
+      const char* value = colon + 1;
+      unsigned long long int parsed;
+      if (ProcFile_parseULL(&value, &parsed))
+         values[key] = parsed;
    }
 
-   fclose(file);
+   const memory_t availableMem = values[MEMINFO_MEM_AVAILABLE];
+   const memory_t freeMem = values[MEMINFO_MEM_FREE];
+   const memory_t totalMem = values[MEMINFO_MEM_TOTAL];
+   const memory_t buffersMem = values[MEMINFO_BUFFERS];
+   const memory_t cachedMem = values[MEMINFO_CACHED];
+   const memory_t sharedMem = values[MEMINFO_SHMEM];
+   const memory_t swapTotalMem = values[MEMINFO_SWAP_TOTAL];
+   const memory_t swapCacheMem = values[MEMINFO_SWAP_CACHED];
+   const memory_t swapFreeMem = values[MEMINFO_SWAP_FREE];
+   const memory_t sreclaimableMem = values[MEMINFO_SRECLAIMABLE];
+   const memory_t zswapCompMem = values[MEMINFO_ZSWAP];
+   const memory_t zswapOrigMem = values[MEMINFO_ZSWAPPED];
 
    /*
     * Compute memory partition like procps(free)
@@ -399,47 +418,56 @@ static void LinuxMachine_scanZfsArcstats(LinuxMachine* this) {
    }
 }
 
+static void LinuxMachine_closeFrequencyFd(CPUData* cpuData) {
+   if (cpuData->frequencyFdTried && cpuData->frequencyFd >= 0)
+      close(cpuData->frequencyFd);
+   cpuData->frequencyFd = -1;
+   cpuData->frequencyFdTried = false;
+}
+
 static void LinuxMachine_scanCPUTime(LinuxMachine* this) {
    const Machine* super = &this->super;
 
    LinuxMachine_updateCPUcount(this);
 
-   FILE* file = fopen(PROCSTATFILE, "r");
-   if (!file)
+   if (!ProcFile_read(&this->statFile))
       CRT_fatalError("Cannot open " PROCSTATFILE);
 
    // Add an extra phantom thread for a later loop
    bool adjCpuIdProcessed[super->existingCPUs+2];
    memset(adjCpuIdProcessed, 0, sizeof(adjCpuIdProcessed));
 
+   char* cursor = NULL;
+   char* line = NULL;
    for (unsigned int i = 0; i <= super->existingCPUs; i++) {
-      char buffer[PROC_LINE_LENGTH + 1];
-      unsigned long long int usertime, nicetime, systemtime, idletime;
-      unsigned long long int ioWait = 0, irq = 0, softIrq = 0, steal = 0, guest = 0, guestnice = 0;
-
-      const char* ok = fgets(buffer, sizeof(buffer), file);
-      if (!ok)
+      line = ProcFile_nextLine(&this->statFile, &cursor);
+      if (!line)
          break;
 
       // cpu fields are sorted first
-      if (!String_startsWith(buffer, "cpu"))
+      if (!String_startsWith(line, "cpu"))
          break;
 
-      // Depending on your kernel version,
-      // 5, 7, 8 or 9 of these fields will be set.
-      // The rest will remain at zero.
+      const char* fields = line + strlen("cpu");
       unsigned int adjCpuId;
       if (i == 0) {
-         (void) sscanf(buffer, "cpu  %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu", &usertime, &nicetime, &systemtime, &idletime, &ioWait, &irq, &softIrq, &steal, &guest, &guestnice);
          adjCpuId = 0;
       } else {
-         unsigned int cpuid;
-         (void) sscanf(buffer, "cpu%4u %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu %16llu", &cpuid, &usertime, &nicetime, &systemtime, &idletime, &ioWait, &irq, &softIrq, &steal, &guest, &guestnice);
-         adjCpuId = cpuid + 1;
+         unsigned long long int cpuid;
+         if (!ProcFile_parseULL(&fields, &cpuid) || cpuid >= super->existingCPUs)
+            break;
+         adjCpuId = (unsigned int)cpuid + 1;
       }
 
-      if (adjCpuId > super->existingCPUs)
-         break;
+      // Depending on your kernel version,
+      // 5, 7, 8 or 9 of these fields will be set.
+      // The rest will remain at zero.
+      unsigned long long int times[10] = { 0 };
+      for (size_t n = 0; n < ARRAYSIZE(times) && ProcFile_parseULL(&fields, &times[n]); n++)
+         ;
+
+      unsigned long long int usertime = times[0], nicetime = times[1], systemtime = times[2], idletime = times[3];
+      unsigned long long int ioWait = times[4], irq = times[5], softIrq = times[6], steal = times[7], guest = times[8], guestnice = times[9];
 
       // Guest time is already accounted in usertime
       usertime -= guest;
@@ -489,6 +517,7 @@ static void LinuxMachine_scanCPUTime(LinuxMachine* this) {
       if (adjCpuIdProcessed[i]) {
          for (unsigned int j = lastAdjCpuIdProcessed+1; j < i; j++) {
             // Skipped an ID, but /proc/stat is ordered => threads in between are offline
+            LinuxMachine_closeFrequencyFd(&this->cpuData[j]);
             memset(&(this->cpuData[j]), '\0', sizeof(CPUData));
          }
          lastAdjCpuIdProcessed = i;
@@ -497,79 +526,98 @@ static void LinuxMachine_scanCPUTime(LinuxMachine* this) {
 
    this->period = (double)this->cpuData[0].totalPeriod / super->activeCPUs;
 
-   if (!ferror(file) && !feof(file)) {
-      char buffer[PROC_LINE_LENGTH + 1];
-      while (fgets(buffer, sizeof(buffer), file)) {
-         if (String_startsWith(buffer, "procs_running")) {
-            this->runningTasks = (unsigned int) strtoul(buffer + strlen("procs_running"), NULL, 10);
-            break;
-         }
-      }
+   for (; line; line = ProcFile_nextLine(&this->statFile, &cursor)) {
+      const char* space = strchr(line, ' ');
+      if (!space || ProcKeys_find(&LinuxMachine_statKeys, line, (size_t)(space - line)) != STAT_PROCS_RUNNING)
+         continue;
+
+      unsigned long long int running;
+      if (ProcFile_parseULL(&space, &running))
+         this->runningTasks = (unsigned int)running;
+      break;
    }
+}
 
-   fclose(file);
+static uint64_t LinuxMachine_monotonicUs(void) {
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000;
 }
 
-static int scanCPUFrequencyFromSysCPUFreq(LinuxMachine* this) {
-   const Machine* super = &this->super;
-   int numCPUsWithFrequency = 0;
-   unsigned long totalFrequency = 0;
+/* Returns the frequency of a CPU in MHz, or NAN */
+static double LinuxMachine_readCPUFrequency(CPUData* cpuData, unsigned int cpu) {
+   if (!cpuData->frequencyFdTried) {
+      char pathBuffer[64];
+      xSnprintf(pathBuffer, sizeof(pathBuffer), "/sys/devices/system/cpu/cpu%u/cpufreq/scaling_cur_freq", cpu);
+      cpuData->frequencyFd = open(pathBuffer, O_RDONLY | O_CLOEXEC);
+      cpuData->frequencyFdTried = true;
+   }
 
-   /*
-    * On some AMD and Intel CPUs read()ing scaling_cur_freq is quite slow (> 1ms). This delay
-    * accumulates for every core. For details see issue#471.
-    * If the read on CPU 0 takes longer than 500us bail out and fall back to reading the
-    * frequencies from /proc/cpuinfo.
-    * Once the condition has been met, bail out early for the next couple of scans.
-    */
-   static int timeout = 0;
+   if (cpuData->frequencyFd < 0)
+      return NAN;
 
-   if (timeout > 0) {
-      timeout--;
-      return -1;
+   char buffer[32];
+   ssize_t res = pread(cpuData->frequencyFd, buffer, sizeof(buffer) - 1, 0);
+   if (res < 1) {
+      /* the cpufreq directory goes away with offlining the CPU; reopen later */
+      LinuxMachine_closeFrequencyFd(cpuData);
+      return NAN;
    }
+   buffer[res] = '\0';
 
-   for (unsigned int i = 0; i < super->existingCPUs; ++i) {
-      if (!Machine_isCPUonline(super, i))
-         continue;
+   char* end;
+   unsigned long frequency = strtoul(buffer, &end, 10);
+   if (end == buffer)
+      return NAN;
 
-      char pathBuffer[64];
-      xSnprintf(pathBuffer, sizeof(pathBuffer), "/sys/devices/system/cpu/cpu%u/cpufreq/scaling_cur_freq", i);
-
-      struct timespec start;
-      if (i == 0)
-         clock_gettime(CLOCK_MONOTONIC, &start);
-
-      FILE* file = fopen(pathBuffer, "r");
-      if (!file)
-         return -errno;
-
-      unsigned long frequency;
-      if (fscanf(file, "%lu", &frequency) == 1) {
-         /* convert kHz to MHz */
-         frequency = frequency / 1000;
-         this->cpuData[i + 1].frequency = frequency;
-         numCPUsWithFrequency++;
-         totalFrequency += frequency;
+   /* convert kHz to MHz */
+   return (double)(frequency / 1000);
+}
+
+static bool LinuxMachine_hasCPUFrequencyFd(const CPUData* cpuData) {
+   return cpuData->frequencyFdTried && cpuData->frequencyFd >= 0;
+}
+
+/*
+ * On some AMD and Intel CPUs read()ing scaling_cur_freq is quite slow (> 1ms). This delay
+ * accumulates for every core. For details see issue#471.
+ * The files are kept open and read at most once per CPUFREQ_INTERVAL_US; a sweep over all
+ * CPUs taking longer than CPUFREQ_BUDGET_US continues in the next scan, keeping the previous
+ * frequencies of the CPUs not read yet. At least 1/CPUFREQ_MAX_SCANS of the CPUs is read per
+ * scan whatever the budget, so no frequency shown is older than CPUFREQ_MAX_SCANS scans past
+ * the interval. Returns whether any CPU was read.
+ */
+static bool LinuxMachine_sweepCPUFrequencies(LinuxMachine* this) {
+   const Machine* super = &this->super;
+   const unsigned int cpus = super->existingCPUs;
+
+   uint64_t now = LinuxMachine_monotonicUs();
+   if (this->freqNextCPU == 0) {
+      if (this->freqSweepStartUs && now - this->freqSweepStartUs < CPUFREQ_INTERVAL_US)
+         return false;
+      this->freqSweepStartUs = now;
+   }
+
+   const uint64_t deadline = now + CPUFREQ_BUDGET_US;
+   const unsigned int minimum = this->freqNextCPU + (cpus + CPUFREQ_MAX_SCANS - 1) / CPUFREQ_MAX_SCANS;
+   unsigned int i = this->freqNextCPU;
+   this->freqNextCPU = 0;
+   for (; i < cpus; i++) {
+      CPUData* cpuData = &this->cpuData[i + 1];
+      if (!Machine_isCPUonline(super, i)) {
+         cpuData->frequency = NAN;
+         continue;
       }
 
-      fclose(file);
+      cpuData->frequency = LinuxMachine_readCPUFrequency(cpuData, i);
 
-      if (i == 0) {
-         struct timespec end;
-         clock_gettime(CLOCK_MONOTONIC, &end);
-         const time_t timeTakenUs = (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
-         if (timeTakenUs > 500) {
-            timeout = 30;
-            return -1;
-         }
+      if (i + 1 < cpus && i + 1 >= minimum && LinuxMachine_monotonicUs() > deadline) {
+         this->freqNextCPU = i + 1;
+         break;
       }
    }
 
-   if (numCPUsWithFrequency > 0)
-      this->cpuData[0].frequency = (double)totalFrequency / numCPUsWithFrequency;
-
-   return 0;
+   return true;
 }
 
 static void scanCPUFrequencyFromCPUinfo(LinuxMachine* this) {
@@ -579,8 +627,6 @@ static void scanCPUFrequencyFromCPUinfo(LinuxMachine* this) {
    if (file == NULL)
       return;
 
-   int numCPUsWithFrequency = 0;
-   double totalFrequency = 0;
    int cpuid = -1;
 
    while (!feof(file)) {
@@ -607,20 +653,14 @@ static void scanCPUFrequencyFromCPUinfo(LinuxMachine* this) {
 
          CPUData* cpuData = &(this->cpuData[cpuid + 1]);
          /* do not override sysfs data */
-         if (!isNonnegative(cpuData->frequency)) {
+         if (!LinuxMachine_hasCPUFrequencyFd(cpuData)) {
             cpuData->frequency = frequency;
          }
-         numCPUsWithFrequency++;
-         totalFrequency += frequency;
       } else if (buffer[0] == '\n') {
          cpuid = -1;
       }
    }
    fclose(file);
-
-   if (numCPUsWithFrequency > 0) {
-      this->cpuData[0].frequency = totalFrequency / numCPUsWithFrequency;
-   }
 }
 
 #ifdef HAVE_SENSORS_SENSORS_H
@@ -719,14 +759,34 @@ static void LinuxMachine_assignCCDs(LinuxMachine* this, int ccds) {
 
 static void LinuxMachine_scanCPUFrequency(LinuxMachine* this) {
    const Machine* super = &this->super;
+   const unsigned int cpus = super->existingCPUs;
 
-   for (unsigned int i = 0; i <= super->existingCPUs; i++)
-      this->cpuData[i].frequency = NAN;
+   bool swept = LinuxMachine_sweepCPUFrequencies(this);
 
-   if (scanCPUFrequencyFromSysCPUFreq(this) == 0)
-      return;
+   /* CPUs without a cpufreq file, or without any cpufreq driver, take their
+      frequency from /proc/cpuinfo, parsed along with the sweep */
+   bool withoutFd = false;
+   for (unsigned int i = 0; i < cpus; i++) {
+      if (Machine_isCPUonline(super, i) && !LinuxMachine_hasCPUFrequencyFd(&this->cpuData[i + 1])) {
+         withoutFd = true;
+         break;
+      }
+   }
+   if (swept && withoutFd)
+      scanCPUFrequencyFromCPUinfo(this);
+
+   int numCPUsWithFrequency = 0;
+   double totalFrequency = 0;
+   for (unsigned int i = 0; i < cpus; i++) {
+      const CPUData* cpuData = &this->cpuData[i + 1];
+      if (!Machine_isCPUonline(super, i) || !isNonnegative(cpuData->frequency))
+         continue;
+
+      numCPUsWithFrequency++;
+      totalFrequency += cpuData->frequency;
+   }
 
-   scanCPUFrequencyFromCPUinfo(this);
+   this->cpuData[0].frequency = numCPUsWithFrequency > 0 ? totalFrequency / numCPUsWithFrequency : NAN;
 }
 
 void Machine_scan(Machine* super) {
@@ -767,24 +827,29 @@ Machine* Machine_new(UsersTable* usersTable, uid_t userId) {
    if ((this->jiffies = sysconf(_SC_CLK_TCK)) == -1)
       CRT_fatalError("Cannot get clock ticks by sysconf(_SC_CLK_TCK)");
 
+   ProcKeys_init(&LinuxMachine_meminfoKeys, LinuxMachine_meminfoKeyNames, MEMINFO_KEYS);
+   ProcKeys_init(&LinuxMachine_statKeys, LinuxMachine_statKeyNames, STAT_KEYS);
+   ProcFile_init(&this->meminfoFile, PROCMEMINFOFILE);
+   ProcFile_init(&this->statFile, PROCSTATFILE);
+
    // Read btime (the kernel boot time, as number of seconds since the epoch)
-   FILE* statfile = fopen(PROCSTATFILE, "r");
-   if (statfile == NULL)
+   if (!ProcFile_read(&this->statFile))
       CRT_fatalError("Cannot open " PROCSTATFILE);
 
    this->boottime = -1;
 
-   while (true) {
-      char buffer[PROC_LINE_LENGTH + 1];
-      if (fgets(buffer, sizeof(buffer), statfile) == NULL)
-         break;
-      if (String_startsWith(buffer, "btime ") == false)
+   char* cursor = NULL;
+   for (char* line; (line = ProcFile_nextLine(&this->statFile, &cursor)) != NULL; ) {
+      const char* space = strchr(line, ' ');
+      if (!space || ProcKeys_find(&LinuxMachine_statKeys, line, (size_t)(space - line)) != STAT_BTIME)
          continue;
-      if (sscanf(buffer, "btime %lld\n", &this->boottime) == 1)
-         break;
-      CRT_fatalError("Failed to parse btime from " PROCSTATFILE);
+
+      unsigned long long int btime;
+      if (!ProcFile_parseULL(&space, &btime))
+         CRT_fatalError("Failed to parse btime from " PROCSTATFILE);
+      this->boottime = (long long)btime;
+      break;
    }
-   fclose(statfile);
 
    if (this->boottime == -1)
       CRT_fatalError("No btime in " PROCSTATFILE);
@@ -799,6 +864,8 @@ Machine* Machine_new(UsersTable* usersTable, uid_t userId) {
    LinuxMachine_assignCCDs(this, ccds);
    #endif
 
+   Platform_updateTables(super);
+
    return super;
 }
 
@@ -815,6 +882,12 @@ void Machine_delete(Machine* super) {
       gpuEngineData = next;
    }
 
+   for (unsigned int i = 0; i < super->existingCPUs; i++)
+      LinuxMachine_closeFrequencyFd(&this->cpuData[i + 1]);
+
+   ProcFile_done(&this->meminfoFile);
+   ProcFile_done(&this->statFile);
+
    free(this->cpuData);
    free(this);
 }
@@ -10,6 +10,7 @@ in the source distribution for its full text.
 #include <stdbool.h>
 
 #include "Machine.h"
+#include "linux/ProcFile.h"
 #include "linux/ZramStats.h"
 #include "linux/ZswapStats.h"
 #include "zfs/ZfsArcStats.h"
@@ -45,6 +46,8 @@ typedef struct CPUData_ {
    unsigned long long int guestPeriod;
 
    double frequency;
+   int frequencyFd;               /* open cpufreq/scaling_cur_freq, -1 if unavailable */
+   bool frequencyFdTried;
 
    #ifdef HAVE_SENSORS_SENSORS_H
    double temperature;
@@ -78,6 +81,12 @@ typedef struct LinuxMachine_ {
 
    CPUData* cpuData;
 
+   ProcFile meminfoFile;
+   ProcFile statFile;
+
+   unsigned int freqNextCPU;      /* where the running frequency sweep continues, 0 between sweeps */
+   uint64_t freqSweepStartUs;     /* monotonic start time of the last sweep */
+
    #ifdef HAVE_SENSORS_SENSORS_H
    int maxPhysicalID;
    int maxCoreID;
@@ -0,0 +1,262 @@
+/*
+htop - LinuxOpenFilesScreen.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/LinuxOpenFilesScreen.h"
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+
+#include "CRT.h"
+#include "FunctionBar.h"
+#include "ListItem.h"
+#include "Macros.h"
+#include "Meter.h"
+#include "Object.h"
+#include "Panel.h"
+#include "ProvideCurses.h"
+#include "RichString.h"
+#include "Settings.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+
+static const char* const LinuxOpenFilesScreenFunctions[] = {"Search ", "Filter ", "Refresh", "Live   ", "Done   ", NULL};
+
+static const char* const LinuxOpenFilesScreenKeys[] = {"F3", "F4", "F5", "F8", "Esc"};
+
+static const int LinuxOpenFilesScreenEvents[] = {KEY_F(3), KEY_F(4), KEY_F(5), KEY_F(8), 27};
+
+LinuxOpenFilesScreen* LinuxOpenFilesScreen_new(const Process* process) {
+   LinuxOpenFilesScreen* this = xCalloc(1, sizeof(LinuxOpenFilesScreen));
+   Object_setClass(this, Class(LinuxOpenFilesScreen));
+   if (Process_isThread(process)) {
+      this->pid = Process_getThreadGroup(process);
+   } else {
+      this->pid = Process_getPid(process);
+   }
+   FunctionBar* fuBar = FunctionBar_new(LinuxOpenFilesScreenFunctions, LinuxOpenFilesScreenKeys, LinuxOpenFilesScreenEvents);
+   return (LinuxOpenFilesScreen*) InfoScreen_init(&this->super, process, fuBar, LINES - 2, "   FD TYPE    MODE DEVICE           SIZE     OFFSET       NODE  NAME");
+}
+
+void LinuxOpenFilesScreen_delete(Object* this) {
+   if (((LinuxOpenFilesScreen*)this)->files)
+      OpenFileTable_delete(((LinuxOpenFilesScreen*)this)->files);
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void LinuxOpenFilesScreen_draw(InfoScreen* this) {
+   if (((LinuxOpenFilesScreen*)this)->live) {
+      InfoScreen_drawTitled(this, "Files open in process %d - %s", ((LinuxOpenFilesScreen*)this)->pid, Process_getCommand(this->process));
+      return;
+   }
+   InfoScreen_drawTitled(this, "Snapshot of files open in process %d - %s", ((LinuxOpenFilesScreen*)this)->pid, Process_getCommand(this->process));
+}
+
+static int LinuxOpenFilesScreen_digits(unsigned long long int value) {
+   int digits = 1;
+   for (; value >= 10; value /= 10)
+      digits++;
+   return digits;
+}
+
+static const char* LinuxOpenFilesScreen_accessMode(const OpenFile* file) {
+   if (file->mntId < 0)
+      return "";
+
+   switch (file->flags & O_ACCMODE) {
+   case O_RDONLY: return "r";
+   case O_WRONLY: return "w";
+   default:       return "u";
+   }
+}
+
+/* Only files have a meaningful position, and only regular ones and directories a size */
+static bool LinuxOpenFilesScreen_hasOffset(const OpenFile* file) {
+   return file->mntId >= 0 && (S_ISREG(file->mode) || S_ISDIR(file->mode) || S_ISBLK(file->mode) || S_ISCHR(file->mode));
+}
+
+/* A line of the list, marked as a process row is while the descriptor is new or just closed */
+typedef struct LinuxOpenFilesScreen_Line_ {
+   ListItem super;
+   int highlightAttr;
+} LinuxOpenFilesScreen_Line;
+
+static void LinuxOpenFilesScreen_Line_display(const Object* cast, RichString* out) {
+   ListItem_display(cast, out);
+   out->highlightAttr = ((const LinuxOpenFilesScreen_Line*)cast)->highlightAttr;
+}
+
+static const ObjectClass LinuxOpenFilesScreen_Line_class = {
+   .extends = Class(ListItem),
+   .display = LinuxOpenFilesScreen_Line_display,
+   .delete = ListItem_delete,
+   .compare = ListItem_compare
+};
+
+static int LinuxOpenFilesScreen_highlightOf(const OpenFile* file, const Settings* settings, uint64_t now) {
+   if (!settings->highlightChanges)
+      return 0;
+
+   if (file->tombStampMs > 0)
+      return CRT_colors[PROCESS_TOMB];
+
+   if (file->seenStampMs > 0 && now - file->seenStampMs <= 1000 * (uint64_t)settings->highlightDelaySecs)
+      return CRT_colors[PROCESS_NEW];
+
+   return 0;
+}
+
+static void LinuxOpenFilesScreen_scan(InfoScreen* super) {
+   LinuxOpenFilesScreen* this = (LinuxOpenFilesScreen*) super;
+   const Settings* settings = super->process->super.host->settings;
+   Panel* panel = super->display;
+   int idx = Panel_getSelectedIndex(panel);
+   Panel_prune(panel);
+   Vector_prune(super->lines);
+
+   if (!this->files)
+      this->files = OpenFileTable_new(this->pid);
+
+   /* closed descriptors stay listed as long as dead processes do */
+   OpenFileTable* files = this->files;
+   const uint64_t keepClosedMs = settings->highlightChanges ? 1000 * (uint64_t)settings->highlightDelaySecs : 0;
+   if (!OpenFileTable_update(files, keepClosedMs)) {
+      char message[128];
+      xSnprintf(message, sizeof(message), "Failed listing open files: %s", strerror(files->error));
+      InfoScreen_addLine(super, message);
+      Panel_setSelected(panel, idx);
+      return;
+   }
+
+   int sizeWidth = 4;
+   int offsetWidth = 6;
+   int queueWidth = 6;
+   int nodeWidth = 4;
+   for (size_t i = 0; i < OpenFileTable_size(files); i++) {
+      const OpenFile* file = OpenFileTable_get(files, i);
+      if (S_ISREG(file->mode) || S_ISDIR(file->mode))
+         sizeWidth = MAXIMUM(sizeWidth, LinuxOpenFilesScreen_digits((unsigned long long int)file->size));
+      if (LinuxOpenFilesScreen_hasOffset(file))
+         offsetWidth = MAXIMUM(offsetWidth, LinuxOpenFilesScreen_digits(file->pos));
+      if (file->hasQueues)
+         queueWidth = MAXIMUM(queueWidth, LinuxOpenFilesScreen_digits(MAXIMUM(file->sendQueue, file->recvQueue)));
+      nodeWidth = MAXIMUM(nodeWidth, LinuxOpenFilesScreen_digits((unsigned long long int)file->inode));
+   }
+
+   char hdrbuf[160];
+   xSnprintf(hdrbuf, sizeof(hdrbuf), "%5.5s %-7.7s %-4.4s %6.6s %5.5s %*s %*s %8s %*s %*s %*s  %s",
+      "FD", "TYPE", "MODE", "DEVICE", "MNT",
+      sizeWidth, "SIZE",
+      offsetWidth, "OFFSET",
+      "POS/s",
+      queueWidth, "SEND-Q",
+      queueWidth, "RECV-Q",
+      nodeWidth, "NODE",
+      "NAME"
+   );
+   Panel_setHeader(panel, hdrbuf);
+
+   for (size_t i = 0; i < OpenFileTable_size(files); i++) {
+      const OpenFile* file = OpenFileTable_get(files, i);
+
+      char device[16];
+      xSnprintf(device, sizeof(device), "%u,%u", major(file->dev), minor(file->dev));
+
+      char mount[12] = "";
+      if (file->mntId >= 0)
+         xSnprintf(mount, sizeof(mount), "%d", file->mntId);
+
+      char size[24] = "";
+      if (S_ISREG(file->mode) || S_ISDIR(file->mode))
+         xSnprintf(size, sizeof(size), "%llu", (unsigned long long int)file->size);
+
+      char offset[24] = "";
+      char rate[16] = "";
+      if (LinuxOpenFilesScreen_hasOffset(file)) {
+         xSnprintf(offset, sizeof(offset), "%llu", file->pos);
+
+         if (!isnan(file->posRate)) {
+            char amount[6];
+            Meter_humanUnit(amount, file->posRate / ONE_K, sizeof(amount));
+            xSnprintf(rate, sizeof(rate), "%siB", amount);
+         }
+      }
+
+      char sendQueue[12] = "";
+      char recvQueue[12] = "";
+      if (file->hasQueues) {
+         xSnprintf(sendQueue, sizeof(sendQueue), "%u", file->sendQueue);
+         xSnprintf(recvQueue, sizeof(recvQueue), "%u", file->recvQueue);
+      }
+
+      char* entry = NULL;
+      xAsprintf(&entry, "%5d %-7.7s %-4.4s %6.6s %5.5s %*s %*s %8s %*s %*s %*llu  %s",
+                file->super.number,
+                file->type,
+                LinuxOpenFilesScreen_accessMode(file),
+                device,
+                mount,
+                sizeWidth, size,
+                offsetWidth, offset,
+                rate,
+                queueWidth, sendQueue,
+                queueWidth, recvQueue,
+                nodeWidth, (unsigned long long int)file->inode,
+                file->name ? file->name : "");
+
+      LinuxOpenFilesScreen_Line* line = xMalloc(sizeof(LinuxOpenFilesScreen_Line));
+      Object_setClass(line, Class(LinuxOpenFilesScreen_Line));
+      ListItem_init(&line->super, entry, 0);
+      line->highlightAttr = LinuxOpenFilesScreen_highlightOf(file, settings, files->monotonicMs);
+      InfoScreen_addItem(super, &line->super);
+      free(entry);
+   }
+
+   Panel_setSelected(panel, idx);
+}
+
+/* Refreshes the list whenever no key was pressed within the update delay, while live */
+static void LinuxOpenFilesScreen_update(InfoScreen* super) {
+   if (!((LinuxOpenFilesScreen*)super)->live)
+      return;
+
+   LinuxOpenFilesScreen_scan(super);
+   InfoScreen_draw(super);
+}
+
+static bool LinuxOpenFilesScreen_onKey(InfoScreen* super, int ch) {
+   LinuxOpenFilesScreen* this = (LinuxOpenFilesScreen*) super;
+
+   switch (ch) {
+      case 'l':
+      case KEY_F(8):
+         this->live = !this->live;
+         FunctionBar_setLabel(super->display->defaultBar, KEY_F(8), this->live ? "Pause  " : "Live   ");
+         InfoScreen_draw(this);
+         return true;
+   }
+
+   return false;
+}
+
+const InfoScreenClass LinuxOpenFilesScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = LinuxOpenFilesScreen_delete
+   },
+   .scan = LinuxOpenFilesScreen_scan,
+   .draw = LinuxOpenFilesScreen_draw,
+   .onErr = LinuxOpenFilesScreen_update,
+   .onKey = LinuxOpenFilesScreen_onKey,
+};
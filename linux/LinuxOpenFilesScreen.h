@@ -0,0 +1,33 @@
+#ifndef HEADER_LinuxOpenFilesScreen
+#define HEADER_LinuxOpenFilesScreen
+/*
+htop - LinuxOpenFilesScreen.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <sys/types.h>
+
+#include "InfoScreen.h"
+#include "Object.h"
+#include "Process.h"
+#include "linux/OpenFileTable.h"
+
+
+/* The open files screen of Linux, read from /proc rather than by running lsof */
+typedef struct LinuxOpenFilesScreen_ {
+   InfoScreen super;
+   pid_t pid;
+   OpenFileTable* files;          /* kept between refreshes, which read only what changed */
+   bool live;                     /* refreshed at every update delay */
+} LinuxOpenFilesScreen;
+
+extern const InfoScreenClass LinuxOpenFilesScreen_class;
+
+LinuxOpenFilesScreen* LinuxOpenFilesScreen_new(const Process* process);
+
+void LinuxOpenFilesScreen_delete(Object* this);
+
+#endif
@@ -15,6 +15,7 @@ in the source distribution for its full text.
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <syscall.h>
 #include <unistd.h>
 
@@ -29,6 +30,7 @@ in the source distribution for its full text.
 #include "XUtils.h"
 #include "linux/IOPriority.h"
 #include "linux/LinuxMachine.h"
+#include "linux/ProcFile.h"
 
 
 const ProcessFieldData Process_fields[LAST_PROCESSFIELD] = {
@@ -98,6 +100,7 @@ const ProcessFieldData Process_fields[LAST_PROCESSFIELD] = {
 #endif
    [M_PSS] = { .name = "M_PSS", .title = "  PSS ", .description = "proportional set size, same as M_RESIDENT but each page is divided by the number of processes sharing it", .flags = PROCESS_FLAG_LINUX_SMAPS, .defaultSortDesc = true, },
    [M_SWAP] = { .name = "M_SWAP", .title = " SWAP ", .description = "Size of the process's swapped pages", .flags = PROCESS_FLAG_LINUX_SMAPS, .defaultSortDesc = true, },
+   [M_WSS] = { .name = "M_WSS", .title = "  WSS ", .description = "Working set size: memory touched within the last refreshes, sampled from idle page tracking while shown (root only)", .flags = PROCESS_FLAG_LINUX_WSS, .defaultSortDesc = true, },
    [M_PSSWP] = { .name = "M_PSSWP", .title = " PSSWP ", .description = "shows proportional swap share of this mapping, unlike \"Swap\", this does not take into account swapped out page of underlying shmem objects", .flags = PROCESS_FLAG_LINUX_SMAPS, .defaultSortDesc = true, },
    [CTXT] = { .name = "CTXT", .title = " CTXT ", .description = "Context switches (incremental sum of voluntary_ctxt_switches and nonvoluntary_ctxt_switches)", .flags = PROCESS_FLAG_LINUX_CTXT, .defaultSortDesc = true, },
    [SECATTR] = { .name = "SECATTR", .title = "Security Attribute", .description = "Security attribute of the process (e.g. SELinux or AppArmor)", .flags = PROCESS_FLAG_LINUX_SECATTR, .autoWidth = true, },
@@ -118,6 +121,7 @@ Process* LinuxProcess_new(const Machine* host) {
    LinuxProcess* this = xCalloc(1, sizeof(LinuxProcess));
    Object_setClass(this, Class(LinuxProcess));
    Process_init(&this->super, host);
+   this->m_wss = -1;
    return (Process*)this;
 }
 
@@ -218,6 +222,26 @@ bool LinuxProcess_rowChangeAutogroupPriorityBy(Row* super, Arg delta) {
    return LinuxProcess_changeAutogroupPriorityBy(p, delta);
 }
 
+bool LinuxProcess_isSame(const LinuxProcess* this) {
+   char path[32];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/stat", Process_getPid(&this->super));
+
+   char buffer[1024];
+   if (xReadfile(path, buffer, sizeof(buffer)) <= 0)
+      return false;
+
+   /* (22) starttime, counting fields after the name, which may hold blanks and parentheses */
+   const char* p = strrchr(buffer, ')');
+   if (!p)
+      return false;
+   p++;
+   for (int field = 3; field < 22; field++)
+      p = ProcFile_skipField(p);
+
+   unsigned long long int starttime;
+   return ProcFile_parseULL(&p, &starttime) && starttime == this->starttime;
+}
+
 static double LinuxProcess_totalIORate(const LinuxProcess* lp) {
    double totalRate = NAN;
    if (isNonnegative(lp->io_rate_read_bps)) {
@@ -263,6 +287,15 @@ static void LinuxProcess_rowWriteField(const Row* super, RichString* str, Proces
    case M_PSS: Row_printKBytes(str, lp->m_pss, coloring); return;
    case M_SWAP: Row_printKBytes(str, lp->m_swap, coloring); return;
    case M_PSSWP: Row_printKBytes(str, lp->m_psswp, coloring); return;
+   case M_WSS:
+      if (lp->m_wss >= 0) {
+         Row_printKBytes(str, lp->m_wss, coloring);
+         return;
+      }
+
+      attr = CRT_colors[PROCESS_SHADOW];
+      xSnprintf(buffer, n, "  N/A ");
+      break;
    case UTIME: Row_printTime(str, lp->utime, coloring); return;
    case STIME: Row_printTime(str, lp->stime, coloring); return;
    case CUTIME: Row_printTime(str, lp->cutime, coloring); return;
@@ -391,6 +424,8 @@ static int LinuxProcess_compareByKey(const Process* v1, const Process* v2, Proce
       return SPACESHIP_NUMBER(p1->m_swap, p2->m_swap);
    case M_PSSWP:
       return SPACESHIP_NUMBER(p1->m_psswp, p2->m_psswp);
+   case M_WSS:
+      return SPACESHIP_NUMBER(p1->m_wss, p2->m_wss);
    case UTIME:
       return SPACESHIP_NUMBER(p1->utime, p2->utime);
    case CUTIME:
@@ -31,10 +31,15 @@ in the source distribution for its full text.
 #define PROCESS_FLAG_LINUX_AUTOGROUP 0x00080000
 #define PROCESS_FLAG_LINUX_GPU       0x00100000
 #define PROCESS_FLAG_LINUX_CONTAINER 0x00200000
+#define PROCESS_FLAG_LINUX_WSS       0x00400000
 
 typedef struct LinuxProcess_ {
    Process super;
    IOPriority ioPriority;
+
+   /* Start time in clock ticks after boot, telling the process apart from a later one with the same pid */
+   unsigned long long int starttime;
+
    unsigned long int cminflt;
    unsigned long int cmajflt;
    unsigned long long int utime;
@@ -50,6 +55,9 @@ typedef struct LinuxProcess_ {
    long m_drs;
    long m_lrs;
 
+   /* Memory touched within the last refreshes in kB, estimated while shown; -1 if not known */
+   long m_wss;
+
    /* Process flags */
    unsigned long int flags;
 
@@ -140,6 +148,9 @@ bool LinuxProcess_isAutogroupEnabled(void);
 
 bool LinuxProcess_rowChangeAutogroupPriorityBy(Row* super, Arg delta);
 
+/* Whether the pid of the process still names it, rather than a process started since with the same pid */
+bool LinuxProcess_isSame(const LinuxProcess* this);
+
 bool Process_isThread(const Process* this);
 
 #endif
@@ -31,19 +31,24 @@ in the source distribution for its full text.
 #include "Machine.h"
 #include "Macros.h"
 #include "Object.h"
+#include "Panel.h"
 #include "Process.h"
+#include "Profiler.h"
 #include "Row.h"
 #include "RowField.h"
 #include "Scheduling.h"
 #include "Settings.h"
 #include "Table.h"
 #include "UsersTable.h"
+#include "Vector.h"
 #include "XUtils.h"
 #include "linux/CGroupUtils.h"
 #include "linux/GPU.h"
 #include "linux/LinuxMachine.h"
 #include "linux/LinuxProcess.h"
 #include "linux/Platform.h" // needed for GNU/hurd to get PATH_MAX  // IWYU pragma: keep
+#include "linux/ProcessAggregate.h"
+#include "linux/WorkingSet.h"
 
 #ifdef HAVE_DELAYACCT
 #include "linux/LibNl.h"
@@ -246,6 +251,9 @@ ProcessTable* ProcessTable_new(Machine* host, Hashtable* pidMatchList) {
 
    LinuxProcessTable_initTtyDrivers(this);
 
+   this->aggregates = Hashtable_new(16, false);
+   this->lastAggregateId = INT_MIN;
+
    // Test /proc/PID/smaps_rollup availability (faster to parse, Linux 4.14+)
    this->haveSmapsRollup = (access(PROCDIR "/self/smaps_rollup", R_OK) == 0);
 
@@ -266,6 +274,8 @@ ProcessTable* ProcessTable_new(Machine* host, Hashtable* pidMatchList) {
 void ProcessTable_delete(Object* cast) {
    LinuxProcessTable* this = (LinuxProcessTable*) cast;
    ProcessTable_done(&this->super);
+   /* emptied by the aggregates deleted along with the rows */
+   Hashtable_delete(this->aggregates);
    if (this->ttyDrivers) {
       for (int i = 0; this->ttyDrivers[i].path; i++) {
          free(this->ttyDrivers[i].path);
@@ -275,6 +285,8 @@ void ProcessTable_delete(Object* cast) {
    #ifdef HAVE_DELAYACCT
    LibNl_destroyNetlinkSocket(this);
    #endif
+   if (this->workingSets)
+      WorkingSetTable_delete(this->workingSets);
    free(this);
 }
 
@@ -492,7 +504,8 @@ static bool LinuxProcessTable_readStatFile(LinuxProcess* lp, openat_arg_t procFd
 
    /* (22) starttime  -  %llu */
    if (process->starttime_ctime == 0) {
-      process->starttime_ctime = lhost->boottime + LinuxProcessTable_adjustTime(lhost, fast_strtoll_dec(&location, 0)) / 100;
+      lp->starttime = fast_strtoull_dec(&location, 0);
+      process->starttime_ctime = lhost->boottime + LinuxProcessTable_adjustTime(lhost, lp->starttime) / 100;
    } else {
       location = strchr(location, ' ');
       if (!location)
@@ -620,7 +633,7 @@ static bool LinuxProcessTable_updateUser(const Machine* host, Process* process,
    if (statok == -1)
       return false;
 
-   if (process->st_uid != sb.st_uid) {
+   if (process->st_uid != sb.st_uid || !process->user) {
       process->st_uid = sb.st_uid;
       process->user = UsersTable_getRef(host->usersTable, sb.st_uid);
    }
@@ -1554,6 +1567,7 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
    const bool hideKernelThreads = settings->hideKernelThreads;
    const bool hideUserlandThreads = settings->hideUserlandThreads;
    const bool hideRunningInContainer = settings->hideRunningInContainer;
+   const RowField groupBy = ss->groupBy;
    while ((entry = readdir(dir)) != NULL) {
       const char* name = entry->d_name;
 
@@ -1642,7 +1656,10 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
 
       const bool scanMainThread = !hideUserlandThreads && !Process_isKernelThread(proc) && !mainTask;
 
-      if (!LinuxProcessTable_readStatmFile(lp, procFd, lhost, mainTask))
+      uint64_t readStart = Profiler_begin();
+      bool readOk = LinuxProcessTable_readStatmFile(lp, procFd, lhost, mainTask);
+      Profiler_end(PROFILE_READ_STATM, readStart);
+      if (!readOk)
          goto errorReadingProcess;
 
       {
@@ -1673,7 +1690,10 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
       char statCommand[MAX_NAME + 1];
       unsigned long long int lasttimes = (lp->utime + lp->stime);
       unsigned long int last_tty_nr = proc->tty_nr;
-      if (!LinuxProcessTable_readStatFile(lp, procFd, lhost, scanMainThread, statCommand, sizeof(statCommand)))
+      readStart = Profiler_begin();
+      readOk = LinuxProcessTable_readStatFile(lp, procFd, lhost, scanMainThread, statCommand, sizeof(statCommand));
+      Profiler_end(PROFILE_READ_STAT, readStart);
+      if (!readOk)
          goto errorReadingProcess;
 
       if (lp->flags & PF_KTHREAD) {
@@ -1719,7 +1739,10 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
 #endif
       ) {
          proc->isRunningInContainer = TRI_OFF;
-         if (!LinuxProcessTable_readStatusFile(proc, procFd))
+         readStart = Profiler_begin();
+         readOk = LinuxProcessTable_readStatusFile(proc, procFd);
+         Profiler_end(PROFILE_READ_STATUS, readStart);
+         if (!readOk)
             goto errorReadingProcess;
       }
 
@@ -1734,10 +1757,12 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
          if (proc->isKernelThread) {
             Process_updateCmdline(proc, NULL, 0, 0);
          } else {
+            readStart = Profiler_begin();
             if (!LinuxProcessTable_readCmdlineFile(proc, procFd, mainTask)) {
                Process_updateCmdline(proc, statCommand, 0, strlen(statCommand));
             }
             LinuxProcessList_readComm(proc, procFd);
+            Profiler_end(PROFILE_READ_CMDLINE, readStart);
          }
 
          Process_fillStarttimeBuffer(proc);
@@ -1748,10 +1773,12 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
             if (proc->isKernelThread) {
                Process_updateCmdline(proc, NULL, 0, 0);
             } else {
+               readStart = Profiler_begin();
                if (!LinuxProcessTable_readCmdlineFile(proc, procFd, mainTask)) {
                   Process_updateCmdline(proc, statCommand, 0, strlen(statCommand));
                }
                LinuxProcessList_readComm(proc, procFd);
+               Profiler_end(PROFILE_READ_CMDLINE, readStart);
             }
          }
       }
@@ -1774,15 +1801,20 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
          }
       }
 
-      if (ss->flags & PROCESS_FLAG_LINUX_CGROUP)
+      if (ss->flags & PROCESS_FLAG_LINUX_CGROUP) {
+         readStart = Profiler_begin();
          LinuxProcessTable_readCGroupFile(lp, procFd);
+         Profiler_end(PROFILE_READ_CGROUP, readStart);
+      }
 
       if ((ss->flags & PROCESS_FLAG_LINUX_SMAPS) && !Process_isKernelThread(proc)) {
          if (!mainTask) {
             // Read smaps file of each process only every second pass to improve performance
             static int smaps_flag = 0;
             if ((pid & 1) == smaps_flag) {
+               readStart = Profiler_begin();
                LinuxProcessTable_readSmapsFile(lp, procFd, this->haveSmapsRollup);
+               Profiler_end(PROFILE_READ_SMAPS, readStart);
             }
             if (pid == 1) {
                smaps_flag = !smaps_flag;
@@ -1795,7 +1827,9 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
       }
 
       if (ss->flags & PROCESS_FLAG_IO) {
+         readStart = Profiler_begin();
          LinuxProcessTable_readIoFile(lp, procFd, scanMainThread);
+         Profiler_end(PROFILE_READ_IO, readStart);
       }
 
       #ifdef HAVE_DELAYACCT
@@ -1850,6 +1884,15 @@ static bool LinuxProcessTable_recurseProcTree(LinuxProcessTable* this, openat_ar
       proc->super.updated = true;
       Compat_openatArgClose(procFd);
 
+      proc->super.aggregate = 0;
+      if (groupBy) {
+         char buffer[PROCESS_AGGREGATE_TEXT_MAX];
+         const char* key = ProcessAggregate_keyOf(lp, groupBy, buffer, sizeof(buffer));
+         ProcessAggregate* aggregate = ProcessAggregate_get(pt, groupBy, key, lp);
+         ProcessAggregate_add(aggregate, lp);
+         proc->super.aggregate = aggregate->super.super.super.id;
+      }
+
       if (hideRunningInContainer && proc->isRunningInContainer == TRI_ON) {
          proc->super.show = false;
          continue;
@@ -1894,6 +1937,56 @@ errorReadingProcess:
    return true;
 }
 
+static void LinuxProcessTable_scheduleWorkingSet(WorkingSetTable* sets, Row* row, const Settings* settings) {
+   if (!row || row->isAggregate)
+      return;
+
+   LinuxProcess* lp = (LinuxProcess*) row;
+   const WorkingSet* set = WorkingSetTable_schedule(sets, Process_getThreadGroup(&lp->super), settings->workingSetPercent, settings->workingSetWindow);
+   lp->m_wss = set->touchedKB;
+}
+
+/*
+ * Samples the working sets of the processes on screen and of those tagged
+ * only, since sampling costs system calls per page. The rows were put in
+ * the panel by the last refresh and are not removed before this scan ends.
+ */
+static void LinuxProcessTable_updateWorkingSets(LinuxProcessTable* this, const LinuxMachine* lhost) {
+   Table* table = &this->super.super;
+   const Settings* settings = lhost->super.settings;
+
+   if (!(settings->ss->flags & PROCESS_FLAG_LINUX_WSS)) {
+      if (this->workingSets)
+         WorkingSetTable_delete(this->workingSets);
+      this->workingSets = NULL;
+      return;
+   }
+
+   if (!this->workingSets)
+      this->workingSets = WorkingSetTable_new(lhost->pageSizeKB);
+   WorkingSetTable* sets = this->workingSets;
+
+   WorkingSetTable_begin(sets);
+
+   Panel* panel = table->panel;
+   if (panel) {
+      /* the selection first, should the budget not cover the whole screen */
+      LinuxProcessTable_scheduleWorkingSet(sets, (Row*) Panel_getSelected(panel), settings);
+
+      const int last = MINIMUM(Panel_size(panel), panel->scrollV + panel->h);
+      for (int i = MAXIMUM(panel->scrollV, 0); i < last; i++)
+         LinuxProcessTable_scheduleWorkingSet(sets, (Row*) Panel_get(panel, i), settings);
+   }
+
+   for (int i = 0; i < Vector_size(table->rows); i++) {
+      Row* row = (Row*) Vector_get(table->rows, i);
+      if (row->tag)
+         LinuxProcessTable_scheduleWorkingSet(sets, row, settings);
+   }
+
+   WorkingSetTable_end(sets);
+}
+
 void ProcessTable_goThroughEntries(ProcessTable* super) {
    LinuxProcessTable* this = (LinuxProcessTable*) super;
    Machine* host = super->super.host;
@@ -1930,4 +2023,6 @@ void ProcessTable_goThroughEntries(ProcessTable* super) {
 #endif
 
    LinuxProcessTable_recurseProcTree(this, rootFd, lhost, PROCDIR, NULL);
+
+   LinuxProcessTable_updateWorkingSets(this, lhost);
 }
@@ -9,7 +9,9 @@ in the source distribution for its full text.
 
 #include <stdbool.h>
 
+#include "Hashtable.h"
 #include "ProcessTable.h"
+#include "linux/WorkingSet.h"
 
 
 typedef struct TtyDriver_ {
@@ -25,6 +27,9 @@ typedef struct LinuxProcessTable_ {
    TtyDriver* ttyDrivers;
    bool haveSmapsRollup;
    bool haveAutogroup;
+   WorkingSetTable* workingSets;  /* while the working set column is shown */
+   Hashtable* aggregates;         /* the ProcessAggregate rows by the hash of their key */
+   int lastAggregateId;
 
    #ifdef HAVE_DELAYACCT
    int netlink_family;
@@ -0,0 +1,291 @@
+/*
+htop - MemoryMapTable.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/MemoryMapTable.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Macros.h"
+#include "Platform.h"
+#include "Row.h"
+#include "XUtils.h"
+#include "linux/LinuxMachine.h"
+
+
+/* Bytes read at once; far longer than any line, whose path is at most PATH_MAX */
+#define MEMORYMAP_CHUNK (64 * 1024)
+
+typedef enum {
+   SMAPS_RSS,
+   SMAPS_PSS,
+   SMAPS_SWAP,
+   SMAPS_PRIVATE_DIRTY,
+   SMAPS_KEYS
+} SmapsKey;
+
+static const char* const MemoryMapTable_keyNames[SMAPS_KEYS] = {
+   [SMAPS_RSS] = "Rss",
+   [SMAPS_PSS] = "Pss",
+   [SMAPS_SWAP] = "Swap",
+   [SMAPS_PRIVATE_DIRTY] = "Private_Dirty",
+};
+
+static ProcKeys MemoryMapTable_keys;
+
+MemoryMapTable* MemoryMapTable_new(pid_t pid) {
+   if (!MemoryMapTable_keys.count)
+      ProcKeys_init(&MemoryMapTable_keys, MemoryMapTable_keyNames, SMAPS_KEYS);
+
+   MemoryMapTable* this = xCalloc(1, sizeof(MemoryMapTable));
+   this->pid = pid;
+   this->fd = -1;
+   this->buffer = xMalloc(MEMORYMAP_CHUNK + 1);
+   this->groups = Hashtable_new(64, false);
+   MemoryMapTable_restart(this);
+   return this;
+}
+
+static void MemoryMapTable_clear(MemoryMapTable* this) {
+   for (size_t i = 0; i < this->count; i++) {
+      free(this->sorted[i]->name);
+      free(this->sorted[i]);
+   }
+   this->count = 0;
+   Hashtable_clear(this->groups);
+   memset(&this->total, 0, sizeof(this->total));
+   this->current = NULL;
+}
+
+static void MemoryMapTable_close(MemoryMapTable* this) {
+   if (this->fd >= 0)
+      close(this->fd);
+   this->fd = -1;
+   this->len = 0;
+}
+
+void MemoryMapTable_delete(MemoryMapTable* this) {
+   MemoryMapTable_close(this);
+   MemoryMapTable_clear(this);
+   Hashtable_delete(this->groups);
+   free(this->sorted);
+   free(this->buffer);
+   free(this);
+}
+
+void MemoryMapTable_restart(MemoryMapTable* this) {
+   MemoryMapTable_close(this);
+   MemoryMapTable_clear(this);
+   this->done = false;
+   this->error = 0;
+
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/smaps", (int)this->pid);
+   this->fd = open(path, O_RDONLY | O_CLOEXEC);
+   if (this->fd < 0) {
+      this->error = errno;
+      this->done = true;
+   }
+}
+
+static bool MemoryMapGroup_isNamed(const void* group, const void* name) {
+   return String_eq(((const MemoryMapGroup*)group)->name, name);
+}
+
+/* The group of the mappings backed by name, added if it is the first one */
+static MemoryMapGroup* MemoryMapTable_groupOf(MemoryMapTable* this, const char* name, MemoryMapKind kind) {
+   ht_key_t key;
+   MemoryMapGroup* group = Hashtable_find(this->groups, Hashtable_hashString(HASHTABLE_HASH_INIT, name), MemoryMapGroup_isNamed, name, &key);
+   if (group)
+      return group;
+
+   group = xCalloc(1, sizeof(MemoryMapGroup));
+   group->name = xStrdup(name);
+   group->kind = kind;
+   Hashtable_put(this->groups, key, group);
+
+   if (this->count == this->capacity) {
+      this->capacity = this->capacity ? this->capacity * 2 : 64;
+      this->sorted = xReallocArray(this->sorted, this->capacity, sizeof(MemoryMapGroup*));
+   }
+   this->sorted[this->count++] = group;
+   return group;
+}
+
+/* "start-end perms offset dev inode   path", the path being empty for anonymous memory */
+static void MemoryMapTable_parseHeader(MemoryMapTable* this, const char* line) {
+   char* end;
+   unsigned long long int start = strtoull(line, &end, 16);
+   if (*end != '-') {
+      this->current = NULL;
+      return;
+   }
+   unsigned long long int stop = strtoull(end + 1, &end, 16);
+
+   const char* path = end;
+   for (int field = 0; field < 4; field++)
+      path = ProcFile_skipField(path);
+   path = ProcFile_skipBlanks(path);
+
+   MemoryMapKind kind = MEMORYMAP_FILE;
+   const char* name = path;
+   if (!*path) {
+      kind = MEMORYMAP_ANON;
+      name = "[anon]";
+   } else if (String_eq(path, "[heap]")) {
+      kind = MEMORYMAP_HEAP;
+   } else if (String_startsWith(path, "[stack")) {
+      kind = MEMORYMAP_STACK;
+      name = "[stack]";
+   } else if (String_startsWith(path, "[anon")) {
+      /* named with prctl(PR_SET_VMA_ANON_NAME), kept apart */
+      kind = MEMORYMAP_ANON;
+   } else if (path[0] == '[') {
+      kind = MEMORYMAP_SPECIAL;
+   }
+
+   MemoryMapGroup* group = MemoryMapTable_groupOf(this, name, kind);
+   unsigned long long int size = stop > start ? (stop - start) / ONE_K : 0;
+   group->mappings++;
+   group->size += size;
+   this->total.mappings++;
+   this->total.size += size;
+   this->current = group;
+}
+
+/* "Key:   value kB" */
+static void MemoryMapTable_parseField(MemoryMapTable* this, const char* line) {
+   const char* colon = strchr(line, ':');
+   if (!colon || !this->current)
+      return;
+
+   int key = ProcKeys_find(&MemoryMapTable_keys, line, (size_t)(colon - line));
+   if (key < 0)
+      return;
+
+   const char* value = colon + 1;
+   unsigned long long int kb;
+   if (!ProcFile_parseULL(&value, &kb))
+      return;
+
+   MemoryMapGroup* group = this->current;
+   switch (key) {
+   case SMAPS_RSS:
+      group->rss += kb;
+      this->total.rss += kb;
+      break;
+   case SMAPS_PSS:
+      group->pss += kb;
+      this->total.pss += kb;
+      break;
+   case SMAPS_SWAP:
+      group->swap += kb;
+      this->total.swap += kb;
+      break;
+   case SMAPS_PRIVATE_DIRTY:
+      group->privateDirty += kb;
+      this->total.privateDirty += kb;
+      break;
+   }
+}
+
+static void MemoryMapTable_parseLine(MemoryMapTable* this, const char* line) {
+   /* the fields of a mapping are capitalised, its header starts with a lowercase hex address */
+   if ((line[0] >= '0' && line[0] <= '9') || (line[0] >= 'a' && line[0] <= 'f'))
+      MemoryMapTable_parseHeader(this, line);
+   else
+      MemoryMapTable_parseField(this, line);
+}
+
+/* Parses the complete lines of the buffer and keeps the last, partial one for the next read */
+static void MemoryMapTable_parseBuffer(MemoryMapTable* this) {
+   char* line = this->buffer;
+   char* limit = this->buffer + this->len;
+   for (char* newline; (newline = memchr(line, '\n', (size_t)(limit - line))) != NULL; line = newline + 1) {
+      *newline = '\0';
+      MemoryMapTable_parseLine(this, line);
+   }
+
+   this->len = (size_t)(limit - line);
+   if (this->len == MEMORYMAP_CHUNK) {
+      /* cannot happen with the paths of Linux, dropped rather than growing the buffer */
+      this->len = 0;
+   } else if (line != this->buffer) {
+      memmove(this->buffer, line, this->len);
+   }
+}
+
+bool MemoryMapTable_read(MemoryMapTable* this, uint64_t budgetMs) {
+   if (this->done)
+      return true;
+
+   uint64_t start;
+   Platform_gettime_monotonic(&start);
+
+   for (;;) {
+      ssize_t n = read(this->fd, this->buffer + this->len, MEMORYMAP_CHUNK - this->len);
+      if (n < 0 && errno == EINTR)
+         continue;
+
+      if (n <= 0) {
+         if (n < 0) {
+            this->error = errno;
+         } else if (this->len) {
+            this->buffer[this->len] = '\0';
+            MemoryMapTable_parseLine(this, this->buffer);
+         }
+         MemoryMapTable_close(this);
+         this->done = true;
+         return true;
+      }
+
+      this->len += (size_t)n;
+      MemoryMapTable_parseBuffer(this);
+
+      uint64_t now;
+      Platform_gettime_monotonic(&now);
+      if (now - start >= budgetMs)
+         return false;
+   }
+}
+
+static MemoryMapSort MemoryMapTable_sortKey;
+
+static unsigned long long int MemoryMapTable_sortValue(const MemoryMapGroup* group) {
+   switch (MemoryMapTable_sortKey) {
+   case MEMORYMAP_SORT_PSS:
+      return group->pss;
+   case MEMORYMAP_SORT_SWAP:
+      return group->swap;
+   case MEMORYMAP_SORT_PRIVATE_DIRTY:
+      return group->privateDirty;
+   default:
+      return group->rss;
+   }
+}
+
+static int MemoryMapGroup_compare(const void* v1, const void* v2) {
+   const MemoryMapGroup* g1 = *(const MemoryMapGroup* const*)v1;
+   const MemoryMapGroup* g2 = *(const MemoryMapGroup* const*)v2;
+
+   int result = SPACESHIP_NUMBER(MemoryMapTable_sortValue(g2), MemoryMapTable_sortValue(g1));
+   if (result)
+      return result;
+
+   result = SPACESHIP_NUMBER(g2->size, g1->size);
+   return result ? result : strcmp(g1->name, g2->name);
+}
+
+void MemoryMapTable_sort(MemoryMapTable* this, MemoryMapSort key) {
+   MemoryMapTable_sortKey = key;
+   qsort(this->sorted, this->count, sizeof(MemoryMapGroup*), MemoryMapGroup_compare);
+}
@@ -0,0 +1,81 @@
+#ifndef HEADER_MemoryMapTable
+#define HEADER_MemoryMapTable
+/*
+htop - MemoryMapTable.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "Hashtable.h"
+#include "linux/ProcFile.h"
+
+
+typedef enum MemoryMapKind_ {
+   MEMORYMAP_FILE,
+   MEMORYMAP_ANON,
+   MEMORYMAP_HEAP,
+   MEMORYMAP_STACK,
+   MEMORYMAP_SPECIAL,             /* [vdso], [vvar] and the like */
+} MemoryMapKind;
+
+/* What the groups are sorted by, largest first */
+typedef enum MemoryMapSort_ {
+   MEMORYMAP_SORT_RSS,
+   MEMORYMAP_SORT_PSS,
+   MEMORYMAP_SORT_SWAP,
+   MEMORYMAP_SORT_PRIVATE_DIRTY,
+   MEMORYMAP_SORTS
+} MemoryMapSort;
+
+/* The mappings of one backing file, or of the anonymous memory, heap or stack; sizes in kB */
+typedef struct MemoryMapGroup_ {
+   char* name;                    /* the path, or "[anon]", "[heap]", "[stack]", ... */
+   MemoryMapKind kind;
+   size_t mappings;
+   unsigned long long int size;
+   unsigned long long int rss;
+   unsigned long long int pss;
+   unsigned long long int swap;
+   unsigned long long int privateDirty;
+} MemoryMapGroup;
+
+/*
+ * The mappings of a process from /proc/<pid>/smaps, summed up by what backs
+ * them. The file is parsed as it is read, in steps bounded in time, so that
+ * a process with hundreds of thousands of mappings can be read between
+ * key presses; the groups read so far can be shown meanwhile.
+ */
+typedef struct MemoryMapTable_ {
+   pid_t pid;
+   int fd;                        /* -1 while not reading */
+   char* buffer;                  /* the part of the file read but not parsed yet */
+   size_t len;
+   Hashtable* groups;             /* MemoryMapGroup, by hash of the name */
+   MemoryMapGroup* current;       /* group of the mapping whose fields are being read */
+   MemoryMapGroup** sorted;
+   size_t count;
+   size_t capacity;
+   MemoryMapGroup total;          /* of all mappings, without a name */
+   bool done;                     /* whether the whole file was read */
+   int error;                     /* errno of the last failed read, 0 if none */
+} MemoryMapTable;
+
+MemoryMapTable* MemoryMapTable_new(pid_t pid);
+
+void MemoryMapTable_delete(MemoryMapTable* this);
+
+/* Forgets the mappings read and starts reading the file again */
+void MemoryMapTable_restart(MemoryMapTable* this);
+
+/* Reads on for about budgetMs at most; returns true once the whole file was read or it cannot be */
+bool MemoryMapTable_read(MemoryMapTable* this, uint64_t budgetMs);
+
+void MemoryMapTable_sort(MemoryMapTable* this, MemoryMapSort key);
+
+#endif
@@ -0,0 +1,187 @@
+/*
+htop - MemoryMapsScreen.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/MemoryMapsScreen.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "CRT.h"
+#include "FunctionBar.h"
+#include "Macros.h"
+#include "Meter.h"
+#include "Panel.h"
+#include "ProvideCurses.h"
+#include "Vector.h"
+#include "XUtils.h"
+#include "linux/LinuxMachine.h"
+
+
+static const char* const MemoryMapsScreenFunctions[] = {"Search ", "Filter ", "Refresh", "SortBy ", "Done   ", NULL};
+
+static const char* const MemoryMapsScreenKeys[] = {"F3", "F4", "F5", "F6", "Esc"};
+
+static const int MemoryMapsScreenEvents[] = {KEY_F(3), KEY_F(4), KEY_F(5), KEY_F(6), 27};
+
+static const char* const MemoryMapsScreen_sortNames[MEMORYMAP_SORTS] = {
+   [MEMORYMAP_SORT_RSS] = "RSS",
+   [MEMORYMAP_SORT_PSS] = "PSS",
+   [MEMORYMAP_SORT_SWAP] = "swap",
+   [MEMORYMAP_SORT_PRIVATE_DIRTY] = "private dirty",
+};
+
+static const char* const MemoryMapsScreen_kindNames[] = {
+   [MEMORYMAP_FILE] = "file",
+   [MEMORYMAP_ANON] = "anon",
+   [MEMORYMAP_HEAP] = "heap",
+   [MEMORYMAP_STACK] = "stack",
+   [MEMORYMAP_SPECIAL] = "kernel",
+};
+
+/* Time spent reading at once, and between two reads for keys to be handled */
+#define MEMORYMAPSSCREEN_READ_MS 50
+#define MEMORYMAPSSCREEN_PAUSE_MS 10
+
+static void MemoryMapsScreen_setTimeout(const MemoryMapsScreen* this) {
+   if (this->maps->done) {
+      CRT_enableDelay();
+      return;
+   }
+
+   /* halfdelay() counts in tenths of a second, too slow to read on */
+   nocbreak();
+   cbreak();
+   timeout(MEMORYMAPSSCREEN_PAUSE_MS);
+}
+
+MemoryMapsScreen* MemoryMapsScreen_new(const Process* process) {
+   MemoryMapsScreen* this = xCalloc(1, sizeof(MemoryMapsScreen));
+   Object_setClass(this, Class(MemoryMapsScreen));
+   this->maps = MemoryMapTable_new(Process_getThreadGroup(process));
+   this->sortKey = MEMORYMAP_SORT_RSS;
+
+   FunctionBar* fuBar = FunctionBar_new(MemoryMapsScreenFunctions, MemoryMapsScreenKeys, MemoryMapsScreenEvents);
+   return (MemoryMapsScreen*) InfoScreen_init(&this->super, process, fuBar, LINES - 2, " ");
+}
+
+void MemoryMapsScreen_delete(Object* cast) {
+   MemoryMapsScreen* this = (MemoryMapsScreen*) cast;
+   MemoryMapTable_delete(this->maps);
+   CRT_enableDelay();
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void MemoryMapsScreen_draw(InfoScreen* super) {
+   const MemoryMapsScreen* this = (const MemoryMapsScreen*) super;
+   const MemoryMapTable* maps = this->maps;
+
+   InfoScreen_drawTitled(super, "Memory maps of process %d - %s: %zu mappings in %zu groups, by %s%s",
+                         (int)maps->pid, Process_getCommand(super->process), maps->total.mappings, maps->count,
+                         MemoryMapsScreen_sortNames[this->sortKey], maps->done ? "" : " (reading...)");
+}
+
+static void MemoryMapsScreen_addGroup(InfoScreen* super, const MemoryMapGroup* group, const char* kind, const char* name) {
+   char size[16];
+   char rss[16];
+   char pss[16];
+   char swap[16];
+   char dirty[16];
+   Meter_humanUnit(size, (double)group->size, sizeof(size));
+   Meter_humanUnit(rss, (double)group->rss, sizeof(rss));
+   Meter_humanUnit(pss, (double)group->pss, sizeof(pss));
+   Meter_humanUnit(swap, (double)group->swap, sizeof(swap));
+   Meter_humanUnit(dirty, (double)group->privateDirty, sizeof(dirty));
+
+   char entry[4200];
+   xSnprintf(entry, sizeof(entry), "%7zu %7s %7s %7s %7s %7s  %-6s %s",
+             group->mappings, size, rss, pss, swap, dirty, kind, name);
+   InfoScreen_addLine(super, entry);
+}
+
+/* Shows the groups read so far, the total first */
+static void MemoryMapsScreen_fill(InfoScreen* super) {
+   MemoryMapsScreen* this = (MemoryMapsScreen*) super;
+   MemoryMapTable* maps = this->maps;
+   Panel* panel = super->display;
+   int idx = Panel_getSelectedIndex(panel);
+   Panel_prune(panel);
+   Vector_prune(super->lines);
+
+   Panel_setHeader(panel, "   MAPS    SIZE     RSS     PSS    SWAP P.DIRTY  KIND   BACKING");
+
+   if (maps->error) {
+      char message[128];
+      xSnprintf(message, sizeof(message), "Could not read " PROCDIR "/%d/smaps: %s", (int)maps->pid, strerror(maps->error));
+      InfoScreen_addLine(super, message);
+   }
+
+   if (maps->total.mappings) {
+      MemoryMapTable_sort(maps, this->sortKey);
+      MemoryMapsScreen_addGroup(super, &maps->total, "", "(total)");
+      for (size_t i = 0; i < maps->count; i++) {
+         const MemoryMapGroup* group = maps->sorted[i];
+         MemoryMapsScreen_addGroup(super, group, MemoryMapsScreen_kindNames[group->kind], group->name);
+      }
+   }
+
+   Panel_setSelected(panel, idx);
+}
+
+/* Reads on for a while, the rest being read between key presses */
+static void MemoryMapsScreen_readOn(MemoryMapsScreen* this) {
+   MemoryMapTable_read(this->maps, MEMORYMAPSSCREEN_READ_MS);
+   MemoryMapsScreen_setTimeout(this);
+}
+
+static void MemoryMapsScreen_scan(InfoScreen* super) {
+   MemoryMapsScreen* this = (MemoryMapsScreen*) super;
+
+   /* the first scan reads what the table started, the later ones read it all again */
+   if (this->maps->done)
+      MemoryMapTable_restart(this->maps);
+
+   MemoryMapsScreen_readOn(this);
+   MemoryMapsScreen_fill(super);
+}
+
+static void MemoryMapsScreen_onErr(InfoScreen* super) {
+   MemoryMapsScreen* this = (MemoryMapsScreen*) super;
+   if (this->maps->done)
+      return;
+
+   MemoryMapsScreen_readOn(this);
+   MemoryMapsScreen_fill(super);
+   InfoScreen_draw(super);
+}
+
+static bool MemoryMapsScreen_onKey(InfoScreen* super, int ch) {
+   MemoryMapsScreen* this = (MemoryMapsScreen*) super;
+
+   switch (ch) {
+      case 's':
+      case KEY_F(6):
+         this->sortKey = (MemoryMapSort)((this->sortKey + 1) % MEMORYMAP_SORTS);
+         MemoryMapsScreen_fill(super);
+         InfoScreen_draw(super);
+         return true;
+   }
+
+   return false;
+}
+
+const InfoScreenClass MemoryMapsScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = MemoryMapsScreen_delete
+   },
+   .scan = MemoryMapsScreen_scan,
+   .draw = MemoryMapsScreen_draw,
+   .onErr = MemoryMapsScreen_onErr,
+   .onKey = MemoryMapsScreen_onKey
+};
@@ -0,0 +1,28 @@
+#ifndef HEADER_MemoryMapsScreen
+#define HEADER_MemoryMapsScreen
+/*
+htop - MemoryMapsScreen.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "InfoScreen.h"
+#include "Object.h"
+#include "Process.h"
+#include "linux/MemoryMapTable.h"
+
+
+typedef struct MemoryMapsScreen_ {
+   InfoScreen super;
+   MemoryMapTable* maps;
+   MemoryMapSort sortKey;
+} MemoryMapsScreen;
+
+extern const InfoScreenClass MemoryMapsScreen_class;
+
+MemoryMapsScreen* MemoryMapsScreen_new(const Process* process);
+
+void MemoryMapsScreen_delete(Object* this);
+
+#endif
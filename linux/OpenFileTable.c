@@ -0,0 +1,462 @@
+/*
+htop - OpenFileTable.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/OpenFileTable.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+
+#include "Macros.h"
+#include "Platform.h"
+#include "XUtils.h"
+#include "linux/LinuxMachine.h"
+
+
+static const char* const OpenFileTable_netFiles[OPENFILE_NET_FILES] = {
+   [OPENFILE_NET_TCP] = "tcp",
+   [OPENFILE_NET_TCP6] = "tcp6",
+   [OPENFILE_NET_UDP] = "udp",
+   [OPENFILE_NET_UDP6] = "udp6",
+   [OPENFILE_NET_UNIX] = "unix",
+};
+
+/* as numbered in include/net/tcp_states.h */
+static const char* const OpenFileTable_tcpStates[] = {
+   "", "ESTABLISHED", "SYN_SENT", "SYN_RECV", "FIN_WAIT1", "FIN_WAIT2", "TIME_WAIT",
+   "CLOSE", "CLOSE_WAIT", "LAST_ACK", "LISTEN", "CLOSING", "NEW_SYN_RECV",
+};
+
+OpenFileTable* OpenFileTable_new(pid_t pid) {
+   OpenFileTable* this = xCalloc(1, sizeof(OpenFileTable));
+   this->pid = pid;
+   ProcEntries_init(&this->files);
+
+   for (size_t i = 0; i < OPENFILE_NET_FILES; i++) {
+      char path[64];
+      xSnprintf(path, sizeof(path), PROCDIR "/%d/net/%s", (int)pid, OpenFileTable_netFiles[i]);
+      ProcFile_init(&this->net[i], path);
+   }
+   return this;
+}
+
+static void OpenFile_delete(ProcEntry* cast) {
+   OpenFile* this = (OpenFile*) cast;
+   free(this->name);
+   free(this);
+}
+
+void OpenFileTable_delete(OpenFileTable* this) {
+   ProcEntries_done(&this->files, OpenFile_delete);
+   free(this->spare);
+
+   for (size_t i = 0; i < OPENFILE_NET_FILES; i++)
+      ProcFile_done(&this->net[i]);
+   free(this);
+}
+
+static const char* OpenFile_typeOf(mode_t mode, const char* link) {
+   if (String_startsWith(link, "anon_inode:"))
+      return "a_inode";
+
+   switch (mode & S_IFMT) {
+   case S_IFREG:  return "REG";
+   case S_IFDIR:  return "DIR";
+   case S_IFCHR:  return "CHR";
+   case S_IFBLK:  return "BLK";
+   case S_IFIFO:  return "FIFO";
+   case S_IFSOCK: return "sock";
+   case S_IFLNK:  return "LINK";
+   default:       return "unknown";
+   }
+}
+
+/* Reads the position, open flags and mount of a descriptor from fdinfo */
+static void OpenFile_readInfo(OpenFile* this, int infoFd) {
+   char name[16];
+   xSnprintf(name, sizeof(name), "%d", this->super.number);
+
+   /* the fields needed come first; what follows, as for epoll or inotify, may be long */
+   char buffer[256];
+   if (infoFd < 0 || xReadfileat(infoFd, name, buffer, sizeof(buffer)) <= 0)
+      return;
+
+   char* cursor = buffer;
+   char* line;
+   while ((line = strsep(&cursor, "\n")) != NULL) {
+      if (String_startsWith(line, "pos:")) {
+         this->pos = strtoull(line + strlen("pos:"), NULL, 10);
+      } else if (String_startsWith(line, "flags:")) {
+         this->flags = (unsigned int) strtoul(line + strlen("flags:"), NULL, 8);
+      } else if (String_startsWith(line, "mnt_id:")) {
+         this->mntId = (int) strtol(line + strlen("mnt_id:"), NULL, 10);
+         break;
+      }
+   }
+}
+
+static bool OpenFileTable_parseHex(const char** str, unsigned int digits, uint32_t* value) {
+   const char* p = *str;
+   uint32_t v = 0;
+   unsigned int n = 0;
+   for (; n < digits; n++, p++) {
+      unsigned int d;
+      if (*p >= '0' && *p <= '9')
+         d = (unsigned int)(*p - '0');
+      else if (*p >= 'A' && *p <= 'F')
+         d = (unsigned int)(*p - 'A' + 10);
+      else if (*p >= 'a' && *p <= 'f')
+         d = (unsigned int)(*p - 'a' + 10);
+      else
+         break;
+      v = (v << 4) | d;
+   }
+   if (n == 0)
+      return false;
+
+   *value = v;
+   *str = p;
+   return true;
+}
+
+/* Formats an "address:port" of the IPv4 or IPv6 socket tables, whose words are printed in host order */
+static bool OpenFileTable_parseAddress(const char** str, int family, char* out, size_t size) {
+   const char* p = ProcFile_skipBlanks(*str);
+   uint32_t words[4] = { 0 };
+   size_t nWords = family == AF_INET6 ? 4 : 1;
+   bool unspecified = true;
+   for (size_t i = 0; i < nWords; i++) {
+      if (!OpenFileTable_parseHex(&p, 8, &words[i]))
+         return false;
+      unspecified = unspecified && words[i] == 0;
+   }
+
+   uint32_t port;
+   if (*p != ':')
+      return false;
+   p++;
+   if (!OpenFileTable_parseHex(&p, 4, &port))
+      return false;
+
+   char addr[INET6_ADDRSTRLEN] = "*";
+   if (!unspecified && !inet_ntop(family, words, addr, sizeof(addr)))
+      return false;
+
+   char portStr[8] = "*";
+   if (port)
+      xSnprintf(portStr, sizeof(portStr), "%u", (unsigned int)port);
+
+   if (family == AF_INET6 && !unspecified)
+      xSnprintf(out, size, "[%s]:%s", addr, portStr);
+   else
+      xSnprintf(out, size, "%s:%s", addr, portStr);
+
+   *str = p;
+   return true;
+}
+
+/* Describes a line of /proc/net/{tcp,tcp6,udp,udp6} and returns its inode, 0 if it cannot be parsed */
+static unsigned long long int OpenFileTable_parseInetLine(const char* line, OpenFileNet net, char* out, size_t size, uint32_t queues[2]) {
+   const int family = (net == OPENFILE_NET_TCP6 || net == OPENFILE_NET_UDP6) ? AF_INET6 : AF_INET;
+   const bool tcp = net == OPENFILE_NET_TCP || net == OPENFILE_NET_TCP6;
+
+   /* sl: local_address rem_address st tx_queue:rx_queue tr:tm->when retrnsmt uid timeout inode */
+   const char* p = ProcFile_skipField(line);
+   char local[INET6_ADDRSTRLEN + 16];
+   char remote[INET6_ADDRSTRLEN + 16];
+   uint32_t state;
+   if (!OpenFileTable_parseAddress(&p, family, local, sizeof(local)) ||
+       !OpenFileTable_parseAddress(&p, family, remote, sizeof(remote)))
+      return 0;
+
+   p = ProcFile_skipBlanks(p);
+   if (!OpenFileTable_parseHex(&p, 2, &state))
+      return 0;
+
+   p = ProcFile_skipBlanks(p);
+   if (!OpenFileTable_parseHex(&p, 8, &queues[0]) || *p != ':')
+      return 0;
+   p++;
+   if (!OpenFileTable_parseHex(&p, 8, &queues[1]))
+      return 0;
+
+   for (int i = 0; i < 4; i++)
+      p = ProcFile_skipField(p);
+
+   unsigned long long int inode;
+   if (!ProcFile_parseULL(&p, &inode))
+      return 0;
+
+   bool connected = !String_eq(remote, "*:*");
+   if (tcp) {
+      const char* stateName = state < ARRAYSIZE(OpenFileTable_tcpStates) ? OpenFileTable_tcpStates[state] : "?";
+      if (connected)
+         xSnprintf(out, size, "TCP %s->%s (%s)", local, remote, stateName);
+      else
+         xSnprintf(out, size, "TCP %s (%s)", local, stateName);
+   } else {
+      if (connected)
+         xSnprintf(out, size, "UDP %s->%s", local, remote);
+      else
+         xSnprintf(out, size, "UDP %s", local);
+   }
+   return inode;
+}
+
+/* Describes a line of /proc/net/unix: Num RefCount Protocol Flags Type St Inode [Path] */
+static unsigned long long int OpenFileTable_parseUnixLine(const char* line, char* out, size_t size) {
+   const char* p = line;
+   for (int i = 0; i < 4; i++)
+      p = ProcFile_skipField(p);
+
+   uint32_t type;
+   p = ProcFile_skipBlanks(p);
+   if (!OpenFileTable_parseHex(&p, 4, &type))
+      return 0;
+
+   p = ProcFile_skipField(p);
+
+   unsigned long long int inode;
+   if (!ProcFile_parseULL(&p, &inode))
+      return 0;
+
+   const char* typeName = type == SOCK_STREAM ? "STREAM" : type == SOCK_DGRAM ? "DGRAM" : type == SOCK_SEQPACKET ? "SEQPACKET" : "?";
+   const char* path = ProcFile_skipBlanks(p);
+   if (*path)
+      xSnprintf(out, size, "UNIX %s type=%s", path, typeName);
+   else
+      xSnprintf(out, size, "UNIX type=%s", typeName);
+   return inode;
+}
+
+/* One pass over the socket tables describes all sockets waiting in pending, chained by inode */
+static void OpenFileTable_describeSockets(OpenFileTable* this, Hashtable* pending, size_t count) {
+   for (size_t net = 0; net < OPENFILE_NET_FILES && count > 0; net++) {
+      ProcFile* file = &this->net[net];
+      if (!ProcFile_read(file))
+         continue;
+
+      const char* type = net == OPENFILE_NET_UNIX ? "unix" : (net == OPENFILE_NET_TCP6 || net == OPENFILE_NET_UDP6) ? "IPv6" : "IPv4";
+      char* cursor = NULL;
+      ProcFile_nextLine(file, &cursor); /* header */
+
+      char* line;
+      while (count > 0 && (line = ProcFile_nextLine(file, &cursor)) != NULL) {
+         char description[PATH_MAX + 32];
+         uint32_t queues[2] = { 0, 0 };
+         unsigned long long int inode = net == OPENFILE_NET_UNIX
+            ? OpenFileTable_parseUnixLine(line, description, sizeof(description))
+            : OpenFileTable_parseInetLine(line, (OpenFileNet)net, description, sizeof(description), queues);
+         if (!inode)
+            continue;
+
+         /* a socket open on several descriptors is described for each; others sharing the key wait on */
+         OpenFile* chain = Hashtable_remove(pending, (ht_key_t)inode);
+         OpenFile* others = NULL;
+         while (chain) {
+            OpenFile* socket = chain;
+            chain = socket->nextPending;
+
+            if ((unsigned long long int)socket->inode != inode) {
+               socket->nextPending = others;
+               others = socket;
+               continue;
+            }
+
+            if (!String_eq(socket->name, description))
+               free_and_xStrdup(&socket->name, description);
+            socket->type = type;
+            socket->hasQueues = net != OPENFILE_NET_UNIX;
+            socket->sendQueue = queues[0];
+            socket->recvQueue = queues[1];
+            socket->nextPending = NULL;
+            count--;
+         }
+         if (others)
+            Hashtable_put(pending, (ht_key_t)inode, others);
+      }
+   }
+}
+
+static int OpenFile_compareByFd(const void* v1, const void* v2) {
+   const ProcEntry* f1 = *(const ProcEntry* const*)v1;
+   const ProcEntry* f2 = *(const ProcEntry* const*)v2;
+   return SPACESHIP_NUMBER(f1->number, f2->number);
+}
+
+/* Closed descriptors, kept in order at the front, go back among the open ones */
+static void OpenFileTable_mergeClosed(OpenFileTable* this, size_t closed) {
+   ProcEntries* files = &this->files;
+   this->spare = xReallocArray(this->spare, files->capacity, sizeof(ProcEntry*));
+
+   size_t i = 0;
+   size_t j = closed;
+   size_t n = 0;
+   while (i < closed || j < files->count) {
+      if (j == files->count || (i < closed && files->sorted[i]->number < files->sorted[j]->number))
+         this->spare[n++] = files->sorted[i++];
+      else
+         this->spare[n++] = files->sorted[j++];
+   }
+
+   ProcEntry** merged = this->spare;
+   this->spare = files->sorted;
+   files->sorted = merged;
+}
+
+typedef struct OpenFileTable_KeepClosed_ {
+   uint64_t now;
+   uint64_t keepClosedMs;
+} OpenFileTable_KeepClosed;
+
+/* Descriptors no longer open are kept for a while */
+static bool OpenFile_keepClosed(ProcEntry* cast, void* data) {
+   OpenFile* this = (OpenFile*) cast;
+   const OpenFileTable_KeepClosed* keep = data;
+
+   if (!this->tombStampMs && keep->keepClosedMs)
+      this->tombStampMs = keep->now + keep->keepClosedMs;
+   return this->tombStampMs > keep->now;
+}
+
+bool OpenFileTable_update(OpenFileTable* this, uint64_t keepClosedMs) {
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d", (int)this->pid);
+   int procFd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   if (procFd < 0) {
+      this->error = errno;
+      return false;
+   }
+
+   int dirFd = openat(procFd, "fd", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   int infoFd = openat(procFd, "fdinfo", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   this->error = dirFd < 0 ? errno : 0;
+   close(procFd);
+
+   DIR* dir = dirFd >= 0 ? fdopendir(dirFd) : NULL;
+   if (!dir) {
+      if (!this->error)
+         this->error = errno;
+      if (dirFd >= 0)
+         close(dirFd);
+      if (infoFd >= 0)
+         close(infoFd);
+      return false;
+   }
+
+   uint64_t now;
+   Platform_gettime_monotonic(&now);
+   const uint64_t elapsedMs = this->monotonicMs && now > this->monotonicMs ? now - this->monotonicMs : 0;
+
+   ProcEntries_begin(&this->files);
+
+   Hashtable* pending = NULL;
+   size_t nPending = 0;
+   bool inOrder = true;
+   int lastFd = -1;
+
+   const char* name;
+   int fd;
+   while ((name = ProcEntries_next(dir, &fd)) != NULL) {
+      struct stat sb;
+      if (fstatat(dirFd, name, &sb, 0) < 0) {
+         /* closed since the directory was read */
+         if (errno == ENOENT)
+            continue;
+         memset(&sb, 0, sizeof(sb));
+      }
+
+      OpenFile* file = (OpenFile*) ProcEntries_get(&this->files, fd);
+      bool fresh = !file || file->dev != sb.st_dev || file->inode != sb.st_ino;
+      if (!file) {
+         file = xCalloc(1, sizeof(OpenFile));
+         file->super.number = fd;
+         ProcEntries_add(&this->files, &file->super);
+      }
+
+      /* a descriptor number used again, even for the same file, is a new descriptor */
+      if (fresh || file->tombStampMs) {
+         file->seenStampMs = this->monotonicMs ? now : 0;
+         file->tombStampMs = 0;
+         file->posRate = NAN;
+      }
+
+      if (fresh) {
+         char link[PATH_MAX];
+         ssize_t len = readlinkat(dirFd, name, link, sizeof(link) - 1);
+         link[len > 0 ? len : 0] = '\0';
+
+         free_and_xStrdup(&file->name, link);
+         file->type = OpenFile_typeOf(sb.st_mode, link);
+         file->dev = sb.st_dev;
+         file->inode = sb.st_ino;
+         file->mode = sb.st_mode;
+         file->mntId = -1;
+         file->hasQueues = false;
+      }
+      file->size = sb.st_size;
+
+      /* the state and queues of network sockets change, what other sockets are does not */
+      if (S_ISSOCK(file->mode) && !file->super.updated && (fresh || file->hasQueues)) {
+         if (!pending)
+            pending = Hashtable_new(64, false);
+         file->nextPending = Hashtable_get(pending, (ht_key_t)file->inode);
+         Hashtable_put(pending, (ht_key_t)file->inode, file);
+         nPending++;
+      }
+
+      /* only the position of files that have one changes */
+      if (fresh) {
+         OpenFile_readInfo(file, infoFd);
+      } else if (S_ISREG(file->mode) || S_ISDIR(file->mode) || S_ISBLK(file->mode) || S_ISCHR(file->mode)) {
+         unsigned long long int pos = file->pos;
+         OpenFile_readInfo(file, infoFd);
+         if (elapsedMs)
+            file->posRate = file->pos >= pos ? (double)(file->pos - pos) * 1000.0 / (double)elapsedMs : 0.0;
+      }
+
+      if (!ProcEntries_found(&this->files, &file->super))
+         continue;
+
+      inOrder = inOrder && fd > lastFd;
+      lastFd = fd;
+   }
+   closedir(dir);
+   if (infoFd >= 0)
+      close(infoFd);
+
+   /* descriptors no longer open are kept for a while, in order, before the open ones */
+   OpenFileTable_KeepClosed keep = { .now = now, .keepClosedMs = keepClosedMs };
+   size_t closed = ProcEntries_end(&this->files, OpenFile_keepClosed, &keep, OpenFile_delete);
+
+   /* the directory lists descriptors in order, so this seldom sorts */
+   if (!inOrder)
+      qsort(this->files.sorted + closed, this->files.count - closed, sizeof(ProcEntry*), OpenFile_compareByFd);
+
+   if (closed)
+      OpenFileTable_mergeClosed(this, closed);
+   this->monotonicMs = now;
+
+   if (pending) {
+      OpenFileTable_describeSockets(this, pending, nPending);
+      Hashtable_delete(pending);
+   }
+
+   return true;
+}
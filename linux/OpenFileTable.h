@@ -0,0 +1,86 @@
+#ifndef HEADER_OpenFileTable
+#define HEADER_OpenFileTable
+/*
+htop - OpenFileTable.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "linux/ProcEntries.h"
+#include "linux/ProcFile.h"
+
+
+typedef enum OpenFileNet_ {
+   OPENFILE_NET_TCP,
+   OPENFILE_NET_TCP6,
+   OPENFILE_NET_UDP,
+   OPENFILE_NET_UDP6,
+   OPENFILE_NET_UNIX,
+   OPENFILE_NET_FILES
+} OpenFileNet;
+
+typedef struct OpenFile_ {
+   ProcEntry super;               /* numbered by descriptor */
+   const char* type;              /* REG, DIR, IPv4, unix, ... as lsof names them */
+   dev_t dev;                     /* of the file the descriptor refers to */
+   ino_t inode;
+   mode_t mode;
+   off_t size;
+   unsigned long long int pos;    /* from fdinfo */
+   unsigned int flags;            /* open flags, from fdinfo */
+   int mntId;                     /* from fdinfo, -1 if unknown */
+   char* name;                    /* target of the link, or what the socket is connected to */
+   double posRate;                /* bytes per second the position moved by, NAN if unknown */
+   unsigned int sendQueue;        /* bytes queued on an IPv4 or IPv6 socket */
+   unsigned int recvQueue;
+   bool hasQueues;
+   uint64_t seenStampMs;          /* when the descriptor was found, 0 if by the first update */
+   uint64_t tombStampMs;          /* until when a closed descriptor stays listed, 0 while open */
+   struct OpenFile_* nextPending; /* during an update, the next socket to describe under the same key */
+} OpenFile;
+
+/*
+ * Descriptors open in a process, read from /proc/<pid>/fd and fdinfo and
+ * kept from one update to the next. A descriptor still referring to the
+ * same file costs one fstatat() per update; only new ones have their link
+ * read, and sockets are described by one pass over the socket tables of
+ * the network namespace of the process, made when new sockets showed up
+ * or IPv4 and IPv6 sockets need their state and queues read again.
+ * Closed descriptors can be kept listed for a while, as rows of dead
+ * processes are.
+ */
+typedef struct OpenFileTable_ {
+   pid_t pid;
+   ProcEntries files;             /* by descriptor, as of the last update */
+   ProcEntry** spare;             /* to merge closed descriptors into the sorted ones */
+   uint64_t monotonicMs;          /* time of the last update, 0 before the first */
+   ProcFile net[OPENFILE_NET_FILES];
+   int error;                     /* errno of the last failed update, 0 otherwise */
+} OpenFileTable;
+
+OpenFileTable* OpenFileTable_new(pid_t pid);
+
+void OpenFileTable_delete(OpenFileTable* this);
+
+/*
+ * Reads the descriptors of the process again; returns false if they cannot
+ * be listed. Descriptors closed since the last update are kept listed for
+ * keepClosedMs, with their tombStampMs set.
+ */
+bool OpenFileTable_update(OpenFileTable* this, uint64_t keepClosedMs);
+
+static inline size_t OpenFileTable_size(const OpenFileTable* this) {
+   return this->files.count;
+}
+
+static inline const OpenFile* OpenFileTable_get(const OpenFileTable* this, size_t i) {
+   return (const OpenFile*) this->files.sorted[i];
+}
+
+#endif
@@ -15,25 +15,36 @@ in the source distribution for its full text.
 #include <fcntl.h>
 #include <inttypes.h>
 #include <math.h>
+#include <signal.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include <unistd.h>
+#include <sys/syscall.h>
 #include <sys/sysmacros.h>
 
 #include "BatteryMeter.h"
+#include "BulkAction.h"
 #include "ClockMeter.h"
 #include "Compat.h"
+#include "CPUHeatmapMeter.h"
 #include "CPUMeter.h"
+#include "CRT.h"
 #include "DateMeter.h"
 #include "DateTimeMeter.h"
 #include "DiskIOMeter.h"
+#include "DynamicColumn.h"
+#include "DynamicScreen.h"
 #include "FileDescriptorMeter.h"
+#include "FunctionBar.h"
 #include "GPUMeter.h"
+#include "Hashtable.h"
 #include "HostnameMeter.h"
 #include "HugePageMeter.h"
+#include "InfoScreen.h"
+#include "ListItem.h"
 #include "LoadAverageMeter.h"
 #include "Machine.h"
 #include "Macros.h"
@@ -45,19 +56,34 @@ in the source distribution for its full text.
 #include "Object.h"
 #include "Panel.h"
 #include "PressureStallMeter.h"
+#include "ProfileMeter.h"
 #include "ProvideCurses.h"
 #include "Settings.h"
 #include "SwapMeter.h"
 #include "SysArchMeter.h"
+#include "Table.h"
 #include "TasksMeter.h"
 #include "UptimeMeter.h"
 #include "XUtils.h"
+#include "linux/CGroupEntry.h"
+#include "linux/CGroupTable.h"
+#include "linux/FileLocksScreen.h"
+#include "linux/IODeviceTable.h"
+#include "linux/IODevicesMeter.h"
+#include "linux/IODevicesScreen.h"
 #include "linux/IOPriority.h"
 #include "linux/IOPriorityPanel.h"
 #include "linux/LinuxMachine.h"
+#include "linux/LinuxOpenFilesScreen.h"
 #include "linux/LinuxProcess.h"
+#include "linux/MemoryMapsScreen.h"
+#include "linux/ProcFile.h"
 #include "linux/SELinuxMeter.h"
 #include "linux/SystemdMeter.h"
+#include "linux/SystemdUnitsScreen.h"
+#include "linux/ThreadsScreen.h"
+#include "linux/WaitProfileScreen.h"
+#include "linux/WorkingSetScreen.h"
 #include "linux/ZramMeter.h"
 #include "linux/ZramStats.h"
 #include "linux/ZswapStats.h"
@@ -77,6 +103,10 @@ in the source distribution for its full text.
 #define O_PATH         010000000 // declare for ancient glibc versions
 #endif
 
+#if defined(SYS_pidfd_open) && defined(SYS_pidfd_send_signal)
+#define PLATFORM_PIDFD
+#endif
+
 
 #ifdef HAVE_LIBCAP
 enum CapMode {
@@ -143,9 +173,6 @@ const SignalItem Platform_signals[] = {
 const unsigned int Platform_numberOfSignals = ARRAYSIZE(Platform_signals);
 
 static enum { BAT_PROC, BAT_SYS, BAT_ERR } Platform_Battery_method = BAT_PROC;
-static time_t Platform_Battery_cacheTime;
-static double Platform_Battery_cachePercent = NAN;
-static ACPresence Platform_Battery_cacheIsOnAC;
 
 #ifdef HAVE_LIBCAP
 static enum CapMode Platform_capabilitiesMode = CAP_MODE_BASIC;
@@ -164,10 +191,11 @@ static Htop_Reaction Platform_actionSetIOPriority(State* st) {
    const void* set = Action_pickFromVector(st, ioprioPanel, 20, true);
    if (set) {
       IOPriority ioprio2 = IOPriorityPanel_getIOPriority(ioprioPanel);
-      bool ok = MainPanel_foreachRow(st->mainPanel, LinuxProcess_rowSetIOPriority, (Arg) { .i = ioprio2 }, NULL);
-      if (!ok) {
-         beep();
-      }
+      BulkAction action;
+      BulkAction_init(&action, st->mainPanel);
+      BulkAction_run(&action, LinuxProcess_rowSetIOPriority, (Arg) { .i = ioprio2 });
+      BulkAction_report(&action, "Set I/O priority");
+      BulkAction_done(&action);
    }
    Panel_delete((Object*)ioprioPanel);
    return HTOP_REFRESH | HTOP_REDRAW_BAR | HTOP_UPDATE_PANELHDR;
@@ -201,8 +229,169 @@ static Htop_Reaction Platform_actionLowerAutogroupPriority(State* st) {
    return changed ? HTOP_REFRESH : HTOP_OK;
 }
 
+static Htop_Reaction Platform_actionShowIODevices(ATTR_UNUSED State* st) {
+   IODevicesScreen* ids = IODevicesScreen_new();
+   InfoScreen_run((InfoScreen*)ids);
+   IODevicesScreen_delete((Object*)ids);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
+static Htop_Reaction Platform_actionShowFileLocks(State* st) {
+   FileLocksScreen* fls = FileLocksScreen_new(st->host);
+   InfoScreen_run((InfoScreen*)fls);
+   FileLocksScreen_delete((Object*)fls);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
+static Htop_Reaction Platform_actionShowMemoryMaps(State* st) {
+   const Process* p = (const Process*) Panel_getSelected((Panel*)st->mainPanel);
+   if (!p || p->super.isAggregate)
+      return HTOP_OK;
+
+   MemoryMapsScreen* mms = MemoryMapsScreen_new(p);
+   InfoScreen_run((InfoScreen*)mms);
+   MemoryMapsScreen_delete((Object*)mms);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
+static Htop_Reaction Platform_actionShowWorkingSet(State* st) {
+   const Process* p = (const Process*) Panel_getSelected((Panel*)st->mainPanel);
+   if (!p || p->super.isAggregate)
+      return HTOP_OK;
+
+   WorkingSetScreen* wss = WorkingSetScreen_new(p);
+   InfoScreen_run((InfoScreen*)wss);
+   WorkingSetScreen_delete((Object*)wss);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
+static Htop_Reaction Platform_actionShowSystemdUnits(ATTR_UNUSED State* st) {
+   SystemdUnitsScreen* sus = SystemdUnitsScreen_new();
+   InfoScreen_run((InfoScreen*)sus);
+   SystemdUnitsScreen_delete((Object*)sus);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
+/* Replaces the lsof screen of 'l' */
+static Htop_Reaction Platform_actionShowOpenFiles(State* st) {
+   if (Settings_isReadonly() || st->host->settings->ss->dynamic)
+      return HTOP_OK;
+
+   const Process* p = (const Process*) Panel_getSelected((Panel*)st->mainPanel);
+   if (!p || p->super.isAggregate)
+      return HTOP_OK;
+
+   LinuxOpenFilesScreen* ofs = LinuxOpenFilesScreen_new(p);
+   InfoScreen_run((InfoScreen*)ofs);
+   LinuxOpenFilesScreen_delete((Object*)ofs);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
+static Htop_Reaction Platform_actionShowThreads(State* st) {
+   const Process* p = (const Process*) Panel_getSelected((Panel*)st->mainPanel);
+   if (!p || p->super.isAggregate)
+      return HTOP_OK;
+
+   ThreadsScreen* ts = ThreadsScreen_new(p);
+   InfoScreen_run((InfoScreen*)ts);
+   ThreadsScreen_delete((Object*)ts);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
+static Htop_Reaction Platform_actionShowWaitProfile(State* st) {
+   const Process* p = (const Process*) Panel_getSelected((Panel*)st->mainPanel);
+   if (!p || p->super.isAggregate)
+      return HTOP_OK;
+
+   WaitProfileScreen* wps = WaitProfileScreen_new(p);
+   InfoScreen_run((InfoScreen*)wps);
+   WaitProfileScreen_delete((Object*)wps);
+   clear();
+   CRT_enableDelay();
+   return HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
+static void Platform_addGroupByItem(Panel* panel, const Settings* settings, RowField field) {
+   char* name;
+   if (field >= ROW_DYNAMIC_FIELDS) {
+      const DynamicColumn* column = Hashtable_get(settings->dynamicColumns, field);
+      if (!column)
+         return;
+      name = xStrdup(column->caption ? column->caption : column->name);
+   } else {
+      name = String_trim(Process_fields[field].name);
+   }
+   Panel_add(panel, (Object*) ListItem_new(name, field));
+   if (field == settings->ss->groupBy)
+      Panel_setSelected(panel, Panel_size(panel) - 1);
+   free(name);
+}
+
+/* Picks the field processes are shown grouped by: the columns of the screen come first, then any other one */
+static Htop_Reaction Platform_actionSetGroupBy(State* st) {
+   Machine* host = st->host;
+   Settings* settings = host->settings;
+   ScreenSettings* ss = settings->ss;
+   if (ss->dynamic)
+      return HTOP_OK;
+
+   Panel* groupPanel = Panel_new(0, 0, 0, 0, Class(ListItem), true, FunctionBar_newEnterEsc("Group  ", "Cancel "));
+   Panel_setHeader(groupPanel, "Group by");
+   Panel_add(groupPanel, (Object*) ListItem_new("(none)", 0));
+
+   const RowField* fields = ss->fields;
+   for (int i = 0; fields[i]; i++)
+      Platform_addGroupByItem(groupPanel, settings, fields[i]);
+   for (RowField field = 1; field < LAST_PROCESSFIELD; field++) {
+      if (!Process_fields[field].name || !Process_fields[field].description)
+         continue;
+
+      bool shown = false;
+      for (int i = 0; fields[i] && !shown; i++)
+         shown = fields[i] == field;
+      if (!shown)
+         Platform_addGroupByItem(groupPanel, settings, field);
+   }
+
+   Htop_Reaction reaction = HTOP_OK;
+   const ListItem* item = (const ListItem*) Action_pickFromVector(st, groupPanel, 14, false);
+   if (item && (RowField) item->key != ss->groupBy) {
+      ScreenSettings_setGroupBy(ss, item->key);
+      if (!ss->allBranchesCollapsed)
+         Table_expandTree(host->activeTable);
+      host->activeTable->needsSort = true;
+      reaction |= HTOP_RECALCULATE | HTOP_SAVE_SETTINGS | HTOP_KEEP_FOLLOWING | HTOP_UPDATE_PANELHDR;
+   }
+   Object_delete(groupPanel);
+
+   return reaction | HTOP_REFRESH | HTOP_REDRAW_BAR;
+}
+
 void Platform_setBindings(Htop_Action* keys) {
+   keys['D'] = Platform_actionShowIODevices;
+   keys['E'] = Platform_actionShowWorkingSet;
+   keys['G'] = Platform_actionSetGroupBy;
+   keys['J'] = Platform_actionShowThreads;
+   keys['R'] = Platform_actionShowMemoryMaps;
+   keys['V'] = Platform_actionShowSystemdUnits;
+   keys['W'] = Platform_actionShowWaitProfile;
+   keys['X'] = Platform_actionShowFileLocks;
    keys['i'] = Platform_actionSetIOPriority;
+   keys['l'] = Platform_actionShowOpenFiles;
    keys['{'] = Platform_actionLowerAutogroupPriority;
    keys['}'] = Platform_actionHigherAutogroupPriority;
    keys[KEY_F(19)] = Platform_actionLowerAutogroupPriority;  // Shift-F7
@@ -237,6 +426,11 @@ const MeterClass* const Platform_meterTypes[] = {
    &RightCPUs4Meter_class,
    &LeftCPUs8Meter_class,
    &RightCPUs8Meter_class,
+   &CPUHeatmapMeter_class,
+   &CoreHeatmapMeter_class,
+   &CCDHeatmapMeter_class,
+   &SocketHeatmapMeter_class,
+   &NodeHeatmapMeter_class,
    &BlankMeter_class,
    &PressureStallCPUSomeMeter_class,
    &PressureStallIOSomeMeter_class,
@@ -249,11 +443,14 @@ const MeterClass* const Platform_meterTypes[] = {
    &ZramMeter_class,
    &DiskIOMeter_class,
    &NetworkIOMeter_class,
+   &DiskIODevicesMeter_class,
+   &NetworkIODevicesMeter_class,
    &SELinuxMeter_class,
    &SystemdMeter_class,
    &SystemdUserMeter_class,
    &FileDescriptorMeter_class,
    &GPUMeter_class,
+   &ProfileMeter_class,
    NULL
 };
 
@@ -493,40 +690,53 @@ void Platform_setZfsCompressedArcValues(Meter* this) {
    ZfsCompressedArcMeter_readStats(this, &(lhost->zfs));
 }
 
-char* Platform_getProcessEnv(pid_t pid) {
-   char procname[128];
-   xSnprintf(procname, sizeof(procname), PROCDIR "/%d/environ", pid);
-   FILE* fp = fopen(procname, "r");
-   if (!fp)
+/* Reads a whole file of a process, doubling the buffer as it fills up; the content is followed by two NULs */
+static char* Platform_readProcessFile(pid_t pid, const char* name, size_t* size) {
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/%s", pid, name);
+   int fd = open(path, O_RDONLY | O_CLOEXEC);
+   if (fd < 0)
       return NULL;
 
-   char* env = NULL;
+   size_t capacity = 16384;
+   size_t used = 0;
+   char* data = xMalloc(capacity);
 
-   size_t capacity = 0;
-   size_t size = 0;
-   ssize_t bytes = 0;
+   for (;;) {
+      if (capacity - used < 4096) {
+         capacity *= 2;
+         data = xRealloc(data, capacity);
+      }
 
-   do {
-      size += bytes;
-      capacity += 4096;
-      env = xRealloc(env, capacity);
-   } while (!ferror(fp) && !feof(fp) && (bytes = fread(env + size, 1, capacity - size, fp)) > 0);
+      ssize_t bytes = read(fd, data + used, capacity - used - 2);
+      if (bytes < 0) {
+         if (errno == EINTR)
+            continue;
 
-   fclose(fp);
+         free(data);
+         close(fd);
+         return NULL;
+      }
+      if (bytes == 0)
+         break;
 
-   if (bytes < 0) {
-      free(env);
-      return NULL;
+      used += (size_t)bytes;
    }
+   close(fd);
 
-   size += bytes;
-
-   env = xRealloc(env, size + 2);
+   data[used] = '\0';
+   data[used + 1] = '\0';
+   *size = used;
+   return data;
+}
 
-   env[size] = '\0';
-   env[size + 1] = '\0';
+char* Platform_getProcessEnv(pid_t pid) {
+   size_t size;
+   return Platform_readProcessFile(pid, "environ", &size);
+}
 
-   return env;
+char* Platform_getProcessCmdline(pid_t pid, size_t* size) {
+   return Platform_readProcessFile(pid, "cmdline", size);
 }
 
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
@@ -616,22 +826,96 @@ err:
    return pdata;
 }
 
+bool Platform_pinProcess(const Process* proc, int* pidfd) {
+   *pidfd = -1;
+
+#ifdef PLATFORM_PIDFD
+   /* fails on kernels before 5.3, and for threads but the first one */
+   *pidfd = (int) syscall(SYS_pidfd_open, Process_getPid(proc), 0);
+#endif
+
+   /* checked once pinned: the pidfd then refers to the very process that was listed */
+   if (!LinuxProcess_isSame((const LinuxProcess*) proc)) {
+      if (*pidfd >= 0)
+         close(*pidfd);
+      *pidfd = -1;
+      errno = ESRCH;
+      return false;
+   }
+
+   return true;
+}
+
+bool Platform_signalPinned(const Process* proc, int pidfd, int sgn) {
+#ifdef PLATFORM_PIDFD
+   if (pidfd >= 0)
+      return syscall(SYS_pidfd_send_signal, pidfd, sgn, NULL, 0) == 0;
+#else
+   (void) pidfd;
+#endif
+
+   return kill(Process_getPid(proc), sgn) == 0;
+}
+
+/* System-wide files read by the meters, kept open between updates */
+static IODeviceTable Platform_ioDevices;
+
+static const char* const Platform_pressureNames[] = { "cpu", "io", "irq", "memory" };
+static ProcFile Platform_pressureFiles[ARRAYSIZE(Platform_pressureNames)] = {
+   { .fd = -1 }, { .fd = -1 }, { .fd = -1 }, { .fd = -1 },
+};
+
+static bool Platform_readProcFile(ProcFile* file, const char* path) {
+   if (!file->path)
+      ProcFile_init(file, path);
+   return ProcFile_read(file);
+}
+
+/* Parses "avg10=A avg60=B avg300=C" following the "some" or "full" of a pressure line */
+static bool Platform_parsePressureLine(const char* line, double* ten, double* sixty, double* threehundred) {
+   double* const values[] = { ten, sixty, threehundred };
+   const char* p = line;
+   for (size_t i = 0; i < ARRAYSIZE(values); i++) {
+      p = strchr(p, '=');
+      if (!p)
+         return false;
+      p++;
+      if (!ProcFile_parseDecimal(&p, values[i]))
+         return false;
+   }
+   return true;
+}
+
 void Platform_getPressureStall(const char* file, bool some, double* ten, double* sixty, double* threehundred) {
-   *ten = *sixty = *threehundred = 0;
+   *ten = *sixty = *threehundred = NAN;
+
+   ProcFile* procFile = NULL;
+   for (size_t i = 0; i < ARRAYSIZE(Platform_pressureNames); i++) {
+      if (String_eq(file, Platform_pressureNames[i])) {
+         procFile = &Platform_pressureFiles[i];
+         break;
+      }
+   }
+   assert(procFile);
+
    char procname[128];
    xSnprintf(procname, sizeof(procname), PROCDIR "/pressure/%s", file);
-   FILE* fp = fopen(procname, "r");
-   if (!fp) {
-      *ten = *sixty = *threehundred = NAN;
+   if (!procFile || !Platform_readProcFile(procFile, procname))
+      return;
+
+   const char* kind = some ? "some " : "full ";
+   char* cursor = NULL;
+   for (char* line; (line = ProcFile_nextLine(procFile, &cursor)) != NULL; ) {
+      if (!String_startsWith(line, kind))
+         continue;
+
+      if (!Platform_parsePressureLine(line + strlen(kind), ten, sixty, threehundred))
+         *ten = *sixty = *threehundred = NAN;
       return;
    }
-   int total = fscanf(fp, "some avg10=%32lf avg60=%32lf avg300=%32lf total=%*f ", ten, sixty, threehundred);
-   if (total != EOF && !some) {
-      total = fscanf(fp, "full avg10=%32lf avg60=%32lf avg300=%32lf total=%*f ", ten, sixty, threehundred);
-   }
-   (void) total;
-   assert(total == 3);
-   fclose(fp);
+
+   /* older kernels have no "full" line for cpu */
+   *ten = *sixty = *threehundred = 0;
 }
 
 void Platform_getFileDescriptors(double* used, double* max) {
@@ -652,77 +936,28 @@ void Platform_getFileDescriptors(double* used, double* max) {
    }
 }
 
+const IODeviceTable* Platform_getIODevices(void) {
+   if (!Platform_ioDevices.disks)
+      IODeviceTable_init(&Platform_ioDevices);
+   IODeviceTable_update(&Platform_ioDevices);
+   return &Platform_ioDevices;
+}
+
 bool Platform_getDiskIO(DiskIOData* data) {
-   FILE* fp = fopen(PROCDIR "/diskstats", "r");
-   if (!fp)
+   const IODeviceTable* table = Platform_getIODevices();
+   if (!table->haveDisks)
       return false;
 
-   char lastTopDisk[32] = { '\0' };
-
-   uint64_t read_sum = 0, write_sum = 0, timeSpend_sum = 0;
-   uint64_t numDisks = 0;
-
-   char lineBuffer[256];
-   while (fgets(lineBuffer, sizeof(lineBuffer), fp)) {
-      char diskname[32];
-      unsigned long long int read_tmp, write_tmp, timeSpend_tmp;
-      if (sscanf(lineBuffer, "%*d %*d %31s %*u %*u %llu %*u %*u %*u %llu %*u %*u %llu", diskname, &read_tmp, &write_tmp, &timeSpend_tmp) == 4) {
-         if (String_startsWith(diskname, "dm-"))
-            continue;
-
-         if (String_startsWith(diskname, "zram"))
-            continue;
-
-         /* only count root disks, e.g. do not count IO from sda and sda1 twice */
-         if (lastTopDisk[0] && String_startsWith(diskname, lastTopDisk))
-            continue;
-
-         /* This assumes disks are listed directly before any of their partitions */
-         String_safeStrncpy(lastTopDisk, diskname, sizeof(lastTopDisk));
-
-         read_sum += read_tmp;
-         write_sum += write_tmp;
-         timeSpend_sum += timeSpend_tmp;
-         numDisks++;
-      }
-   }
-   fclose(fp);
-   /* multiply with sector size */
-   data->totalBytesRead = 512 * read_sum;
-   data->totalBytesWritten = 512 * write_sum;
-   data->totalMsTimeSpend = timeSpend_sum;
-   data->numDisks = numDisks;
+   IODeviceTable_sumDisks(table, data);
    return true;
 }
 
 bool Platform_getNetworkIO(NetworkIOData* data) {
-   FILE* fp = fopen(PROCDIR "/net/dev", "r");
-   if (!fp)
+   const IODeviceTable* table = Platform_getIODevices();
+   if (!table->haveInterfaces)
       return false;
 
-   char lineBuffer[512];
-   while (fgets(lineBuffer, sizeof(lineBuffer), fp)) {
-      char interfaceName[32];
-      unsigned long long int bytesReceived, packetsReceived, bytesTransmitted, packetsTransmitted;
-      if (sscanf(lineBuffer, "%31s %llu %llu %*u %*u %*u %*u %*u %*u %llu %llu",
-                             interfaceName,
-                             &bytesReceived,
-                             &packetsReceived,
-                             &bytesTransmitted,
-                             &packetsTransmitted) != 5)
-         continue;
-
-      if (String_eq(interfaceName, "lo:"))
-         continue;
-
-      data->bytesReceived += bytesReceived;
-      data->packetsReceived += packetsReceived;
-      data->bytesTransmitted += bytesTransmitted;
-      data->packetsTransmitted += packetsTransmitted;
-   }
-
-   fclose(fp);
-
+   IODeviceTable_sumInterfaces(table, data);
    return true;
 }
 
@@ -938,14 +1173,6 @@ next:
 }
 
 void Platform_getBattery(double* percent, ACPresence* isOnAC) {
-   time_t now = time(NULL);
-   // update battery reading is slow. Update it each 10 seconds only.
-   if (now < Platform_Battery_cacheTime + 10) {
-      *percent = Platform_Battery_cachePercent;
-      *isOnAC = Platform_Battery_cacheIsOnAC;
-      return;
-   }
-
    if (Platform_Battery_method == BAT_PROC) {
       Platform_Battery_getProcData(percent, isOnAC);
       if (!isNonnegative(*percent))
@@ -962,9 +1189,6 @@ void Platform_getBattery(double* percent, ACPresence* isOnAC) {
    } else {
       *percent = CLAMP(*percent, 0.0, 100.0);
    }
-   Platform_Battery_cachePercent = *percent;
-   Platform_Battery_cacheIsOnAC = *isOnAC;
-   Platform_Battery_cacheTime = now;
 }
 
 void Platform_longOptionsUsage(const char* name)
@@ -1145,7 +1369,128 @@ bool Platform_init(void) {
 }
 
 void Platform_done(void) {
+   IODeviceTable_done(&Platform_ioDevices);
+   for (size_t i = 0; i < ARRAYSIZE(Platform_pressureFiles); i++)
+      ProcFile_done(&Platform_pressureFiles[i]);
+
 #ifdef HAVE_SENSORS_SENSORS_H
    LibSensors_cleanup();
 #endif
 }
+
+/* The cgroups screen is the only dynamic screen; its columns are the only dynamic columns */
+static const char Platform_cgroupScreenName[] = "cgroups";
+static Hashtable* Platform_cgroupColumns;
+static CGroupTable* Platform_cgroupTable;
+
+Hashtable* Platform_dynamicColumns(void) {
+   Hashtable* columns = Hashtable_new(LAST_CGROUP_FIELD, true);
+
+   for (int i = 0; i < LAST_CGROUP_FIELD; i++) {
+      const CGroupFieldData* field = &CGroupEntry_fields[i];
+      DynamicColumn* column = xCalloc(1, sizeof(DynamicColumn));
+      xSnprintf(column->name, sizeof(column->name), "%s:%s", Platform_cgroupScreenName, field->name);
+      column->heading = xStrdup(field->heading);
+      column->caption = xStrdup(field->caption);
+      column->description = xStrdup(field->description);
+      column->width = field->width;
+      column->enabled = true;
+      Hashtable_put(columns, (ht_key_t)CGROUP_FIELD_KEY(i), column);
+   }
+
+   Platform_cgroupColumns = columns;
+   return columns;
+}
+
+static void Platform_dynamicColumnDone(ATTR_UNUSED ht_key_t key, void* value, ATTR_UNUSED void* data) {
+   DynamicColumn_done((DynamicColumn*) value);
+}
+
+void Platform_dynamicColumnsDone(Hashtable* columns) {
+   Hashtable_foreach(columns, Platform_dynamicColumnDone, NULL);
+   if (columns == Platform_cgroupColumns)
+      Platform_cgroupColumns = NULL;
+}
+
+const char* Platform_dynamicColumnName(unsigned int key) {
+   if (key < ROW_DYNAMIC_FIELDS || key >= (unsigned int)CGROUP_FIELD_KEY(LAST_CGROUP_FIELD))
+      return NULL;
+
+   return CGroupEntry_fields[key - ROW_DYNAMIC_FIELDS].caption;
+}
+
+Hashtable* Platform_dynamicScreens(void) {
+   Hashtable* screens = Hashtable_new(1, true);
+
+   DynamicScreen* screen = xCalloc(1, sizeof(DynamicScreen));
+   xSnprintf(screen->name, sizeof(screen->name), "%s", Platform_cgroupScreenName);
+   screen->heading = xStrdup("CGroups");
+   screen->caption = xStrdup("Resource usage of the cgroup v2 hierarchy");
+   screen->direction = -1;
+
+   char* columnKeys = xStrdup("");
+   for (int i = 0; i < LAST_CGROUP_FIELD; i++) {
+      char* prefix = columnKeys;
+      xAsprintf(&columnKeys, "%s%sDynamic(%s:%s)", prefix, i ? " " : "", Platform_cgroupScreenName, CGroupEntry_fields[i].name);
+      free(prefix);
+   }
+   screen->columnKeys = columnKeys;
+
+   Hashtable_put(screens, 0, screen);
+   return screens;
+}
+
+void Platform_defaultDynamicScreens(Settings* settings) {
+   const DynamicScreen* screen = Hashtable_get(settings->dynamicScreens, 0);
+   if (!screen || !Platform_cgroupTable || !CGroupTable_available(Platform_cgroupTable))
+      return;
+
+   /* sorted by CPU usage, in tree view */
+   ScreenSettings* ss = Settings_newDynamicScreen(settings, screen->heading, screen, &Platform_cgroupTable->super);
+   ss->treeView = true;
+   ss->treeSortKey = ss->sortKey;
+   ss->treeDirection = -1;
+}
+
+void Platform_addDynamicScreen(ScreenSettings* ss) {
+   if (Platform_cgroupTable && String_eq(ss->dynamic, Platform_cgroupScreenName))
+      ss->table = &Platform_cgroupTable->super;
+}
+
+void Platform_addDynamicScreenAvailableColumns(Panel* availableColumns, const char* screen) {
+   Vector_prune(availableColumns->items);
+
+   if (!String_eq(screen, Platform_cgroupScreenName))
+      return;
+
+   for (int i = 0; i < LAST_CGROUP_FIELD; i++) {
+      const CGroupFieldData* field = &CGroupEntry_fields[i];
+      char description[256];
+      xSnprintf(description, sizeof(description), "%s - %s", field->caption, field->description);
+      Panel_add(availableColumns, (Object*) ListItem_new(description, CGROUP_FIELD_KEY(i)));
+   }
+}
+
+static void Platform_dynamicScreenDone(ATTR_UNUSED ht_key_t key, void* value, ATTR_UNUSED void* data) {
+   DynamicScreen_done((DynamicScreen*) value);
+}
+
+void Platform_dynamicScreensDone(Hashtable* screens) {
+   Hashtable_foreach(screens, Platform_dynamicScreenDone, NULL);
+   if (Platform_cgroupTable) {
+      Object_delete(Platform_cgroupTable);
+      Platform_cgroupTable = NULL;
+   }
+}
+
+static void Platform_setColumnTable(ATTR_UNUSED ht_key_t key, void* value, void* data) {
+   ((DynamicColumn*) value)->table = data;
+}
+
+void Platform_updateTables(Machine* host) {
+   Platform_cgroupTable = CGroupTable_new(host);
+
+   /* marks the columns as belonging to the screen, not to processes */
+   if (Platform_cgroupColumns)
+      Hashtable_foreach(Platform_cgroupColumns, Platform_setColumnTable, &Platform_cgroupTable->super);
+}
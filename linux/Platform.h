@@ -18,6 +18,7 @@ in the source distribution for its full text.
 #include "BatteryMeter.h"
 #include "DiskIOMeter.h"
 #include "Hashtable.h"
+#include "Machine.h"
 #include "Macros.h"
 #include "Meter.h"
 #include "NetworkIOMeter.h"
@@ -31,6 +32,7 @@ in the source distribution for its full text.
 #include "generic/gettime.h"
 #include "generic/hostname.h"
 #include "generic/uname.h"
+#include "linux/IODeviceTable.h"
 
 
 /* GNU/Hurd does not have PATH_MAX in limits.h */
@@ -78,8 +80,22 @@ void Platform_setZfsCompressedArcValues(Meter* this);
 
 char* Platform_getProcessEnv(pid_t pid);
 
+/* The arguments of a process, each followed by a NUL, or NULL to show the command line of the process table */
+char* Platform_getProcessCmdline(pid_t pid, size_t* size);
+
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid);
 
+/*
+ * Pins a process about to be acted upon, so that a pid reused since the
+ * last update is never hit: sets pidfd to a descriptor of the process, -1
+ * where there is none, and returns false with errno set if the process
+ * listed is gone.
+ */
+bool Platform_pinProcess(const Process* proc, int* pidfd);
+
+/* Sends a signal to a pinned process, through its pidfd if it has one */
+bool Platform_signalPinned(const Process* proc, int pidfd, int sgn);
+
 void Platform_getPressureStall(const char* file, bool some, double* ten, double* sixty, double* threehundred);
 
 void Platform_getFileDescriptors(double* used, double* max);
@@ -88,6 +104,9 @@ bool Platform_getDiskIO(DiskIOData* data);
 
 bool Platform_getNetworkIO(NetworkIOData* data);
 
+/* The per-device statistics, refreshed unless they are more recent than IODEVICE_INTERVAL_MS */
+const IODeviceTable* Platform_getIODevices(void);
+
 void Platform_getBattery(double* percent, ACPresence* isOnAC);
 
 static inline void Platform_getHostname(char* buffer, size_t size) {
@@ -133,30 +152,26 @@ static inline void Platform_dynamicMeterUpdateValues(ATTR_UNUSED Meter* meter) {
 
 static inline void Platform_dynamicMeterDisplay(ATTR_UNUSED const Meter* meter, ATTR_UNUSED RichString* out) { }
 
-static inline Hashtable* Platform_dynamicColumns(void) {
-   return NULL;
-}
+Hashtable* Platform_dynamicColumns(void);
 
-static inline void Platform_dynamicColumnsDone(ATTR_UNUSED Hashtable* table) { }
+void Platform_dynamicColumnsDone(Hashtable* columns);
 
-static inline const char* Platform_dynamicColumnName(ATTR_UNUSED unsigned int key) {
-   return NULL;
-}
+const char* Platform_dynamicColumnName(unsigned int key);
 
 static inline bool Platform_dynamicColumnWriteField(ATTR_UNUSED const Process* proc, ATTR_UNUSED RichString* str, ATTR_UNUSED unsigned int key) {
    return false;
 }
 
-static inline Hashtable* Platform_dynamicScreens(void) {
-   return NULL;
-}
+Hashtable* Platform_dynamicScreens(void);
+
+void Platform_defaultDynamicScreens(Settings* settings);
 
-static inline void Platform_defaultDynamicScreens(ATTR_UNUSED Settings* settings) { }
+void Platform_addDynamicScreen(ScreenSettings* ss);
 
-static inline void Platform_addDynamicScreen(ATTR_UNUSED ScreenSettings* ss) { }
+void Platform_addDynamicScreenAvailableColumns(Panel* availableColumns, const char* screen);
 
-static inline void Platform_addDynamicScreenAvailableColumns(ATTR_UNUSED Panel* availableColumns, ATTR_UNUSED const char* screen) { }
+void Platform_dynamicScreensDone(Hashtable* screens);
 
-static inline void Platform_dynamicScreensDone(ATTR_UNUSED Hashtable* screens) { }
+void Platform_updateTables(Machine* host);
 
 #endif
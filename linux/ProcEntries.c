@@ -0,0 +1,93 @@
+/*
+htop - ProcEntries.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/ProcEntries.h"
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "XUtils.h"
+
+
+void ProcEntries_init(ProcEntries* this) {
+   memset(this, 0, sizeof(ProcEntries));
+   this->byNumber = Hashtable_new(64, false);
+}
+
+void ProcEntries_done(ProcEntries* this, ProcEntries_DeleteFunction deleteEntry) {
+   for (size_t i = 0; i < this->count; i++)
+      deleteEntry(this->sorted[i]);
+   free(this->sorted);
+   Hashtable_delete(this->byNumber);
+}
+
+const char* ProcEntries_next(DIR* dir, int* number) {
+   const struct dirent* entry;
+   while ((entry = readdir(dir)) != NULL) {
+      const char* name = entry->d_name;
+      if (name[0] < '0' || name[0] > '9')
+         continue;
+
+      char* end;
+      long value = strtol(name, &end, 10);
+      if (*end || value > INT_MAX)
+         continue;
+
+      *number = (int)value;
+      return name;
+   }
+   return NULL;
+}
+
+void ProcEntries_begin(ProcEntries* this) {
+   for (size_t i = 0; i < this->count; i++)
+      this->sorted[i]->updated = false;
+
+   /* entries found are collected after the current ones, which go once the removed ones are known */
+   this->previous = this->count;
+   this->found = 0;
+}
+
+bool ProcEntries_found(ProcEntries* this, ProcEntry* entry) {
+   if (entry->updated)
+      return false;
+   entry->updated = true;
+
+   if (this->previous + this->found == this->capacity) {
+      this->capacity = this->capacity ? this->capacity * 2 : 64;
+      this->sorted = xReallocArray(this->sorted, this->capacity, sizeof(ProcEntry*));
+   }
+   this->sorted[this->previous + this->found] = entry;
+   this->found++;
+   return true;
+}
+
+size_t ProcEntries_end(ProcEntries* this, ProcEntries_KeepFunction keep, void* data, ProcEntries_DeleteFunction deleteEntry) {
+   size_t kept = 0;
+   for (size_t i = 0; i < this->previous; i++) {
+      ProcEntry* entry = this->sorted[i];
+      if (entry->updated)
+         continue;
+
+      if (keep && keep(entry, data)) {
+         this->sorted[kept++] = entry;
+         continue;
+      }
+
+      Hashtable_remove(this->byNumber, (ht_key_t)entry->number);
+      deleteEntry(entry);
+   }
+
+   memmove(this->sorted + kept, this->sorted + this->previous, this->found * sizeof(ProcEntry*));
+   this->count = kept + this->found;
+   this->previous = 0;
+   this->found = 0;
+   return kept;
+}
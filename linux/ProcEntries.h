@@ -0,0 +1,71 @@
+#ifndef HEADER_ProcEntries
+#define HEADER_ProcEntries
+/*
+htop - ProcEntries.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <dirent.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "Hashtable.h"
+
+
+/* First member of what stands for an entry of a numbered directory */
+typedef struct ProcEntry_ {
+   int number;                    /* the name of the entry, as a thread id or a descriptor */
+   bool updated;                  /* found by the last read */
+} ProcEntry;
+
+/* Decides whether an entry no longer listed is kept for now; it is deleted otherwise */
+typedef bool(*ProcEntries_KeepFunction)(ProcEntry* entry, void* data);
+typedef void(*ProcEntries_DeleteFunction)(ProcEntry* entry);
+
+/*
+ * Entries of a /proc directory named by numbers, as task or fd, kept from
+ * one read of the directory to the next. A read starts with
+ * ProcEntries_begin(), counts each entry listed with ProcEntries_found(),
+ * and ends with ProcEntries_end(), which drops those no longer listed.
+ */
+typedef struct ProcEntries_ {
+   Hashtable* byNumber;
+   ProcEntry** sorted;            /* entries kept by the last read, then those found */
+   size_t count;
+   size_t capacity;
+   size_t previous;               /* during a read, entries of the last one, before those found */
+   size_t found;
+} ProcEntries;
+
+void ProcEntries_init(ProcEntries* this);
+
+/* Deletes the entries along with the table */
+void ProcEntries_done(ProcEntries* this, ProcEntries_DeleteFunction deleteEntry);
+
+/* Returns the next entry of dir named by a number, which is stored, or NULL after the last one */
+const char* ProcEntries_next(DIR* dir, int* number);
+
+static inline ProcEntry* ProcEntries_get(const ProcEntries* this, int number) {
+   return Hashtable_get(this->byNumber, (ht_key_t)number);
+}
+
+/* Indexes an entry new to the table, before it is found */
+static inline void ProcEntries_add(ProcEntries* this, ProcEntry* entry) {
+   Hashtable_put(this->byNumber, (ht_key_t)entry->number, entry);
+}
+
+void ProcEntries_begin(ProcEntries* this);
+
+/* Counts an entry as listed by the read; returns false if it already was */
+bool ProcEntries_found(ProcEntries* this, ProcEntry* entry);
+
+/*
+ * Ends a read: the entries no longer listed that keep() accepts stay at the
+ * front, in their order, and the others are deleted; those found follow.
+ * Returns the number of entries kept.
+ */
+size_t ProcEntries_end(ProcEntries* this, ProcEntries_KeepFunction keep, void* data, ProcEntries_DeleteFunction deleteEntry);
+
+#endif
@@ -0,0 +1,152 @@
+/*
+htop - ProcFile.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/ProcFile.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "XUtils.h"
+
+
+#define PROCFILE_INITIAL_SIZE 4096
+
+void ProcFile_init(ProcFile* this, const char* path) {
+   *this = (ProcFile) {
+      .path = xStrdup(path),
+      .fd = -1,
+   };
+}
+
+void ProcFile_done(ProcFile* this) {
+   if (this->fd >= 0)
+      close(this->fd);
+   free(this->buffer);
+   free(this->path);
+   *this = (ProcFile) { .fd = -1 };
+}
+
+static bool ProcFile_readOnce(ProcFile* this) {
+   this->len = 0;
+   for (;;) {
+      if (this->len + 1 >= this->size) {
+         this->size = this->size ? this->size * 2 : PROCFILE_INITIAL_SIZE;
+         this->buffer = xRealloc(this->buffer, this->size);
+      }
+
+      ssize_t res = pread(this->fd, this->buffer + this->len, this->size - 1 - this->len, (off_t)this->len);
+      if (res < 0) {
+         if (errno == EINTR)
+            continue;
+         return false;
+      }
+      if (res == 0)
+         break;
+
+      this->len += (size_t)res;
+   }
+
+   this->buffer[this->len] = '\0';
+   return true;
+}
+
+bool ProcFile_read(ProcFile* this) {
+   /* a failing read is retried once with a fresh descriptor */
+   for (int attempt = 0; attempt < 2; attempt++) {
+      if (this->fd < 0) {
+         this->fd = open(this->path, O_RDONLY | O_CLOEXEC);
+         if (this->fd < 0)
+            break;
+      }
+
+      if (ProcFile_readOnce(this))
+         return true;
+
+      close(this->fd);
+      this->fd = -1;
+   }
+
+   this->len = 0;
+   if (this->buffer)
+      this->buffer[0] = '\0';
+   return false;
+}
+
+char* ProcFile_nextLine(ProcFile* this, char** cursor) {
+   if (!this->buffer)
+      return NULL;
+
+   char* end = this->buffer + this->len;
+   char* line = *cursor ? *cursor : this->buffer;
+   if (line >= end)
+      return NULL;
+
+   char* newline = memchr(line, '\n', (size_t)(end - line));
+   if (newline) {
+      *newline = '\0';
+      *cursor = newline + 1;
+   } else {
+      *cursor = end;
+   }
+   return line;
+}
+
+static unsigned int ProcKeys_hash(unsigned int multiplier, const char* key, size_t len) {
+   assert(len > 0);
+   unsigned int h = (unsigned char)key[0] * multiplier + (unsigned char)key[len - 1] * (multiplier >> 4) + (unsigned int)len * 31;
+   return (h >> 3) % PROCKEYS_SLOTS;
+}
+
+void ProcKeys_init(ProcKeys* this, const char* const* keys, unsigned int count) {
+   assert(count < PROCKEYS_SLOTS);
+
+   this->keys = keys;
+   this->count = count;
+
+   /* search a multiplier without collisions among the keys */
+   for (unsigned int multiplier = 1; multiplier < 65536; multiplier++) {
+      memset(this->slots, 0, sizeof(this->slots));
+
+      bool perfect = true;
+      for (unsigned int i = 0; i < count && perfect; i++) {
+         unsigned int slot = ProcKeys_hash(multiplier, keys[i], strlen(keys[i]));
+         if (this->slots[slot])
+            perfect = false;
+         else
+            this->slots[slot] = (uint8_t)(i + 1);
+      }
+
+      if (perfect) {
+         this->multiplier = multiplier;
+         return;
+      }
+   }
+
+   /* the keys are fixed at compile time, so this is a programming error */
+   fail();
+}
+
+int ProcKeys_find(const ProcKeys* this, const char* key, size_t len) {
+   if (!len)
+      return -1;
+
+   unsigned int index = this->slots[ProcKeys_hash(this->multiplier, key, len)];
+   if (!index)
+      return -1;
+
+   const char* candidate = this->keys[index - 1];
+   if (strncmp(candidate, key, len) != 0 || candidate[len] != '\0')
+      return -1;
+
+   return (int)index - 1;
+}
@@ -0,0 +1,101 @@
+#ifndef HEADER_ProcFile
+#define HEADER_ProcFile
+/*
+htop - ProcFile.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+
+/* A system-wide procfs file read again on every update through the same descriptor */
+typedef struct ProcFile_ {
+   char* path;
+   int fd;                 /* -1 while not open */
+   char* buffer;           /* contents of the last read, NUL terminated */
+   size_t size;            /* allocated size of buffer */
+   size_t len;             /* bytes of the last read */
+} ProcFile;
+
+void ProcFile_init(ProcFile* this, const char* path);
+
+void ProcFile_done(ProcFile* this);
+
+/* Reads the whole file from its start; returns false if it cannot be read */
+bool ProcFile_read(ProcFile* this);
+
+/* Returns the next line of the last read, or NULL after the last one; start with *cursor = NULL.
+   Lines are NUL terminated in place. */
+char* ProcFile_nextLine(ProcFile* this, char** cursor);
+
+#define PROCKEYS_SLOTS 64
+
+/*
+ * Perfect hash of the keys of a "Key: value" file: every key gets a slot of
+ * its own, so looking up a line costs one hash and one comparison.
+ */
+typedef struct ProcKeys_ {
+   const char* const* keys;
+   unsigned int count;
+   unsigned int multiplier;
+   uint8_t slots[PROCKEYS_SLOTS];  /* index of the key plus one, 0 if the slot is free */
+} ProcKeys;
+
+void ProcKeys_init(ProcKeys* this, const char* const* keys, unsigned int count);
+
+/* Returns the index of the key of len bytes, or -1 if it is none of the keys */
+int ProcKeys_find(const ProcKeys* this, const char* key, size_t len);
+
+static inline const char* ProcFile_skipBlanks(const char* str) {
+   while (*str == ' ' || *str == '\t')
+      str++;
+   return str;
+}
+
+/* Skips blanks and a non-blank field */
+static inline const char* ProcFile_skipField(const char* str) {
+   str = ProcFile_skipBlanks(str);
+   while (*str && *str != ' ' && *str != '\t' && *str != '\n')
+      str++;
+   return str;
+}
+
+/* Parses an unsigned decimal after blanks, advancing *str; returns false if there is none */
+static inline bool ProcFile_parseULL(const char** str, unsigned long long int* value) {
+   const char* p = ProcFile_skipBlanks(*str);
+   if (*p < '0' || *p > '9')
+      return false;
+
+   unsigned long long int v = 0;
+   for (; *p >= '0' && *p <= '9'; p++)
+      v = v * 10 + (unsigned int)(*p - '0');
+
+   *value = v;
+   *str = p;
+   return true;
+}
+
+/* Parses a non-negative fixed-point number like "12.34" after blanks, advancing *str */
+static inline bool ProcFile_parseDecimal(const char** str, double* value) {
+   unsigned long long int integer;
+   if (!ProcFile_parseULL(str, &integer))
+      return false;
+
+   double v = (double)integer;
+   const char* p = *str;
+   if (*p == '.') {
+      double scale = 0.1;
+      for (p++; *p >= '0' && *p <= '9'; p++, scale /= 10)
+         v += (*p - '0') * scale;
+   }
+
+   *value = v;
+   *str = p;
+   return true;
+}
+
+#endif
@@ -0,0 +1,382 @@
+/*
+htop - ProcessAggregate.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/ProcessAggregate.h"
+
+#include <limits.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+
+#include "CRT.h"
+#include "Hashtable.h"
+#include "Macros.h"
+#include "Meter.h"
+#include "Object.h"
+#include "Process.h"
+#include "RichString.h"
+#include "Row.h"
+#include "Table.h"
+#include "XUtils.h"
+#include "linux/LinuxProcessTable.h"
+
+
+/* The value of a field printed cut short or as a name, NULL for the fields whose printed text is their whole value */
+static const char* ProcessAggregate_value(const LinuxProcess* lp, RowField field, char* buffer, size_t size) {
+   const Process* proc = &lp->super;
+
+   switch (field) {
+   case COMM:
+      /* rather than the merged command, only built for the rows shown */
+      return proc->cmdline ? proc->cmdline : (proc->procComm ? proc->procComm : "");
+   case PROC_COMM:
+      return proc->procComm ? proc->procComm : "";
+   case PROC_EXE:
+      return proc->procExe ? proc->procExe : "";
+   case CWD:
+      return proc->procCwd ? proc->procCwd : "";
+   case USER:
+      /* names may be looked up after the processes were first seen */
+      xSnprintf(buffer, size, "%u", (unsigned int) proc->st_uid);
+      return buffer;
+   case TTY:
+      xSnprintf(buffer, size, "%lu", proc->tty_nr);
+      return buffer;
+   case CGROUP:
+      return lp->cgroup ? lp->cgroup : "";
+   case CCGROUP:
+      return lp->cgroup_short ? lp->cgroup_short : (lp->cgroup ? lp->cgroup : "");
+   case CONTAINER:
+      return lp->container_short ? lp->container_short : "";
+   case SECATTR:
+      return lp->secattr ? lp->secattr : "";
+   #ifdef HAVE_OPENVZ
+   case CTID:
+      return lp->ctid ? lp->ctid : "";
+   #endif
+   default:
+      return NULL;
+   }
+}
+
+/* What the group of a value is called */
+static const char* ProcessAggregate_label(const LinuxProcess* lp, RowField field, const char* value) {
+   const Process* proc = &lp->super;
+
+   switch (field) {
+   case USER:
+      return proc->user ? proc->user : value;
+   case TTY:
+      if (!proc->tty_name)
+         return "(no tty)";
+      return String_startsWith(proc->tty_name, "/dev/") ? proc->tty_name + strlen("/dev/") : proc->tty_name;
+   default:
+      return *value ? value : "N/A";
+   }
+}
+
+const char* ProcessAggregate_keyOf(const LinuxProcess* lp, RowField field, char* buffer, size_t size) {
+   const char* value = ProcessAggregate_value(lp, field, buffer, size);
+   if (value)
+      return value;
+
+   RichString_begin(str);
+   LinuxProcess_class.super.writeField(&lp->super.super, &str, field);
+
+   size_t len = 0;
+   for (int i = 0; i < RichString_size(&str) && len + MB_LEN_MAX < size; i++) {
+#ifdef HAVE_LIBNCURSESW
+      mbstate_t ps;
+      memset(&ps, 0, sizeof(ps));
+      size_t n = wcrtomb(buffer + len, RichString_getCharVal(str, i), &ps);
+      if (n != (size_t)-1)
+         len += n;
+#else
+      buffer[len++] = (char) RichString_getCharVal(str, i);
+#endif
+   }
+   buffer[len] = '\0';
+
+   RichString_delete(&str);
+   return buffer;
+}
+
+static void ProcessAggregate_setName(ProcessAggregate* this, const char* name) {
+   Process_updateCmdline(&this->super.super, name, 0, strlen(name));
+}
+
+static ProcessAggregate* ProcessAggregate_new(const Machine* host, int id, RowField field, const char* key, const LinuxProcess* lp) {
+   ProcessAggregate* this = xCalloc(1, sizeof(ProcessAggregate));
+   Object_setClass(this, Class(ProcessAggregate));
+   Process* super = &this->super.super;
+   Process_init(super, host);
+   Process_setPid(super, id);
+   Process_setThreadGroup(super, id);
+   super->super.isAggregate = true;
+   super->state = UNKNOWN;
+   super->percent_cpu = NAN;
+   this->super.io_rate_read_bps = NAN;
+   this->super.io_rate_write_bps = NAN;
+
+   this->field = field;
+   this->key = xStrdup(key);
+
+   char buffer[PROCESS_AGGREGATE_TEXT_MAX];
+   this->printed = !ProcessAggregate_value(lp, field, buffer, sizeof(buffer));
+   if (this->printed) {
+      /* the text without its padding names the group */
+      char* name = String_trim(key);
+      ProcessAggregate_setName(this, name);
+      free(name);
+   } else {
+      ProcessAggregate_setName(this, ProcessAggregate_label(lp, field, key));
+   }
+   return this;
+}
+
+static ht_key_t ProcessAggregate_hashOf(const void* cast) {
+   const ProcessAggregate* this = cast;
+   return this->hash;
+}
+
+static bool ProcessAggregate_is(const void* cast, const void* other) {
+   return cast == other;
+}
+
+static void ProcessAggregate_delete(Object* cast) {
+   ProcessAggregate* this = (ProcessAggregate*) cast;
+   if (this->index) {
+      ht_key_t key;
+      if (Hashtable_find(this->index, this->hash, ProcessAggregate_is, this, &key))
+         Hashtable_removeFound(this->index, key, ProcessAggregate_hashOf);
+   }
+   free(this->key);
+   Process_delete(cast);
+}
+
+typedef struct ProcessAggregateKey_ {
+   RowField field;
+   const char* key;
+} ProcessAggregateKey;
+
+static bool ProcessAggregate_matches(const void* cast, const void* keyCast) {
+   const ProcessAggregate* this = cast;
+   const ProcessAggregateKey* key = keyCast;
+   return this->field == key->field && String_eq(this->key, key->key);
+}
+
+/* Row identifiers are handed out in turn from the negative ones below -1, skipping those still in use */
+static int ProcessAggregate_nextId(LinuxProcessTable* this) {
+   const Table* table = &this->super.super;
+   do {
+      this->lastAggregateId = this->lastAggregateId < -2 ? this->lastAggregateId + 1 : INT_MIN;
+   } while (Hashtable_get(table->table, (ht_key_t)this->lastAggregateId));
+   return this->lastAggregateId;
+}
+
+ProcessAggregate* ProcessAggregate_get(ProcessTable* pt, RowField field, const char* key, const LinuxProcess* lp) {
+   LinuxProcessTable* this = (LinuxProcessTable*) pt;
+
+   ht_key_t hash = Hashtable_hashBytes(HASHTABLE_HASH_INIT, &field, sizeof(field));
+   hash = Hashtable_hashString(hash, key);
+
+   const ProcessAggregateKey aggregateKey = { .field = field, .key = key };
+   ht_key_t at;
+   ProcessAggregate* aggregate = Hashtable_find(this->aggregates, hash, ProcessAggregate_matches, &aggregateKey, &at);
+   if (aggregate)
+      return aggregate;
+
+   aggregate = ProcessAggregate_new(pt->super.host, ProcessAggregate_nextId(this), field, key, lp);
+   aggregate->hash = hash;
+   aggregate->index = this->aggregates;
+   Hashtable_put(this->aggregates, at, aggregate);
+   ProcessTable_add(pt, &aggregate->super.super);
+   return aggregate;
+}
+
+void ProcessAggregate_add(ProcessAggregate* this, const LinuxProcess* lp) {
+   Process* sum = &this->super.super;
+   const Process* proc = &lp->super;
+
+   if (!sum->super.updated) {
+      sum->super.updated = true;
+      this->members = 0;
+      this->maxPercentCpu = 0.0F;
+      this->maxResident = 0;
+      sum->percent_cpu = 0.0F;
+      sum->percent_mem = 0.0F;
+      sum->m_resident = 0;
+      sum->nlwp = 0;
+      sum->time = 0;
+      sum->starttime_ctime = 0;
+      this->super.io_rate_read_bps = NAN;
+      this->super.io_rate_write_bps = NAN;
+
+      /* the name of a user may have been looked up since */
+      if (this->field == USER && proc->user && !String_eq(sum->cmdline, proc->user))
+         ProcessAggregate_setName(this, proc->user);
+   }
+
+   /* the figures of threads are included in those of their process */
+   if (Process_isUserlandThread(proc))
+      return;
+
+   this->members++;
+   if (!isnan(proc->percent_cpu)) {
+      sum->percent_cpu += proc->percent_cpu;
+      this->maxPercentCpu = MAXIMUM(this->maxPercentCpu, proc->percent_cpu);
+   }
+   sum->percent_mem += proc->percent_mem;
+   sum->m_resident += proc->m_resident;
+   this->maxResident = MAXIMUM(this->maxResident, proc->m_resident);
+   sum->nlwp += proc->nlwp;
+   sum->time += proc->time;
+
+   if (isNonnegative(lp->io_rate_read_bps))
+      this->super.io_rate_read_bps = (isNonnegative(this->super.io_rate_read_bps) ? this->super.io_rate_read_bps : 0.0) + lp->io_rate_read_bps;
+   if (isNonnegative(lp->io_rate_write_bps))
+      this->super.io_rate_write_bps = (isNonnegative(this->super.io_rate_write_bps) ? this->super.io_rate_write_bps : 0.0) + lp->io_rate_write_bps;
+
+   if (proc->starttime_ctime > 0 && (sum->starttime_ctime == 0 || proc->starttime_ctime < sum->starttime_ctime)) {
+      sum->starttime_ctime = proc->starttime_ctime;
+      Process_fillStarttimeBuffer(sum);
+   }
+
+   Process_updateCPUFieldWidths(sum->percent_cpu);
+}
+
+/* The name of the group, with whether it is collapsed, how many processes it has and the largest of them */
+static void ProcessAggregate_writeName(const ProcessAggregate* this, RichString* str) {
+   const Process* super = &this->super.super;
+   char buffer[64];
+
+   xSnprintf(buffer, sizeof(buffer), "%s ", CRT_treeStr[super->super.showChildren ? TREE_STR_SHUT : TREE_STR_OPEN]);
+   RichString_appendWide(str, CRT_colors[PROCESS_TREE], buffer);
+   RichString_appendWide(str, CRT_colors[PROCESS_BASENAME], super->cmdline);
+
+   if (this->members > 1) {
+      char resident[16];
+      Meter_humanUnit(resident, (double) this->maxResident, sizeof(resident));
+      xSnprintf(buffer, sizeof(buffer), " (%u, max %.1f%% %s)", this->members, (double) this->maxPercentCpu, resident);
+   } else {
+      xSnprintf(buffer, sizeof(buffer), " (%u)", this->members);
+   }
+   RichString_appendAscii(str, CRT_colors[PROCESS_SHADOW], buffer);
+}
+
+static void ProcessAggregate_rowWriteField(const Row* super, RichString* str, RowField field) {
+   const ProcessAggregate* this = (const ProcessAggregate*) super;
+   const Row_WriteField writeField = LinuxProcess_class.super.writeField;
+
+   switch (field) {
+   case COMM:
+      ProcessAggregate_writeName(this, str);
+      return;
+   case PERCENT_CPU:
+   case PERCENT_NORM_CPU:
+   case PERCENT_MEM:
+   case M_RESIDENT:
+   case NLWP:
+   case TIME:
+   case STARTTIME:
+   case ELAPSED:
+   case IO_READ_RATE:
+   case IO_WRITE_RATE:
+   case IO_RATE:
+      writeField(super, str, field);
+      return;
+   default:
+      break;
+   }
+
+   if (field == this->field && this->printed) {
+      RichString_appendWide(str, CRT_colors[DEFAULT_COLOR], this->key);
+      return;
+   }
+
+   /* Other columns stay blank, as wide as the process would print them */
+   int width;
+   if (field < LAST_PROCESSFIELD && Process_fields[field].pidColumn) {
+      width = Process_pidDigits + 1;
+   } else {
+      int start = RichString_size(str);
+      writeField(super, str, field);
+      width = RichString_size(str) - start;
+      RichString_rewind(str, width);
+   }
+
+   /* the grouped value, cut to the column like the processes print it */
+   if (field == this->field && width > 0) {
+      Row_printLeftAlignedField(str, CRT_colors[DEFAULT_COLOR], this->super.super.cmdline, (unsigned int) width - 1);
+      return;
+   }
+   RichString_appendChr(str, CRT_colors[DEFAULT_COLOR], ' ', width);
+}
+
+static bool ProcessAggregate_rowIsHighlighted(ATTR_UNUSED const Row* super) {
+   return false;
+}
+
+static bool ProcessAggregate_rowIsVisible(ATTR_UNUSED const Row* super, ATTR_UNUSED const Table* table) {
+   return true;
+}
+
+/*
+ * Shown as long as one of its processes is, or, with no user or pid to
+ * show alone, if its name matches the filter. Its processes are summed
+ * whatever the filter, which only hides some of them.
+ */
+static bool ProcessAggregate_rowMatchesFilter(const Row* super, const Table* table) {
+   for (const Row* member = super->nextInAggregate; member; member = member->nextInAggregate) {
+      if (!Row_matchesFilter(member, table))
+         return false;
+   }
+
+   const Process* this = (const Process*) super;
+   const Machine* host = table->host;
+   if (host->userId != (uid_t) -1)
+      return true;
+
+   const ProcessTable* pt = (const ProcessTable*) table;
+   if (pt->pidMatchList)
+      return true;
+
+   return table->incFilter && !String_contains_i(this->cmdline, table->incFilter, true);
+}
+
+static int ProcessAggregate_compareByKey(const Process* v1, const Process* v2, ProcessField key) {
+   /* groups sorted by the field they are made of follow its printed value */
+   if (v1->super.isAggregate && v2->super.isAggregate) {
+      const ProcessAggregate* a1 = (const ProcessAggregate*) v1;
+      const ProcessAggregate* a2 = (const ProcessAggregate*) v2;
+      if (a1->field == key && a2->field == key && key != COMM)
+         return a1->printed ? strcmp(a1->key, a2->key) : strcmp(v1->cmdline, v2->cmdline);
+   }
+
+   return LinuxProcess_class.compareByKey(v1, v2, key);
+}
+
+const ProcessClass ProcessAggregate_class = {
+   .super = {
+      .super = {
+         .extends = Class(LinuxProcess),
+         .display = Row_display,
+         .delete = ProcessAggregate_delete,
+         .compare = Process_compare
+      },
+      .isHighlighted = ProcessAggregate_rowIsHighlighted,
+      .isVisible = ProcessAggregate_rowIsVisible,
+      .matchesFilter = ProcessAggregate_rowMatchesFilter,
+      .compareByParent = Process_compareByParent,
+      .sortKeyString = Process_rowGetSortKey,
+      .writeField = ProcessAggregate_rowWriteField
+   },
+   .compareByKey = ProcessAggregate_compareByKey
+};
@@ -0,0 +1,63 @@
+#ifndef HEADER_ProcessAggregate
+#define HEADER_ProcessAggregate
+/*
+htop - ProcessAggregate.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "Hashtable.h"
+#include "Machine.h"
+#include "ProcessTable.h"
+#include "RowField.h"
+#include "linux/LinuxProcess.h"
+
+
+#define PROCESS_AGGREGATE_TEXT_MAX 256
+
+/*
+ * Synthetic row of the process table standing for all processes that
+ * have the same value in a field (user, command, cgroup, or any other
+ * column, dynamic ones included), which are shown under it. Its CPU%,
+ * memory, CPU time, I/O rates and thread count are sums and its start
+ * is that of its oldest process; the largest CPU% and resident memory of
+ * a process follow its name. All are accumulated by the scan as it reads
+ * each process. Aggregates have negative identifiers, so they never collide
+ * with processes; they are kept from one update to the next, so a steady
+ * set of groups costs no allocation. They are found by their key through
+ * an index of the process table, which each removes itself from.
+ */
+typedef struct ProcessAggregate_ {
+   LinuxProcess super;
+
+   RowField field;                           /* field the processes are grouped by */
+   unsigned int members;                     /* processes summed up in the last update */
+   float maxPercentCpu;                      /* of a single process in the last update */
+   long maxResident;                         /* in kB */
+   bool printed;                             /* whether the key is the field as printed rather than its value */
+   char* key;                                /* see ProcessAggregate_keyOf; the group is named by the cmdline */
+   ht_key_t hash;                            /* of the field and key, which the aggregate was indexed by */
+   Hashtable* index;                         /* LinuxProcessTable aggregates */
+} ProcessAggregate;
+
+extern const ProcessClass ProcessAggregate_class;
+
+/*
+ * The key of the aggregate of a process: the whole value for fields whose
+ * column may cut it short or names an identifier (the uid for USER, the
+ * command line for Command), the field as printed for the others. The key
+ * points into the process or into buffer.
+ */
+const char* ProcessAggregate_keyOf(const LinuxProcess* lp, RowField field, char* buffer, size_t size);
+
+/* Finds the aggregate of a key, adding it to the table if there is none yet, named after lp */
+ProcessAggregate* ProcessAggregate_get(ProcessTable* pt, RowField field, const char* key, const LinuxProcess* lp);
+
+/* Sums up a process read in this update; the first one restarts the sums */
+void ProcessAggregate_add(ProcessAggregate* this, const LinuxProcess* lp);
+
+#endif
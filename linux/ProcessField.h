@@ -51,6 +51,7 @@ in the source distribution for its full text.
    GPU_TIME = 132,               \
    GPU_PERCENT = 133,            \
    ISCONTAINER = 134,            \
+   M_WSS = 135,                  \
    // End of list
 
 
@@ -92,5 +92,6 @@ const MeterClass SELinuxMeter_class = {
    .name = "SELinux",
    .uiName = "SELinux",
    .description = "SELinux state overview",
-   .caption = "SELinux: "
+   .caption = "SELinux: ",
+   .updateInterval = 10000
 };
@@ -24,6 +24,7 @@ in the source distribution for its full text.
 #include "RichString.h"
 #include "Settings.h"
 #include "XUtils.h"
+#include "linux/SystemdState.h"
 
 #if defined(BUILD_STATIC) && defined(HAVE_LIBSYSTEMD)
 #include <systemd/sd-bus.h>
@@ -58,15 +59,17 @@ typedef struct SystemdMeterContext {
 #if !defined(BUILD_STATIC) || defined(HAVE_LIBSYSTEMD)
    sd_bus* bus;
 #endif /* !BUILD_STATIC || HAVE_LIBSYSTEMD */
+   SystemdState state;
    char* systemState;
    unsigned int nFailedUnits;
    unsigned int nInstalledJobs;
    unsigned int nNames;
    unsigned int nJobs;
+   unsigned int nActiveUnits;
 } SystemdMeterContext_t;
 
 static SystemdMeterContext_t ctx_system;
-static SystemdMeterContext_t ctx_user;
+static SystemdMeterContext_t ctx_user = { .state = { .user = true } };
 
 static void SystemdMeter_done(ATTR_UNUSED Meter* this) {
    SystemdMeterContext_t* ctx = String_eq(Meter_name(this), "SystemdUser") ? &ctx_user : &ctx_system;
@@ -74,6 +77,8 @@ static void SystemdMeter_done(ATTR_UNUSED Meter* this) {
    free(ctx->systemState);
    ctx->systemState = NULL;
 
+   SystemdState_done(&ctx->state);
+
 #ifdef BUILD_STATIC
 # ifdef HAVE_LIBSYSTEMD
    if (ctx->bus) {
@@ -94,6 +99,24 @@ static void SystemdMeter_done(ATTR_UNUSED Meter* this) {
 #endif /* BUILD_STATIC */
 }
 
+/* Reads the state over D-Bus natively, which needs neither libsystemd nor a fork per update */
+static bool updateViaDBus(bool user) {
+   SystemdMeterContext_t* ctx = user ? &ctx_user : &ctx_system;
+   const SystemdState* state = &ctx->state;
+
+   if (!SystemdState_update(&ctx->state))
+      return false;
+
+   if (state->systemState)
+      free_and_xStrdup(&ctx->systemState, state->systemState);
+   ctx->nFailedUnits = state->nFailedUnits;
+   ctx->nInstalledJobs = state->nInstalledJobs;
+   ctx->nNames = state->nNames;
+   ctx->nJobs = state->nJobs;
+   ctx->nActiveUnits = state->unitCounts[SYSTEMD_UNITS_ACTIVE];
+   return true;
+}
+
 #if !defined(BUILD_STATIC) || defined(HAVE_LIBSYSTEMD)
 static int updateViaLib(bool user) {
    SystemdMeterContext_t* ctx = user ? &ctx_user : &ctx_system;
@@ -294,7 +317,10 @@ static void SystemdMeter_updateValues(Meter* this) {
 
    free(ctx->systemState);
    ctx->systemState = NULL;
-   ctx->nFailedUnits = ctx->nInstalledJobs = ctx->nNames = ctx->nJobs = INVALID_VALUE;
+   ctx->nFailedUnits = ctx->nInstalledJobs = ctx->nNames = ctx->nJobs = ctx->nActiveUnits = INVALID_VALUE;
+
+   if (updateViaDBus(user))
+      goto done;
 
 #if !defined(BUILD_STATIC) || defined(HAVE_LIBSYSTEMD)
    if (updateViaLib(user) < 0)
@@ -303,6 +329,7 @@ static void SystemdMeter_updateValues(Meter* this) {
    updateViaExec(user);
 #endif /* !BUILD_STATIC || HAVE_LIBSYSTEMD */
 
+done:
    xSnprintf(this->txtBuffer, sizeof(this->txtBuffer), "%s", ctx->systemState ? ctx->systemState : "???");
 }
 
@@ -364,6 +391,13 @@ static void _SystemdMeter_display(ATTR_UNUSED const Object* cast, RichString* ou
 
    RichString_appendAscii(out, CRT_colors[METER_TEXT], " failed) (");
 
+   /* only known when reading the units over D-Bus */
+   if (ctx->nActiveUnits != INVALID_VALUE) {
+      len = xSnprintf(buffer, sizeof(buffer), "%u", ctx->nActiveUnits);
+      RichString_appendnAscii(out, CRT_colors[METER_VALUE], buffer, len);
+      RichString_appendAscii(out, CRT_colors[METER_TEXT], " active) (");
+   }
+
    if (ctx->nJobs == INVALID_VALUE) {
       buffer[0] = '?';
       buffer[1] = '\0';
@@ -416,6 +450,7 @@ const MeterClass SystemdMeter_class = {
    .uiName = "Systemd state",
    .description = "Systemd system state and unit overview",
    .caption = "Systemd: ",
+   .updateInterval = 5000,
 };
 
 const MeterClass SystemdUserMeter_class = {
@@ -435,4 +470,5 @@ const MeterClass SystemdUserMeter_class = {
    .uiName = "Systemd user state",
    .description = "Systemd user state and unit overview",
    .caption = "Systemd User: ",
+   .updateInterval = 5000,
 };
@@ -0,0 +1,202 @@
+/*
+htop - SystemdState.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/SystemdState.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "XUtils.h"
+
+
+static const char* const busServiceName = "org.freedesktop.systemd1";
+static const char* const busObjectPath = "/org/freedesktop/systemd1";
+static const char* const busInterfaceName = "org.freedesktop.systemd1.Manager";
+
+void SystemdState_init(SystemdState* this, bool user) {
+   *this = (SystemdState) { .user = user };
+}
+
+static void SystemdState_freeUnits(SystemdState* this) {
+   for (size_t i = 0; i < this->nUnits; i++) {
+      SystemdUnit* unit = &this->units[i];
+      free(unit->name);
+      free(unit->description);
+      free(unit->loadState);
+      free(unit->activeState);
+      free(unit->subState);
+   }
+   free(this->units);
+   this->units = NULL;
+   this->nUnits = 0;
+   memset(this->unitCounts, 0, sizeof(this->unitCounts));
+}
+
+static void SystemdState_disconnect(SystemdState* this) {
+   DBus_close(this->bus);
+   this->bus = NULL;
+   this->subscribed = false;
+   this->valid = false;
+}
+
+void SystemdState_done(SystemdState* this) {
+   SystemdState_disconnect(this);
+   SystemdState_freeUnits(this);
+   free(this->systemState);
+   this->systemState = NULL;
+}
+
+static bool SystemdState_connect(SystemdState* this) {
+   this->bus = DBus_openBus(this->user);
+   if (!this->bus)
+      return false;
+
+   /* without signals every update reads the whole state */
+   DBusMessage* reply = DBus_call(this->bus, "org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus", "AddMatch", "type='signal',sender='org.freedesktop.systemd1'");
+   if (reply) {
+      DBusMessage_delete(reply);
+      reply = DBus_call(this->bus, busServiceName, busObjectPath, busInterfaceName, "Subscribe", NULL);
+      this->subscribed = reply != NULL;
+      DBusMessage_delete(reply);
+   }
+
+   return true;
+}
+
+/* One GetAll for the properties of the manager, instead of a call per property */
+static bool SystemdState_readManager(SystemdState* this) {
+   DBusMessage* reply = DBus_call(this->bus, busServiceName, busObjectPath, "org.freedesktop.DBus.Properties", "GetAll", busInterfaceName);
+   if (!reply)
+      return false;
+
+   DBusReader r;
+   DBusReader_init(&r, reply);
+   size_t end;
+   bool ok = String_eq(reply->signature, "a{sv}") && DBusReader_enterArray(&r, '{', &end);
+   while (ok && r.pos < end) {
+      DBusReader_enterStruct(&r);
+      const char* name = DBusReader_string(&r);
+      const char* type = DBusReader_signature(&r);
+      if (!name || !type) {
+         ok = false;
+         break;
+      }
+
+      if (String_eq(name, "SystemState") && String_eq(type, "s")) {
+         const char* value = DBusReader_string(&r);
+         if (value)
+            free_and_xStrdup(&this->systemState, value);
+      } else if (String_eq(name, "NFailedUnits") && String_eq(type, "u")) {
+         this->nFailedUnits = DBusReader_uint32(&r);
+      } else if (String_eq(name, "NInstalledJobs") && String_eq(type, "u")) {
+         this->nInstalledJobs = DBusReader_uint32(&r);
+      } else if (String_eq(name, "NNames") && String_eq(type, "u")) {
+         this->nNames = DBusReader_uint32(&r);
+      } else if (String_eq(name, "NJobs") && String_eq(type, "u")) {
+         this->nJobs = DBusReader_uint32(&r);
+      } else {
+         ok = DBusReader_skip(&r, &type) && !*type;
+      }
+   }
+
+   ok = ok && !r.failed;
+   DBusMessage_delete(reply);
+   return ok;
+}
+
+static SystemdUnitCount SystemdState_classify(const char* activeState) {
+   if (String_eq(activeState, "active"))
+      return SYSTEMD_UNITS_ACTIVE;
+   if (String_eq(activeState, "failed"))
+      return SYSTEMD_UNITS_FAILED;
+   if (String_eq(activeState, "inactive"))
+      return SYSTEMD_UNITS_INACTIVE;
+   return SYSTEMD_UNITS_CHANGING;
+}
+
+static int SystemdState_compareUnits(const void* v1, const void* v2) {
+   const SystemdUnit* unit1 = v1;
+   const SystemdUnit* unit2 = v2;
+   return strcmp(unit1->name, unit2->name);
+}
+
+static bool SystemdState_readUnits(SystemdState* this) {
+   DBusMessage* reply = DBus_call(this->bus, busServiceName, busObjectPath, busInterfaceName, "ListUnits", NULL);
+   if (!reply)
+      return false;
+
+   SystemdState_freeUnits(this);
+
+   DBusReader r;
+   DBusReader_init(&r, reply);
+   size_t end;
+   bool ok = String_eq(reply->signature, "a(ssssssouso)") && DBusReader_enterArray(&r, '(', &end);
+   size_t capacity = 0;
+   while (ok && r.pos < end) {
+      DBusReader_enterStruct(&r);
+      const char* name = DBusReader_string(&r);
+      const char* description = DBusReader_string(&r);
+      const char* loadState = DBusReader_string(&r);
+      const char* activeState = DBusReader_string(&r);
+      const char* subState = DBusReader_string(&r);
+
+      /* followed unit, object path, job id, job type and job path */
+      const char* rest = "souso";
+      ok = DBusReader_skip(&r, &rest) && DBusReader_skip(&r, &rest) && DBusReader_skip(&r, &rest) &&
+           DBusReader_skip(&r, &rest) && DBusReader_skip(&r, &rest);
+      if (!ok || r.failed) {
+         ok = false;
+         break;
+      }
+
+      if (this->nUnits == capacity) {
+         capacity = capacity ? capacity * 2 : 256;
+         this->units = xReallocArray(this->units, capacity, sizeof(SystemdUnit));
+      }
+      this->units[this->nUnits++] = (SystemdUnit) {
+         .name = xStrdup(name),
+         .description = xStrdup(description),
+         .loadState = xStrdup(loadState),
+         .activeState = xStrdup(activeState),
+         .subState = xStrdup(subState),
+      };
+      this->unitCounts[SystemdState_classify(activeState)]++;
+   }
+
+   DBusMessage_delete(reply);
+   if (!ok) {
+      SystemdState_freeUnits(this);
+      return false;
+   }
+
+   if (this->nUnits > 1)
+      qsort(this->units, this->nUnits, sizeof(SystemdUnit), SystemdState_compareUnits);
+   return true;
+}
+
+bool SystemdState_update(SystemdState* this) {
+   if (this->bus && !DBus_poll(this->bus))
+      SystemdState_disconnect(this);
+
+   if (!this->bus && !SystemdState_connect(this))
+      return false;
+
+   if (this->valid && this->subscribed && !this->bus->signalled)
+      return true;
+
+   /* signals arriving from now on are about changes after this read */
+   this->bus->signalled = false;
+   this->valid = SystemdState_readManager(this) && SystemdState_readUnits(this);
+   if (!this->valid) {
+      SystemdState_disconnect(this);
+      return false;
+   }
+
+   return true;
+}
@@ -0,0 +1,61 @@
+#ifndef HEADER_SystemdState
+#define HEADER_SystemdState
+/*
+htop - SystemdState.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "linux/DBus.h"
+
+
+typedef struct SystemdUnit_ {
+   char* name;
+   char* description;
+   char* loadState;
+   char* activeState;
+   char* subState;
+} SystemdUnit;
+
+typedef enum SystemdUnitCount_ {
+   SYSTEMD_UNITS_ACTIVE,
+   SYSTEMD_UNITS_FAILED,
+   SYSTEMD_UNITS_INACTIVE,
+   SYSTEMD_UNITS_CHANGING,        /* activating, deactivating, reloading, ... */
+   SYSTEMD_UNIT_COUNTS
+} SystemdUnitCount;
+
+/*
+ * State of a systemd instance, read over a D-Bus connection kept open
+ * between updates. The manager is subscribed to, so its signals tell
+ * whether anything changed: without one, an update costs no round trip.
+ */
+typedef struct SystemdState_ {
+   bool user;                     /* the instance of the user, not the system one */
+   DBus* bus;
+   bool subscribed;               /* whether signals announce changes */
+   bool valid;                    /* whether the values below were read from the bus */
+
+   char* systemState;
+   unsigned int nFailedUnits;
+   unsigned int nInstalledJobs;
+   unsigned int nNames;
+   unsigned int nJobs;
+
+   SystemdUnit* units;            /* loaded units, by name */
+   size_t nUnits;
+   unsigned int unitCounts[SYSTEMD_UNIT_COUNTS];
+} SystemdState;
+
+void SystemdState_init(SystemdState* this, bool user);
+
+void SystemdState_done(SystemdState* this);
+
+/* Reads the state again if it may have changed; returns false if the bus cannot be reached */
+bool SystemdState_update(SystemdState* this);
+
+#endif
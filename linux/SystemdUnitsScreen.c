@@ -0,0 +1,95 @@
+/*
+htop - SystemdUnitsScreen.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/SystemdUnitsScreen.h"
+
+#include <stdlib.h>
+
+#include "Panel.h"
+#include "ProvideCurses.h"
+#include "Vector.h"
+#include "XUtils.h"
+
+
+SystemdUnitsScreen* SystemdUnitsScreen_new(void) {
+   SystemdUnitsScreen* this = xCalloc(1, sizeof(SystemdUnitsScreen));
+   Object_setClass(this, Class(SystemdUnitsScreen));
+   SystemdState_init(&this->state, false);
+   return (SystemdUnitsScreen*) InfoScreen_init(&this->super, NULL, NULL, LINES - 2, "UNIT                                     LOAD      ACTIVE       SUB          DESCRIPTION");
+}
+
+void SystemdUnitsScreen_delete(Object* cast) {
+   SystemdUnitsScreen* this = (SystemdUnitsScreen*) cast;
+   SystemdState_done(&this->state);
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void SystemdUnitsScreen_draw(InfoScreen* super) {
+   const SystemdUnitsScreen* this = (const SystemdUnitsScreen*) super;
+   const SystemdState* state = &this->state;
+
+   if (!state->valid) {
+      InfoScreen_drawTitled(super, "systemd units");
+      return;
+   }
+
+   InfoScreen_drawTitled(super, "systemd units (%s): %u active, %u failed, %u inactive, %u changing",
+                         state->systemState ? state->systemState : "???",
+                         state->unitCounts[SYSTEMD_UNITS_ACTIVE],
+                         state->unitCounts[SYSTEMD_UNITS_FAILED],
+                         state->unitCounts[SYSTEMD_UNITS_INACTIVE],
+                         state->unitCounts[SYSTEMD_UNITS_CHANGING]);
+}
+
+static void SystemdUnitsScreen_addUnit(InfoScreen* super, const SystemdUnit* unit) {
+   char entry[512];
+   xSnprintf(entry, sizeof(entry), "%-40.40s %-9.9s %-12.12s %-12.12s %s",
+             unit->name, unit->loadState, unit->activeState, unit->subState, unit->description);
+   InfoScreen_addLine(super, entry);
+}
+
+static void SystemdUnitsScreen_scan(InfoScreen* super) {
+   SystemdUnitsScreen* this = (SystemdUnitsScreen*) super;
+   Panel* panel = super->display;
+   int idx = Panel_getSelectedIndex(panel);
+   Panel_prune(panel);
+   Vector_prune(super->lines);
+
+   if (!SystemdState_update(&this->state)) {
+      InfoScreen_addLine(super, "Could not read the units from the systemd manager over D-Bus.");
+      return;
+   }
+
+   /* failed units first, they are what one usually looks for */
+   const SystemdState* state = &this->state;
+   for (size_t i = 0; i < state->nUnits; i++)
+      if (String_eq(state->units[i].activeState, "failed"))
+         SystemdUnitsScreen_addUnit(super, &state->units[i]);
+   for (size_t i = 0; i < state->nUnits; i++)
+      if (!String_eq(state->units[i].activeState, "failed"))
+         SystemdUnitsScreen_addUnit(super, &state->units[i]);
+
+   Panel_setSelected(panel, idx);
+}
+
+/* Refreshes the list whenever no key was pressed within the update delay */
+static void SystemdUnitsScreen_update(InfoScreen* this) {
+   SystemdUnitsScreen_scan(this);
+   InfoScreen_draw(this);
+}
+
+const InfoScreenClass SystemdUnitsScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = SystemdUnitsScreen_delete
+   },
+   .scan = SystemdUnitsScreen_scan,
+   .draw = SystemdUnitsScreen_draw,
+   .onErr = SystemdUnitsScreen_update
+};
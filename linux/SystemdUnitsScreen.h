@@ -0,0 +1,26 @@
+#ifndef HEADER_SystemdUnitsScreen
+#define HEADER_SystemdUnitsScreen
+/*
+htop - SystemdUnitsScreen.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "InfoScreen.h"
+#include "Object.h"
+#include "linux/SystemdState.h"
+
+
+typedef struct SystemdUnitsScreen_ {
+   InfoScreen super;
+   SystemdState state;
+} SystemdUnitsScreen;
+
+extern const InfoScreenClass SystemdUnitsScreen_class;
+
+SystemdUnitsScreen* SystemdUnitsScreen_new(void);
+
+void SystemdUnitsScreen_delete(Object* this);
+
+#endif
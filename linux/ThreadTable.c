@@ -0,0 +1,259 @@
+/*
+htop - ThreadTable.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/ThreadTable.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Macros.h"
+#include "Platform.h"
+#include "XUtils.h"
+#include "linux/ProcFile.h"
+
+
+ThreadTable* ThreadTable_new(pid_t pid, long jiffies) {
+   ThreadTable* this = xCalloc(1, sizeof(ThreadTable));
+   this->pid = pid;
+   this->jiffies = jiffies > 0 ? jiffies : 100;
+   ProcEntries_init(&this->threads);
+   return this;
+}
+
+static void ThreadSample_delete(ProcEntry* cast) {
+   free(cast);
+}
+
+void ThreadTable_delete(ThreadTable* this) {
+   ProcEntries_done(&this->threads, ThreadSample_delete);
+   free(this->groups);
+   free(this);
+}
+
+/* Reads the name, state, times and last CPU from task/<tid>/stat; the name may hold blanks and parentheses */
+static bool ThreadSample_readStat(ThreadSample* this, int taskFd, const char* tid) {
+   char path[32];
+   xSnprintf(path, sizeof(path), "%s/stat", tid);
+
+   char buffer[512];
+   if (xReadfileat(taskFd, path, buffer, sizeof(buffer)) <= 0)
+      return false;
+
+   const char* open = strchr(buffer, '(');
+   const char* close = strrchr(buffer, ')');
+   if (!open || !close || close < open)
+      return false;
+
+   size_t len = MINIMUM((size_t)(close - open - 1), sizeof(this->comm) - 1);
+   memcpy(this->comm, open + 1, len);
+   this->comm[len] = '\0';
+
+   /* (3) state, then (14) utime, (15) stime and (39) processor */
+   const char* p = ProcFile_skipBlanks(close + 1);
+   if (!*p)
+      return false;
+   this->state = *p++;
+
+   for (int field = 4; field < 14; field++)
+      p = ProcFile_skipField(p);
+
+   unsigned long long int utime;
+   unsigned long long int stime;
+   if (!ProcFile_parseULL(&p, &utime) || !ProcFile_parseULL(&p, &stime))
+      return false;
+
+   for (int field = 16; field < 39; field++)
+      p = ProcFile_skipField(p);
+
+   unsigned long long int processor;
+   if (ProcFile_parseULL(&p, &processor))
+      this->processor = (unsigned int)processor;
+
+   this->ticks = utime + stime;
+   return true;
+}
+
+/* A running thread sleeps nowhere, so only the others have their wchan read */
+static void ThreadSample_readWchan(ThreadSample* this, int taskFd, const char* tid) {
+   this->wchan[0] = '\0';
+   if (this->state == 'R')
+      return;
+
+   char path[32];
+   xSnprintf(path, sizeof(path), "%s/wchan", tid);
+   if (xReadfileat(taskFd, path, this->wchan, sizeof(this->wchan)) <= 0 || String_eq(this->wchan, "0"))
+      this->wchan[0] = '\0';
+}
+
+/* task/<tid>/syscall holds "running", "-1 sp pc" outside of a system call, or its number and arguments */
+static void ThreadSample_readSyscall(ThreadSample* this, int taskFd, const char* tid) {
+   if (this->state == 'R') {
+      this->syscall = THREAD_SYSCALL_RUNNING;
+      return;
+   }
+
+   char path[32];
+   xSnprintf(path, sizeof(path), "%s/syscall", tid);
+
+   char buffer[32];
+   this->syscall = THREAD_SYSCALL_UNKNOWN;
+   if (xReadfileat(taskFd, path, buffer, sizeof(buffer)) <= 0)
+      return;
+
+   if (String_startsWith(buffer, "running")) {
+      this->syscall = THREAD_SYSCALL_RUNNING;
+   } else if (String_startsWith(buffer, "-1")) {
+      this->syscall = THREAD_SYSCALL_NONE;
+   } else {
+      const char* p = buffer;
+      unsigned long long int nr;
+      if (ProcFile_parseULL(&p, &nr))
+         this->syscall = (long)nr;
+   }
+}
+
+static int ThreadSample_compare(const void* v1, const void* v2) {
+   const ThreadSample* t1 = (const ThreadSample*) *(const ProcEntry* const*)v1;
+   const ThreadSample* t2 = (const ThreadSample*) *(const ProcEntry* const*)v2;
+
+   int result = compareRealNumbers(t2->percentCpu, t1->percentCpu);
+   if (result)
+      return result;
+
+   result = SPACESHIP_NUMBER(t2->ticks, t1->ticks);
+   return result ? result : SPACESHIP_NUMBER(t1->super.number, t2->super.number);
+}
+
+bool ThreadTable_sample(ThreadTable* this) {
+   char path[64];
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/task", (int)this->pid);
+   int taskFd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   DIR* dir = taskFd >= 0 ? fdopendir(taskFd) : NULL;
+   if (!dir) {
+      this->error = errno;
+      if (taskFd >= 0)
+         close(taskFd);
+      return false;
+   }
+   this->error = 0;
+
+   uint64_t now;
+   Platform_gettime_monotonic(&now);
+   const double interval = this->monotonicMs && now > this->monotonicMs ? (double)(now - this->monotonicMs) / 1000.0 : 0.0;
+
+   ProcEntries_begin(&this->threads);
+
+   const char* name;
+   int tid;
+   while ((name = ProcEntries_next(dir, &tid)) != NULL) {
+      ThreadSample* thread = (ThreadSample*) ProcEntries_get(&this->threads, tid);
+      bool fresh = !thread;
+      if (fresh) {
+         thread = xCalloc(1, sizeof(ThreadSample));
+         thread->super.number = tid;
+      }
+
+      unsigned long long int lastTicks = thread->ticks;
+      if (!ThreadSample_readStat(thread, taskFd, name)) {
+         /* exited since the directory was read */
+         if (fresh)
+            free(thread);
+         continue;
+      }
+      ThreadSample_readWchan(thread, taskFd, name);
+      thread->syscall = THREAD_SYSCALL_UNKNOWN;
+      if (this->readSyscalls)
+         ThreadSample_readSyscall(thread, taskFd, name);
+
+      if (fresh) {
+         ProcEntries_add(&this->threads, &thread->super);
+         thread->percentCpu = NAN;
+      } else if (interval > 0.0) {
+         thread->percentCpu = (double)saturatingSub(thread->ticks, lastTicks) * 100.0 / ((double)this->jiffies * interval);
+      }
+
+      ProcEntries_found(&this->threads, &thread->super);
+   }
+   closedir(dir);
+
+   ProcEntries_end(&this->threads, NULL, NULL, ThreadSample_delete);
+   this->monotonicMs = now;
+
+   qsort(this->threads.sorted, this->threads.count, sizeof(ProcEntry*), ThreadSample_compare);
+   return true;
+}
+
+/* The name of a thread with each run of digits replaced by '*', as "worker-*" for "worker-12" */
+static void ThreadTable_patternOf(const char* comm, char* pattern, size_t size) {
+   size_t len = 0;
+   for (const char* c = comm; *c && len + 1 < size; c++) {
+      if (*c >= '0' && *c <= '9') {
+         if (len == 0 || pattern[len - 1] != '*')
+            pattern[len++] = '*';
+         continue;
+      }
+      pattern[len++] = *c;
+   }
+   pattern[len] = '\0';
+}
+
+static int ThreadGroup_compare(const void* v1, const void* v2) {
+   const ThreadGroup* g1 = (const ThreadGroup*)v1;
+   const ThreadGroup* g2 = (const ThreadGroup*)v2;
+
+   int result = compareRealNumbers(g2->percentCpu, g1->percentCpu);
+   if (result)
+      return result;
+
+   result = SPACESHIP_NUMBER(g2->count, g1->count);
+   return result ? result : strcmp(g1->pattern, g2->pattern);
+}
+
+static bool ThreadGroup_hasPattern(const void* group, const void* pattern) {
+   return String_eq(((const ThreadGroup*)group)->pattern, pattern);
+}
+
+void ThreadTable_group(ThreadTable* this) {
+   /* there are never more groups than threads, so the array is not moved while the index points into it */
+   this->groups = xReallocArray(this->groups, MAXIMUM(ThreadTable_size(this), 1), sizeof(ThreadGroup));
+   this->groupCount = 0;
+
+   Hashtable* index = Hashtable_new(64, false);
+   for (size_t i = 0; i < ThreadTable_size(this); i++) {
+      const ThreadSample* thread = ThreadTable_get(this, i);
+
+      char pattern[sizeof(this->groups[0].pattern)];
+      ThreadTable_patternOf(thread->comm, pattern, sizeof(pattern));
+
+      ht_key_t key;
+      ThreadGroup* group = Hashtable_find(index, Hashtable_hashString(HASHTABLE_HASH_INIT, pattern), ThreadGroup_hasPattern, pattern, &key);
+      if (!group) {
+         group = &this->groups[this->groupCount++];
+         memset(group, 0, sizeof(ThreadGroup));
+         memcpy(group->pattern, pattern, sizeof(pattern));
+         Hashtable_put(index, key, group);
+      }
+
+      group->count++;
+      if (thread->state == 'R')
+         group->running++;
+      group->ticks += thread->ticks;
+      if (!isnan(thread->percentCpu))
+         group->percentCpu += thread->percentCpu;
+   }
+   Hashtable_delete(index);
+
+   qsort(this->groups, this->groupCount, sizeof(ThreadGroup), ThreadGroup_compare);
+}
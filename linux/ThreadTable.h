@@ -0,0 +1,80 @@
+#ifndef HEADER_ThreadTable
+#define HEADER_ThreadTable
+/*
+htop - ThreadTable.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "linux/ProcEntries.h"
+
+
+/* as long as a comm can be, TASK_COMM_LEN */
+#define THREAD_COMM_MAX 16
+
+/* what ThreadSample.syscall holds when the thread is in no system call */
+#define THREAD_SYSCALL_NONE     (-1)   /* blocked outside of one, as in a page fault */
+#define THREAD_SYSCALL_RUNNING  (-2)
+#define THREAD_SYSCALL_UNKNOWN  (-3)   /* not read, or not readable */
+
+typedef struct ThreadSample_ {
+   ProcEntry super;               /* numbered by thread id */
+   char comm[THREAD_COMM_MAX];
+   char state;
+   unsigned int processor;        /* CPU the thread last ran on */
+   unsigned long long int ticks;  /* user and system time, in clock ticks */
+   double percentCpu;             /* over the last sampling interval, NAN after the first sample */
+   char wchan[64];                /* kernel function the thread sleeps in, empty while it runs */
+   long syscall;                  /* system call the thread is in, or one of THREAD_SYSCALL_* */
+} ThreadSample;
+
+/* Threads whose names differ only by numbers, as the workers of a pool */
+typedef struct ThreadGroup_ {
+   char pattern[THREAD_COMM_MAX + 8];  /* the name, with numbers replaced by '*' */
+   unsigned int count;
+   unsigned int running;
+   unsigned long long int ticks;
+   double percentCpu;
+} ThreadGroup;
+
+/*
+ * Threads of one process, sampled from /proc/<pid>/task alone: a sample
+ * costs a read of the stat file of each thread, and of its wchan if it is
+ * not running, whatever the number of processes on the system.
+ */
+typedef struct ThreadTable_ {
+   pid_t pid;
+   long jiffies;                  /* clock ticks per second */
+   bool readSyscalls;             /* whether samples read task/<tid>/syscall too */
+   ProcEntries threads;           /* busiest first */
+   ThreadGroup* groups;           /* busiest first, as of the last ThreadTable_group() */
+   size_t groupCount;
+   uint64_t monotonicMs;          /* time of the last sample, 0 before the first */
+   int error;                     /* errno of the last failed sample, 0 otherwise */
+} ThreadTable;
+
+ThreadTable* ThreadTable_new(pid_t pid, long jiffies);
+
+void ThreadTable_delete(ThreadTable* this);
+
+/* Reads the threads of the process again; returns false if they cannot be listed */
+bool ThreadTable_sample(ThreadTable* this);
+
+/* Sums up the threads of the last sample by the pattern of their names */
+void ThreadTable_group(ThreadTable* this);
+
+static inline size_t ThreadTable_size(const ThreadTable* this) {
+   return this->threads.count;
+}
+
+static inline const ThreadSample* ThreadTable_get(const ThreadTable* this, size_t i) {
+   return (const ThreadSample*) this->threads.sorted[i];
+}
+
+#endif
@@ -0,0 +1,160 @@
+/*
+htop - ThreadsScreen.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/ThreadsScreen.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CRT.h"
+#include "FunctionBar.h"
+#include "Macros.h"
+#include "Panel.h"
+#include "ProvideCurses.h"
+#include "Settings.h"
+#include "Vector.h"
+#include "XUtils.h"
+#include "linux/LinuxMachine.h"
+
+
+static const char* const ThreadsScreenFunctions[] = {"Search ", "Filter ", "Refresh", "Group  ", "Done   ", NULL};
+
+static const char* const ThreadsScreenKeys[] = {"F3", "F4", "F5", "F6", "Esc"};
+
+static const int ThreadsScreenEvents[] = {KEY_F(3), KEY_F(4), KEY_F(5), KEY_F(6), 27};
+
+ThreadsScreen* ThreadsScreen_new(const Process* process) {
+   ThreadsScreen* this = xCalloc(1, sizeof(ThreadsScreen));
+   Object_setClass(this, Class(ThreadsScreen));
+
+   const LinuxMachine* lhost = (const LinuxMachine*) process->super.host;
+   this->threads = ThreadTable_new(Process_getThreadGroup(process), lhost->jiffies);
+
+   /* one process is cheap enough to be sampled four times per update delay */
+   halfdelay(MAXIMUM(1, lhost->super.settings->delay / 4));
+
+   FunctionBar* fuBar = FunctionBar_new(ThreadsScreenFunctions, ThreadsScreenKeys, ThreadsScreenEvents);
+   return (ThreadsScreen*) InfoScreen_init(&this->super, process, fuBar, LINES - 2, " ");
+}
+
+void ThreadsScreen_delete(Object* cast) {
+   ThreadsScreen* this = (ThreadsScreen*) cast;
+   ThreadTable_delete(this->threads);
+   CRT_enableDelay();
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void ThreadsScreen_draw(InfoScreen* super) {
+   const ThreadsScreen* this = (const ThreadsScreen*) super;
+   const ThreadTable* threads = this->threads;
+
+   if (this->grouped) {
+      InfoScreen_drawTitled(super, "Threads of process %d - %s: %zu threads in %zu groups",
+                            (int)threads->pid, Process_getCommand(super->process), ThreadTable_size(threads), threads->groupCount);
+   } else {
+      InfoScreen_drawTitled(super, "Threads of process %d - %s: %zu threads",
+                            (int)threads->pid, Process_getCommand(super->process), ThreadTable_size(threads));
+   }
+}
+
+/* CPU time as the TIME+ column prints it, minutes:seconds.hundredths */
+static void ThreadsScreen_formatTime(char* buffer, size_t size, unsigned long long int ticks, long jiffies) {
+   unsigned long long int hundredths = ticks * 100 / (unsigned long long int)jiffies;
+   xSnprintf(buffer, size, "%llu:%02llu.%02llu", hundredths / 6000, (hundredths / 100) % 60, hundredths % 100);
+}
+
+static void ThreadsScreen_addThread(InfoScreen* super, const ThreadTable* threads, const ThreadSample* thread) {
+   char percent[8] = "  N/A";
+   if (!isnan(thread->percentCpu))
+      xSnprintf(percent, sizeof(percent), "%5.1f", thread->percentCpu);
+
+   char time[24];
+   ThreadsScreen_formatTime(time, sizeof(time), thread->ticks, threads->jiffies);
+
+   char entry[256];
+   xSnprintf(entry, sizeof(entry), "%*d %c %s %3u %10s  %-24.24s %s",
+             Process_pidDigits, (int)thread->super.number, thread->state, percent, thread->processor, time, thread->wchan, thread->comm);
+   InfoScreen_addLine(super, entry);
+}
+
+static void ThreadsScreen_addGroup(InfoScreen* super, const ThreadTable* threads, const ThreadGroup* group) {
+   char time[24];
+   ThreadsScreen_formatTime(time, sizeof(time), group->ticks, threads->jiffies);
+
+   char entry[256];
+   xSnprintf(entry, sizeof(entry), "%7u %7u %6.1f %10s  %s",
+             group->count, group->running, group->percentCpu, time, group->pattern);
+   InfoScreen_addLine(super, entry);
+}
+
+static void ThreadsScreen_scan(InfoScreen* super) {
+   ThreadsScreen* this = (ThreadsScreen*) super;
+   ThreadTable* threads = this->threads;
+   Panel* panel = super->display;
+   int idx = Panel_getSelectedIndex(panel);
+   Panel_prune(panel);
+   Vector_prune(super->lines);
+
+   if (!ThreadTable_sample(threads)) {
+      char message[128];
+      xSnprintf(message, sizeof(message), "Failed listing threads: %s", strerror(threads->error));
+      InfoScreen_addLine(super, message);
+      Panel_setSelected(panel, idx);
+      return;
+   }
+
+   if (this->grouped) {
+      Panel_setHeader(panel, "THREADS RUNNING   CPU%      TIME+  NAME");
+      ThreadTable_group(threads);
+      for (size_t i = 0; i < threads->groupCount; i++)
+         ThreadsScreen_addGroup(super, threads, &threads->groups[i]);
+   } else {
+      char header[128];
+      xSnprintf(header, sizeof(header), "%*s S  CPU%% CPU      TIME+  %-24s %s", Process_pidDigits, "TID", "WCHAN", "NAME");
+      Panel_setHeader(panel, header);
+      for (size_t i = 0; i < ThreadTable_size(threads); i++)
+         ThreadsScreen_addThread(super, threads, ThreadTable_get(threads, i));
+   }
+
+   Panel_setSelected(panel, idx);
+}
+
+/* Samples the threads again whenever no key was pressed within the sampling interval */
+static void ThreadsScreen_update(InfoScreen* super) {
+   ThreadsScreen_scan(super);
+   InfoScreen_draw(super);
+}
+
+static bool ThreadsScreen_onKey(InfoScreen* super, int ch) {
+   ThreadsScreen* this = (ThreadsScreen*) super;
+
+   switch (ch) {
+      case 'g':
+      case KEY_F(6):
+         this->grouped = !this->grouped;
+         FunctionBar_setLabel(super->display->defaultBar, KEY_F(6), this->grouped ? "Threads" : "Group  ");
+         Panel_setSelected(super->display, 0);
+         ThreadsScreen_update(super);
+         return true;
+   }
+
+   return false;
+}
+
+const InfoScreenClass ThreadsScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = ThreadsScreen_delete
+   },
+   .scan = ThreadsScreen_scan,
+   .draw = ThreadsScreen_draw,
+   .onErr = ThreadsScreen_update,
+   .onKey = ThreadsScreen_onKey
+};
@@ -0,0 +1,31 @@
+#ifndef HEADER_ThreadsScreen
+#define HEADER_ThreadsScreen
+/*
+htop - ThreadsScreen.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <sys/types.h>
+
+#include "InfoScreen.h"
+#include "Object.h"
+#include "Process.h"
+#include "linux/ThreadTable.h"
+
+
+typedef struct ThreadsScreen_ {
+   InfoScreen super;
+   ThreadTable* threads;
+   bool grouped;                  /* threads summed up by the pattern of their names */
+} ThreadsScreen;
+
+extern const InfoScreenClass ThreadsScreen_class;
+
+ThreadsScreen* ThreadsScreen_new(const Process* process);
+
+void ThreadsScreen_delete(Object* this);
+
+#endif
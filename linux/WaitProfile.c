@@ -0,0 +1,676 @@
+/*
+htop - WaitProfile.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/WaitProfile.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+
+
+typedef struct WaitProfile_Syscall_ {
+   long number;
+   const char* name;
+} WaitProfile_Syscall;
+
+/*
+ * The system calls a thread is most often found in, numbered as on the
+ * architecture built for. The numbers may start far from zero (x32 sets
+ * a high bit in all of them, MIPS counts from 4000 up), so rather than
+ * index an array they are paired with the names, sorted by number when
+ * first looked up.
+ */
+static WaitProfile_Syscall WaitProfile_syscalls[] = {
+#ifdef SYS_accept
+   { SYS_accept, "accept" },
+#endif
+#ifdef SYS_accept4
+   { SYS_accept4, "accept4" },
+#endif
+#ifdef SYS_access
+   { SYS_access, "access" },
+#endif
+#ifdef SYS_arch_prctl
+   { SYS_arch_prctl, "arch_prctl" },
+#endif
+#ifdef SYS_bind
+   { SYS_bind, "bind" },
+#endif
+#ifdef SYS_brk
+   { SYS_brk, "brk" },
+#endif
+#ifdef SYS_chdir
+   { SYS_chdir, "chdir" },
+#endif
+#ifdef SYS_chmod
+   { SYS_chmod, "chmod" },
+#endif
+#ifdef SYS_chown
+   { SYS_chown, "chown" },
+#endif
+#ifdef SYS_clock_gettime
+   { SYS_clock_gettime, "clock_gettime" },
+#endif
+#ifdef SYS_clock_nanosleep
+   { SYS_clock_nanosleep, "clock_nanosleep" },
+#endif
+#ifdef SYS_clone
+   { SYS_clone, "clone" },
+#endif
+#ifdef SYS_clone3
+   { SYS_clone3, "clone3" },
+#endif
+#ifdef SYS_close
+   { SYS_close, "close" },
+#endif
+#ifdef SYS_close_range
+   { SYS_close_range, "close_range" },
+#endif
+#ifdef SYS_connect
+   { SYS_connect, "connect" },
+#endif
+#ifdef SYS_copy_file_range
+   { SYS_copy_file_range, "copy_file_range" },
+#endif
+#ifdef SYS_creat
+   { SYS_creat, "creat" },
+#endif
+#ifdef SYS_dup
+   { SYS_dup, "dup" },
+#endif
+#ifdef SYS_dup2
+   { SYS_dup2, "dup2" },
+#endif
+#ifdef SYS_dup3
+   { SYS_dup3, "dup3" },
+#endif
+#ifdef SYS_epoll_create
+   { SYS_epoll_create, "epoll_create" },
+#endif
+#ifdef SYS_epoll_create1
+   { SYS_epoll_create1, "epoll_create1" },
+#endif
+#ifdef SYS_epoll_ctl
+   { SYS_epoll_ctl, "epoll_ctl" },
+#endif
+#ifdef SYS_epoll_pwait
+   { SYS_epoll_pwait, "epoll_pwait" },
+#endif
+#ifdef SYS_epoll_pwait2
+   { SYS_epoll_pwait2, "epoll_pwait2" },
+#endif
+#ifdef SYS_epoll_wait
+   { SYS_epoll_wait, "epoll_wait" },
+#endif
+#ifdef SYS_eventfd2
+   { SYS_eventfd2, "eventfd2" },
+#endif
+#ifdef SYS_execve
+   { SYS_execve, "execve" },
+#endif
+#ifdef SYS_execveat
+   { SYS_execveat, "execveat" },
+#endif
+#ifdef SYS_exit
+   { SYS_exit, "exit" },
+#endif
+#ifdef SYS_exit_group
+   { SYS_exit_group, "exit_group" },
+#endif
+#ifdef SYS_faccessat
+   { SYS_faccessat, "faccessat" },
+#endif
+#ifdef SYS_fadvise64
+   { SYS_fadvise64, "fadvise64" },
+#endif
+#ifdef SYS_fallocate
+   { SYS_fallocate, "fallocate" },
+#endif
+#ifdef SYS_fchmod
+   { SYS_fchmod, "fchmod" },
+#endif
+#ifdef SYS_fchown
+   { SYS_fchown, "fchown" },
+#endif
+#ifdef SYS_fcntl
+   { SYS_fcntl, "fcntl" },
+#endif
+#ifdef SYS_fdatasync
+   { SYS_fdatasync, "fdatasync" },
+#endif
+#ifdef SYS_flock
+   { SYS_flock, "flock" },
+#endif
+#ifdef SYS_fork
+   { SYS_fork, "fork" },
+#endif
+#ifdef SYS_fstat
+   { SYS_fstat, "fstat" },
+#endif
+#ifdef SYS_fstatfs
+   { SYS_fstatfs, "fstatfs" },
+#endif
+#ifdef SYS_fsync
+   { SYS_fsync, "fsync" },
+#endif
+#ifdef SYS_ftruncate
+   { SYS_ftruncate, "ftruncate" },
+#endif
+#ifdef SYS_futex
+   { SYS_futex, "futex" },
+#endif
+#ifdef SYS_futex_waitv
+   { SYS_futex_waitv, "futex_waitv" },
+#endif
+#ifdef SYS_getcwd
+   { SYS_getcwd, "getcwd" },
+#endif
+#ifdef SYS_getdents
+   { SYS_getdents, "getdents" },
+#endif
+#ifdef SYS_getdents64
+   { SYS_getdents64, "getdents64" },
+#endif
+#ifdef SYS_getpid
+   { SYS_getpid, "getpid" },
+#endif
+#ifdef SYS_getrandom
+   { SYS_getrandom, "getrandom" },
+#endif
+#ifdef SYS_getsockopt
+   { SYS_getsockopt, "getsockopt" },
+#endif
+#ifdef SYS_gettid
+   { SYS_gettid, "gettid" },
+#endif
+#ifdef SYS_gettimeofday
+   { SYS_gettimeofday, "gettimeofday" },
+#endif
+#ifdef SYS_inotify_add_watch
+   { SYS_inotify_add_watch, "inotify_add_watch" },
+#endif
+#ifdef SYS_inotify_init1
+   { SYS_inotify_init1, "inotify_init1" },
+#endif
+#ifdef SYS_io_getevents
+   { SYS_io_getevents, "io_getevents" },
+#endif
+#ifdef SYS_io_pgetevents
+   { SYS_io_pgetevents, "io_pgetevents" },
+#endif
+#ifdef SYS_io_submit
+   { SYS_io_submit, "io_submit" },
+#endif
+#ifdef SYS_io_uring_enter
+   { SYS_io_uring_enter, "io_uring_enter" },
+#endif
+#ifdef SYS_io_uring_register
+   { SYS_io_uring_register, "io_uring_register" },
+#endif
+#ifdef SYS_io_uring_setup
+   { SYS_io_uring_setup, "io_uring_setup" },
+#endif
+#ifdef SYS_ioctl
+   { SYS_ioctl, "ioctl" },
+#endif
+#ifdef SYS_kill
+   { SYS_kill, "kill" },
+#endif
+#ifdef SYS_lseek
+   { SYS_lseek, "lseek" },
+#endif
+#ifdef SYS_lstat
+   { SYS_lstat, "lstat" },
+#endif
+#ifdef SYS_madvise
+   { SYS_madvise, "madvise" },
+#endif
+#ifdef SYS_memfd_create
+   { SYS_memfd_create, "memfd_create" },
+#endif
+#ifdef SYS_mkdir
+   { SYS_mkdir, "mkdir" },
+#endif
+#ifdef SYS_mkdirat
+   { SYS_mkdirat, "mkdirat" },
+#endif
+#ifdef SYS_mmap
+   { SYS_mmap, "mmap" },
+#endif
+#ifdef SYS_mprotect
+   { SYS_mprotect, "mprotect" },
+#endif
+#ifdef SYS_mremap
+   { SYS_mremap, "mremap" },
+#endif
+#ifdef SYS_msgrcv
+   { SYS_msgrcv, "msgrcv" },
+#endif
+#ifdef SYS_msgsnd
+   { SYS_msgsnd, "msgsnd" },
+#endif
+#ifdef SYS_msync
+   { SYS_msync, "msync" },
+#endif
+#ifdef SYS_munmap
+   { SYS_munmap, "munmap" },
+#endif
+#ifdef SYS_nanosleep
+   { SYS_nanosleep, "nanosleep" },
+#endif
+#ifdef SYS_newfstatat
+   { SYS_newfstatat, "newfstatat" },
+#endif
+#ifdef SYS_open
+   { SYS_open, "open" },
+#endif
+#ifdef SYS_openat
+   { SYS_openat, "openat" },
+#endif
+#ifdef SYS_openat2
+   { SYS_openat2, "openat2" },
+#endif
+#ifdef SYS_pause
+   { SYS_pause, "pause" },
+#endif
+#ifdef SYS_pipe
+   { SYS_pipe, "pipe" },
+#endif
+#ifdef SYS_pipe2
+   { SYS_pipe2, "pipe2" },
+#endif
+#ifdef SYS_poll
+   { SYS_poll, "poll" },
+#endif
+#ifdef SYS_ppoll
+   { SYS_ppoll, "ppoll" },
+#endif
+#ifdef SYS_prctl
+   { SYS_prctl, "prctl" },
+#endif
+#ifdef SYS_pread64
+   { SYS_pread64, "pread64" },
+#endif
+#ifdef SYS_preadv
+   { SYS_preadv, "preadv" },
+#endif
+#ifdef SYS_preadv2
+   { SYS_preadv2, "preadv2" },
+#endif
+#ifdef SYS_pselect6
+   { SYS_pselect6, "pselect6" },
+#endif
+#ifdef SYS_ptrace
+   { SYS_ptrace, "ptrace" },
+#endif
+#ifdef SYS_pwrite64
+   { SYS_pwrite64, "pwrite64" },
+#endif
+#ifdef SYS_pwritev
+   { SYS_pwritev, "pwritev" },
+#endif
+#ifdef SYS_pwritev2
+   { SYS_pwritev2, "pwritev2" },
+#endif
+#ifdef SYS_read
+   { SYS_read, "read" },
+#endif
+#ifdef SYS_readlink
+   { SYS_readlink, "readlink" },
+#endif
+#ifdef SYS_readlinkat
+   { SYS_readlinkat, "readlinkat" },
+#endif
+#ifdef SYS_readv
+   { SYS_readv, "readv" },
+#endif
+#ifdef SYS_recvfrom
+   { SYS_recvfrom, "recvfrom" },
+#endif
+#ifdef SYS_recvmmsg
+   { SYS_recvmmsg, "recvmmsg" },
+#endif
+#ifdef SYS_recvmsg
+   { SYS_recvmsg, "recvmsg" },
+#endif
+#ifdef SYS_rename
+   { SYS_rename, "rename" },
+#endif
+#ifdef SYS_renameat
+   { SYS_renameat, "renameat" },
+#endif
+#ifdef SYS_renameat2
+   { SYS_renameat2, "renameat2" },
+#endif
+#ifdef SYS_restart_syscall
+   { SYS_restart_syscall, "restart_syscall" },
+#endif
+#ifdef SYS_rmdir
+   { SYS_rmdir, "rmdir" },
+#endif
+#ifdef SYS_rt_sigaction
+   { SYS_rt_sigaction, "rt_sigaction" },
+#endif
+#ifdef SYS_rt_sigprocmask
+   { SYS_rt_sigprocmask, "rt_sigprocmask" },
+#endif
+#ifdef SYS_rt_sigreturn
+   { SYS_rt_sigreturn, "rt_sigreturn" },
+#endif
+#ifdef SYS_rt_sigsuspend
+   { SYS_rt_sigsuspend, "rt_sigsuspend" },
+#endif
+#ifdef SYS_rt_sigtimedwait
+   { SYS_rt_sigtimedwait, "rt_sigtimedwait" },
+#endif
+#ifdef SYS_sched_getaffinity
+   { SYS_sched_getaffinity, "sched_getaffinity" },
+#endif
+#ifdef SYS_sched_yield
+   { SYS_sched_yield, "sched_yield" },
+#endif
+#ifdef SYS_select
+   { SYS_select, "select" },
+#endif
+#ifdef SYS_semop
+   { SYS_semop, "semop" },
+#endif
+#ifdef SYS_semtimedop
+   { SYS_semtimedop, "semtimedop" },
+#endif
+#ifdef SYS_sendfile
+   { SYS_sendfile, "sendfile" },
+#endif
+#ifdef SYS_sendmmsg
+   { SYS_sendmmsg, "sendmmsg" },
+#endif
+#ifdef SYS_sendmsg
+   { SYS_sendmsg, "sendmsg" },
+#endif
+#ifdef SYS_sendto
+   { SYS_sendto, "sendto" },
+#endif
+#ifdef SYS_set_robust_list
+   { SYS_set_robust_list, "set_robust_list" },
+#endif
+#ifdef SYS_setsockopt
+   { SYS_setsockopt, "setsockopt" },
+#endif
+#ifdef SYS_shutdown
+   { SYS_shutdown, "shutdown" },
+#endif
+#ifdef SYS_sigaltstack
+   { SYS_sigaltstack, "sigaltstack" },
+#endif
+#ifdef SYS_socket
+   { SYS_socket, "socket" },
+#endif
+#ifdef SYS_socketpair
+   { SYS_socketpair, "socketpair" },
+#endif
+#ifdef SYS_splice
+   { SYS_splice, "splice" },
+#endif
+#ifdef SYS_stat
+   { SYS_stat, "stat" },
+#endif
+#ifdef SYS_statfs
+   { SYS_statfs, "statfs" },
+#endif
+#ifdef SYS_statx
+   { SYS_statx, "statx" },
+#endif
+#ifdef SYS_sync
+   { SYS_sync, "sync" },
+#endif
+#ifdef SYS_sync_file_range
+   { SYS_sync_file_range, "sync_file_range" },
+#endif
+#ifdef SYS_syncfs
+   { SYS_syncfs, "syncfs" },
+#endif
+#ifdef SYS_tee
+   { SYS_tee, "tee" },
+#endif
+#ifdef SYS_tgkill
+   { SYS_tgkill, "tgkill" },
+#endif
+#ifdef SYS_timerfd_create
+   { SYS_timerfd_create, "timerfd_create" },
+#endif
+#ifdef SYS_timerfd_settime
+   { SYS_timerfd_settime, "timerfd_settime" },
+#endif
+#ifdef SYS_truncate
+   { SYS_truncate, "truncate" },
+#endif
+#ifdef SYS_umask
+   { SYS_umask, "umask" },
+#endif
+#ifdef SYS_uname
+   { SYS_uname, "uname" },
+#endif
+#ifdef SYS_unlink
+   { SYS_unlink, "unlink" },
+#endif
+#ifdef SYS_unlinkat
+   { SYS_unlinkat, "unlinkat" },
+#endif
+#ifdef SYS_userfaultfd
+   { SYS_userfaultfd, "userfaultfd" },
+#endif
+#ifdef SYS_vfork
+   { SYS_vfork, "vfork" },
+#endif
+#ifdef SYS_vmsplice
+   { SYS_vmsplice, "vmsplice" },
+#endif
+#ifdef SYS_wait4
+   { SYS_wait4, "wait4" },
+#endif
+#ifdef SYS_waitid
+   { SYS_waitid, "waitid" },
+#endif
+#ifdef SYS_write
+   { SYS_write, "write" },
+#endif
+#ifdef SYS_writev
+   { SYS_writev, "writev" },
+#endif
+};
+
+static int WaitProfile_compareSyscalls(const void* v1, const void* v2) {
+   const WaitProfile_Syscall* s1 = v1;
+   const WaitProfile_Syscall* s2 = v2;
+   return SPACESHIP_NUMBER(s1->number, s2->number);
+}
+
+const char* WaitProfile_syscallName(long syscall) {
+   static bool sorted = false;
+   if (!sorted) {
+      qsort(WaitProfile_syscalls, ARRAYSIZE(WaitProfile_syscalls), sizeof(WaitProfile_Syscall), WaitProfile_compareSyscalls);
+      sorted = true;
+   }
+
+   const WaitProfile_Syscall key = { .number = syscall };
+   const WaitProfile_Syscall* found = bsearch(&key, WaitProfile_syscalls, ARRAYSIZE(WaitProfile_syscalls), sizeof(WaitProfile_Syscall), WaitProfile_compareSyscalls);
+   return found ? found->name : NULL;
+}
+
+WaitProfile* WaitProfile_new(pid_t pid, long jiffies) {
+   WaitProfile* this = xCalloc(1, sizeof(WaitProfile));
+   this->threads = ThreadTable_new(pid, jiffies);
+   this->threads->readSyscalls = true;
+   this->sites = Hashtable_new(64, true);
+   return this;
+}
+
+void WaitProfile_delete(WaitProfile* this) {
+   ThreadTable_delete(this->threads);
+   Hashtable_delete(this->sites);
+   free(this->sorted);
+   free(this);
+}
+
+void WaitProfile_reset(WaitProfile* this) {
+   Hashtable_clear(this->sites);
+   this->siteCount = 0;
+   this->count = 0;
+   this->samples = 0;
+   this->threadSamples = 0;
+}
+
+/* Where a thread is, in the process (tid 0) or on its own */
+typedef struct WaitSiteKey_ {
+   pid_t tid;
+   const ThreadSample* thread;
+} WaitSiteKey;
+
+static bool WaitSite_matches(const void* cast, const void* keyCast) {
+   const WaitSite* this = cast;
+   const WaitSiteKey* key = keyCast;
+   return this->tid == key->tid &&
+          this->state == key->thread->state &&
+          this->syscall == key->thread->syscall &&
+          String_eq(this->wchan, key->thread->wchan);
+}
+
+static ht_key_t WaitSite_hash(pid_t tid, char state, long syscall, const char* wchan) {
+   const uint32_t words[] = { (uint32_t)tid, (uint32_t)(unsigned char)state, (uint32_t)syscall };
+   ht_key_t hash = Hashtable_hashBytes(HASHTABLE_HASH_INIT, words, sizeof(words));
+   return Hashtable_hashString(hash, wchan);
+}
+
+static ht_key_t WaitSite_hashOf(const void* cast) {
+   const WaitSite* this = cast;
+   return WaitSite_hash(this->tid, this->state, this->syscall, this->wchan);
+}
+
+static bool WaitSite_is(const void* cast, const void* other) {
+   return cast == other;
+}
+
+/* Counts a thread at its site, that of the process (tid 0) or its own one */
+static void WaitProfile_count(WaitProfile* this, pid_t tid, const ThreadSample* thread) {
+   ht_key_t hash = WaitSite_hash(tid, thread->state, thread->syscall, thread->wchan);
+
+   const WaitSiteKey siteKey = { .tid = tid, .thread = thread };
+   ht_key_t key;
+   WaitSite* site = Hashtable_find(this->sites, hash, WaitSite_matches, &siteKey, &key);
+   if (!site) {
+      site = xCalloc(1, sizeof(WaitSite));
+      site->tid = tid;
+      site->state = thread->state;
+      site->syscall = thread->syscall;
+      memcpy(site->wchan, thread->wchan, sizeof(site->wchan));
+      Hashtable_put(this->sites, key, site);
+      this->siteCount++;
+   }
+
+   /* a thread keeps the name it had when last seen there */
+   memcpy(site->comm, thread->comm, sizeof(site->comm));
+   site->hits++;
+}
+
+typedef struct WaitProfile_Prune_ {
+   WaitProfile* profile;
+   WaitSite** stale;
+   size_t count;
+} WaitProfile_Prune;
+
+static void WaitProfile_findStale(ATTR_UNUSED ht_key_t key, void* value, void* userdata) {
+   WaitProfile_Prune* prune = userdata;
+   const WaitSite* site = value;
+
+   if (site->tid == 0)
+      return;
+
+   const ProcEntry* thread = ProcEntries_get(&prune->profile->threads->threads, site->tid);
+   if (thread && thread->updated)
+      return;
+
+   if (!prune->stale)
+      prune->stale = xMallocArray(prune->profile->siteCount, sizeof(WaitSite*));
+   prune->stale[prune->count++] = value;
+}
+
+/* Drops the sites of the threads gone since the previous sample, which would otherwise pile up in processes starting threads */
+static void WaitProfile_prune(WaitProfile* this) {
+   WaitProfile_Prune prune = { .profile = this, .stale = NULL, .count = 0 };
+   Hashtable_foreach(this->sites, WaitProfile_findStale, &prune);
+
+   for (size_t i = 0; i < prune.count; i++) {
+      ht_key_t key;
+      if (Hashtable_find(this->sites, WaitSite_hashOf(prune.stale[i]), WaitSite_is, prune.stale[i], &key)) {
+         Hashtable_removeFound(this->sites, key, WaitSite_hashOf);
+         this->siteCount--;
+      }
+   }
+   free(prune.stale);
+}
+
+bool WaitProfile_sample(WaitProfile* this) {
+   ThreadTable* threads = this->threads;
+   if (!ThreadTable_sample(threads))
+      return false;
+
+   this->samples++;
+   this->threadSamples += ThreadTable_size(threads);
+   for (size_t i = 0; i < ThreadTable_size(threads); i++) {
+      const ThreadSample* thread = ThreadTable_get(threads, i);
+      WaitProfile_count(this, 0, thread);
+      WaitProfile_count(this, (pid_t)thread->super.number, thread);
+   }
+   WaitProfile_prune(this);
+   return true;
+}
+
+typedef struct WaitProfile_Collect_ {
+   WaitProfile* profile;
+   bool byThread;
+} WaitProfile_Collect;
+
+static void WaitProfile_collect(ATTR_UNUSED ht_key_t key, void* value, void* userdata) {
+   const WaitProfile_Collect* collect = userdata;
+   WaitProfile* this = collect->profile;
+   WaitSite* site = value;
+
+   if ((site->tid != 0) == collect->byThread)
+      this->sorted[this->count++] = site;
+}
+
+static int WaitSite_compare(const void* v1, const void* v2) {
+   const WaitSite* s1 = *(const WaitSite* const*)v1;
+   const WaitSite* s2 = *(const WaitSite* const*)v2;
+
+   int result = SPACESHIP_NUMBER(s2->hits, s1->hits);
+   if (result)
+      return result;
+
+   result = SPACESHIP_NUMBER(s1->tid, s2->tid);
+   return result ? result : strcmp(s1->wchan, s2->wchan);
+}
+
+void WaitProfile_sort(WaitProfile* this, bool byThread) {
+   if (this->capacity < this->siteCount) {
+      this->capacity = this->siteCount;
+      this->sorted = xReallocArray(this->sorted, this->capacity, sizeof(WaitSite*));
+   }
+
+   this->count = 0;
+   WaitProfile_Collect collect = { .profile = this, .byThread = byThread };
+   Hashtable_foreach(this->sites, WaitProfile_collect, &collect);
+
+   qsort(this->sorted, this->count, sizeof(WaitSite*), WaitSite_compare);
+}
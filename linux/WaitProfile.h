@@ -0,0 +1,60 @@
+#ifndef HEADER_WaitProfile
+#define HEADER_WaitProfile
+/*
+htop - WaitProfile.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+#include "Hashtable.h"
+#include "linux/ThreadTable.h"
+
+
+/* Where threads were found: their state, the system call they were in and the kernel function they slept in */
+typedef struct WaitSite_ {
+   pid_t tid;                     /* 0 for the sites of the whole process */
+   char comm[THREAD_COMM_MAX];
+   char state;
+   long syscall;                  /* as ThreadSample.syscall */
+   char wchan[64];
+   unsigned long long int hits;   /* samples the site was seen in */
+} WaitSite;
+
+/*
+ * Histogram of where the threads of a process are, built from samples of
+ * /proc/<pid>/task/<tid>/{stat,syscall,wchan}. Unlike tracing, sampling
+ * neither stops nor slows the process; it costs some reads per thread and
+ * sample, so its overhead is bounded by the sampling rate.
+ */
+typedef struct WaitProfile_ {
+   ThreadTable* threads;
+   Hashtable* sites;              /* WaitSite, of the process and of each thread, by hash */
+   size_t siteCount;
+   WaitSite** sorted;             /* most seen first, as of the last WaitProfile_sort() */
+   size_t count;
+   size_t capacity;
+   unsigned long long int samples;
+   unsigned long long int threadSamples;   /* threads seen, summed over the samples */
+} WaitProfile;
+
+WaitProfile* WaitProfile_new(pid_t pid, long jiffies);
+
+void WaitProfile_delete(WaitProfile* this);
+
+/* Samples the threads once and counts where each one is, dropping the sites of the threads gone; returns false if they cannot be listed */
+bool WaitProfile_sample(WaitProfile* this);
+
+void WaitProfile_reset(WaitProfile* this);
+
+/* Sorts the sites of the whole process, or those of each thread */
+void WaitProfile_sort(WaitProfile* this, bool byThread);
+
+/* Name of a system call of this architecture, or NULL if it has none here */
+const char* WaitProfile_syscallName(long syscall);
+
+#endif
@@ -0,0 +1,223 @@
+/*
+htop - WaitProfileScreen.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/WaitProfileScreen.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "CRT.h"
+#include "FunctionBar.h"
+#include "Macros.h"
+#include "Panel.h"
+#include "Platform.h"
+#include "ProvideCurses.h"
+#include "Settings.h"
+#include "Vector.h"
+#include "XUtils.h"
+#include "linux/LinuxMachine.h"
+
+
+static const char* const WaitProfileScreenFunctions[] = {"Search ", "Filter ", "Refresh", "Threads", "Reset  ", "Done   ", NULL};
+
+static const char* const WaitProfileScreenKeys[] = {"F3", "F4", "F5", "F6", "F8", "Esc"};
+
+static const int WaitProfileScreenEvents[] = {KEY_F(3), KEY_F(4), KEY_F(5), KEY_F(6), KEY_F(8), 27};
+
+/* Sampling intervals chosen among with - and + */
+static const int WaitProfileScreen_intervalsMs[] = { 10, 20, 50, 100, 200, 500, 1000 };
+
+#define WAITPROFILESCREEN_DEFAULT_RATE 2
+
+/* Share of the samples drawn as a bar of this many characters */
+#define WAITPROFILESCREEN_BAR 10
+
+static void WaitProfileScreen_setTimeout(const WaitProfileScreen* this) {
+   /* halfdelay() counts in tenths of a second, too coarse for sampling */
+   nocbreak();
+   cbreak();
+   timeout(WaitProfileScreen_intervalsMs[this->rate]);
+}
+
+WaitProfileScreen* WaitProfileScreen_new(const Process* process) {
+   WaitProfileScreen* this = xCalloc(1, sizeof(WaitProfileScreen));
+   Object_setClass(this, Class(WaitProfileScreen));
+
+   const LinuxMachine* lhost = (const LinuxMachine*) process->super.host;
+   this->profile = WaitProfile_new(Process_getThreadGroup(process), lhost->jiffies);
+   this->rate = WAITPROFILESCREEN_DEFAULT_RATE;
+   WaitProfileScreen_setTimeout(this);
+
+   FunctionBar* fuBar = FunctionBar_new(WaitProfileScreenFunctions, WaitProfileScreenKeys, WaitProfileScreenEvents);
+   return (WaitProfileScreen*) InfoScreen_init(&this->super, process, fuBar, LINES - 2, " ");
+}
+
+void WaitProfileScreen_delete(Object* cast) {
+   WaitProfileScreen* this = (WaitProfileScreen*) cast;
+   WaitProfile_delete(this->profile);
+   CRT_enableDelay();
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void WaitProfileScreen_draw(InfoScreen* super) {
+   const WaitProfileScreen* this = (const WaitProfileScreen*) super;
+   const WaitProfile* profile = this->profile;
+
+   InfoScreen_drawTitled(super, "Where the threads of process %d - %s are: %llu samples, one every %dms (- and + to change)",
+                         (int)profile->threads->pid, Process_getCommand(super->process), profile->samples,
+                         WaitProfileScreen_intervalsMs[this->rate]);
+}
+
+static void WaitProfileScreen_describeSyscall(long syscall, char* buffer, size_t size) {
+   switch (syscall) {
+   case THREAD_SYSCALL_NONE:
+      xSnprintf(buffer, size, "(none)");
+      return;
+   case THREAD_SYSCALL_RUNNING:
+      xSnprintf(buffer, size, "(running)");
+      return;
+   case THREAD_SYSCALL_UNKNOWN:
+      xSnprintf(buffer, size, "?");
+      return;
+   }
+
+   const char* name = WaitProfile_syscallName(syscall);
+   if (name)
+      xSnprintf(buffer, size, "%s", name);
+   else
+      xSnprintf(buffer, size, "syscall %ld", syscall);
+}
+
+static void WaitProfileScreen_addSite(InfoScreen* super, const WaitSite* site, unsigned long long int total) {
+   double share = total ? (double)site->hits * 100.0 / (double)total : 0.0;
+
+   char bar[WAITPROFILESCREEN_BAR + 1];
+   int filled = (int)(share * WAITPROFILESCREEN_BAR / 100.0 + 0.5);
+   filled = CLAMP(filled, 0, WAITPROFILESCREEN_BAR);
+   memset(bar, '|', (size_t)filled);
+   memset(bar + filled, ' ', (size_t)(WAITPROFILESCREEN_BAR - filled));
+   bar[WAITPROFILESCREEN_BAR] = '\0';
+
+   char syscall[32];
+   WaitProfileScreen_describeSyscall(site->syscall, syscall, sizeof(syscall));
+
+   char entry[256];
+   if (site->tid) {
+      xSnprintf(entry, sizeof(entry), "%5.1f%% %s %9llu %c %-20.20s %-26.26s %*d %s",
+                share, bar, site->hits, site->state, syscall, site->wchan[0] ? site->wchan : "-",
+                Process_pidDigits, (int)site->tid, site->comm);
+   } else {
+      xSnprintf(entry, sizeof(entry), "%5.1f%% %s %9llu %c %-20.20s %s",
+                share, bar, site->hits, site->state, syscall, site->wchan[0] ? site->wchan : "-");
+   }
+   InfoScreen_addLine(super, entry);
+}
+
+/* Lists the sites; those of the process share the threads seen, those of a thread the samples taken */
+static void WaitProfileScreen_show(WaitProfileScreen* this) {
+   InfoScreen* super = &this->super;
+   WaitProfile* profile = this->profile;
+   Panel* panel = super->display;
+   int idx = Panel_getSelectedIndex(panel);
+   Panel_prune(panel);
+   Vector_prune(super->lines);
+
+   Platform_gettime_monotonic(&this->shownMs);
+
+   if (profile->threads->error) {
+      char message[128];
+      xSnprintf(message, sizeof(message), "Failed sampling threads: %s", strerror(profile->threads->error));
+      InfoScreen_addLine(super, message);
+      Panel_setSelected(panel, idx);
+      return;
+   }
+
+   char header[160];
+   if (this->byThread) {
+      xSnprintf(header, sizeof(header), " SHARE %-*s   SAMPLES S %-20s %-26s %*s %s",
+                WAITPROFILESCREEN_BAR, "", "SYSCALL", "WCHAN", Process_pidDigits, "TID", "NAME");
+   } else {
+      xSnprintf(header, sizeof(header), " SHARE %-*s   SAMPLES S %-20s %s",
+                WAITPROFILESCREEN_BAR, "", "SYSCALL", "WCHAN");
+   }
+   Panel_setHeader(panel, header);
+
+   WaitProfile_sort(profile, this->byThread);
+   for (size_t i = 0; i < profile->count; i++)
+      WaitProfileScreen_addSite(super, profile->sorted[i], this->byThread ? profile->samples : profile->threadSamples);
+
+   Panel_setSelected(panel, idx);
+}
+
+static void WaitProfileScreen_scan(InfoScreen* super) {
+   WaitProfileScreen* this = (WaitProfileScreen*) super;
+   WaitProfile_sample(this->profile);
+   WaitProfileScreen_show(this);
+}
+
+/* Samples whenever no key was pressed within the interval, and shows the counts once per update delay */
+static void WaitProfileScreen_update(InfoScreen* super) {
+   WaitProfileScreen* this = (WaitProfileScreen*) super;
+   const Settings* settings = super->process->super.host->settings;
+
+   WaitProfile_sample(this->profile);
+
+   uint64_t now;
+   Platform_gettime_monotonic(&now);
+   if (now - this->shownMs < 100 * (uint64_t)settings->delay)
+      return;
+
+   WaitProfileScreen_show(this);
+   InfoScreen_draw(super);
+}
+
+static bool WaitProfileScreen_onKey(InfoScreen* super, int ch) {
+   WaitProfileScreen* this = (WaitProfileScreen*) super;
+
+   switch (ch) {
+      case 't':
+      case KEY_F(6):
+         this->byThread = !this->byThread;
+         FunctionBar_setLabel(super->display->defaultBar, KEY_F(6), this->byThread ? "Process" : "Threads");
+         Panel_setSelected(super->display, 0);
+         break;
+      case 'r':
+      case KEY_F(8):
+         WaitProfile_reset(this->profile);
+         break;
+      case '-':
+         if (this->rate + 1 < ARRAYSIZE(WaitProfileScreen_intervalsMs))
+            this->rate++;
+         WaitProfileScreen_setTimeout(this);
+         break;
+      case '+':
+      case '=':
+         if (this->rate > 0)
+            this->rate--;
+         WaitProfileScreen_setTimeout(this);
+         break;
+      default:
+         return false;
+   }
+
+   WaitProfileScreen_show(this);
+   InfoScreen_draw(super);
+   return true;
+}
+
+const InfoScreenClass WaitProfileScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = WaitProfileScreen_delete
+   },
+   .scan = WaitProfileScreen_scan,
+   .draw = WaitProfileScreen_draw,
+   .onErr = WaitProfileScreen_update,
+   .onKey = WaitProfileScreen_onKey
+};
@@ -0,0 +1,33 @@
+#ifndef HEADER_WaitProfileScreen
+#define HEADER_WaitProfileScreen
+/*
+htop - WaitProfileScreen.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "InfoScreen.h"
+#include "Object.h"
+#include "Process.h"
+#include "linux/WaitProfile.h"
+
+
+typedef struct WaitProfileScreen_ {
+   InfoScreen super;
+   WaitProfile* profile;
+   bool byThread;                 /* sites of each thread rather than of the process */
+   unsigned int rate;             /* index of the sampling interval */
+   uint64_t shownMs;              /* when the list was last built */
+} WaitProfileScreen;
+
+extern const InfoScreenClass WaitProfileScreen_class;
+
+WaitProfileScreen* WaitProfileScreen_new(const Process* process);
+
+void WaitProfileScreen_delete(Object* this);
+
+#endif
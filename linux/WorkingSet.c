@@ -0,0 +1,360 @@
+/*
+htop - WorkingSet.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/WorkingSet.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "Macros.h"
+#include "XUtils.h"
+#include "linux/LinuxMachine.h"
+
+
+/* System calls a refresh may spend on all estimates together */
+#define WORKINGSET_BUDGET 4096
+
+/* Entries of /proc/<pid>/pagemap read at once */
+#define WORKINGSET_CHUNK 512
+
+/* Largest address space sampled, in pages; reading the pagemap of a larger one would take too many refreshes */
+#define WORKINGSET_MAX_PAGES (UINT64_C(1) << 26)
+
+/* Refreshes an estimate is kept for without being scheduled, so that scrolling back does not start it over */
+#define WORKINGSET_KEEP 16
+
+#define PAGEMAP_PRESENT (UINT64_C(1) << 63)
+#define PAGEMAP_PFN_MASK ((UINT64_C(1) << 55) - 1)
+
+WorkingSetTable* WorkingSetTable_new(long pageSizeKB) {
+   WorkingSetTable* this = xCalloc(1, sizeof(WorkingSetTable));
+   this->sets = Hashtable_new(64, false);
+   this->pageSizeKB = pageSizeKB > 0 ? pageSizeKB : 4;
+
+   /* only root may read it, and only kernels built with CONFIG_IDLE_PAGE_TRACKING have it */
+   this->bitmapFd = open(WORKINGSET_BITMAP, O_RDWR | O_CLOEXEC);
+   if (this->bitmapFd < 0)
+      this->error = errno;
+   return this;
+}
+
+static void WorkingSet_reset(WorkingSet* this) {
+   if (this->pagemapFd >= 0)
+      close(this->pagemapFd);
+   this->pagemapFd = -1;
+   free(this->ranges);
+   this->ranges = NULL;
+   this->rangeCount = 0;
+   this->pageCount = 0;
+   this->phase = WORKINGSET_MARKING;
+}
+
+static void WorkingSet_delete(WorkingSet* this) {
+   WorkingSet_reset(this);
+   free(this->pages);
+   free(this);
+}
+
+static void WorkingSetTable_deleteSet(ATTR_UNUSED ht_key_t key, void* value, ATTR_UNUSED void* userData) {
+   WorkingSet_delete(value);
+}
+
+void WorkingSetTable_delete(WorkingSetTable* this) {
+   Hashtable_foreach(this->sets, WorkingSetTable_deleteSet, NULL);
+   Hashtable_delete(this->sets);
+   if (this->bitmapFd >= 0)
+      close(this->bitmapFd);
+   free(this);
+}
+
+void WorkingSetTable_begin(WorkingSetTable* this) {
+   this->cycle++;
+   this->budget = WORKINGSET_BUDGET;
+}
+
+/* Lists the mappings that can hold pages and starts a round over them */
+static bool WorkingSet_start(WorkingSet* this, int percent) {
+   char path[64];
+   if (this->pagemapFd < 0) {
+      xSnprintf(path, sizeof(path), PROCDIR "/%d/pagemap", (int)this->pid);
+      this->pagemapFd = open(path, O_RDONLY | O_CLOEXEC);
+      if (this->pagemapFd < 0) {
+         this->error = errno;
+         return false;
+      }
+   }
+
+   xSnprintf(path, sizeof(path), PROCDIR "/%d/maps", (int)this->pid);
+   FILE* fp = fopen(path, "r");
+   if (!fp) {
+      this->error = errno;
+      return false;
+   }
+
+   size_t capacity = 0;
+   uint64_t pages = 0;
+   const uint64_t pageSize = (uint64_t)sysconf(_SC_PAGESIZE);
+   char buffer[1024];
+   bool atStart = true;
+   while (fgets(buffer, sizeof(buffer), fp)) {
+      /* the rest of a line longer than the buffer is skipped */
+      bool lineStart = atStart;
+      atStart = strchr(buffer, '\n') != NULL;
+      if (!lineStart)
+         continue;
+
+      /* "start-end perms offset dev inode path" */
+      char* end;
+      uint64_t start = strtoull(buffer, &end, 16);
+      if (*end != '-')
+         continue;
+      uint64_t stop = strtoull(end + 1, &end, 16);
+      if (*end != ' ' || String_startsWith(end + 1, "---") || strstr(end, "[vsyscall]"))
+         continue;
+
+      if (this->rangeCount == capacity) {
+         capacity = capacity ? capacity * 2 : 64;
+         this->ranges = xReallocArray(this->ranges, capacity, sizeof(WorkingSetRange));
+      }
+      WorkingSetRange* range = &this->ranges[this->rangeCount++];
+      range->first = start / pageSize;
+      range->end = stop / pageSize;
+      pages += range->end - range->first;
+   }
+   fclose(fp);
+
+   if (pages > WORKINGSET_MAX_PAGES) {
+      this->error = EFBIG;
+      return false;
+   }
+
+   this->stride = (unsigned int) (100 / CLAMP(percent, 1, 100));
+   this->range = 0;
+   this->vpn = this->rangeCount ? this->ranges[0].first : 0;
+   this->pageCount = 0;
+   return true;
+}
+
+static bool WorkingSetTable_readWord(const WorkingSetTable* this, uint64_t pfn, uint64_t* word) {
+   return pread(this->bitmapFd, word, sizeof(*word), (off_t)(pfn / 64 * sizeof(*word))) == (ssize_t)sizeof(*word);
+}
+
+/* Samples the resident pages of the next chunks and marks them idle; returns true once all ranges are done */
+static bool WorkingSet_mark(WorkingSet* this, WorkingSetTable* table) {
+   uint64_t entries[WORKINGSET_CHUNK];
+
+   while (this->range < this->rangeCount) {
+      const WorkingSetRange* range = &this->ranges[this->range];
+      if (this->vpn >= range->end) {
+         this->range++;
+         if (this->range < this->rangeCount)
+            this->vpn = this->ranges[this->range].first;
+         continue;
+      }
+
+      if (!table->budget)
+         return false;
+      table->budget--;
+
+      size_t count = (size_t) MINIMUM(range->end - this->vpn, (uint64_t)WORKINGSET_CHUNK);
+      ssize_t n = pread(this->pagemapFd, entries, count * sizeof(uint64_t), (off_t)(this->vpn * sizeof(uint64_t)));
+      if (n <= 0) {
+         /* unmapped since the maps were read, or the process is gone */
+         this->vpn = range->end;
+         continue;
+      }
+      count = (size_t)n / sizeof(uint64_t);
+
+      for (size_t i = 0; i < count; i++) {
+         uint64_t vpn = this->vpn + i;
+         if (vpn % this->stride || !(entries[i] & PAGEMAP_PRESENT))
+            continue;
+
+         uint64_t pfn = entries[i] & PAGEMAP_PFN_MASK;
+         if (!pfn) {
+            /* page frames are hidden from those lacking CAP_SYS_ADMIN */
+            this->error = EPERM;
+            return false;
+         }
+
+         /* the chunk is finished even if that overdraws the budget by a few writes */
+         uint64_t word = UINT64_C(1) << (pfn % 64);
+         if (table->budget)
+            table->budget--;
+         if (pwrite(table->bitmapFd, &word, sizeof(word), (off_t)(pfn / 64 * sizeof(word))) != (ssize_t)sizeof(word))
+            continue;
+
+         if (this->pageCount == this->pageCapacity) {
+            this->pageCapacity = this->pageCapacity ? this->pageCapacity * 2 : 256;
+            this->pages = xReallocArray(this->pages, this->pageCapacity, sizeof(WorkingSetPage));
+         }
+         this->pages[this->pageCount].vpn = vpn;
+         this->pages[this->pageCount].pfn = pfn;
+         this->pages[this->pageCount].markedCycle = table->cycle;
+         this->pageCount++;
+      }
+      this->vpn += count;
+   }
+
+   return true;
+}
+
+static int WorkingSet_comparePfns(const void* v1, const void* v2) {
+   uint64_t pfn1 = *(const uint64_t*)v1;
+   uint64_t pfn2 = *(const uint64_t*)v2;
+   return SPACESHIP_NUMBER(pfn1, pfn2);
+}
+
+/*
+ * Counts the pages sampled that were used since marked, those of a chunk
+ * of the pagemap at a time, and only once their window has passed;
+ * returns true once all are checked.
+ */
+static bool WorkingSet_check(WorkingSet* this, WorkingSetTable* table, unsigned int window) {
+   uint64_t entries[WORKINGSET_CHUNK];
+   uint64_t pfns[WORKINGSET_CHUNK];
+
+   while (this->cursor < this->pageCount) {
+      const WorkingSetPage* first = &this->pages[this->cursor];
+      if (table->cycle - first->markedCycle < window || !table->budget)
+         return false;
+      table->budget--;
+
+      size_t end = this->cursor + 1;
+      while (end < this->pageCount && this->pages[end].vpn - first->vpn < WORKINGSET_CHUNK &&
+             table->cycle - this->pages[end].markedCycle >= window)
+         end++;
+
+      size_t count = (size_t)(this->pages[end - 1].vpn - first->vpn + 1);
+      ssize_t n = pread(this->pagemapFd, entries, count * sizeof(uint64_t), (off_t)(first->vpn * sizeof(uint64_t)));
+      count = n > 0 ? (size_t)n / sizeof(uint64_t) : 0;
+
+      size_t pfnCount = 0;
+      for (size_t i = this->cursor; i < end; i++) {
+         const WorkingSetPage* page = &this->pages[i];
+         uint64_t offset = page->vpn - first->vpn;
+         if (offset >= count || !(entries[offset] & PAGEMAP_PRESENT))
+            continue;
+
+         /* moved to another frame, as when written after a fork: used meanwhile */
+         if ((entries[offset] & PAGEMAP_PFN_MASK) != page->pfn) {
+            this->touched++;
+            continue;
+         }
+         pfns[pfnCount++] = page->pfn;
+      }
+      this->cursor = end;
+
+      /* each word of the bitmap is read once for the page frames it holds; like marking, this may overdraw the budget */
+      qsort(pfns, pfnCount, sizeof(uint64_t), WorkingSet_comparePfns);
+      for (size_t i = 0; i < pfnCount;) {
+         uint64_t index = pfns[i] / 64;
+         uint64_t word;
+         if (table->budget)
+            table->budget--;
+         bool ok = WorkingSetTable_readWord(table, pfns[i], &word);
+         for (; i < pfnCount && pfns[i] / 64 == index; i++) {
+            if (ok && !(word & (UINT64_C(1) << (pfns[i] % 64))))
+               this->touched++;
+         }
+      }
+   }
+
+   return true;
+}
+
+static void WorkingSet_advance(WorkingSet* this, WorkingSetTable* table, int percent, int window) {
+   for (;;) {
+      switch (this->phase) {
+      case WORKINGSET_MARKING:
+         if (!this->ranges && !WorkingSet_start(this, percent))
+            return;
+         if (!WorkingSet_mark(this, table))
+            return;
+
+         free(this->ranges);
+         this->ranges = NULL;
+         this->rangeCount = 0;
+         this->phase = WORKINGSET_WAITING;
+         break;
+      case WORKINGSET_WAITING:
+         /* until the window of the first page marked has passed */
+         if (this->pageCount && table->cycle - this->pages[0].markedCycle < (unsigned int)MAXIMUM(window, 1))
+            return;
+
+         this->cursor = 0;
+         this->touched = 0;
+         this->phase = WORKINGSET_CHECKING;
+         break;
+      case WORKINGSET_CHECKING:
+         if (!WorkingSet_check(this, table, (unsigned int)MAXIMUM(window, 1)))
+            return;
+
+         this->touchedKB = (long)(this->touched * this->stride) * table->pageSizeKB;
+         this->residentKB = (long)(this->pageCount * this->stride) * table->pageSizeKB;
+         this->rounds++;
+         this->pageCount = 0;
+         this->phase = WORKINGSET_MARKING;
+         /* the next round starts with the next refresh */
+         return;
+      }
+   }
+}
+
+const WorkingSet* WorkingSetTable_schedule(WorkingSetTable* this, pid_t pid, int percent, int window) {
+   WorkingSet* set = Hashtable_get(this->sets, (ht_key_t)pid);
+   if (!set) {
+      set = xCalloc(1, sizeof(WorkingSet));
+      set->pid = pid;
+      set->pagemapFd = -1;
+      set->phase = WORKINGSET_MARKING;
+      set->touchedKB = -1;
+      set->residentKB = -1;
+      Hashtable_put(this->sets, (ht_key_t)pid, set);
+      this->count++;
+   }
+   set->scheduledCycle = this->cycle;
+
+   if (this->bitmapFd >= 0 && !set->error) {
+      WorkingSet_advance(set, this, percent, window);
+      if (set->error)
+         WorkingSet_reset(set);
+   }
+   return set;
+}
+
+typedef struct WorkingSetTable_Stale_ {
+   unsigned int cycle;
+   ht_key_t* pids;
+   size_t count;
+} WorkingSetTable_Stale;
+
+static void WorkingSetTable_findStale(ht_key_t key, void* value, void* userData) {
+   WorkingSetTable_Stale* stale = userData;
+   const WorkingSet* set = value;
+   if (stale->cycle - set->scheduledCycle > WORKINGSET_KEEP)
+      stale->pids[stale->count++] = key;
+}
+
+void WorkingSetTable_end(WorkingSetTable* this) {
+   if (!this->count)
+      return;
+
+   /* collected first, as the table cannot change while walked */
+   WorkingSetTable_Stale stale = { .cycle = this->cycle, .pids = xMallocArray(this->count, sizeof(ht_key_t)), .count = 0 };
+   Hashtable_foreach(this->sets, WorkingSetTable_findStale, &stale);
+   for (size_t i = 0; i < stale.count; i++)
+      WorkingSet_delete(Hashtable_remove(this->sets, stale.pids[i]));
+   this->count -= stale.count;
+   free(stale.pids);
+}
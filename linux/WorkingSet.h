@@ -0,0 +1,94 @@
+#ifndef HEADER_WorkingSet
+#define HEADER_WorkingSet
+/*
+htop - WorkingSet.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "Hashtable.h"
+
+
+#define WORKINGSET_BITMAP "/sys/kernel/mm/page_idle/bitmap"
+
+typedef enum WorkingSetPhase_ {
+   WORKINGSET_MARKING,            /* sampling resident pages and marking them idle */
+   WORKINGSET_WAITING,            /* letting the process touch them for the window */
+   WORKINGSET_CHECKING,           /* counting the sampled pages no longer idle */
+} WorkingSetPhase;
+
+/* A resident page sampled, with the page frame it was in and the refresh it was in when marked idle */
+typedef struct WorkingSetPage_ {
+   uint64_t vpn;
+   uint64_t pfn;
+   unsigned int markedCycle;
+} WorkingSetPage;
+
+/* A readable, writable or executable mapping, in pages */
+typedef struct WorkingSetRange_ {
+   uint64_t first;
+   uint64_t end;
+} WorkingSetRange;
+
+/*
+ * Estimate of the memory a process touched within a window of refreshes,
+ * from idle page tracking: every stride-th resident page is marked idle
+ * through the page frame it is in, and the pages found no longer idle
+ * after the window were used meanwhile. A round spans several refreshes,
+ * each advancing it within a budget; as marking may take several of them,
+ * each page is checked once its own window has passed.
+ */
+typedef struct WorkingSet_ {
+   pid_t pid;
+   int pagemapFd;                 /* -1 while not open */
+   WorkingSetPhase phase;
+   unsigned int stride;           /* of the round going on */
+   WorkingSetRange* ranges;
+   size_t rangeCount;
+   size_t range;                  /* the range being marked */
+   uint64_t vpn;                  /* the next page of that range to look at */
+   WorkingSetPage* pages;         /* in the order marked, so by address */
+   size_t pageCount;
+   size_t pageCapacity;
+   size_t cursor;                 /* the next page to check */
+   size_t touched;                /* pages checked found no longer idle */
+   unsigned int scheduledCycle;   /* last refresh it was advanced in */
+
+   /* results of the last round, in kB; -1 before the first one */
+   long touchedKB;
+   long residentKB;               /* resident pages sampled, scaled as touchedKB */
+   unsigned int rounds;
+   int error;                     /* errno, 0 if the process can be sampled */
+} WorkingSet;
+
+/* The estimates of the processes sampled, sharing the budget of a refresh */
+typedef struct WorkingSetTable_ {
+   Hashtable* sets;               /* WorkingSet, by pid */
+   size_t count;
+   int bitmapFd;                  /* -1 if idle page tracking cannot be used */
+   int error;                     /* why it cannot, 0 otherwise */
+   long pageSizeKB;
+   unsigned int cycle;
+   size_t budget;                 /* page lookups left for this refresh */
+} WorkingSetTable;
+
+WorkingSetTable* WorkingSetTable_new(long pageSizeKB);
+
+void WorkingSetTable_delete(WorkingSetTable* this);
+
+/* Starts a refresh, with a new budget */
+void WorkingSetTable_begin(WorkingSetTable* this);
+
+/* Advances the estimate of a process as far as the budget allows; percent of its pages are sampled, window refreshes apart */
+const WorkingSet* WorkingSetTable_schedule(WorkingSetTable* this, pid_t pid, int percent, int window);
+
+/* Ends a refresh, forgetting the processes not scheduled for some time */
+void WorkingSetTable_end(WorkingSetTable* this);
+
+#endif
@@ -0,0 +1,149 @@
+/*
+htop - WorkingSetScreen.c
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include "config.h" // IWYU pragma: keep
+
+#include "linux/WorkingSetScreen.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Meter.h"
+#include "Panel.h"
+#include "ProvideCurses.h"
+#include "Settings.h"
+#include "Vector.h"
+#include "XUtils.h"
+#include "linux/LinuxMachine.h"
+#include "linux/LinuxProcessTable.h"
+
+
+WorkingSetScreen* WorkingSetScreen_new(const Process* process) {
+   WorkingSetScreen* this = xCalloc(1, sizeof(WorkingSetScreen));
+   Object_setClass(this, Class(WorkingSetScreen));
+
+   const LinuxMachine* lhost = (const LinuxMachine*) process->super.host;
+   const Settings* settings = lhost->super.settings;
+
+   /* the estimates of the main screen go on here, as a table of its own would mark their pages idle again */
+   LinuxProcessTable* pt = (LinuxProcessTable*) lhost->super.processTable;
+   this->ownsSets = !pt->workingSets;
+   this->sets = pt->workingSets ? pt->workingSets : WorkingSetTable_new(lhost->pageSizeKB);
+   this->percent = settings->workingSetPercent;
+   this->window = settings->workingSetWindow;
+
+   return (WorkingSetScreen*) InfoScreen_init(&this->super, process, NULL, LINES - 2, " ");
+}
+
+void WorkingSetScreen_delete(Object* cast) {
+   WorkingSetScreen* this = (WorkingSetScreen*) cast;
+   if (this->ownsSets)
+      WorkingSetTable_delete(this->sets);
+   free(this->rounds);
+   free(InfoScreen_done((InfoScreen*)this));
+}
+
+static void WorkingSetScreen_draw(InfoScreen* super) {
+   const WorkingSetScreen* this = (const WorkingSetScreen*) super;
+
+   InfoScreen_drawTitled(super, "Working set of process %d - %s: %d%% of its pages sampled, touched within %d updates",
+                         Process_getThreadGroup(super->process), Process_getCommand(super->process), this->percent, this->window);
+}
+
+/* What the sampling is doing, or why it cannot */
+static void WorkingSetScreen_describe(const WorkingSetScreen* this, char* buffer, size_t size) {
+   const WorkingSet* set = this->set;
+
+   if (this->sets->error) {
+      xSnprintf(buffer, size, "Idle page tracking cannot be used: " WORKINGSET_BITMAP ": %s (needs root and a kernel with CONFIG_IDLE_PAGE_TRACKING)",
+                strerror(this->sets->error));
+   } else if (!set) {
+      buffer[0] = '\0';
+   } else if (set->error == EFBIG) {
+      xSnprintf(buffer, size, "The address space of the process is too large to be sampled");
+   } else if (set->error) {
+      xSnprintf(buffer, size, "The pages of the process cannot be sampled: %s (needs root)", strerror(set->error));
+   } else if (set->phase == WORKINGSET_MARKING) {
+      xSnprintf(buffer, size, "Marking one page in %u idle: %zu resident pages so far", set->stride, set->pageCount);
+   } else if (set->phase == WORKINGSET_WAITING) {
+      unsigned int waited = set->pageCount ? this->sets->cycle - set->pages[0].markedCycle : (unsigned int)this->window;
+      xSnprintf(buffer, size, "Leaving %zu sampled pages to the process for %u more updates", set->pageCount,
+                (unsigned int)this->window - MINIMUM(waited, (unsigned int)this->window));
+   } else {
+      xSnprintf(buffer, size, "Checking the sampled pages: %zu of %zu, %zu touched", set->cursor, set->pageCount, set->touched);
+   }
+}
+
+static void WorkingSetScreen_scan(InfoScreen* super) {
+   WorkingSetScreen* this = (WorkingSetScreen*) super;
+   Panel* panel = super->display;
+   int idx = Panel_getSelectedIndex(panel);
+   Panel_prune(panel);
+   Vector_prune(super->lines);
+
+   Panel_setHeader(panel, "ROUND    ENDED   TOUCHED  RESIDENT TOUCHED%");
+
+   char line[256];
+   WorkingSetScreen_describe(this, line, sizeof(line));
+   if (line[0])
+      InfoScreen_addLine(super, line);
+
+   for (size_t i = this->count; i-- > 0;) {
+      const WorkingSetRound* round = &this->rounds[i];
+
+      char ended[16];
+      struct tm tm;
+      strftime(ended, sizeof(ended), "%H:%M:%S", localtime_r(&round->ended, &tm));
+
+      char touched[16];
+      char resident[16];
+      Meter_humanUnit(touched, (double)round->touchedKB, sizeof(touched));
+      Meter_humanUnit(resident, (double)round->residentKB, sizeof(resident));
+
+      double percent = round->residentKB > 0 ? 100.0 * (double)round->touchedKB / (double)round->residentKB : 0.0;
+      xSnprintf(line, sizeof(line), "%5u %8s %9s %9s %7.1f%%", round->round, ended, touched, resident, percent);
+      InfoScreen_addLine(super, line);
+   }
+
+   Panel_setSelected(panel, idx);
+}
+
+/* Advances the sampling by one update, as the main screen would */
+static void WorkingSetScreen_update(InfoScreen* super) {
+   WorkingSetScreen* this = (WorkingSetScreen*) super;
+
+   WorkingSetTable_begin(this->sets);
+   const WorkingSet* set = WorkingSetTable_schedule(this->sets, Process_getThreadGroup(super->process), this->percent, this->window);
+   WorkingSetTable_end(this->sets);
+   this->set = set;
+
+   if (set->rounds && (!this->count || this->rounds[this->count - 1].round != set->rounds)) {
+      if (this->count == this->capacity) {
+         this->capacity = this->capacity ? this->capacity * 2 : 16;
+         this->rounds = xReallocArray(this->rounds, this->capacity, sizeof(WorkingSetRound));
+      }
+      WorkingSetRound* round = &this->rounds[this->count++];
+      round->round = set->rounds;
+      round->touchedKB = set->touchedKB;
+      round->residentKB = set->residentKB;
+      round->ended = time(NULL);
+   }
+
+   WorkingSetScreen_scan(super);
+   InfoScreen_draw(super);
+}
+
+const InfoScreenClass WorkingSetScreen_class = {
+   .super = {
+      .extends = Class(Object),
+      .delete = WorkingSetScreen_delete
+   },
+   .scan = WorkingSetScreen_scan,
+   .draw = WorkingSetScreen_draw,
+   .onErr = WorkingSetScreen_update
+};
@@ -0,0 +1,46 @@
+#ifndef HEADER_WorkingSetScreen
+#define HEADER_WorkingSetScreen
+/*
+htop - WorkingSetScreen.h
+(C) 2025 htop dev team
+Released under the GNU GPLv2+, see the COPYING file
+in the source distribution for its full text.
+*/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+
+#include "InfoScreen.h"
+#include "Object.h"
+#include "Process.h"
+#include "linux/WorkingSet.h"
+
+
+/* The result of a round of sampling */
+typedef struct WorkingSetRound_ {
+   unsigned int round;
+   long touchedKB;
+   long residentKB;
+   time_t ended;
+} WorkingSetRound;
+
+typedef struct WorkingSetScreen_ {
+   InfoScreen super;
+   WorkingSetTable* sets;         /* that of the process table while its column is shown */
+   bool ownsSets;
+   const WorkingSet* set;
+   int percent;
+   int window;
+   WorkingSetRound* rounds;       /* latest first */
+   size_t count;
+   size_t capacity;
+} WorkingSetScreen;
+
+extern const InfoScreenClass WorkingSetScreen_class;
+
+WorkingSetScreen* WorkingSetScreen_new(const Process* process);
+
+void WorkingSetScreen_delete(Object* this);
+
+#endif
@@ -10,6 +10,7 @@ Released under the GNU GPLv2+, see the COPYING file
 in the source distribution for its full text.
 */
 
+#include <signal.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -65,6 +66,8 @@ void Platform_setSwapValues(Meter* this);
 
 char* Platform_getProcessEnv(pid_t pid);
 
+char* Platform_getProcessCmdline(pid_t pid, size_t* size);
+
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid);
 
 void Platform_getFileDescriptors(double* used, double* max);
@@ -139,4 +142,13 @@ static inline void Platform_addDynamicScreenAvailableColumns(ATTR_UNUSED Panel*
 
 static inline void Platform_dynamicScreensDone(ATTR_UNUSED Hashtable* screens) { }
 
+static inline bool Platform_pinProcess(ATTR_UNUSED const Process* proc, int* pidfd) {
+   *pidfd = -1;
+   return true;
+}
+
+static inline bool Platform_signalPinned(const Process* proc, ATTR_UNUSED int pidfd, int sgn) {
+   return kill(Process_getPid(proc), sgn) == 0;
+}
+
 #endif
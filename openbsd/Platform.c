@@ -26,6 +26,7 @@ in the source distribution for its full text.
 #include <sys/types.h>
 #include <uvm/uvmexp.h>
 
+#include "CPUHeatmapMeter.h"
 #include "CPUMeter.h"
 #include "ClockMeter.h"
 #include "DateMeter.h"
@@ -37,6 +38,7 @@ in the source distribution for its full text.
 #include "MemoryMeter.h"
 #include "MemorySwapMeter.h"
 #include "Meter.h"
+#include "ProfileMeter.h"
 #include "Settings.h"
 #include "SignalsPanel.h"
 #include "SwapMeter.h"
@@ -127,8 +129,14 @@ const MeterClass* const Platform_meterTypes[] = {
    &RightCPUs4Meter_class,
    &LeftCPUs8Meter_class,
    &RightCPUs8Meter_class,
+   &CPUHeatmapMeter_class,
+   &CoreHeatmapMeter_class,
+   &CCDHeatmapMeter_class,
+   &SocketHeatmapMeter_class,
+   &NodeHeatmapMeter_class,
    &FileDescriptorMeter_class,
    &BlankMeter_class,
+   &ProfileMeter_class,
    NULL
 };
 
@@ -301,6 +309,12 @@ end:
    return env;
 }
 
+char* Platform_getProcessCmdline(pid_t pid, size_t* size) {
+   (void) pid;
+   (void) size;
+   return NULL;
+}
+
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
    (void)pid;
    return NULL;
@@ -18,6 +18,7 @@ in the source distribution for its full text.
 #include <unistd.h>
 
 #include "BatteryMeter.h"
+#include "CPUHeatmapMeter.h"
 #include "CPUMeter.h"
 #include "ClockMeter.h"
 #include "DateMeter.h"
@@ -35,6 +36,7 @@ in the source distribution for its full text.
 #include "Meter.h"
 #include "NetworkIOMeter.h"
 #include "ProcessTable.h"
+#include "ProfileMeter.h"
 #include "Settings.h"
 #include "SwapMeter.h"
 #include "SysArchMeter.h"
@@ -105,6 +107,11 @@ const MeterClass* const Platform_meterTypes[] = {
    &RightCPUs4Meter_class,
    &LeftCPUs8Meter_class,
    &RightCPUs8Meter_class,
+   &CPUHeatmapMeter_class,
+   &CoreHeatmapMeter_class,
+   &CCDHeatmapMeter_class,
+   &SocketHeatmapMeter_class,
+   &NodeHeatmapMeter_class,
    &PressureStallCPUSomeMeter_class,
    &PressureStallIOSomeMeter_class,
    &PressureStallIOFullMeter_class,
@@ -120,6 +127,7 @@ const MeterClass* const Platform_meterTypes[] = {
    &FileDescriptorMeter_class,
    &BlankMeter_class,
    &DynamicMeter_class,
+   &ProfileMeter_class,
    NULL
 };
 
@@ -722,6 +730,12 @@ char* Platform_getProcessEnv(pid_t pid) {
    return value.cp;
 }
 
+char* Platform_getProcessCmdline(pid_t pid, size_t* size) {
+   (void) pid;
+   (void) size;
+   return NULL;
+}
+
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
    (void)pid;
    return NULL;
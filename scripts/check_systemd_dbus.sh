@@ -0,0 +1,72 @@
+#!/bin/sh
+
+# Checks the native D-Bus reading of the systemd state (linux/SystemdState.c)
+# against the stand-in bus of fakesystemdbus.py, through the Systemd meter.
+#
+# usage: check_systemd_dbus.sh [HTOP]
+#
+# htop (default: the one built in the source directory) runs for about 12
+# updates of one second; the meter reads the state every 5 seconds. The
+# state must be read once at the start, then only once more after the
+# manager announced a change, and the meter must show both states.
+
+set -e
+
+SCRIPT=$(readlink -f "$0")
+SCRIPTDIR=$(dirname "$SCRIPT")
+SRCDIR=$(dirname "$SCRIPTDIR")
+
+HTOP=${1:-$SRCDIR/htop}
+
+WORKDIR=$(mktemp -d)
+BUS=
+cleanup() {
+   [ -n "$BUS" ] && kill "$BUS" 2> /dev/null
+   rm -rf "$WORKDIR"
+}
+trap cleanup EXIT
+
+python3 "$SCRIPTDIR/fakesystemdbus.py" "$WORKDIR/bus" "$WORKDIR/calls" &
+BUS=$!
+while [ ! -S "$WORKDIR/bus" ]; do
+   sleep 0.1
+done
+
+cat > "$WORKDIR/htoprc" << EOF
+header_layout=one_100
+column_meters_0=Systemd
+column_meter_modes_0=2
+EOF
+
+# input that stays open, so the updates wait for the delay
+sleep 14 | DBUS_SYSTEM_BUS_ADDRESS="unix:path=$WORKDIR/bus" HTOPRC="$WORKDIR/htoprc" TERM=xterm COLUMNS=120 LINES=30 \
+   "$HTOP" -d 10 -n 12 > "$WORKDIR/screen" 2>&1 &
+HTOPPID=$!
+
+# between the first and the second read of the meter
+sleep 3
+kill -USR1 "$BUS"
+wait "$HTOPPID"
+
+FAILED=0
+check() {
+   if [ "$2" = "$3" ]; then
+      echo "ok: $1"
+   else
+      echo "FAILED: $1: expected $3, got $2"
+      FAILED=1
+   fi
+}
+
+calls() {
+   grep -cx "$1" "$WORKDIR/calls" || true
+}
+
+check "connected once" "$(calls Hello)" 1
+check "subscribed once" "$(calls Subscribe)" 1
+check "manager read at the start and after the change only" "$(calls GetAll)" 2
+check "units read at the start and after the change only" "$(calls ListUnits)" 2
+check "degraded state shown" "$(grep -c degraded "$WORKDIR/screen")" 1
+check "running state shown after the change" "$(grep -c running "$WORKDIR/screen")" 1
+
+exit "$FAILED"
@@ -0,0 +1,254 @@
+#!/usr/bin/env python3
+
+# Checks the wait profile screen (see linux/WaitProfile.c) against a busy
+# process whose threads are each in a known place: one spins, two sleep in
+# clock_nanosleep and one blocks reading a pipe, until the whole process is
+# stopped halfway through the sampling.
+#
+# usage: check_wait_profile.py [HTOP]
+#
+# htop (default: the one built in the source directory) runs on a pseudo
+# terminal taken for a vt100 of 160x40, and what it draws is replayed on a
+# screen of that size. The screen must sample at about its default rate,
+# its process and thread histograms must place every thread where it is,
+# half of the time stopped, and the shares must add up to all the samples.
+
+import fcntl
+import os
+import pty
+import re
+import signal
+import struct
+import subprocess
+import sys
+import termios
+import threading
+import time
+
+COLUMNS = 160
+LINES = 40
+
+# sampling the process for this long, then as long again while it is stopped
+PHASE = 2.0
+
+# default sampling interval of the screen, in seconds
+INTERVAL = 0.05
+
+
+def busy(ready):
+    import ctypes
+
+    libc = ctypes.CDLL(None)
+
+    def named(name, target):
+        def run():
+            libc.prctl(15, name.encode(), 0, 0, 0)  # PR_SET_NAME
+            target()
+        return run
+
+    def spin():
+        while True:
+            pass
+
+    def sleep():
+        while True:
+            time.sleep(3600)
+
+    reader, _ = os.pipe()
+
+    for name, target in (("spinner", spin), ("sleeper", sleep), ("sleeper", sleep), ("reader", lambda: os.read(reader, 1))):
+        threading.Thread(target=named(name, target), daemon=True).start()
+
+    # the threads name themselves before they get where they stay
+    time.sleep(0.5)
+    os.write(ready, b"\n")
+    while True:
+        time.sleep(3600)
+
+
+def replay(output):
+    """Returns the screens shown before each clear, and the last one"""
+    screen = [[" "] * COLUMNS for _ in range(LINES)]
+    screens = []
+    y = x = 0
+
+    for m in re.finditer(rb"\x1b\[([0-9;?]*)([A-Za-z@])|\x1b[()=>][0-9A-B]?|[\x00-\x1f]|[^\x00-\x1f\x1b]+", output):
+        token = m.group(0)
+        if m.group(2):
+            args = m.group(1).decode()
+            if args.startswith("?"):
+                continue
+            n = [int(a) if a else 0 for a in args.split(";")] if args else []
+            arg = n[0] if n and n[0] else 1
+            command = m.group(2).decode()
+            if command == "H":
+                y = (n[0] if n and n[0] else 1) - 1
+                x = (n[1] if len(n) > 1 and n[1] else 1) - 1
+            elif command == "J":
+                # a vt100 clears the screen from its top left corner
+                if n and n[0] == 2 or (not n and y == 0 and x == 0):
+                    screens.append(["".join(row).rstrip() for row in screen])
+                    screen = [[" "] * COLUMNS for _ in range(LINES)]
+                else:
+                    screen[y][x:] = [" "] * (COLUMNS - x)
+                    for row in range(y + 1, LINES):
+                        screen[row] = [" "] * COLUMNS
+            elif command == "K":
+                screen[y][x:] = [" "] * (COLUMNS - x)
+            elif command == "A":
+                y = max(y - arg, 0)
+            elif command == "B":
+                y = min(y + arg, LINES - 1)
+            elif command == "C":
+                x = min(x + arg, COLUMNS - 1)
+            elif command == "D":
+                x = max(x - arg, 0)
+        elif token == b"\r":
+            x = 0
+        elif token == b"\n":
+            y = min(y + 1, LINES - 1)
+        elif token == b"\b":
+            x = max(x - 1, 0)
+        elif token[0] >= 0x20 and token[0] != 0x1b:
+            for c in token.decode("utf-8", "replace"):
+                if x < COLUMNS:
+                    screen[y][x] = c
+                x += 1
+            x = min(x, COLUMNS - 1)
+
+    screens.append(["".join(row).rstrip() for row in screen])
+    return screens
+
+
+# " SHARE            SAMPLES S SYSCALL              WCHAN                      TID NAME"
+ROW = re.compile(r"^\s*([0-9.]+)% [| ]{10} +([0-9]+) (\S) (.{20}) (\S+)(?: +([0-9]+) (.*))?$")
+
+# "Where the threads of process PID - COMMAND are: N samples, one every ..."
+TITLE = re.compile(r"are: ([0-9]+) samples")
+
+
+def histogram(screens, byThread):
+    """Returns the samples and rows of the last screen of the profile by process, or by thread"""
+    for screen in reversed(screens):
+        header = next((line for line in screen if "SAMPLES" in line and "SYSCALL" in line), None)
+        if header is None or ("NAME" in header) != byThread:
+            continue
+        title = next((TITLE.search(line) for line in screen if TITLE.search(line)), None)
+        samples = int(title.group(1)) if title else 0
+        rows = []
+        for line in screen:
+            m = ROW.match(line)
+            if m:
+                rows.append({
+                    "share": float(m.group(1)),
+                    "state": m.group(3),
+                    "syscall": m.group(4).strip(),
+                    "wchan": m.group(5),
+                    "name": (m.group(7) or "").strip(),
+                })
+        return samples, rows
+    return 0, []
+
+
+failed = False
+
+
+def check(what, ok, rows=None):
+    global failed
+    if ok:
+        print("ok: " + what)
+        return
+    print("FAILED: " + what)
+    for row in rows or []:
+        print("   %(share)5.1f%% %(state)s %(syscall)-20s %(wchan)-26s %(name)s" % row)
+    failed = True
+
+
+def main():
+    srcdir = os.path.dirname(os.path.dirname(os.path.realpath(__file__)))
+    htop = sys.argv[1] if len(sys.argv) > 1 else os.path.join(srcdir, "htop")
+
+    ready, notify = os.pipe()
+    pid = os.fork()
+    if pid == 0:
+        os.close(ready)
+        busy(notify)
+        os._exit(0)
+    os.close(notify)
+    os.read(ready, 1)
+
+    # on a pipe the screen would only sample once per update, as keys are then not waited for with a timeout
+    terminal, tty = pty.openpty()
+    fcntl.ioctl(tty, termios.TIOCSWINSZ, struct.pack("HHHH", LINES, COLUMNS, 0, 0))
+    env = dict(os.environ, HTOPRC=os.devnull, TERM="vt100")
+    ui = subprocess.Popen([htop, "-d", "5", "-p", str(pid)], stdin=tty, stdout=tty, stderr=tty, env=env, start_new_session=True)
+    os.close(tty)
+
+    output = []
+
+    def collect():
+        while True:
+            try:
+                data = os.read(terminal, 65536)
+            except OSError:
+                return
+            if not data:
+                return
+            output.append(data)
+
+    collector = threading.Thread(target=collect)
+    collector.start()
+
+    def press(keys, wait):
+        os.write(terminal, keys)
+        time.sleep(wait)
+
+    try:
+        time.sleep(1.5)
+        press(b"W", PHASE)
+        os.kill(pid, signal.SIGSTOP)
+        time.sleep(PHASE)
+        # a clear after each histogram keeps it on a screen of its own
+        press(b"\014", 0.5)
+        press(b"t", 0.5)
+        press(b"\014", 0.5)
+        press(b"qq", 0)
+        ui.wait(timeout=10)
+    finally:
+        if ui.poll() is None:
+            ui.kill()
+            ui.wait()
+        os.kill(pid, signal.SIGKILL)
+        os.waitpid(pid, 0)
+    collector.join()
+    os.close(terminal)
+
+    screens = replay(b"".join(output))
+    samples, process = histogram(screens, False)
+    _, threads = histogram(screens, True)
+
+    def find(rows, **fields):
+        return [row for row in rows if all(row[k] == v for k, v in fields.items())]
+
+    check("process histogram shown", process)
+    check("sampled at about every %dms (%d samples)" % (INTERVAL * 1000, samples), samples >= PHASE * 2 / INTERVAL / 2)
+    check("spinning thread counted as running", find(process, state="R", syscall="(running)"), process)
+    check("sleeping threads counted in clock_nanosleep", find(process, state="S", syscall="clock_nanosleep"), process)
+    check("blocked thread counted in read", find(process, state="S", syscall="read"), process)
+    check("stopped threads counted", find(process, state="T"), process)
+    check("process shares add up to 100%", abs(sum(row["share"] for row in process) - 100.0) < 0.1 * len(process) + 0.1, process)
+
+    check("thread histogram shown", threads)
+    check("spinner running", find(threads, name="spinner", state="R", syscall="(running)"), threads)
+    check("spinner running half of the time", all(25.0 <= row["share"] <= 75.0 for row in find(threads, name="spinner", state="R")), threads)
+    check("both sleepers sleeping", len(find(threads, name="sleeper", state="S", syscall="clock_nanosleep")) == 2, threads)
+    check("reader blocked in read", find(threads, name="reader", state="S", syscall="read"), threads)
+    check("every thread seen stopped", {row["name"] for row in find(threads, state="T")} >= {"spinner", "sleeper", "reader"}, threads)
+    for name in ("spinner", "reader"):
+        check(name + " shares add up to 100%", abs(sum(row["share"] for row in find(threads, name=name)) - 100.0) < 0.5, threads)
+
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
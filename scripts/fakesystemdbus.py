@@ -0,0 +1,353 @@
+#!/usr/bin/env python3
+
+# A stand-in for the system bus with a systemd manager on it, serving just
+# what htop asks for (see linux/SystemdState.c): Hello, AddMatch, Subscribe,
+# the manager properties through GetAll and ListUnits.
+#
+# usage: fakesystemdbus.py SOCKET [LOG]
+#
+# htop is pointed at it with DBUS_SYSTEM_BUS_ADDRESS=unix:path=SOCKET. The
+# member of every method call received is appended to LOG. On SIGUSR1 the
+# manager moves from a degraded to a running state and tells the clients
+# that subscribed with a UnitRemoved signal.
+
+import os
+import select
+import signal
+import socket
+import struct
+import sys
+
+STATES = [
+    {
+        "SystemState": "degraded",
+        "NFailedUnits": 1,
+        "units": [
+            ("dbus.service", "D-Bus System Message Bus", "loaded", "active", "running"),
+            ("failing.service", "A service failing", "loaded", "failed", "failed"),
+            ("idle.service", "An idle service", "loaded", "inactive", "dead"),
+            ("starting.service", "A service starting", "loaded", "activating", "start"),
+            ("sshd.service", "OpenSSH Daemon", "loaded", "active", "running"),
+        ],
+    },
+    {
+        "SystemState": "running",
+        "NFailedUnits": 0,
+        "units": [
+            ("dbus.service", "D-Bus System Message Bus", "loaded", "active", "running"),
+            ("idle.service", "An idle service", "loaded", "inactive", "dead"),
+            ("starting.service", "A service starting", "loaded", "active", "running"),
+            ("sshd.service", "OpenSSH Daemon", "loaded", "active", "running"),
+        ],
+    },
+]
+
+METHOD_CALL, METHOD_RETURN, ERROR, SIGNAL = 1, 2, 3, 4
+HEADER_PATH, HEADER_INTERFACE, HEADER_MEMBER, HEADER_ERROR_NAME = 1, 2, 3, 4
+HEADER_REPLY_SERIAL, HEADER_DESTINATION, HEADER_SENDER, HEADER_SIGNATURE = 5, 6, 7, 8
+
+ALIGNMENT = {"y": 1, "g": 1, "n": 2, "q": 2, "b": 4, "i": 4, "u": 4, "s": 4, "o": 4, "a": 4,
+             "x": 8, "t": 8, "d": 8, "(": 8, "{": 8, "v": 1}
+
+
+def split_types(signature):
+    """Splits a signature into its complete types"""
+    types = []
+    i = 0
+    while i < len(signature):
+        start = i
+        while signature[i] == "a":
+            i += 1
+        if signature[i] in "({":
+            depth = 0
+            while True:
+                if signature[i] in "({":
+                    depth += 1
+                elif signature[i] in ")}":
+                    depth -= 1
+                i += 1
+                if depth == 0:
+                    break
+        else:
+            i += 1
+        types.append(signature[start:i])
+    return types
+
+
+class Writer:
+    """Marshals values; offsets count from the start of the message"""
+
+    def __init__(self, order="<"):
+        self.order = order
+        self.buf = bytearray()
+
+    def align(self, n):
+        self.buf += b"\0" * (-len(self.buf) % n)
+
+    def pack(self, fmt, value):
+        self.align(struct.calcsize(fmt))
+        self.buf += struct.pack(self.order + fmt, value)
+
+    def write(self, t, value):
+        if t == "y":
+            self.buf.append(value)
+        elif t in "bu":
+            self.pack("I", value)
+        elif t == "i":
+            self.pack("i", value)
+        elif t == "t":
+            self.pack("Q", value)
+        elif t in "so":
+            data = value.encode()
+            self.pack("I", len(data))
+            self.buf += data + b"\0"
+        elif t == "g":
+            data = value.encode()
+            self.buf.append(len(data))
+            self.buf += data + b"\0"
+        elif t == "v":
+            self.write("g", value[0])
+            self.write(value[0], value[1])
+        elif t[0] == "a":
+            self.pack("I", 0)
+            lengthAt = len(self.buf) - 4
+            self.align(ALIGNMENT[t[1]])
+            start = len(self.buf)
+            for element in value:
+                self.write(t[1:], element)
+            self.buf[lengthAt:lengthAt + 4] = struct.pack(self.order + "I", len(self.buf) - start)
+        elif t[0] in "({":
+            self.align(8)
+            for field, v in zip(split_types(t[1:-1]), value):
+                self.write(field, v)
+        else:
+            raise ValueError("cannot write type " + t)
+
+
+class Reader:
+    def __init__(self, data, order, pos=0):
+        self.data = data
+        self.order = order
+        self.pos = pos
+
+    def unpack(self, fmt):
+        size = struct.calcsize(fmt)
+        self.pos += -self.pos % size
+        (value,) = struct.unpack_from(self.order + fmt, self.data, self.pos)
+        self.pos += size
+        return value
+
+    def read(self, t):
+        if t == "y":
+            self.pos += 1
+            return self.data[self.pos - 1]
+        if t in "bu":
+            return self.unpack("I")
+        if t in "so":
+            n = self.unpack("I")
+            self.pos += n + 1
+            return self.data[self.pos - n - 1:self.pos - 1].decode()
+        if t == "g":
+            n = self.data[self.pos]
+            self.pos += n + 2
+            return self.data[self.pos - n - 1:self.pos - 1].decode()
+        if t == "v":
+            return self.read(self.read("g"))
+        raise ValueError("cannot read type " + t)
+
+
+def message(kind, serial, fields, signature="", body=()):
+    """Marshals a little-endian message; fields maps header codes to (type, value)"""
+    payload = Writer()
+    for t, v in zip(split_types(signature), body):
+        payload.write(t, v)
+    if signature:
+        fields = dict(fields)
+        fields[HEADER_SIGNATURE] = ("g", signature)
+
+    w = Writer()
+    w.buf += struct.pack("<cBBBII", b"l", kind, 0, 1, len(payload.buf), serial)
+    w.write("a(yv)", sorted(fields.items()))
+    w.align(8)
+    return bytes(w.buf + payload.buf)
+
+
+def parse(data):
+    """Returns (message length, type, serial, header fields, body) of the first message in data, or None if incomplete"""
+    if len(data) < 16:
+        return None
+    order = "<" if data[0:1] == b"l" else ">"
+    kind = data[1]
+    bodyLen, serial, fieldsLen = struct.unpack_from(order + "III", data, 4)
+    bodyAt = 16 + fieldsLen + (-(16 + fieldsLen) % 8)
+    if len(data) < bodyAt + bodyLen:
+        return None
+
+    r = Reader(data, order, 16)
+    fields = {}
+    while r.pos < 16 + fieldsLen:
+        r.pos += -r.pos % 8
+        code = r.read("y")
+        fields[code] = r.read("v")
+
+    body = []
+    r = Reader(data, order, bodyAt)
+    for t in split_types(fields.get(HEADER_SIGNATURE, "")):
+        body.append(r.read(t) if t in "ybusog" else None)
+    return bodyAt + bodyLen, kind, serial, fields, body
+
+
+class Client:
+    def __init__(self, sock, name):
+        self.sock = sock
+        self.name = name
+        self.greeted = False
+        self.authenticated = False
+        self.subscribed = False
+        self.buf = b""
+        self.serial = 0
+
+    def send(self, data):
+        self.sock.sendall(data)
+
+    def reply(self, serial, signature="", body=()):
+        self.serial += 1
+        self.send(message(METHOD_RETURN, self.serial, {
+            HEADER_REPLY_SERIAL: ("u", serial),
+            HEADER_DESTINATION: ("s", self.name),
+            HEADER_SENDER: ("s", "org.freedesktop.DBus"),
+        }, signature, body))
+
+    def error(self, serial, name):
+        self.serial += 1
+        self.send(message(ERROR, self.serial, {
+            HEADER_ERROR_NAME: ("s", name),
+            HEADER_REPLY_SERIAL: ("u", serial),
+            HEADER_DESTINATION: ("s", self.name),
+        }, "s", ("not served by the stand-in",)))
+
+    def signal(self, member, signature, body):
+        self.serial += 1
+        self.send(message(SIGNAL, self.serial, {
+            HEADER_PATH: ("o", "/org/freedesktop/systemd1"),
+            HEADER_INTERFACE: ("s", "org.freedesktop.systemd1.Manager"),
+            HEADER_MEMBER: ("s", member),
+            HEADER_SENDER: ("s", "org.freedesktop.systemd1"),
+        }, signature, body))
+
+
+class Bus:
+    def __init__(self, path, log):
+        self.listener = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        self.listener.bind(path)
+        self.listener.listen(8)
+        self.log = log
+        self.clients = {}
+        self.state = STATES[0]
+        self.changed = False
+        self.wakeup, self.wakeupWrite = os.pipe()
+
+    def manager_properties(self):
+        state = self.state
+        return [
+            ("Version", ("s", "257")),
+            ("Features", ("as", ["+PAM", "+SELINUX"])),
+            ("SystemState", ("s", state["SystemState"])),
+            ("NFailedUnits", ("u", state["NFailedUnits"])),
+            ("NInstalledJobs", ("u", 42)),
+            ("NNames", ("u", len(state["units"]) + 3)),
+            ("NJobs", ("u", 0)),
+            ("FirmwareTimestamp", ("t", 0)),
+        ]
+
+    def list_units(self):
+        return [(name, description, load, active, sub, "", "/org/freedesktop/systemd1/unit/" + name.replace(".", "_2e"), 0, "", "/")
+                for name, description, load, active, sub in self.state["units"]]
+
+    def call(self, client, serial, fields, body):
+        member = fields.get(HEADER_MEMBER, "")
+        if self.log:
+            with open(self.log, "a") as f:
+                f.write(member + "\n")
+
+        if member == "Hello":
+            client.reply(serial, "s", (client.name,))
+        elif member == "AddMatch":
+            client.reply(serial)
+        elif member == "Subscribe":
+            client.subscribed = True
+            client.reply(serial)
+        elif member == "GetAll" and body[:1] == ["org.freedesktop.systemd1.Manager"]:
+            client.reply(serial, "a{sv}", (self.manager_properties(),))
+        elif member == "ListUnits":
+            client.reply(serial, "a(ssssssouso)", (self.list_units(),))
+        else:
+            client.error(serial, "org.freedesktop.DBus.Error.UnknownMethod")
+
+    def receive(self, client):
+        data = client.sock.recv(65536)
+        if not data:
+            return False
+        client.buf += data
+
+        # any AUTH command is accepted; the messages start after BEGIN
+        if not client.authenticated:
+            if not client.greeted and b"\r\n" in client.buf:
+                client.send(b"OK 0123456789abcdef0123456789abcdef\r\n")
+                client.greeted = True
+            if b"BEGIN\r\n" not in client.buf:
+                return True
+            client.buf = client.buf.split(b"BEGIN\r\n", 1)[1]
+            client.authenticated = True
+
+        while True:
+            parsed = parse(client.buf)
+            if not parsed:
+                return True
+            length, kind, serial, fields, body = parsed
+            client.buf = client.buf[length:]
+            if kind == METHOD_CALL:
+                self.call(client, serial, fields, body)
+
+    def change(self):
+        self.state = STATES[1]
+        for client in self.clients.values():
+            if client.subscribed:
+                client.signal("UnitRemoved", "so", ("failing.service", "/org/freedesktop/systemd1/unit/failing_2eservice"))
+
+    def run(self):
+        signal.signal(signal.SIGUSR1, lambda signum, frame: os.write(self.wakeupWrite, b"x"))
+        count = 0
+        while True:
+            readable, _, _ = select.select([self.listener, self.wakeup] + list(self.clients), [], [])
+            for sock in readable:
+                if sock is self.listener:
+                    conn, _ = self.listener.accept()
+                    count += 1
+                    self.clients[conn] = Client(conn, ":1.%d" % count)
+                elif sock is self.wakeup:
+                    os.read(self.wakeup, 64)
+                    self.change()
+                elif not self.receive(self.clients[sock]):
+                    sock.close()
+                    del self.clients[sock]
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.stderr.write("usage: %s SOCKET [LOG]\n" % sys.argv[0])
+        return 1
+
+    path = sys.argv[1]
+    if os.path.exists(path):
+        os.unlink(path)
+    signal.signal(signal.SIGTERM, lambda signum, frame: sys.exit(0))
+    try:
+        Bus(path, sys.argv[2] if len(sys.argv) > 2 else None).run()
+    finally:
+        os.unlink(path)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,151 @@
+#!/bin/sh
+
+# Creates a synthetic procfs tree for benchmarking htop built with
+# ./configure --with-proc=DIR
+#
+# usage: mkfakeproc.sh DIR [PROCESSES [THREADS]]
+#
+# Every tenth process is a kernel thread; THREADS userland threads are
+# spread over the remaining processes.
+
+set -e
+
+DIR=$1
+NPROC=${2:-1000}
+NTHREADS=${3:-4000}
+
+if [ -z "$DIR" ]; then
+   echo "usage: $0 DIR [PROCESSES [THREADS]]" >&2
+   exit 1
+fi
+
+rm -rf "$DIR"
+mkdir -p "$DIR/tty" "$DIR/sys/kernel" "$DIR/sys/fs" "$DIR/self/ns"
+
+# One directory per process and per thread, matching the layout written below
+awk -v nproc="$NPROC" -v nthreads="$NTHREADS" -v dir="$DIR" 'BEGIN {
+   tid = nproc + 100
+   for (pid = 1; pid <= nproc; pid++)
+      print dir "/" pid "/task/" pid
+   users = nproc - int(nproc / 10)
+   for (t = 0; t < nthreads; t++) {
+      n = t % users
+      pid = int(n / 9) * 10 + (n % 9) + 1
+      print dir "/" pid "/task/" (tid + t)
+   }
+}' | xargs mkdir -p
+
+awk -v nproc="$NPROC" -v nthreads="$NTHREADS" -v dir="$DIR" '
+function task(path, pid, tgid, ppid, comm, cmdline, kthread, utime, rss,    f) {
+   f = path "/stat"
+   printf "%d (%s) %s %d %d %d %d %d %d %d 0 %d 0 %d %d 0 0 20 0 %d 0 %d %d %d 18446744073709551615 1 1 0 0 0 0 0 0 0 0 0 0 17 %d 0 0 0 0 0 0 0 0 0 0 0 0 0\n", \
+      pid, comm, (pid % 7 == 0) ? "R" : "S", ppid, tgid, tgid, kthread ? 0 : 34816, -1, \
+      kthread ? 2129984 : 4194560, pid * 13, pid % 5, utime, int(utime / 3), \
+      threads[tgid] + 1, 100 + pid, rss * 1024 * 4, rss, pid % 8 > f
+   close(f)
+
+   f = path "/statm"
+   printf "%d %d %d 100 0 %d 0\n", rss * 4, rss, int(rss / 3), int(rss / 2) > f
+   close(f)
+
+   f = path "/status"
+   printf "Name:\t%s\nUmask:\t0022\nState:\tS (sleeping)\nTgid:\t%d\nNgid:\t0\nPid:\t%d\nPPid:\t%d\nTracerPid:\t0\n", comm, tgid, pid, ppid > f
+   printf "Uid:\t%d\t%d\t%d\t%d\nGid:\t0\t0\t0\t0\nFDSize:\t64\nVmPeak:\t%d kB\nVmSize:\t%d kB\nVmRSS:\t%d kB\n", \
+      pid % 3 * 1000, pid % 3 * 1000, pid % 3 * 1000, pid % 3 * 1000, rss * 16, rss * 16, rss * 4 > f
+   printf "RssAnon:\t%d kB\nRssFile:\t%d kB\nRssShmem:\t0 kB\nVmSwap:\t0 kB\nThreads:\t%d\n", rss * 3, rss, threads[tgid] + 1 > f
+   printf "voluntary_ctxt_switches:\t%d\nnonvoluntary_ctxt_switches:\t%d\n", pid * 17, pid % 11 > f
+   close(f)
+
+   f = path "/comm"
+   print comm > f
+   close(f)
+
+   f = path "/cmdline"
+   printf "%s", cmdline > f
+   close(f)
+
+   f = path "/io"
+   printf "rchar: %d\nwchar: %d\nsyscr: %d\nsyscw: %d\nread_bytes: %d\nwrite_bytes: %d\ncancelled_write_bytes: 0\n", \
+      pid * 4096, pid * 1024, pid * 3, pid, pid * 512, pid * 256 > f
+   close(f)
+
+   f = path "/cgroup"
+   printf "0::/system.slice/svc%d.service\n", tgid % 50 > f
+   close(f)
+
+   f = path "/smaps_rollup"
+   printf "00400000-7fffffffffff ---p 00000000 00:00 0 [rollup]\nRss: %d kB\nPss: %d kB\nPss_Anon: %d kB\nShared_Clean: %d kB\nPrivate_Dirty: %d kB\nSwap: 0 kB\nSwapPss: 0 kB\n", \
+      rss * 4, rss * 3, rss * 2, rss, rss * 2 > f
+   close(f)
+
+   f = path "/oom_score"
+   print pid % 1000 > f
+   close(f)
+}
+
+BEGIN {
+   users = nproc - int(nproc / 10)
+   for (t = 0; t < nthreads; t++) {
+      n = t % users
+      owner[t] = int(n / 9) * 10 + (n % 9) + 1
+      threads[owner[t]]++
+   }
+
+   for (i = 0; i < nproc; i++) {
+      pid = i + 1
+      kthread = i % 10 == 9
+      ppid = kthread ? 2 : (pid > 1 ? int((pid - 1) / 4) + 1 : 0)
+      rss = kthread ? 0 : 500 + (pid * 37) % 20000
+      if (kthread) {
+         comm = "kworker/" pid
+         cmdline = ""
+      } else {
+         comm = "worker" (pid % 100)
+         cmdline = sprintf("/usr/lib/fake/bin/worker%d%c--config%c/etc/fake/worker-%d.conf%c--verbose", pid % 100, 0, 0, pid, 0)
+      }
+      task(dir "/" pid, pid, pid, ppid, comm, cmdline, kthread, pid * 3, rss)
+      task(dir "/" pid "/task/" pid, pid, pid, ppid, comm, cmdline, kthread, pid * 3, rss)
+   }
+
+   tid = nproc + 100
+   for (t = 0; t < nthreads; t++) {
+      pid = owner[t]
+      task(dir "/" pid "/task/" (tid + t), tid + t, pid, int((pid - 1) / 4) + 1, "thread" (t % 16), "", 0, t, 500 + (pid * 37) % 20000)
+   }
+}'
+
+cat > "$DIR/stat" <<EOF
+cpu  400000 1000 100000 3000000 5000 0 2000 0 0 0
+cpu0 100000 250 25000 750000 1250 0 500 0 0 0
+cpu1 100000 250 25000 750000 1250 0 500 0 0 0
+cpu2 100000 250 25000 750000 1250 0 500 0 0 0
+cpu3 100000 250 25000 750000 1250 0 500 0 0 0
+intr 0
+ctxt 123456789
+btime 1700000000
+processes 123456
+procs_running 3
+procs_blocked 0
+EOF
+
+cat > "$DIR/meminfo" <<EOF
+MemTotal:       16318432 kB
+MemFree:         8154760 kB
+MemAvailable:   11669960 kB
+Buffers:          159004 kB
+Cached:          3661344 kB
+SwapCached:            0 kB
+Shmem:            201344 kB
+SReclaimable:     301344 kB
+SwapTotal:       2097148 kB
+SwapFree:        2097148 kB
+EOF
+
+echo "1000.00 3900.00" > "$DIR/uptime"
+echo "0.50 0.40 0.30 3/$((NPROC + NTHREADS)) $((NPROC + NTHREADS + 100))" > "$DIR/loadavg"
+echo "4194304" > "$DIR/sys/kernel/pid_max"
+echo "1024 0 9223372036854775807" > "$DIR/sys/fs/file-nr"
+cat > "$DIR/tty/drivers" <<EOF
+/dev/tty             /dev/tty        5       0 system:/dev/tty
+pty_slave            /dev/pts      136 0-1048575 pty:slave
+EOF
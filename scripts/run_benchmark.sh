@@ -0,0 +1,78 @@
+#!/bin/sh
+
+# Times htop scanning a synthetic procfs tree (see mkfakeproc.sh).
+#
+# usage: run_benchmark.sh [PROCESSES [THREADS [ITERATIONS]]]
+#
+# htop is configured with --with-proc pointing to the fixture and built
+# in $BENCHDIR (default: /tmp/htop-benchmark); extra configure options can
+# be passed in $CONFIGURE_FLAGS. Reports the CPU time per task and update
+# for batch mode (scan, sort, format) and the interactive mode (scan, sort,
+# draw to a terminal discarding the output), the mean wall clock time per
+# task of each refresh phase (see --stats-file) and per update of the
+# machine-level scan, plus the heap allocations per task and update if
+# valgrind is installed.
+
+set -e
+
+SCRIPT=$(readlink -f "$0")
+SCRIPTDIR=$(dirname "$SCRIPT")
+SRCDIR=$(dirname "$SCRIPTDIR")
+
+NPROC=${1:-1000}
+NTHREADS=${2:-4000}
+ITERATIONS=${3:-20}
+BENCHDIR=${BENCHDIR:-/tmp/htop-benchmark}
+
+"$SCRIPTDIR/mkfakeproc.sh" "$BENCHDIR/proc" "$NPROC" "$NTHREADS"
+
+if [ ! -x "$SRCDIR/configure" ]; then
+   (cd "$SRCDIR" && ./autogen.sh)
+fi
+
+mkdir -p "$BENCHDIR/build"
+if [ ! -f "$BENCHDIR/build/Makefile" ]; then
+   # shellcheck disable=SC2086
+   (cd "$BENCHDIR/build" && "$SRCDIR/configure" --with-proc="$BENCHDIR/proc" $CONFIGURE_FLAGS > /dev/null)
+fi
+make -C "$BENCHDIR/build" -j"$(nproc 2>/dev/null || echo 2)" > /dev/null
+
+HTOP="$BENCHDIR/build/htop"
+HTOPRC="$BENCHDIR/htoprc"
+export HTOPRC
+rm -f "$HTOPRC"
+
+TASKS=$((NPROC + NTHREADS))
+# the initial scan comes on top of the iterations
+SCANS=$((ITERATIONS + 1))
+
+# Prints the CPU time (user + system) used by the children of a subshell, in nanoseconds
+cputime() {
+   times > "$BENCHDIR/times"
+   awk 'NR == 2 {
+      split($1, u, /[ms]/); split($2, s, /[ms]/)
+      printf "%.0f\n", ((u[1] + s[1]) * 60 + u[2] + s[2]) * 1e9
+   }' "$BENCHDIR/times"
+}
+
+report() {
+   echo "$1: $(($2 / SCANS / TASKS)) ns/task/update"
+   # reading the system-wide files does not depend on the number of tasks
+   awk -F, -v tasks="$TASKS" '/^# counter/ { exit } !/^#/ && $2 > 0 {
+      if ($1 == "Machine_scan")
+         printf "   %-26s %8.1f us/update\n", $1, $6
+      else
+         printf "   %-26s %8.0f ns/task\n", $1, $6 * 1000 / tasks
+   }' "$3"
+}
+
+BATCH=$( ("$HTOP" --batch -d 1 -n "$ITERATIONS" --stats-file="$BENCHDIR/batch.csv" > /dev/null; cputime) )
+report "batch" "$BATCH" "$BENCHDIR/batch.csv"
+
+UI=$( (TERM=xterm COLUMNS=200 LINES=60 "$HTOP" -d 1 -n "$ITERATIONS" --stats-file="$BENCHDIR/interactive.csv" < /dev/null > /dev/null 2>&1; cputime) )
+report "interactive" "$UI" "$BENCHDIR/interactive.csv"
+
+if command -v valgrind > /dev/null; then
+   ALLOCS=$(valgrind "$HTOP" --batch -d 1 -n "$ITERATIONS" 2>&1 > /dev/null | awk '/total heap usage/ { gsub(",", "", $5); print $5 }')
+   echo "batch: $((ALLOCS / SCANS / TASKS)) allocations/task/update"
+fi
@@ -24,9 +24,11 @@ in the source distribution for its full text.
 
 #include "Macros.h"
 #include "Meter.h"
+#include "CPUHeatmapMeter.h"
 #include "CPUMeter.h"
 #include "MemoryMeter.h"
 #include "MemorySwapMeter.h"
+#include "ProfileMeter.h"
 #include "SwapMeter.h"
 #include "TasksMeter.h"
 #include "LoadAverageMeter.h"
@@ -128,9 +130,15 @@ const MeterClass* const Platform_meterTypes[] = {
    &RightCPUs4Meter_class,
    &LeftCPUs8Meter_class,
    &RightCPUs8Meter_class,
+   &CPUHeatmapMeter_class,
+   &CoreHeatmapMeter_class,
+   &CCDHeatmapMeter_class,
+   &SocketHeatmapMeter_class,
+   &NodeHeatmapMeter_class,
    &ZfsArcMeter_class,
    &ZfsCompressedArcMeter_class,
    &BlankMeter_class,
+   &ProfileMeter_class,
    NULL
 };
 
@@ -314,6 +322,12 @@ char* Platform_getProcessEnv(pid_t pid) {
    return xRealloc(envBuilder.env, envBuilder.size + 1);
 }
 
+char* Platform_getProcessCmdline(pid_t pid, size_t* size) {
+   (void) pid;
+   (void) size;
+   return NULL;
+}
+
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
    (void)pid;
    return NULL;
@@ -163,7 +163,7 @@ static int SolarisProcessTable_walkproc(psinfo_t* _psinfo, lwpsinfo_t* _lwpsinfo
    proc->m_resident         = _psinfo->pr_rssize;  // KB
    proc->m_virt             = _psinfo->pr_size;    // KB
 
-   if (proc->st_uid != _psinfo->pr_euid) {
+   if (proc->st_uid != _psinfo->pr_euid || !proc->user) {
       proc->st_uid          = _psinfo->pr_euid;
       proc->user            = UsersTable_getRef(host->usersTable, proc->st_uid);
    }
@@ -12,6 +12,7 @@ in the source distribution for its full text.
 
 #include <math.h>
 
+#include "CPUHeatmapMeter.h"
 #include "CPUMeter.h"
 #include "ClockMeter.h"
 #include "DateMeter.h"
@@ -22,6 +23,7 @@ in the source distribution for its full text.
 #include "Macros.h"
 #include "MemoryMeter.h"
 #include "MemorySwapMeter.h"
+#include "ProfileMeter.h"
 #include "SwapMeter.h"
 #include "SysArchMeter.h"
 #include "TasksMeter.h"
@@ -71,8 +73,14 @@ const MeterClass* const Platform_meterTypes[] = {
    &RightCPUs4Meter_class,
    &LeftCPUs8Meter_class,
    &RightCPUs8Meter_class,
+   &CPUHeatmapMeter_class,
+   &CoreHeatmapMeter_class,
+   &CCDHeatmapMeter_class,
+   &SocketHeatmapMeter_class,
+   &NodeHeatmapMeter_class,
    &FileDescriptorMeter_class,
    &BlankMeter_class,
+   &ProfileMeter_class,
    NULL
 };
 
@@ -131,6 +139,12 @@ char* Platform_getProcessEnv(pid_t pid) {
    return NULL;
 }
 
+char* Platform_getProcessCmdline(pid_t pid, size_t* size) {
+   (void) pid;
+   (void) size;
+   return NULL;
+}
+
 FileLocks_ProcessData* Platform_getProcessLocks(pid_t pid) {
    (void)pid;
    return NULL;